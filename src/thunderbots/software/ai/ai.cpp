@@ -1,46 +1,79 @@
 #include "ai.h"
 
-AI::AI(const World &world)
-    : world(world),
-      navigator(std::make_unique<RRTNav>()),
-      high_level(std::make_unique<STP_HL>())
+#include <algorithm>
+#include <thread>
+
+#include "util/constants.h"
+
+AI::AI(const World &world, MetricsRegistry &metrics)
+    : world_buffer(world),
+      predicted_world(world),
+      actuation_latency(Util::Constants::DEFAULT_ROBOT_COMMAND_LATENCY),
+      thread_pool(
+          std::max(1u, std::min(NUM_THREADS, std::thread::hardware_concurrency()))),
+      high_level(std::make_unique<STP_HL>(metrics, thread_pool)),
+      navigator(std::make_unique<RRTNav>(thread_pool))
 {
 }
 
-std::vector<std::unique_ptr<Primitive>> AI::getPrimitives(
-    const AITimestamp &timestamp) const
+std::vector<std::unique_ptr<Primitive>> AI::getPrimitives(const AITimestamp &timestamp)
 {
-    // NOTE: The only thing the AI really needs an updated timestamp for (updated relative
-    // to the timestamp when the state/world was last updated) is to update the
-    // "zero-time"
-    // for any predictors (ie. modules that predict Robot, Ball position etc.). When those
-    // are implemented we can update them in some way from here, if necessary.
+    // The snapshot doesn't change until we ask for the next one, so the whole tick
+    // sees the same world even if new data arrives while we plan. The copy shares the
+    // snapshot's signed distance field, and the rest of the World is small and copied
+    // into the storage the last tick's copy already allocated
+    predicted_world = world_buffer.getLatestSnapshot();
+
+    // Plan with the world as it will be when the Primitives take effect. The world is
+    // never predicted backwards, and never too far past the latest data we have
+    auto latest_data_time = predicted_world.getMostRecentTimestamp();
+    auto actuation_time =
+        std::chrono::steady_clock::time_point(timestamp + actuation_latency);
+    auto prediction_time =
+        std::clamp(actuation_time, latest_data_time,
+                   latest_data_time + Util::Constants::AI_MAX_PREDICTION_TIME);
+    predicted_world.updateStateToPredictedState(prediction_time);
 
     std::vector<std::unique_ptr<Intent>> assignedIntents =
-        high_level->getIntentAssignment(world);
+        high_level->getIntentAssignment(predicted_world);
 
     std::vector<std::unique_ptr<Primitive>> assignedPrimitives =
-        navigator->getAssignedPrimitives(world, assignedIntents);
+        navigator->getAssignedPrimitives(predicted_world, assignedIntents);
 
     return assignedPrimitives;
 }
 
+void AI::setActuationLatency(const AITimestamp &actuation_latency)
+{
+    this->actuation_latency = actuation_latency;
+}
+
+void AI::setTickDeadline(const AITimestamp &deadline)
+{
+    navigator->setDeadline(deadline);
+}
+
+bool AI::publishWorldSnapshot()
+{
+    return world_buffer.publish();
+}
+
 void AI::updateWorldBallState(const Ball &new_ball_data)
 {
-    world.updateBallState(new_ball_data);
+    world_buffer.updateBallState(new_ball_data);
 }
 
 void AI::updateWorldFieldState(const Field &new_field_data)
 {
-    world.updateFieldGeometry(new_field_data);
+    world_buffer.updateFieldGeometry(new_field_data);
 }
 
 void AI::updateWorldFriendlyTeamState(const Team &new_friendly_team_data)
 {
-    world.updateFriendlyTeamState(new_friendly_team_data);
+    world_buffer.updateFriendlyTeamState(new_friendly_team_data);
 }
 
 void AI::updateWorldEnemyTeamState(const Team &new_enemy_team_data)
 {
-    world.updateEnemyTeamState(new_enemy_team_data);
+    world_buffer.updateEnemyTeamState(new_enemy_team_data);
 }
\ No newline at end of file
@@ -4,13 +4,26 @@
 #include "ai/navigator/rrt/rrt.h"
 #include "ai/primitive/primitive.h"
 #include "ai/world/world.h"
+#include "ai/world/world_snapshot_buffer.h"
 #include "thunderbots_msgs/Field.h"
 #include "thunderbots_msgs/Team.h"
+#include "util/metrics/metrics_registry.h"
+#include "util/thread_pool.h"
 #include "util/timestamp.h"
 
 /**
  * This class wraps all our AI logic and decision making to help separate our
  * logic from ROS communication as much as possible.
+ *
+ * New data is received on one thread (the ingest thread) while the AI plans on
+ * another (the planning thread). The ingest thread updates the next state of the
+ * world and publishes it as an immutable snapshot, and the planning thread plans each
+ * tick with the latest snapshot, so neither thread has to wait for the other.
+ *
+ * The timestamps in the world are SSL Vision's capture times, which are on the system
+ * clock even though they are stored in std::chrono::steady_clock::time_points. The
+ * times passed to getPrimitives() must be on the same clock, while the tick deadline is
+ * on the steady clock like Timestamp::getTimestampNow().
  */
 class AI final
 {
@@ -19,30 +32,67 @@ class AI final
      * Creates a new AI
      *
      * @param world The initial state of the world for the AI
+     * @param metrics The registry the AI's modules record their metrics in. Must
+     * outlive the AI
      */
-    explicit AI(const World& world);
+    explicit AI(const World& world, MetricsRegistry& metrics);
 
     /**
-     * Calculates the Primitives that should be run by our Robots given the current
-     * state of the world.
+     * Calculates the Primitives that should be run by our Robots given the latest
+     * published snapshot of the world. Must only be called by the planning thread
      *
-     * @param timestamp The timestamp at which this function call is being made
+     * The data in the snapshot is already old by the time we plan with it, and the
+     * Primitives won't take effect until the actuation latency after this call, so the
+     * world is predicted forward to that time before planning.
+     *
+     * @param timestamp The timestamp at which this function call is being made, on the
+     * same clock as the timestamps of the data in the world (SSL Vision's clock)
      *
      * @return the Primitives that should be run by our Robots given the current state
      * of the world.
      */
-    std::vector<std::unique_ptr<Primitive>> getPrimitives(
-        const AITimestamp& timestamp) const;
+    std::vector<std::unique_ptr<Primitive>> getPrimitives(const AITimestamp& timestamp);
+
+    /**
+     * Sets the expected time from getPrimitives() being called to the robots acting on
+     * the Primitives it returns. Must only be called by the planning thread
+     *
+     * @param actuation_latency the expected time from getPrimitives() being called to
+     * the robots acting on the Primitives it returns
+     */
+    void setActuationLatency(const AITimestamp& actuation_latency);
+
+    /**
+     * Sets the time by which getPrimitives() must return, so the navigator plans its
+     * paths in the time left after the high-level logic. Must only be called by the
+     * planning thread
+     *
+     * @param deadline When getPrimitives() must return by, on the same clock as
+     * Timestamp::getTimestampNow()
+     */
+    void setTickDeadline(const AITimestamp& deadline);
 
     /**
-     * Updates the state of the ball in the AI's world with the new ball data
+     * Publishes the updates made to the world since the last time this was called as a
+     * new snapshot, which the planning thread will use on its next tick. Must only be
+     * called by the ingest thread
+     *
+     * @return true if a new snapshot was published, and false if the world had not
+     * been updated
+     */
+    bool publishWorldSnapshot();
+
+    /**
+     * Updates the state of the ball in the AI's world with the new ball data. Must
+     * only be called by the ingest thread
      *
      * @param new_ball_data A Ball containing new ball information
      */
     void updateWorldBallState(const Ball& new_ball_data);
 
     /**
-     * Updates the state of the field in the AI's world with the new field data
+     * Updates the state of the field in the AI's world with the new field data. Must
+     * only be called by the ingest thread
      *
      * @param new_field_data A Field containing new field information
      */
@@ -50,7 +100,8 @@ class AI final
 
     /**
      * Given a message containing new information about the friendly team, updates
-     * the state of the friendly team in the world
+     * the state of the friendly team in the world. Must only be called by the ingest
+     * thread
      *
      * @param new_friendly_team_msg The message containing new friendly team information
      */
@@ -58,7 +109,8 @@ class AI final
 
     /**
      * Given a message containing new information about the enemy team, updates
-     * the state of the enemy team in the world
+     * the state of the enemy team in the world. Must only be called by the ingest
+     * thread
      *
      * @param new_enemy_team_msg The message containing new enemy team information
      */
@@ -66,7 +118,20 @@ class AI final
 
 
    private:
-    World world;
+    // The most threads the modules spread their work across. The modules plan one
+    // after another, so they share one pool. It never has more threads than there
+    // are cores, since the path planners stop after a fixed amount of wall time and
+    // extra threads would only take time away from each other
+    static constexpr unsigned int NUM_THREADS = 4;
+
+    WorldSnapshotBuffer world_buffer;
+    // The latest snapshot of the world, predicted forward to when the Primitives from
+    // the current tick will take effect. This is only used by the planning thread
+    World predicted_world;
+    AITimestamp actuation_latency;
+    // Used by the planning thread for the modules. This is declared before them, so it
+    // outlives them
+    ThreadPool thread_pool;
     std::unique_ptr<HL> high_level;
     std::unique_ptr<Navigator> navigator;
 };
@@ -0,0 +1,208 @@
+#include "ai/hl/stp/evaluation/intercept.h"
+
+#include <algorithm>
+#include <cmath>
+
+const double InterceptSolver::INTERCEPT_DISTANCE_METERS =
+    ROBOT_MAX_RADIUS_METERS + BALL_MAX_RADIUS_METERS;
+
+InterceptSolver::InterceptSolver()
+    : robot_x_positions(),
+      robot_y_positions(),
+      robot_x_velocities(),
+      robot_y_velocities(),
+      robot_start_delays(),
+      intercepts(),
+      friendly_presence_mask(0),
+      enemy_presence_mask(0)
+{
+}
+
+void InterceptSolver::solve(const BallTrajectory &ball_trajectory,
+                            const Team &friendly_team, const Team &enemy_team)
+{
+    const auto start_timestamp = ball_trajectory.getStartTimestamp();
+    friendly_presence_mask     = friendly_team.getRobotPresenceMask();
+    enemy_presence_mask        = enemy_team.getRobotPresenceMask();
+    loadTeam(friendly_team, start_timestamp, 0);
+    loadTeam(enemy_team, start_timestamp, Team::MAX_ROBOT_IDS);
+
+    const uint64_t presence_mask =
+        friendly_presence_mask |
+        (static_cast<uint64_t>(enemy_presence_mask) << Team::MAX_ROBOT_IDS);
+    const double sample_period_seconds =
+        std::chrono::duration_cast<std::chrono::duration<double>>(
+            BallTrajectory::SAMPLE_PERIOD)
+            .count();
+    const std::size_t num_samples          = ball_trajectory.getNumSamples();
+    const std::vector<double> &ball_xs     = ball_trajectory.getSampleXPositions();
+    const std::vector<double> &ball_ys     = ball_trajectory.getSampleYPositions();
+    const std::vector<double> &ball_speeds = ball_trajectory.getSampleSpeeds();
+
+    for (unsigned int i = 0; i < MAX_NUM_ROBOTS; i++)
+    {
+        if (!(presence_mask & (uint64_t(1) << i)))
+        {
+            continue;
+        }
+
+        const double robot_speed =
+            std::min(std::hypot(robot_x_velocities[i], robot_y_velocities[i]),
+                     ROBOT_MAX_SPEED_METERS_PER_SECOND);
+        std::size_t sample = 0;
+        std::optional<std::size_t> intercept_sample;
+        while (sample < num_samples)
+        {
+            const double dx       = ball_xs[sample] - robot_x_positions[i];
+            const double dy       = ball_ys[sample] - robot_y_positions[i];
+            const double distance = std::hypot(dx, dy);
+            const double time =
+                std::max(0.0, sample * sample_period_seconds - robot_start_delays[i]);
+
+            // The robot drives towards where the ball will be, starting at its current
+            // speed in that direction
+            const double initial_speed =
+                distance > 0
+                    ? (robot_x_velocities[i] * dx + robot_y_velocities[i] * dy) / distance
+                    : 0;
+            const double gap = distance - INTERCEPT_DISTANCE_METERS -
+                               getReachableDistance(time, initial_speed);
+            if (gap <= 0)
+            {
+                intercept_sample = sample;
+                break;
+            }
+
+            // The gap can't close faster than the ball's current speed plus the robot's
+            // maximum speed, and the robot can't reach further than if all of its
+            // velocity were towards the ball, so it can't reach the ball any sooner
+            // than this
+            const double optimistic_gap = distance - INTERCEPT_DISTANCE_METERS -
+                                          getReachableDistance(time, robot_speed);
+            const double max_closing_distance_per_sample =
+                (ball_speeds[sample] + ROBOT_MAX_SPEED_METERS_PER_SECOND) *
+                sample_period_seconds;
+            const double samples_to_skip =
+                std::max(1.0, optimistic_gap / max_closing_distance_per_sample);
+            sample += static_cast<std::size_t>(samples_to_skip);
+        }
+
+        if (intercept_sample)
+        {
+            intercepts[i].position =
+                Point(ball_xs[*intercept_sample], ball_ys[*intercept_sample]);
+            intercepts[i].timestamp =
+                start_timestamp + std::chrono::duration_cast<std::chrono::microseconds>(
+                                      BallTrajectory::SAMPLE_PERIOD * *intercept_sample);
+            continue;
+        }
+
+        // The robot can't reach the ball before the end of the samples, so it goes to
+        // the last sample. The ball has usually stopped by then
+        const std::size_t last_sample = num_samples - 1;
+        const Point last_ball_position(ball_xs[last_sample], ball_ys[last_sample]);
+        const Vector to_ball =
+            last_ball_position - Point(robot_x_positions[i], robot_y_positions[i]);
+        const double initial_speed =
+            to_ball.len() > 0
+                ? Vector(robot_x_velocities[i], robot_y_velocities[i]).dot(to_ball) /
+                      to_ball.len()
+                : 0;
+        const double seconds_after_start =
+            std::max(last_sample * sample_period_seconds,
+                     robot_start_delays[i] +
+                         getTimeToTravelDistance(
+                             to_ball.len() - INTERCEPT_DISTANCE_METERS, initial_speed));
+        intercepts[i].position = last_ball_position;
+        intercepts[i].timestamp =
+            start_timestamp + std::chrono::duration_cast<std::chrono::microseconds>(
+                                  std::chrono::duration<double>(seconds_after_start));
+    }
+}
+
+std::optional<BallIntercept> InterceptSolver::getFriendlyIntercept(
+    unsigned int robot_id) const
+{
+    if (robot_id >= Team::MAX_ROBOT_IDS || !(friendly_presence_mask & (1u << robot_id)))
+    {
+        return std::nullopt;
+    }
+    return intercepts[robot_id];
+}
+
+std::optional<BallIntercept> InterceptSolver::getEnemyIntercept(
+    unsigned int robot_id) const
+{
+    if (robot_id >= Team::MAX_ROBOT_IDS || !(enemy_presence_mask & (1u << robot_id)))
+    {
+        return std::nullopt;
+    }
+    return intercepts[Team::MAX_ROBOT_IDS + robot_id];
+}
+
+void InterceptSolver::loadTeam(const Team &team,
+                               std::chrono::steady_clock::time_point start_timestamp,
+                               unsigned int first_index)
+{
+    const uint32_t presence_mask = team.getRobotPresenceMask();
+    for (unsigned int id = 0; id < Team::MAX_ROBOT_IDS; id++)
+    {
+        unsigned int i = first_index + id;
+        if (presence_mask & (1u << id))
+        {
+            const Point &position  = team.getRobotPositions()[id];
+            const Vector &velocity = team.getRobotVelocities()[id];
+            robot_x_positions[i]   = position.x();
+            robot_y_positions[i]   = position.y();
+            robot_x_velocities[i]  = velocity.x();
+            robot_y_velocities[i]  = velocity.y();
+            robot_start_delays[i] =
+                std::chrono::duration_cast<std::chrono::duration<double>>(
+                    team.getRobotLastUpdateTimestamps()[id] - start_timestamp)
+                    .count();
+        }
+        else
+        {
+            robot_x_positions[i]  = 0;
+            robot_y_positions[i]  = 0;
+            robot_x_velocities[i] = 0;
+            robot_y_velocities[i] = 0;
+            robot_start_delays[i] = 0;
+        }
+    }
+}
+
+double InterceptSolver::getReachableDistance(double seconds, double initial_speed)
+{
+    const double max_speed = ROBOT_MAX_SPEED_METERS_PER_SECOND;
+    const double max_accel = ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED;
+    initial_speed          = std::clamp(initial_speed, -max_speed, max_speed);
+
+    const double accel_time = std::min(seconds, (max_speed - initial_speed) / max_accel);
+    return initial_speed * accel_time + 0.5 * max_accel * accel_time * accel_time +
+           max_speed * (seconds - accel_time);
+}
+
+double InterceptSolver::getTimeToTravelDistance(double distance, double initial_speed)
+{
+    if (distance <= 0)
+    {
+        return 0;
+    }
+
+    const double max_speed = ROBOT_MAX_SPEED_METERS_PER_SECOND;
+    const double max_accel = ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED;
+    initial_speed          = std::clamp(initial_speed, -max_speed, max_speed);
+
+    // Solve distance = initial_speed * t + max_accel * t^2 / 2 if the robot gets there
+    // before reaching its maximum speed, and otherwise add the time at maximum speed
+    const double accel_time     = (max_speed - initial_speed) / max_accel;
+    const double accel_distance = (initial_speed + max_speed) / 2 * accel_time;
+    if (distance <= accel_distance)
+    {
+        return (-initial_speed +
+                std::sqrt(initial_speed * initial_speed + 2 * max_accel * distance)) /
+               max_accel;
+    }
+    return accel_time + (distance - accel_distance) / max_speed;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+#include "ai/world/ball_trajectory.h"
+#include "ai/world/team.h"
+#include "geom/point.h"
+#include "shared/constants.h"
+
+/**
+ * Where and when a robot can first get to the ball
+ */
+typedef struct
+{
+    // Where the ball will be when the robot gets to it
+    Point position;
+    // When the robot gets to the ball
+    std::chrono::steady_clock::time_point timestamp;
+} BallIntercept;
+
+/**
+ * Finds the earliest time and place each robot on both teams can get to the ball, given
+ * the trajectory of the ball and how fast the robots can accelerate and move.
+ *
+ * Both teams are solved in one batch against the sampled ball trajectory, with the
+ * robots stored as separate arrays of coordinates. Rather than checking every sample,
+ * each robot skips ahead by as many samples as it certainly can't close its gap to the
+ * ball in, since the ball never speeds up and the robot can't go faster than its maximum
+ * speed. This finds the same intercepts as checking every sample, but usually checks
+ * only a few dozen samples per robot. Nothing is allocated after construction.
+ *
+ * A robot accelerates straight towards where the ball will be, starting from its
+ * current speed in that direction. The rest of its velocity is ignored, so the
+ * intercepts are slightly optimistic for robots moving across the ball's path.
+ */
+class InterceptSolver final
+{
+   public:
+    // How close the centre of a robot must get to the centre of the ball to reach it
+    static const double INTERCEPT_DISTANCE_METERS;
+
+    /**
+     * Creates a new InterceptSolver with no intercepts
+     */
+    explicit InterceptSolver();
+
+    /**
+     * Finds where and when each robot on both teams can first get to the ball. The
+     * intercepts of the previous call are replaced
+     *
+     * @param ball_trajectory The trajectory of the ball
+     * @param friendly_team The friendly team
+     * @param enemy_team The enemy team
+     */
+    void solve(const BallTrajectory& ball_trajectory, const Team& friendly_team,
+               const Team& enemy_team);
+
+    /**
+     * Returns where and when the friendly robot with the given id can first get to the
+     * ball
+     *
+     * @param robot_id The id of the friendly robot
+     *
+     * @return where and when the robot can first get to the ball, or std::nullopt if
+     * there was no friendly robot with the given id the last time the solver was run
+     */
+    std::optional<BallIntercept> getFriendlyIntercept(unsigned int robot_id) const;
+
+    /**
+     * Returns where and when the enemy robot with the given id can first get to the
+     * ball
+     *
+     * @param robot_id The id of the enemy robot
+     *
+     * @return where and when the robot can first get to the ball, or std::nullopt if
+     * there was no enemy robot with the given id the last time the solver was run
+     */
+    std::optional<BallIntercept> getEnemyIntercept(unsigned int robot_id) const;
+
+   private:
+    // The friendly robots are stored first, indexed by id, and then the enemy robots
+    static constexpr unsigned int MAX_NUM_ROBOTS = 2 * Team::MAX_ROBOT_IDS;
+    /**
+     * Copies the robots on the given team into the arrays of robot state, starting at
+     * the given index
+     *
+     * @param team The team to copy the robots of
+     * @param start_timestamp The time the ball trajectory starts at
+     * @param first_index The index of the robot with id 0 in the arrays
+     */
+    void loadTeam(const Team& team, std::chrono::steady_clock::time_point start_timestamp,
+                  unsigned int first_index);
+
+    /**
+     * Returns how far a robot can travel in a straight line in the given time,
+     * accelerating as hard as it can up to its maximum speed
+     *
+     * @param seconds The time to travel for, in seconds
+     * @param initial_speed The speed the robot is already travelling in the direction
+     * it needs to go, in metres per second. May be negative if it is moving away
+     *
+     * @return how far the robot can travel, in metres
+     */
+    static double getReachableDistance(double seconds, double initial_speed);
+
+    /**
+     * Returns how long it takes a robot to travel the given distance in a straight line,
+     * accelerating as hard as it can up to its maximum speed
+     *
+     * @param distance The distance to travel, in metres
+     * @param initial_speed The speed the robot is already travelling in the direction
+     * it needs to go, in metres per second. May be negative if it is moving away
+     *
+     * @return how long it takes the robot to travel the distance, in seconds
+     */
+    static double getTimeToTravelDistance(double distance, double initial_speed);
+
+    // The state of each robot, in metres, metres per second and seconds. The start delay
+    // is how long after the start of the ball trajectory the robot's state is from
+    std::array<double, MAX_NUM_ROBOTS> robot_x_positions;
+    std::array<double, MAX_NUM_ROBOTS> robot_y_positions;
+    std::array<double, MAX_NUM_ROBOTS> robot_x_velocities;
+    std::array<double, MAX_NUM_ROBOTS> robot_y_velocities;
+    std::array<double, MAX_NUM_ROBOTS> robot_start_delays;
+    std::array<BallIntercept, MAX_NUM_ROBOTS> intercepts;
+    uint32_t friendly_presence_mask;
+    uint32_t enemy_presence_mask;
+};
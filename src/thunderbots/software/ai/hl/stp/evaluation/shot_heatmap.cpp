@@ -0,0 +1,281 @@
+#include "ai/hl/stp/evaluation/shot_heatmap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "shared/constants.h"
+
+const double ShotHeatmap::ROBOT_BLOCKING_RADIUS_METERS =
+    ROBOT_MAX_RADIUS_METERS + BALL_MAX_RADIUS_METERS;
+
+ShotHeatmap::ShotHeatmap(double cell_size_meters, ThreadPool &thread_pool)
+    : cell_size(cell_size_meters),
+      thread_pool(thread_pool),
+      field(std::nullopt),
+      goalpost_neg(),
+      goalpost_pos(),
+      min_x(0),
+      min_y(0),
+      num_columns(0),
+      num_rows(0),
+      open_angles(),
+      num_cells_recomputed_per_row(),
+      robot_x_positions(),
+      robot_y_positions(),
+      presence_mask(0),
+      previous_robot_x_positions(),
+      previous_robot_y_positions(),
+      previous_presence_mask(0),
+      changed_mask(0)
+{
+}
+
+void ShotHeatmap::update(const Field &field, const Team &friendly_team,
+                         const Team &enemy_team)
+{
+    bool recompute_all = false;
+    if (!this->field || *this->field != field)
+    {
+        this->field  = field;
+        goalpost_neg = field.enemyGoalpostNeg();
+        goalpost_pos = field.enemyGoalpostPos();
+        min_x        = -field.length() / 2;
+        min_y        = -field.width() / 2;
+        num_columns  = static_cast<std::size_t>(
+            std::max(1.0, std::ceil(field.length() / cell_size)));
+        num_rows =
+            static_cast<std::size_t>(std::max(1.0, std::ceil(field.width() / cell_size)));
+        open_angles.assign(num_columns * num_rows, 0);
+        num_cells_recomputed_per_row.assign(num_rows, 0);
+        recompute_all = true;
+    }
+
+    previous_presence_mask = presence_mask;
+    changed_mask           = 0;
+    loadTeam(friendly_team, 0);
+    loadTeam(enemy_team, Team::MAX_ROBOT_IDS);
+
+    if (!recompute_all && changed_mask == 0)
+    {
+        std::fill(num_cells_recomputed_per_row.begin(),
+                  num_cells_recomputed_per_row.end(), 0);
+        return;
+    }
+
+    thread_pool.parallelFor(num_rows, [this, recompute_all](std::size_t row) {
+        num_cells_recomputed_per_row[row] = updateRow(row, recompute_all);
+    });
+}
+
+Angle ShotHeatmap::getOpenAngle(const Point &point) const
+{
+    if (open_angles.empty())
+    {
+        return Angle::zero();
+    }
+
+    const double column = std::floor((point.x() - min_x) / cell_size);
+    const double row    = std::floor((point.y() - min_y) / cell_size);
+    return getOpenAngle(
+        static_cast<std::size_t>(std::clamp(column, 0.0, num_columns - 1.0)),
+        static_cast<std::size_t>(std::clamp(row, 0.0, num_rows - 1.0)));
+}
+
+Angle ShotHeatmap::getOpenAngle(std::size_t column, std::size_t row) const
+{
+    return Angle::ofRadians(open_angles[row * num_columns + column]);
+}
+
+Point ShotHeatmap::getCellCentre(std::size_t column, std::size_t row) const
+{
+    return Point(min_x + (column + 0.5) * cell_size, min_y + (row + 0.5) * cell_size);
+}
+
+std::size_t ShotHeatmap::getNumColumns() const
+{
+    return num_columns;
+}
+
+std::size_t ShotHeatmap::getNumRows() const
+{
+    return num_rows;
+}
+
+std::size_t ShotHeatmap::getNumCellsRecomputed() const
+{
+    return std::accumulate(num_cells_recomputed_per_row.begin(),
+                           num_cells_recomputed_per_row.end(), std::size_t(0));
+}
+
+void ShotHeatmap::loadTeam(const Team &team, unsigned int first_index)
+{
+    const uint32_t team_presence_mask = team.getRobotPresenceMask();
+    for (unsigned int id = 0; id < Team::MAX_ROBOT_IDS; id++)
+    {
+        const unsigned int i   = first_index + id;
+        const uint64_t bit     = uint64_t(1) << i;
+        const bool was_present = presence_mask & bit;
+        const bool is_present  = team_presence_mask & (1u << id);
+        if (!was_present && !is_present)
+        {
+            continue;
+        }
+
+        const Point &position = team.getRobotPositions()[id];
+        if (was_present && is_present &&
+            std::hypot(position.x() - robot_x_positions[i],
+                       position.y() - robot_y_positions[i]) <=
+                ROBOT_MOVEMENT_THRESHOLD_METERS)
+        {
+            continue;
+        }
+
+        previous_robot_x_positions[i] = robot_x_positions[i];
+        previous_robot_y_positions[i] = robot_y_positions[i];
+        changed_mask |= bit;
+        if (is_present)
+        {
+            robot_x_positions[i] = position.x();
+            robot_y_positions[i] = position.y();
+            presence_mask |= bit;
+        }
+        else
+        {
+            presence_mask &= ~bit;
+        }
+    }
+}
+
+std::size_t ShotHeatmap::updateRow(std::size_t row, bool recompute_all)
+{
+    std::size_t num_cells_recomputed = 0;
+    for (std::size_t column = 0; column < num_columns; column++)
+    {
+        const Point centre = getCellCentre(column, row);
+
+        // Only cells whose shots a changed robot blocked before it changed, or blocks
+        // now, can have a different open angle. Most robots aren't anywhere near the
+        // shot, so the directions to the goalposts are only found if one might be
+        bool affected = recompute_all;
+        std::optional<std::pair<double, double>> goal_angles;
+        auto blocks_shot = [&](double robot_x, double robot_y) {
+            if (!mayBlockShot(centre, robot_x, robot_y))
+            {
+                return false;
+            }
+            if (!goal_angles)
+            {
+                goal_angles = getGoalAngles(centre);
+            }
+            double blocked_start, blocked_end;
+            return getBlockedDirections(centre, robot_x, robot_y, goal_angles->first,
+                                        goal_angles->second, blocked_start, blocked_end);
+        };
+        for (uint64_t mask = changed_mask; mask != 0 && !affected; mask &= mask - 1)
+        {
+            const unsigned int i = static_cast<unsigned int>(__builtin_ctzll(mask));
+            const uint64_t bit   = uint64_t(1) << i;
+            if ((previous_presence_mask & bit) &&
+                blocks_shot(previous_robot_x_positions[i], previous_robot_y_positions[i]))
+            {
+                affected = true;
+            }
+            else if ((presence_mask & bit) &&
+                     blocks_shot(robot_x_positions[i], robot_y_positions[i]))
+            {
+                affected = true;
+            }
+        }
+
+        if (affected)
+        {
+            open_angles[row * num_columns + column] = calculateOpenAngle(centre);
+            num_cells_recomputed++;
+        }
+    }
+    return num_cells_recomputed;
+}
+
+std::pair<double, double> ShotHeatmap::getGoalAngles(const Point &point) const
+{
+    return std::make_pair(
+        std::atan2(goalpost_neg.y() - point.y(), goalpost_neg.x() - point.x()),
+        std::atan2(goalpost_pos.y() - point.y(), goalpost_pos.x() - point.x()));
+}
+
+bool ShotHeatmap::mayBlockShot(const Point &point, double robot_x, double robot_y) const
+{
+    const double radius = ROBOT_BLOCKING_RADIUS_METERS;
+    return robot_x + radius > point.x() && robot_x - radius < goalpost_neg.x() &&
+           robot_y + radius > std::min(point.y(), goalpost_neg.y()) &&
+           robot_y - radius < std::max(point.y(), goalpost_pos.y());
+}
+
+bool ShotHeatmap::getBlockedDirections(const Point &point, double robot_x, double robot_y,
+                                       double goal_start_angle, double goal_end_angle,
+                                       double &blocked_start, double &blocked_end) const
+{
+    if (!mayBlockShot(point, robot_x, robot_y))
+    {
+        return false;
+    }
+
+    const double radius           = ROBOT_BLOCKING_RADIUS_METERS;
+    const double dx               = robot_x - point.x();
+    const double dy               = robot_y - point.y();
+    const double distance_squared = dx * dx + dy * dy;
+    if (distance_squared <= radius * radius)
+    {
+        // The point is inside the robot, so every shot is blocked
+        blocked_start = goal_start_angle;
+        blocked_end   = goal_end_angle;
+        return true;
+    }
+
+    // The robot is in front of the point, so its directions don't wrap around
+    const double centre_angle = std::atan2(dy, dx);
+    const double half_width   = std::asin(radius / std::sqrt(distance_squared));
+    blocked_start             = std::max(centre_angle - half_width, goal_start_angle);
+    blocked_end               = std::min(centre_angle + half_width, goal_end_angle);
+    return blocked_start < blocked_end;
+}
+
+double ShotHeatmap::calculateOpenAngle(const Point &point) const
+{
+    // The goal is in front of every cell, so the directions to the goalposts are
+    // between -90 and 90 degrees and the negative goalpost is clockwise of the positive
+    // one
+    const auto [goal_start_angle, goal_end_angle] = getGoalAngles(point);
+    if (goal_end_angle <= goal_start_angle)
+    {
+        return 0;
+    }
+
+    std::array<std::pair<double, double>, MAX_NUM_ROBOTS> blocked_ranges;
+    std::size_t num_blocked_ranges = 0;
+    for (uint64_t mask = presence_mask; mask != 0; mask &= mask - 1)
+    {
+        const unsigned int i = static_cast<unsigned int>(__builtin_ctzll(mask));
+        double blocked_start, blocked_end;
+        if (getBlockedDirections(point, robot_x_positions[i], robot_y_positions[i],
+                                 goal_start_angle, goal_end_angle, blocked_start,
+                                 blocked_end))
+        {
+            blocked_ranges[num_blocked_ranges++] =
+                std::make_pair(blocked_start, blocked_end);
+        }
+    }
+
+    // Sweep across the goal, measuring the gaps between the blocked ranges. Unlike
+    // angleSweepCircles, the ranges are allowed to overlap
+    std::sort(blocked_ranges.begin(), blocked_ranges.begin() + num_blocked_ranges);
+    double largest_gap = 0;
+    double open_from   = goal_start_angle;
+    for (std::size_t i = 0; i < num_blocked_ranges; i++)
+    {
+        largest_gap = std::max(largest_gap, blocked_ranges[i].first - open_from);
+        open_from   = std::max(open_from, blocked_ranges[i].second);
+    }
+    return std::max(largest_gap, goal_end_angle - open_from);
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "ai/world/field.h"
+#include "ai/world/team.h"
+#include "geom/angle.h"
+#include "geom/point.h"
+#include "util/thread_pool.h"
+
+/**
+ * A grid over the field that holds, for the centre of every cell, the largest open
+ * angle a ball could be shot through into the enemy goal, with every robot on both
+ * teams treated as an obstacle. Tactics can look up how good a position is to shoot
+ * from without sweeping over the robots themselves.
+ *
+ * The first update computes every cell, with the rows of the grid spread across a
+ * ThreadPool. After that, the heatmap keeps the position of each robot as of the last
+ * time it was used, and only recomputes the cells whose shots the robots that have
+ * moved further than ROBOT_MOVEMENT_THRESHOLD_METERS since then blocked before or block
+ * now. Robots that moved less than that are left where they were, so the heatmap is
+ * always exactly what it would be if it were computed from scratch with the robots at
+ * the positions it keeps.
+ */
+class ShotHeatmap final
+{
+   public:
+    // How far a robot can move before the cells it affects are recomputed
+    static constexpr double ROBOT_MOVEMENT_THRESHOLD_METERS = 0.02;
+    // How close the centre of a robot must be to the path of the ball to block it
+    static const double ROBOT_BLOCKING_RADIUS_METERS;
+
+    /**
+     * Creates a new ShotHeatmap. The grid is empty until the first update
+     *
+     * @param cell_size_meters The width and height of each cell of the grid, in metres
+     * @param thread_pool The threads to spread the rows of the grid across when
+     * updating it. Must outlive the heatmap
+     */
+    explicit ShotHeatmap(double cell_size_meters, ThreadPool& thread_pool);
+
+    /**
+     * Updates the open angles for the current positions of the robots. Every cell is
+     * recomputed if the field has changed
+     *
+     * @param field The field the grid covers, not including its boundary
+     * @param friendly_team The friendly team
+     * @param enemy_team The enemy team
+     */
+    void update(const Field& field, const Team& friendly_team, const Team& enemy_team);
+
+    /**
+     * Returns the largest open angle into the enemy goal from the centre of the cell
+     * containing the given point. Points off the edge of the field use the nearest cell
+     *
+     * @param point The point to look up
+     *
+     * @return the largest open angle into the enemy goal near the point, or zero if
+     * the heatmap has not been updated yet
+     */
+    Angle getOpenAngle(const Point& point) const;
+
+    /**
+     * Returns the largest open angle into the enemy goal from the centre of the given
+     * cell
+     *
+     * @param column The column of the cell. Must be less than getNumColumns()
+     * @param row The row of the cell. Must be less than getNumRows()
+     *
+     * @return the largest open angle into the enemy goal from the centre of the cell
+     */
+    Angle getOpenAngle(std::size_t column, std::size_t row) const;
+
+    /**
+     * Returns the centre of the given cell
+     *
+     * @param column The column of the cell
+     * @param row The row of the cell
+     *
+     * @return the centre of the cell
+     */
+    Point getCellCentre(std::size_t column, std::size_t row) const;
+
+    /**
+     * Returns the number of columns in the grid, along the length of the field
+     *
+     * @return the number of columns in the grid
+     */
+    std::size_t getNumColumns() const;
+
+    /**
+     * Returns the number of rows in the grid, along the width of the field
+     *
+     * @return the number of rows in the grid
+     */
+    std::size_t getNumRows() const;
+
+    /**
+     * Returns how many cells were recomputed by the last update
+     *
+     * @return how many cells were recomputed by the last update
+     */
+    std::size_t getNumCellsRecomputed() const;
+
+   private:
+    // The friendly robots are stored first, indexed by id, and then the enemy robots
+    static constexpr unsigned int MAX_NUM_ROBOTS = 2 * Team::MAX_ROBOT_IDS;
+    static_assert(MAX_NUM_ROBOTS <= 64, "The robot presence mask must fit in 64 bits");
+
+    /**
+     * Updates the stored position of each robot on the given team that has moved far
+     * enough, or joined or left the team, and marks it as changed
+     *
+     * @param team The team
+     * @param first_index The index of the robot with id 0 on the team
+     */
+    void loadTeam(const Team& team, unsigned int first_index);
+
+    /**
+     * Recomputes the cells in the given row whose shots were or are blocked by a
+     * changed robot, or every cell in the row if recompute_all is true
+     *
+     * @param row The row to update
+     * @param recompute_all Whether to recompute every cell in the row
+     *
+     * @return the number of cells recomputed
+     */
+    std::size_t updateRow(std::size_t row, bool recompute_all);
+
+    /**
+     * Returns the directions from the given point to the negative and positive
+     * goalposts, in radians
+     */
+    std::pair<double, double> getGoalAngles(const Point& point) const;
+
+    /**
+     * Returns whether the robot at the given position overlaps the bounding box of the
+     * triangle between the given point and the goalposts. Robots that don't can't
+     * block any shot from the point, and this is much cheaper to check than the
+     * directions they block
+     */
+    bool mayBlockShot(const Point& point, double robot_x, double robot_y) const;
+
+    /**
+     * Returns the range of directions that the robot at the given position blocks,
+     * as seen from the given point, clipped to the directions into the goal. Robots
+     * that can't be between the point and the goal are ignored
+     *
+     * @param point The point to shoot from
+     * @param robot_x, robot_y The position of the robot
+     * @param goal_start_angle, goal_end_angle The directions from the point to the
+     * goalposts, in radians, with goal_start_angle <= goal_end_angle
+     * @param blocked_start, blocked_end Set to the range of directions blocked, in
+     * radians, if any are
+     *
+     * @return true if the robot blocks any direction into the goal, and false otherwise
+     */
+    bool getBlockedDirections(const Point& point, double robot_x, double robot_y,
+                              double goal_start_angle, double goal_end_angle,
+                              double& blocked_start, double& blocked_end) const;
+
+    /**
+     * Returns the largest open angle into the goal from the given point, with the
+     * robots at their stored positions as obstacles
+     *
+     * @param point The point to shoot from
+     *
+     * @return the largest open angle into the goal, in radians
+     */
+    double calculateOpenAngle(const Point& point) const;
+
+    double cell_size;
+    ThreadPool& thread_pool;
+
+    // The geometry the grid was last computed for
+    std::optional<Field> field;
+    Point goalpost_neg;
+    Point goalpost_pos;
+    double min_x;
+    double min_y;
+    std::size_t num_columns;
+    std::size_t num_rows;
+
+    // The open angle from the centre of each cell, in radians, indexed by
+    // row * num_columns + column. Each row is only written by the thread updating it
+    std::vector<double> open_angles;
+    // The number of cells recomputed in each row by the last update
+    std::vector<std::size_t> num_cells_recomputed_per_row;
+
+    // The positions of the robots the open angles were computed with
+    std::array<double, MAX_NUM_ROBOTS> robot_x_positions;
+    std::array<double, MAX_NUM_ROBOTS> robot_y_positions;
+    uint64_t presence_mask;
+    // The robots that changed in the current update, and where they were before it
+    std::array<double, MAX_NUM_ROBOTS> previous_robot_x_positions;
+    std::array<double, MAX_NUM_ROBOTS> previous_robot_y_positions;
+    uint64_t previous_presence_mask;
+    uint64_t changed_mask;
+};
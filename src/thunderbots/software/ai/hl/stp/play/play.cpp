@@ -17,11 +17,16 @@ std::vector<std::string> Play::getPlayNames()
 
     for (const auto& play_factory : Play::getRegistry())
     {
-        names.emplace_back(play_factory->getInstance()->name());
+        names.emplace_back(play_factory->getName());
     }
     return names;
 }
 
+double Play::calculateScore(const World& world)
+{
+    return 0.5;
+}
+
 void Play::registerPlay(std::shared_ptr<PlayFactory> play_factory)
 {
     Play::getMutableRegistry().emplace_back(play_factory);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "ai/hl/stp/tactic/tactic.h"
@@ -22,12 +23,21 @@ class PlayFactory
 {
    public:
     /**
-     * Returns a pointer to the Play constructed by this Factory
+     * Returns a pointer to the Play constructed by this Factory. Each Factory only
+     * constructs its Play once, when it is registered, so this is always the same Play
      *
      * @return a shared pointer to the Play constructed by this Factory
      */
     virtual std::shared_ptr<Play> getInstance() = 0;
 
+    /**
+     * Returns the name of the Play constructed by this Factory, which is read once when
+     * the Play is registered
+     *
+     * @return the name of the Play constructed by this Factory
+     */
+    virtual const std::string& getName() const = 0;
+
     virtual ~PlayFactory() = default;
 };
 
@@ -88,6 +98,16 @@ class Play
      */
     virtual std::vector<std::unique_ptr<Tactic>> getTactics(const World& world) = 0;
 
+    /**
+     * Returns how well suited this Play is to the current state of the world. When
+     * several Plays are applicable, the one with the highest score is run. Scores are
+     * between 0 and 1, and default to 0.5 for Plays that don't have a preference
+     *
+     * @param world The current state of the world
+     * @return how well suited this Play is to the current state of the world
+     */
+    virtual double calculateScore(const World& world);
+
     /**
      * Returns the name of this Play
      *
@@ -158,13 +178,22 @@ class TPlayFactory : public PlayFactory
     static_assert(std::is_base_of<Play, T>::value, "T must be derived class of Play!");
 
    public:
-    TPlayFactory()
+    TPlayFactory() : instance(std::make_shared<T>()), name(instance->name())
     {
         Play::registerPlay(std::make_shared<TPlayFactory>(*this));
     }
 
     std::shared_ptr<Play> getInstance() override
     {
-        return std::make_shared<T>();
+        return instance;
     }
+
+    const std::string& getName() const override
+    {
+        return name;
+    }
+
+   private:
+    std::shared_ptr<Play> instance;
+    std::string name;
 };
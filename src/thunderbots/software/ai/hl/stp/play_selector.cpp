@@ -0,0 +1,83 @@
+#include "ai/hl/stp/play_selector.h"
+
+#include <algorithm>
+#include <optional>
+
+PlaySelector::PlaySelector(const std::vector<std::shared_ptr<PlayFactory>> &play_registry,
+                           ThreadPool &thread_pool)
+    : plays(),
+      thread_pool(thread_pool),
+      play_applicable(play_registry.size(), 0),
+      play_scores(play_registry.size(), 0),
+      last_selection_duration(0)
+{
+    for (const auto &play_factory : play_registry)
+    {
+        plays.emplace_back(play_factory->getInstance());
+    }
+}
+
+std::shared_ptr<Play> PlaySelector::selectPlay(const World &world,
+                                               const std::shared_ptr<Play> &current_play)
+{
+    const AITimestamp start_time = Timestamp::getTimestampNow();
+
+    thread_pool.parallelFor(plays.size(), [this, &world](std::size_t i) {
+        play_applicable[i] = plays[i]->isApplicable(world);
+        play_scores[i]     = plays[i]->calculateScore(world);
+    });
+
+    // A Play that has failed or whose invariant doesn't hold can't be chosen again
+    // straight away, even if it would otherwise still be applicable
+    const bool current_play_can_continue = current_play &&
+                                           current_play->invariantHolds(world) &&
+                                           !current_play->hasFailed(world);
+    std::optional<std::size_t> current_play_index;
+    std::optional<std::size_t> best_play_index;
+    for (std::size_t i = 0; i < plays.size(); i++)
+    {
+        if (plays[i] == current_play)
+        {
+            current_play_index = i;
+            if (!current_play_can_continue)
+            {
+                continue;
+            }
+        }
+        if (play_applicable[i] &&
+            (!best_play_index || play_scores[i] > play_scores[*best_play_index]))
+        {
+            best_play_index = i;
+        }
+    }
+
+    std::shared_ptr<Play> selected_play;
+    if (current_play_can_continue &&
+        (!best_play_index || !current_play_index ||
+         play_scores[*best_play_index] <=
+             play_scores[*current_play_index] + PLAY_SWITCH_SCORE_HYSTERESIS))
+    {
+        selected_play = current_play;
+    }
+    else if (best_play_index)
+    {
+        selected_play = plays[*best_play_index];
+    }
+    else if (current_play)
+    {
+        // Nothing else can run, so the current Play carries on as best it can
+        selected_play = current_play;
+    }
+    else if (!plays.empty())
+    {
+        selected_play = plays.front();
+    }
+
+    last_selection_duration = Timestamp::getTimestampNow() - start_time;
+    return selected_play;
+}
+
+AITimestamp PlaySelector::getLastSelectionDuration() const
+{
+    return last_selection_duration;
+}
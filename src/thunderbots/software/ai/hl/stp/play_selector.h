@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ai/hl/stp/play/play.h"
+#include "ai/world/world.h"
+#include "util/thread_pool.h"
+#include "util/timestamp.h"
+
+/**
+ * Chooses which Play the AI should run each tick.
+ *
+ * The selector keeps the one instance of each registered Play, and checks whether every
+ * Play is applicable, and how well suited it is, in parallel on a ThreadPool. The
+ * current Play keeps running while its invariant holds and it hasn't failed, unless
+ * another applicable Play scores more than PLAY_SWITCH_SCORE_HYSTERESIS higher, so the
+ * AI doesn't flip between Plays whose scores are close. Otherwise the applicable Play
+ * with the highest score is chosen, with ties going to the Play registered first.
+ *
+ * Since the Plays are checked on different threads at the same time, a Play's
+ * isApplicable and calculateScore functions must only change the Play itself.
+ */
+class PlaySelector final
+{
+   public:
+    // How much higher another Play has to score than the current Play to replace it
+    static constexpr double PLAY_SWITCH_SCORE_HYSTERESIS = 0.1;
+
+    /**
+     * Creates a new PlaySelector that chooses from the given Plays
+     *
+     * @param play_registry The factories of the Plays to choose from
+     * @param thread_pool The threads to check the Plays on. Must outlive the selector
+     */
+    explicit PlaySelector(const std::vector<std::shared_ptr<PlayFactory>>& play_registry,
+                          ThreadPool& thread_pool);
+
+    /**
+     * Chooses the Play that should be run in the given state of the world
+     *
+     * @param world The current state of the world
+     * @param current_play The Play that is running now, if any
+     *
+     * @return the Play that should be run. This is the current Play if no other Play
+     * should replace it, and nullptr if there are no Plays at all
+     */
+    std::shared_ptr<Play> selectPlay(const World& world,
+                                     const std::shared_ptr<Play>& current_play);
+
+    /**
+     * Returns how long the last call to selectPlay() took
+     *
+     * @return how long the last call to selectPlay() took
+     */
+    AITimestamp getLastSelectionDuration() const;
+
+   private:
+    std::vector<std::shared_ptr<Play>> plays;
+    ThreadPool& thread_pool;
+
+    // Whether each Play was applicable, and its score, the last time the Plays were
+    // checked. Bytes are used rather than bools so each thread writes separate memory
+    std::vector<uint8_t> play_applicable;
+    std::vector<double> play_scores;
+
+    AITimestamp last_selection_duration;
+};
@@ -1,32 +1,103 @@
 #include "ai/hl/stp/stp_hl.h"
 
+#include <algorithm>
+
 #include "ai/hl/stp/play/play.h"
 #include "ai/hl/stp/tactic/tactic.h"
 #include "ai/intent/move_intent.h"
+#include "util/timestamp.h"
 
-STP_HL::STP_HL() {}
+STP_HL::STP_HL(MetricsRegistry &metrics, ThreadPool &thread_pool)
+    : current_play(),
+      intercept_solver(),
+      intercept_solver_up_to_date(false),
+      tactic_assignment_solver(),
+      previous_tactic_robot_ids(),
+      shot_heatmap(SHOT_HEATMAP_CELL_SIZE_METERS, thread_pool),
+      shot_heatmap_up_to_date(false),
+      play_selector(Play::getRegistry(), thread_pool),
+      play_selection_time_metric(metrics.getHistogram(
+          "ai_logic.play_selection_time_us",
+          MetricHistogram::createExponentialBucketBounds(1, 1.25, 64)))
+{
+}
 
 std::vector<std::pair<Robot, std::unique_ptr<Tactic>>> STP_HL::assignTacticsToRobots(
-    const World &world, const std::vector<std::unique_ptr<Tactic>> &tactics) const
+    const World &world, std::vector<std::unique_ptr<Tactic>> tactics)
 {
-    return std::vector<std::pair<Robot, std::unique_ptr<Tactic>>>();
+    const std::vector<Robot> robots = world.friendlyTeam().getAllRobots();
+
+    // The tactics are in decreasing order of priority, so when there aren't enough
+    // robots for all of them, the ones at the end are dropped
+    const std::size_t num_tactics = std::min(tactics.size(), robots.size());
+    tactic_assignment_solver.reset(num_tactics, robots.size());
+    for (std::size_t t = 0; t < num_tactics; t++)
+    {
+        for (std::size_t r = 0; r < robots.size(); r++)
+        {
+            double cost = tactics[t]->calculateRobotCost(world, robots[r]);
+            if (previous_tactic_robot_ids[t] == robots[r].id())
+            {
+                cost -= TACTIC_ASSIGNMENT_HYSTERESIS_SECONDS;
+            }
+            tactic_assignment_solver.setCost(t, r, cost);
+        }
+    }
+    tactic_assignment_solver.solve();
+
+    std::vector<std::pair<Robot, std::unique_ptr<Tactic>>> assignment;
+    previous_tactic_robot_ids.fill(std::nullopt);
+    for (std::size_t t = 0; t < num_tactics; t++)
+    {
+        const Robot &robot = robots[tactic_assignment_solver.getAssignedColumn(t)];
+        previous_tactic_robot_ids[t] = robot.id();
+        assignment.emplace_back(robot, std::move(tactics[t]));
+    }
+    return assignment;
 }
 
-std::shared_ptr<Play> STP_HL::calculateNewPlay(const World &world) const
+const ShotHeatmap &STP_HL::getShotHeatmap(const World &world)
 {
-    return Play::getRegistry().at(0)->getInstance();
+    if (!shot_heatmap_up_to_date)
+    {
+        shot_heatmap.update(world.field(), world.friendlyTeam(), world.enemyTeam());
+        shot_heatmap_up_to_date = true;
+    }
+    return shot_heatmap;
+}
+
+const InterceptSolver &STP_HL::getInterceptSolver(const World &world)
+{
+    if (!intercept_solver_up_to_date)
+    {
+        intercept_solver.solve(world.ballTrajectory(), world.friendlyTeam(),
+                               world.enemyTeam());
+        intercept_solver_up_to_date = true;
+    }
+    return intercept_solver;
 }
 
 std::vector<std::unique_ptr<Intent>> STP_HL::getIntentAssignment(const World &world)
 {
-    if (!current_play || !current_play->invariantHolds(world) ||
-        current_play->hasFailed(world))
+    intercept_solver_up_to_date = false;
+    shot_heatmap_up_to_date     = false;
+
+    std::shared_ptr<Play> next_play = play_selector.selectPlay(world, current_play);
+    play_selection_time_metric.record(static_cast<double>(
+        Timestamp::getMicroseconds(play_selector.getLastSelectionDuration())));
+    if (next_play != current_play)
+    {
+        current_play = next_play;
+        // The new play's tactics have nothing to do with the old play's
+        previous_tactic_robot_ids.fill(std::nullopt);
+    }
+    if (!current_play)
     {
-        current_play = calculateNewPlay(world);
+        return std::vector<std::unique_ptr<Intent>>();
     }
 
     auto current_tactics   = current_play->getTactics(world);
-    auto tactic_assignment = assignTacticsToRobots(world, current_tactics);
+    auto tactic_assignment = assignTacticsToRobots(world, std::move(current_tactics));
 
     std::vector<std::unique_ptr<Intent>> intents;
     for (const auto &ta : tactic_assignment)
@@ -1,8 +1,13 @@
 #pragma once
 
 #include "ai/hl/hl.h"
+#include "ai/hl/stp/evaluation/intercept.h"
+#include "ai/hl/stp/evaluation/shot_heatmap.h"
 #include "ai/hl/stp/play/play.h"
+#include "ai/hl/stp/play_selector.h"
 #include "ai/intent/intent.h"
+#include "util/hungarian_solver.h"
+#include "util/metrics/metrics_registry.h"
 
 /**
  * The STPHL module is an implementation of the high-level logic Abstract class, that
@@ -14,31 +19,83 @@ class STP_HL : public HL
     /**
      * Creates a new High-Level logic module that uses the STP framework for
      * decision-making
+     *
+     * @param metrics The registry to record how long each tick's play selection takes
+     * in. Must outlive the STP_HL
+     * @param thread_pool The threads to spread the evaluations and play selection
+     * across, which may be shared with other modules that don't use it at the same
+     * time. Must outlive the STP_HL
      */
-    explicit STP_HL();
+    explicit STP_HL(MetricsRegistry& metrics, ThreadPool& thread_pool);
 
     std::vector<std::unique_ptr<Intent>> getIntentAssignment(const World& world) override;
 
+    /**
+     * Returns how open a shot on the enemy goal is from everywhere on the field. The
+     * heatmap is only brought up to date the first time it is asked for in a tick, so
+     * ticks that don't need it don't pay for it. Must be called from the thread running
+     * the tick, since the update spreads across the thread pool
+     *
+     * @param world The world of the current tick
+     *
+     * @return the shot heatmap for the current tick
+     */
+    const ShotHeatmap& getShotHeatmap(const World& world);
+
+    /**
+     * Returns where and when every robot on both teams can first get to the ball. The
+     * intercepts are only solved the first time they are asked for in a tick, so ticks
+     * that don't need them don't pay for them
+     *
+     * @param world The world of the current tick
+     *
+     * @return the intercepts of every robot for the current tick
+     */
+    const InterceptSolver& getInterceptSolver(const World& world);
+
    private:
+    // The width and height of each cell of the shot heatmap, in metres
+    static constexpr double SHOT_HEATMAP_CELL_SIZE_METERS = 0.1;
+
+    // How much cheaper another robot has to be at a tactic than the robot that ran it
+    // last tick for the tactic to switch robots, so robots don't keep swapping roles
+    // when their costs are close
+    static constexpr double TACTIC_ASSIGNMENT_HYSTERESIS_SECONDS = 0.2;
+    static_assert(Team::MAX_ROBOT_IDS <= HungarianSolver::MAX_SIZE,
+                  "Every friendly robot must fit in the tactic assignment problem");
+
     /**
      * Given a list of tactics, assigns each available friendly Robot to the tactic it
-     * should run, and returns a pairing of Robots to Tactics
+     * should run, and returns a pairing of Robots to Tactics. The total cost of the
+     * assigned tactics is as low as possible. If there are fewer Robots than tactics,
+     * the tactics with the lowest priority are not run
+     *
      * @param world The state of the world, which contains the friendly Robots that will
      * be mapped to a Tactic
-     * @param tactics The list of tactics that should be run (and paired with a Robot)
+     * @param tactics The list of tactics that should be run (and paired with a Robot),
+     * in decreasing order of priority
      * @return A list of pairs, where each pair contains a Robot and the Tactic that the
      * Robot will run
      */
     std::vector<std::pair<Robot, std::unique_ptr<Tactic>>> assignTacticsToRobots(
-        const World& world, const std::vector<std::unique_ptr<Tactic>>& tactics) const;
-
-    /**
-     * Given the state of the world, returns the Play that should be run at this time.
-     * @param world The world object containing the current state of the world
-     * @return A shared pointer to the Play that should be run by the AI
-     */
-    std::shared_ptr<Play> calculateNewPlay(const World& world) const;
+        const World& world, std::vector<std::unique_ptr<Tactic>> tactics);
 
     // The Play that is currently running
     std::shared_ptr<Play> current_play;
+    // Where and when every robot can get to the ball, and whether it has been solved for
+    // the current tick
+    InterceptSolver intercept_solver;
+    bool intercept_solver_up_to_date;
+    HungarianSolver tactic_assignment_solver;
+    // The id of the robot that ran each of the current play's tactics last tick, indexed
+    // by the tactic's priority
+    std::array<std::optional<unsigned int>, Team::MAX_ROBOT_IDS>
+        previous_tactic_robot_ids;
+    // How open a shot on the enemy goal is from everywhere on the field, and whether it
+    // has been updated for the current tick
+    ShotHeatmap shot_heatmap;
+    bool shot_heatmap_up_to_date;
+    // Chooses the Play to run each tick
+    PlaySelector play_selector;
+    MetricHistogram& play_selection_time_metric;
 };
@@ -1,13 +1,13 @@
 #include "ai/hl/stp/tactic/move.h"
 
+#include "shared/constants.h"
+
 MoveTactic::MoveTactic(const Point &destination) : destination(destination) {}
 
-Robot MoveTactic::selectRobot(const World &world,
-                              const std::vector<Robot> &available_robots)
+double MoveTactic::calculateRobotCost(const World &world, const Robot &robot)
 {
-    // Placeholder for now
-    return Robot(0, Point(), Vector(), Angle::zero(), AngularVelocity::zero(),
-                 std::chrono::steady_clock::now());
+    // How long it would take the robot to get to the destination at full speed
+    return (destination - robot.position()).len() / ROBOT_MAX_SPEED_METERS_PER_SECOND;
 }
 
 std::unique_ptr<Intent> MoveTactic::getNextIntent(const World &world, const Robot &robot)
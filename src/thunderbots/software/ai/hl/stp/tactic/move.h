@@ -11,8 +11,7 @@ class MoveTactic : public Tactic
 
     std::unique_ptr<Intent> getNextIntent(const World& world,
                                           const Robot& robot) override;
-    Robot selectRobot(const World& world,
-                      const std::vector<Robot>& available_robots) override;
+    double calculateRobotCost(const World& world, const Robot& robot) override;
 
    private:
     Point destination;
@@ -28,13 +28,17 @@ class Tactic
                                                   const Robot& robot) = 0;
 
     /**
-     * Returns the Robot that the Tactic would prefer to use
-     * @param available_robots The list of available Robots that the Tactic can choose
-     * from
-     * @return The Robot that the Tactic prefers to use
+     * Returns how costly it would be for the given Robot to run this Tactic, such as
+     * how long it would take the Robot to get to where the Tactic starts. Robots are
+     * assigned to Tactics so the total cost is as low as possible, so costs should be
+     * roughly in seconds to compare fairly with other Tactics
+     *
+     * @param world The current state of the world
+     * @param robot The Robot that might run this Tactic
+     * @return The cost of the Robot running this Tactic, where lower is better. Must
+     * be finite
      */
-    virtual Robot selectRobot(const World& world,
-                              const std::vector<Robot>& available_robots) = 0;
+    virtual double calculateRobotCost(const World& world, const Robot& robot) = 0;
 
     virtual ~Tactic() = default;
 };
@@ -1,15 +1,24 @@
+#include <ros/callback_queue.h>
 #include <ros/ros.h>
 
+#include <atomic>
+#include <thread>
+
 #include "ai/ai.h"
 #include "thunderbots_msgs/Ball.h"
 #include "thunderbots_msgs/Field.h"
+#include "thunderbots_msgs/Metrics.h"
 #include "thunderbots_msgs/Primitive.h"
 #include "thunderbots_msgs/PrimitiveArray.h"
 #include "thunderbots_msgs/Team.h"
 #include "util/constants.h"
+#include "util/latency_tracer.h"
 #include "util/logger/init.h"
+#include "util/metrics/metrics_exporter.h"
+#include "util/metrics/metrics_registry.h"
 #include "util/parameter/dynamic_parameters.h"
 #include "util/ros_messages.h"
+#include "util/tick_scheduler.h"
 #include "util/timestamp.h"
 
 // Member variables we need to maintain state
@@ -17,23 +26,114 @@
 // file and are not created as global static variables.
 namespace
 {
+    // The node's metrics. The callbacks and the main loop use the references to the
+    // metrics they update, so they never have to look them up by name. They are
+    // created before the AI, which records some of them itself
+    MetricsRegistry metrics;
+    MetricCounter &ai_ticks_metric = metrics.getCounter("ai_logic.ticks");
+    MetricHistogram &ai_tick_time_metric =
+        metrics.getHistogram("ai_logic.tick_time_us",
+                             MetricHistogram::createExponentialBucketBounds(1, 1.25, 64));
+    MetricCounter &primitive_arrays_published_metric =
+        metrics.getCounter("ai_logic.primitive_arrays_published");
+    MetricCounter &primitives_published_metric =
+        metrics.getCounter("ai_logic.primitives_published");
+    MetricCounter &field_msgs_received_metric =
+        metrics.getCounter("ai_logic.field_msgs_received");
+    MetricCounter &ball_msgs_received_metric =
+        metrics.getCounter("ai_logic.ball_msgs_received");
+    MetricCounter &friendly_team_msgs_received_metric =
+        metrics.getCounter("ai_logic.friendly_team_msgs_received");
+    MetricCounter &enemy_team_msgs_received_metric =
+        metrics.getCounter("ai_logic.enemy_team_msgs_received");
+    MetricGauge &friendly_robots_metric = metrics.getGauge("ai_logic.friendly_robots");
+    MetricGauge &enemy_robots_metric    = metrics.getGauge("ai_logic.enemy_robots");
+
     // Initialize our AI, which is the main object that maintains state
-    AI ai = AI(
-        World(Field(0, 0, 0, 0, 0, 0, 0), Ball(Point(), Vector()),
-              Team(std::chrono::milliseconds(
-                  Util::DynamicParameters::robot_expiry_buffer_milliseconds.value())),
-              Team(std::chrono::milliseconds(
-                  Util::DynamicParameters::robot_expiry_buffer_milliseconds.value()))));
+    AI ai =
+        AI(World(Field(0, 0, 0, 0, 0, 0, 0), Ball(Point(), Vector()),
+                 Team(std::chrono::milliseconds(
+                     Util::DynamicParameters::robot_expiry_buffer_milliseconds.value())),
+                 Team(std::chrono::milliseconds(
+                     Util::DynamicParameters::robot_expiry_buffer_milliseconds.value()))),
+           metrics);
+
+    // The stages of the capture-to-command pipeline that this node measures the
+    // latency of on the ingest thread
+    enum IngestLatencyStage
+    {
+        // From SSL Vision capturing a frame to us receiving the data filtered from it
+        CAPTURE_TO_AI_RECEIVE
+    };
+
+    // The stages of the capture-to-command pipeline that this node measures the
+    // latency of on the planning thread
+    enum PlanningLatencyStage
+    {
+        // The time taken by the AI to decide on the primitives for a tick
+        AI_TICK,
+        // From SSL Vision capturing the latest frame in the world snapshot we planned
+        // with to us publishing the primitives decided with it
+        CAPTURE_TO_PRIMITIVES_PUBLISHED
+    };
+
+    // Each thread has its own tracer, since the tracers are not thread-safe
+    LatencyTracer ingest_latency_tracer =
+        LatencyTracer({"capture_to_ai_receive"}, Util::Constants::LATENCY_REPORT_PERIOD);
+    LatencyTracer planning_latency_tracer =
+        LatencyTracer({"ai_tick", "capture_to_primitives_published"},
+                      Util::Constants::LATENCY_REPORT_PERIOD);
+
+    // The capture time and sequence number of the latest SSL Vision frame we have
+    // received data from. These are only used by the ingest thread
+    int64_t latest_capture_timestamp_microseconds = 0;
+    uint64_t latest_frame_sequence_id             = 0;
+    bool has_received_frame                       = false;
+
+    // The capture time and sequence number of the latest SSL Vision frame in a
+    // published snapshot of the world. These are set by the ingest thread after it
+    // publishes a snapshot, so the snapshot the planning thread plans with is always at
+    // least this new. They are passed along with the primitives so the latency from
+    // capture to command can be traced through the system
+    std::atomic<int64_t> published_capture_timestamp_microseconds(0);
+    std::atomic<uint64_t> published_frame_sequence_id(0);
+    std::atomic<bool> has_published_frame(false);
+
+    // How long the ingest thread waits for new data before checking if ROS is
+    // shutting down
+    static constexpr double INGEST_WAIT_TIMEOUT_SECONDS = 0.1;
 }  // namespace
 
+/**
+ * Records the latency from SSL Vision capturing a frame to us receiving the data
+ * filtered from it, and keeps track of the latest frame we have received data from
+ *
+ * @param capture_timestamp_microseconds The capture time of the frame, in microseconds
+ * @param frame_sequence_id The sequence number of the frame
+ */
+void traceReceivedFrame(int64_t capture_timestamp_microseconds,
+                        uint64_t frame_sequence_id)
+{
+    ingest_latency_tracer.recordLatency(
+        CAPTURE_TO_AI_RECEIVE,
+        Timestamp::getSystemTimestampNow() -
+            Timestamp::fromMicroseconds(capture_timestamp_microseconds));
+
+    if (!has_received_frame || frame_sequence_id >= latest_frame_sequence_id)
+    {
+        latest_capture_timestamp_microseconds = capture_timestamp_microseconds;
+        latest_frame_sequence_id              = frame_sequence_id;
+        has_received_frame                    = true;
+    }
+}
+
 // Callbacks to update the state of the world
 void fieldUpdateCallback(const thunderbots_msgs::Field::ConstPtr &msg)
 {
-    thunderbots_msgs::Field field_msg = *msg;
-
-    Field field = Util::ROSMessages::createFieldFromROSMessage(field_msg);
+    Field field = Util::ROSMessages::createFieldFromROSMessage(*msg);
 
     ai.updateWorldFieldState(field);
+    field_msgs_received_metric.increment();
 }
 
 void ballUpdateCallback(const thunderbots_msgs::Ball::ConstPtr &msg)
@@ -43,6 +143,10 @@ void ballUpdateCallback(const thunderbots_msgs::Ball::ConstPtr &msg)
     Ball ball = Util::ROSMessages::createBallFromROSMessage(ball_msg);
 
     ai.updateWorldBallState(ball);
+    ball_msgs_received_metric.increment();
+
+    // The ball's timestamp is the capture time of the frame it was filtered from
+    traceReceivedFrame(msg->timestamp_microseconds, msg->frame_sequence_id);
 }
 
 void friendlyTeamUpdateCallback(const thunderbots_msgs::Team::ConstPtr &msg)
@@ -52,6 +156,10 @@ void friendlyTeamUpdateCallback(const thunderbots_msgs::Team::ConstPtr &msg)
     Team friendly_team = Util::ROSMessages::createTeamFromROSMessage(friendly_team_msg);
 
     ai.updateWorldFriendlyTeamState(friendly_team);
+    friendly_team_msgs_received_metric.increment();
+    friendly_robots_metric.set(static_cast<double>(msg->robots.size()));
+
+    traceReceivedFrame(msg->capture_timestamp_microseconds, msg->frame_sequence_id);
 }
 
 void enemyTeamUpdateCallback(const thunderbots_msgs::Team::ConstPtr &msg)
@@ -61,6 +169,136 @@ void enemyTeamUpdateCallback(const thunderbots_msgs::Team::ConstPtr &msg)
     Team enemy_team = Util::ROSMessages::createTeamFromROSMessage(enemy_team_msg);
 
     ai.updateWorldEnemyTeamState(enemy_team);
+    enemy_team_msgs_received_metric.increment();
+    enemy_robots_metric.set(static_cast<double>(msg->robots.size()));
+
+    traceReceivedFrame(msg->capture_timestamp_microseconds, msg->frame_sequence_id);
+}
+
+/**
+ * Reads a private parameter that is a duration in milliseconds and must be positive
+ *
+ * @param private_node_handle The node handle to read the parameter from
+ * @param name The name of the parameter
+ * @param default_value The value to use if the parameter is not set, or is not
+ * positive
+ *
+ * @return the value of the parameter
+ */
+AITimestamp getPositiveMillisecondsParam(const ros::NodeHandle &private_node_handle,
+                                         const std::string &name,
+                                         const std::chrono::milliseconds &default_value)
+{
+    double milliseconds;
+    private_node_handle.param<double>(name, milliseconds,
+                                      static_cast<double>(default_value.count()));
+    // Written so that NaN is rejected too
+    if (!(milliseconds > 0))
+    {
+        LOG(WARNING) << name << " must be greater than 0, but it is " << milliseconds
+                     << ", so using " << default_value.count() << " instead" << std::endl;
+        return default_value;
+    }
+
+    return std::chrono::duration_cast<AITimestamp>(
+        std::chrono::duration<double, std::milli>(milliseconds));
+}
+
+/**
+ * Runs the AI's ticks until the scheduler is stopped. Each tick plans with the latest
+ * snapshot of the world published by the ingest thread, and publishes the resulting
+ * primitives
+ *
+ * @param tick_scheduler The scheduler that decides when each tick starts
+ * @param robot_command_latency The expected time from publishing the primitives to the
+ * robots acting on them
+ * @param primitive_publisher The publisher to publish the primitives with
+ * @param metrics_exporter The exporter for the node's metrics
+ * @param metrics_publisher The publisher to publish the node's metrics with
+ * @param metrics_file_path The file to write the node's metrics to
+ */
+void runPlanningLoop(TickScheduler &tick_scheduler,
+                     const AITimestamp &robot_command_latency,
+                     const ros::Publisher &primitive_publisher,
+                     MetricsExporter &metrics_exporter,
+                     const ros::Publisher &metrics_publisher,
+                     const std::string &metrics_file_path)
+{
+    // A smoothed estimate of how long each tick takes, which is part of the time
+    // before the primitives from a tick take effect
+    AITimestamp expected_tick_time = AITimestamp::zero();
+
+    while (tick_scheduler.waitForNextTick())
+    {
+        // The snapshot we plan with is at least as new as the frame these describe
+        int64_t capture_timestamp_microseconds =
+            published_capture_timestamp_microseconds.load();
+        uint64_t frame_sequence_id = published_frame_sequence_id.load();
+        bool frame_was_published   = has_published_frame.load();
+
+        // Get the Primitives the Robots should run from the AI
+        AITimestamp tick_start_time = Timestamp::getTimestampNow();
+        ai.setActuationLatency(expected_tick_time + robot_command_latency);
+        ai.setTickDeadline(tick_scheduler.getTickDeadline());
+        // We pass a timestamp with the current time (the time we initiate the call)
+        // to let the AI predict the world forward to when the primitives will take
+        // effect, so that decisions are always made with the most up to date predicted
+        // data (eg. future Robot or Ball position), even if some time has passed since
+        // the AI's state was last updated. The data in the world is timestamped with
+        // SSL Vision's capture times, so this is on the system clock
+        std::vector<std::unique_ptr<Primitive>> assignedPrimitives =
+            ai.getPrimitives(Timestamp::getSystemTimestampNow());
+        AITimestamp tick_time = Timestamp::getTimestampNow() - tick_start_time;
+        expected_tick_time    = (expected_tick_time * 7 + tick_time) / 8;
+        planning_latency_tracer.recordLatency(AI_TICK, tick_time);
+        ai_ticks_metric.increment();
+        ai_tick_time_metric.record(
+            static_cast<double>(Timestamp::getMicroseconds(tick_time)));
+
+        // Put these Primitives into a message and publish it
+        thunderbots_msgs::PrimitiveArray primitive_array_message;
+        for (auto const &prim : assignedPrimitives)
+        {
+            thunderbots_msgs::Primitive msg = prim->createMsg();
+            primitive_array_message.primitives.emplace_back(msg);
+        }
+        primitive_array_message.capture_timestamp_microseconds =
+            capture_timestamp_microseconds;
+        primitive_array_message.frame_sequence_id = frame_sequence_id;
+        primitive_publisher.publish(primitive_array_message);
+        primitive_arrays_published_metric.increment();
+        primitives_published_metric.increment(primitive_array_message.primitives.size());
+        tick_scheduler.finishTick();
+
+        if (frame_was_published)
+        {
+            planning_latency_tracer.recordLatency(
+                CAPTURE_TO_PRIMITIVES_PUBLISHED,
+                Timestamp::getSystemTimestampNow() -
+                    Timestamp::fromMicroseconds(capture_timestamp_microseconds));
+        }
+
+        std::optional<std::string> latency_report =
+            planning_latency_tracer.getPeriodicReport(Timestamp::getTimestampNow());
+        if (latency_report)
+        {
+            LOG(INFO) << *latency_report << std::endl;
+        }
+
+        std::optional<std::vector<MetricSample>> metrics_snapshot =
+            metrics_exporter.getPeriodicSnapshot(Timestamp::getTimestampNow());
+        if (metrics_snapshot)
+        {
+            if (!MetricsExporter::writeSnapshotToFile(metrics_file_path, "ai_logic",
+                                                      *metrics_snapshot))
+            {
+                LOG(WARNING) << "Could not write metrics to " << metrics_file_path
+                             << std::endl;
+            }
+            metrics_publisher.publish(
+                MetricsExporter::createMetricsMsg("ai_logic", *metrics_snapshot));
+        }
+    }
 }
 
 int main(int argc, char **argv)
@@ -88,32 +326,106 @@ int main(int argc, char **argv)
     // Initialize the logger
     Util::Logger::LoggerSingleton::initializeLogger(node_handle);
 
-    // Main loop
+    // A snapshot of the node's metrics is periodically written to metrics_file, which
+    // is a private parameter, and published on the diagnostics topic
+    ros::NodeHandle private_node_handle("~");
+    std::string metrics_file_path;
+    private_node_handle.param<std::string>(
+        "metrics_file", metrics_file_path,
+        Util::Constants::METRICS_FILE_DIRECTORY + "/ai_logic_metrics.txt");
+    ros::Publisher metrics_publisher = node_handle.advertise<thunderbots_msgs::Metrics>(
+        Util::Constants::DIAGNOSTICS_METRICS_TOPIC, 1);
+    MetricsExporter metrics_exporter(metrics, Util::Constants::METRICS_EXPORT_PERIOD);
+
+    // The AI either ticks as soon as a new snapshot of the world is published, or at a
+    // fixed rate, depending on the tick_mode private parameter ("new_data" or
+    // "fixed_rate"). The fixed rate is set with the tick_rate_hz private parameter, and
+    // the longest the AI waits for new data before ticking anyway with the
+    // max_tick_period_ms private parameter. Each tick should finish within the
+    // tick_deadline_ms private parameter
+    std::string tick_mode_name;
+    double tick_rate_hz;
+    private_node_handle.param<std::string>("tick_mode", tick_mode_name, "new_data");
+    private_node_handle.param<double>("tick_rate_hz", tick_rate_hz,
+                                      Util::Constants::AI_DEFAULT_FIXED_TICK_RATE_HZ);
+    TickMode tick_mode = TICK_ON_NEW_DATA;
+    AITimestamp tick_period =
+        getPositiveMillisecondsParam(private_node_handle, "max_tick_period_ms",
+                                     Util::Constants::AI_DEFAULT_MAX_TICK_PERIOD);
+    AITimestamp tick_deadline =
+        getPositiveMillisecondsParam(private_node_handle, "tick_deadline_ms",
+                                     Util::Constants::AI_DEFAULT_TICK_DEADLINE);
+    if (tick_mode_name == "fixed_rate")
+    {
+        // A rate that isn't positive has no period to tick at. This is written so that
+        // NaN is rejected too
+        if (tick_rate_hz > 0)
+        {
+            tick_mode   = TICK_AT_FIXED_RATE;
+            tick_period = std::chrono::duration_cast<AITimestamp>(
+                std::chrono::duration<double>(1.0 / tick_rate_hz));
+        }
+        else
+        {
+            LOG(WARNING) << "tick_rate_hz must be greater than 0, but it is "
+                         << tick_rate_hz << ", so ticking on new data instead"
+                         << std::endl;
+        }
+    }
+    else if (tick_mode_name != "new_data")
+    {
+        LOG(WARNING) << "Unknown tick_mode " << tick_mode_name
+                     << ", ticking on new data instead" << std::endl;
+    }
+    // The time from publishing primitives to the robots acting on them can be set with
+    // the robot_command_latency_ms private parameter. The AI plans for the world as it
+    // will be when its primitives take effect
+    double robot_command_latency_ms;
+    private_node_handle.param<double>(
+        "robot_command_latency_ms", robot_command_latency_ms,
+        static_cast<double>(Util::Constants::DEFAULT_ROBOT_COMMAND_LATENCY.count()));
+    AITimestamp robot_command_latency = std::chrono::duration_cast<AITimestamp>(
+        std::chrono::duration<double, std::milli>(robot_command_latency_ms));
+
+    TickScheduler tick_scheduler(tick_mode, tick_period, tick_deadline, metrics,
+                                 "ai_logic.tick");
+
+    // The AI plans on its own thread, so a slow tick never delays receiving new data
+    std::thread planning_thread(
+        runPlanningLoop, std::ref(tick_scheduler), std::cref(robot_command_latency),
+        std::cref(primitive_publisher), std::ref(metrics_exporter),
+        std::cref(metrics_publisher), std::cref(metrics_file_path));
+
+    // This thread is the ingest thread. It runs the callbacks that update the AI's
+    // world as new data arrives, then publishes everything that arrived together as a
+    // single snapshot of the world for the planning thread
     while (ros::ok())
     {
-        // Spin once to let all necessary callbacks run
-        // These callbacks will update the AI's world state
-        ros::spinOnce();
+        ros::getGlobalCallbackQueue()->callAvailable(
+            ros::WallDuration(INGEST_WAIT_TIMEOUT_SECONDS));
 
-        // Get the Primitives the Robots should run from the AI
-        // We pass a timestamp with the current time (the time we initiate the call)
-        // to let the AI update its predictors so that decisions are always made with the
-        // most up to date predicted data (eg. future Robot or Ball position), even if
-        // some time has passed since the AI's state was last updated.
-        AITimestamp timestamp = Timestamp::getTimestampNow();
-        std::vector<std::unique_ptr<Primitive>> assignedPrimitives =
-            ai.getPrimitives(timestamp);
+        if (ai.publishWorldSnapshot())
+        {
+            if (has_received_frame)
+            {
+                published_capture_timestamp_microseconds.store(
+                    latest_capture_timestamp_microseconds);
+                published_frame_sequence_id.store(latest_frame_sequence_id);
+                has_published_frame.store(true);
+            }
+            tick_scheduler.notifyNewData();
+        }
 
-        // Put these Primitives into a message and publish it
-        thunderbots_msgs::PrimitiveArray primitive_array_message;
-        for (auto const &prim : assignedPrimitives)
+        std::optional<std::string> latency_report =
+            ingest_latency_tracer.getPeriodicReport(Timestamp::getTimestampNow());
+        if (latency_report)
         {
-            thunderbots_msgs::Primitive msg = prim->createMsg();
-            primitive_array_message.primitives.emplace_back(msg);
-            LOG(INFO) << msg << std::endl;
+            LOG(INFO) << *latency_report << std::endl;
         }
-        primitive_publisher.publish(primitive_array_message);
     }
 
+    tick_scheduler.stop();
+    planning_thread.join();
+
     return 0;
 }
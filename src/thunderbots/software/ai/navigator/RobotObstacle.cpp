@@ -31,15 +31,22 @@ Point RobotObstacle::getNearestValidPoint(const Point& point)
 
 bool RobotObstacle::willCollide(const Robot& robot)
 {
-    RobotObstacle other = RobotObstacle(robot, default_avoid_dist.value());
-    return dist(velocity, other.velocity) < default_avoid_dist.value();
+    const Seg other_velocity(
+        robot.position(),
+        robot.position() + robot.velocity() * collision_avoid_velocity_scale.value());
+    return dist(velocity, other_velocity) < default_avoid_dist.value();
+}
+
+const Circle& RobotObstacle::getBoundary() const
+{
+    return boundary;
 }
 
 std::vector<RobotObstacle> generate_friendly_obstacles(const Team& friendly_team,
                                                        double avoid_dist)
 {
     std::vector<RobotObstacle> obst;
-    for (Robot r : friendly_team.getAllRobots())
+    for (Robot r : friendly_team.robots())
     {
         obst.push_back(RobotObstacle(r, avoid_dist));
     }
@@ -49,6 +49,14 @@ class RobotObstacle
      */
     bool willCollide(const Robot& robot);
 
+    /**
+     * Returns the circle around the robot, including the avoid distance, that paths
+     * must not pass through
+     *
+     * @return the circle around the robot that paths must not pass through
+     */
+    const Circle& getBoundary() const;
+
    private:
     /**
      * Represents the physical footprint of the robot, with
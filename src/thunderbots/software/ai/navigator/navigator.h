@@ -3,6 +3,7 @@
 #include "ai/intent/intent.h"
 #include "ai/primitive/primitive.h"
 #include "ai/world/world.h"
+#include "util/timestamp.h"
 
 /**
  * An abstraction for all navigation operations performed by our AI. The navigator is
@@ -29,7 +30,16 @@ class Navigator
      */
     virtual std::vector<std::unique_ptr<Primitive>> getAssignedPrimitives(
         const World &world,
-        const std::vector<std::unique_ptr<Intent>> &assignedIntents) const = 0;
+        const std::vector<std::unique_ptr<Intent>> &assignedIntents) = 0;
+
+    /**
+     * Sets the time by which every call to getAssignedPrimitives() from now on should
+     * return, so the navigator can limit how long it spends planning
+     *
+     * @param deadline The time getAssignedPrimitives() should return by, on the same
+     * clock as Timestamp::getTimestampNow()
+     */
+    virtual void setDeadline(const AITimestamp &deadline) = 0;
 
     virtual ~Navigator() = default;
 };
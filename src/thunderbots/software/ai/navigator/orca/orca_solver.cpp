@@ -0,0 +1,343 @@
+#include "ai/navigator/orca/orca_solver.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Lines closer than this to parallel are treated as parallel
+    constexpr double PARALLEL_EPSILON = 1e-9;
+}  // namespace
+
+OrcaSolver::OrcaSolver()
+    : num_agents(0),
+      positions(),
+      velocities(),
+      radii(),
+      preferred_velocities(),
+      max_speeds(),
+      controlled_agent_mask(0),
+      new_velocities(),
+      half_planes(),
+      projected_half_planes()
+{
+}
+
+void OrcaSolver::reset()
+{
+    num_agents            = 0;
+    controlled_agent_mask = 0;
+}
+
+std::size_t OrcaSolver::addControlledAgent(const Point &position, const Vector &velocity,
+                                           double radius,
+                                           const Vector &preferred_velocity,
+                                           double max_speed)
+{
+    return addAgent(position, velocity, radius, preferred_velocity, max_speed, true);
+}
+
+std::size_t OrcaSolver::addUncontrolledAgent(const Point &position,
+                                             const Vector &velocity, double radius)
+{
+    return addAgent(position, velocity, radius, velocity, velocity.len(), false);
+}
+
+std::size_t OrcaSolver::getNumAgents() const
+{
+    return num_agents;
+}
+
+void OrcaSolver::solve()
+{
+    for (std::size_t agent = 0; agent < num_agents; agent++)
+    {
+        new_velocities[agent] = velocities[agent];
+        if (!(controlled_agent_mask & (1u << agent)))
+        {
+            continue;
+        }
+
+        std::size_t num_half_planes = 0;
+        for (std::size_t other = 0; other < num_agents; other++)
+        {
+            if (other != agent)
+            {
+                half_planes[num_half_planes++] = buildHalfPlane(agent, other);
+            }
+        }
+
+        Vector result;
+        const std::size_t first_failed_half_plane =
+            solveLinearProgram(half_planes.data(), num_half_planes, max_speeds[agent],
+                               preferred_velocities[agent], false, result);
+        if (first_failed_half_plane < num_half_planes)
+        {
+            solveLeastViolation(num_half_planes, first_failed_half_plane,
+                                max_speeds[agent], result);
+        }
+        new_velocities[agent] = result;
+    }
+}
+
+Vector OrcaSolver::getNewVelocity(std::size_t agent) const
+{
+    return new_velocities[agent];
+}
+
+std::size_t OrcaSolver::addAgent(const Point &position, const Vector &velocity,
+                                 double radius, const Vector &preferred_velocity,
+                                 double max_speed, bool controlled)
+{
+    const std::size_t agent     = num_agents++;
+    positions[agent]            = position;
+    velocities[agent]           = velocity;
+    radii[agent]                = radius;
+    preferred_velocities[agent] = preferred_velocity;
+    max_speeds[agent]           = max_speed;
+    new_velocities[agent]       = velocity;
+    if (controlled)
+    {
+        controlled_agent_mask |= 1u << agent;
+    }
+    return agent;
+}
+
+OrcaSolver::HalfPlane OrcaSolver::buildHalfPlane(std::size_t agent,
+                                                 std::size_t other) const
+{
+    const Vector relative_position       = positions[other] - positions[agent];
+    const Vector relative_velocity       = velocities[agent] - velocities[other];
+    const double distance_squared        = relative_position.lensq();
+    const double combined_radius         = radii[agent] + radii[other];
+    const double combined_radius_squared = combined_radius * combined_radius;
+
+    // The smallest change to the relative velocity that avoids a collision
+    HalfPlane half_plane;
+    Vector change;
+    if (distance_squared > combined_radius_squared)
+    {
+        // The velocities that collide within the time horizon are a cone with its tip
+        // cut off by a circle. Find which part of it the relative velocity is closest to
+        const double inverse_time_horizon = 1 / TIME_HORIZON_SECONDS;
+        const Vector from_cutoff_centre =
+            relative_velocity - inverse_time_horizon * relative_position;
+        const double from_cutoff_centre_length_squared = from_cutoff_centre.lensq();
+        const double dot_product = from_cutoff_centre.dot(relative_position);
+        if (dot_product < 0 &&
+            dot_product * dot_product >
+                combined_radius_squared * from_cutoff_centre_length_squared)
+        {
+            // Closest to the cut-off circle
+            const double from_cutoff_centre_length =
+                std::sqrt(from_cutoff_centre_length_squared);
+            const Vector unit_from_cutoff_centre =
+                from_cutoff_centre / from_cutoff_centre_length;
+            half_plane.direction =
+                Vector(unit_from_cutoff_centre.y(), -unit_from_cutoff_centre.x());
+            change =
+                (combined_radius * inverse_time_horizon - from_cutoff_centre_length) *
+                unit_from_cutoff_centre;
+        }
+        else
+        {
+            // Closest to one of the sides of the cone
+            const double leg_length =
+                std::sqrt(distance_squared - combined_radius_squared);
+            if (relative_position.cross(from_cutoff_centre) > 0)
+            {
+                half_plane.direction = Vector(relative_position.x() * leg_length -
+                                                  relative_position.y() * combined_radius,
+                                              relative_position.x() * combined_radius +
+                                                  relative_position.y() * leg_length) /
+                                       distance_squared;
+            }
+            else
+            {
+                half_plane.direction =
+                    -Vector(relative_position.x() * leg_length +
+                                relative_position.y() * combined_radius,
+                            -relative_position.x() * combined_radius +
+                                relative_position.y() * leg_length) /
+                    distance_squared;
+            }
+            change = relative_velocity.dot(half_plane.direction) * half_plane.direction -
+                     relative_velocity;
+        }
+    }
+    else
+    {
+        // The agents already overlap, so get them apart as soon as possible
+        const double inverse_time_step = 1 / OVERLAP_RESOLUTION_TIME_SECONDS;
+        const Vector from_cutoff_centre =
+            relative_velocity - inverse_time_step * relative_position;
+        const double from_cutoff_centre_length = from_cutoff_centre.len();
+        const Vector unit_from_cutoff_centre =
+            from_cutoff_centre_length > 0 ? from_cutoff_centre / from_cutoff_centre_length
+                                          : Vector(1, 0);
+        half_plane.direction =
+            Vector(unit_from_cutoff_centre.y(), -unit_from_cutoff_centre.x());
+        change = (combined_radius * inverse_time_step - from_cutoff_centre_length) *
+                 unit_from_cutoff_centre;
+    }
+
+    // Controlled agents share the change between them, and uncontrolled ones won't
+    // make any
+    const double responsibility = (controlled_agent_mask & (1u << other)) ? 0.5 : 1;
+    half_plane.point            = velocities[agent] + responsibility * change;
+    return half_plane;
+}
+
+bool OrcaSolver::solveOnBoundary(const HalfPlane *half_planes, std::size_t half_plane,
+                                 double max_speed, const Vector &optimal_velocity,
+                                 bool optimize_direction, Vector &result)
+{
+    // Find where the boundary crosses the max speed circle
+    const HalfPlane &boundary = half_planes[half_plane];
+    const double dot_product  = boundary.point.dot(boundary.direction);
+    const double discriminant =
+        dot_product * dot_product + max_speed * max_speed - boundary.point.lensq();
+    if (discriminant < 0)
+    {
+        return false;
+    }
+    const double sqrt_discriminant = std::sqrt(discriminant);
+    double t_left                  = -dot_product - sqrt_discriminant;
+    double t_right                 = -dot_product + sqrt_discriminant;
+
+    // Cut the boundary down to the part inside the earlier half-planes
+    for (std::size_t i = 0; i < half_plane; i++)
+    {
+        const double denominator = boundary.direction.cross(half_planes[i].direction);
+        const double numerator =
+            half_planes[i].direction.cross(boundary.point - half_planes[i].point);
+        if (std::fabs(denominator) <= PARALLEL_EPSILON)
+        {
+            // The boundaries are parallel, so this one is either entirely inside the
+            // other half-plane or entirely outside it
+            if (numerator < 0)
+            {
+                return false;
+            }
+            continue;
+        }
+
+        const double t = numerator / denominator;
+        if (denominator >= 0)
+        {
+            t_right = std::min(t_right, t);
+        }
+        else
+        {
+            t_left = std::max(t_left, t);
+        }
+        if (t_left > t_right)
+        {
+            return false;
+        }
+    }
+
+    double t;
+    if (optimize_direction)
+    {
+        t = optimal_velocity.dot(boundary.direction) > 0 ? t_right : t_left;
+    }
+    else
+    {
+        t = std::clamp(boundary.direction.dot(optimal_velocity - boundary.point), t_left,
+                       t_right);
+    }
+    result = boundary.point + t * boundary.direction;
+    return true;
+}
+
+std::size_t OrcaSolver::solveLinearProgram(const HalfPlane *half_planes,
+                                           std::size_t num_half_planes, double max_speed,
+                                           const Vector &optimal_velocity,
+                                           bool optimize_direction, Vector &result)
+{
+    if (optimize_direction)
+    {
+        result = optimal_velocity * max_speed;
+    }
+    else if (optimal_velocity.lensq() > max_speed * max_speed)
+    {
+        result = optimal_velocity.norm(max_speed);
+    }
+    else
+    {
+        result = optimal_velocity;
+    }
+
+    // Add the half-planes one at a time. The result only has to move when it is outside
+    // the new half-plane, and then the best velocity is on its boundary
+    for (std::size_t i = 0; i < num_half_planes; i++)
+    {
+        if (half_planes[i].direction.cross(half_planes[i].point - result) > 0)
+        {
+            const Vector previous_result = result;
+            if (!solveOnBoundary(half_planes, i, max_speed, optimal_velocity,
+                                 optimize_direction, result))
+            {
+                result = previous_result;
+                return i;
+            }
+        }
+    }
+    return num_half_planes;
+}
+
+void OrcaSolver::solveLeastViolation(std::size_t num_half_planes,
+                                     std::size_t first_failed_half_plane,
+                                     double max_speed, Vector &result)
+{
+    // How far the result is outside the half-planes checked so far
+    double violation = 0;
+    for (std::size_t i = first_failed_half_plane; i < num_half_planes; i++)
+    {
+        const HalfPlane &failed = half_planes[i];
+        if (failed.direction.cross(failed.point - result) <= violation)
+        {
+            continue;
+        }
+
+        // Minimise the violation of this half-plane subject to violating the earlier ones
+        // by no more, which is a linear program over the lines halfway between this
+        // half-plane's boundary and each earlier one
+        std::size_t num_projected = 0;
+        for (std::size_t j = 0; j < i; j++)
+        {
+            HalfPlane projected;
+            const double determinant = failed.direction.cross(half_planes[j].direction);
+            if (std::fabs(determinant) <= PARALLEL_EPSILON)
+            {
+                if (failed.direction.dot(half_planes[j].direction) > 0)
+                {
+                    // Pointing the same way, so the earlier half-plane adds nothing
+                    continue;
+                }
+                projected.point = 0.5 * (failed.point + half_planes[j].point);
+            }
+            else
+            {
+                projected.point =
+                    failed.point +
+                    (half_planes[j].direction.cross(failed.point - half_planes[j].point) /
+                     determinant) *
+                        failed.direction;
+            }
+            projected.direction = (half_planes[j].direction - failed.direction).norm();
+            projected_half_planes[num_projected++] = projected;
+        }
+
+        const Vector previous_result = result;
+        if (solveLinearProgram(projected_half_planes.data(), num_projected, max_speed,
+                               failed.direction.perp(), true, result) < num_projected)
+        {
+            // This can only happen because of rounding errors, in which case the
+            // previous result is as good as we'll get
+            result = previous_result;
+        }
+        violation = failed.direction.cross(failed.point - result);
+    }
+}
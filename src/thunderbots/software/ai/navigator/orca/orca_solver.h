@@ -0,0 +1,201 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "geom/point.h"
+
+/**
+ * Chooses collision-free velocities for a group of robots using ORCA (Optimal
+ * Reciprocal Collision Avoidance).
+ *
+ * Every robot is an agent with a position, velocity and radius. Agents are either
+ * controlled, in which case the solver picks a new velocity for them, or uncontrolled,
+ * in which case they are assumed to keep their current velocity, like enemy robots.
+ *
+ * For each pair of agents, the velocities that would lead to a collision within
+ * TIME_HORIZON_SECONDS form a cone. ORCA turns that cone into a half-plane of allowed
+ * velocities for each controlled agent: two controlled agents each take half of the
+ * change needed to avoid each other, and a controlled agent avoids an uncontrolled one
+ * on its own. Each controlled agent's new velocity is then the velocity closest to its
+ * preferred one that is in all its half-planes and under its max speed, which is a
+ * small 2D linear program solved in expected linear time. If the half-planes have no
+ * velocity in common, because the agents are too crowded, the velocity that violates
+ * them the least is used instead.
+ *
+ * All storage is fixed-size arrays inside the solver, so solving never allocates, and
+ * one solver can be reused every tick.
+ */
+class OrcaSolver final
+{
+   public:
+    // The most agents the solver can handle, which is enough for both teams
+    static constexpr std::size_t MAX_NUM_AGENTS = 32;
+    // How far ahead collisions are avoided
+    static constexpr double TIME_HORIZON_SECONDS = 0.5;
+    // How soon agents that already overlap try to get apart
+    static constexpr double OVERLAP_RESOLUTION_TIME_SECONDS = 0.1;
+
+    /**
+     * Creates a new OrcaSolver with no agents
+     */
+    explicit OrcaSolver();
+
+    /**
+     * Removes all the agents
+     */
+    void reset();
+
+    /**
+     * Adds an agent whose velocity is chosen by the solver
+     *
+     * @param position The position of the agent
+     * @param velocity The current velocity of the agent
+     * @param radius The radius of the agent
+     * @param preferred_velocity The velocity the agent would move at if nothing was in
+     * its way
+     * @param max_speed The fastest the agent can move
+     *
+     * @return the index of the agent
+     */
+    std::size_t addControlledAgent(const Point& position, const Vector& velocity,
+                                   double radius, const Vector& preferred_velocity,
+                                   double max_speed);
+
+    /**
+     * Adds an agent that is assumed to keep its current velocity, so the controlled
+     * agents have to avoid it on their own
+     *
+     * @param position The position of the agent
+     * @param velocity The current velocity of the agent
+     * @param radius The radius of the agent
+     *
+     * @return the index of the agent
+     */
+    std::size_t addUncontrolledAgent(const Point& position, const Vector& velocity,
+                                     double radius);
+
+    /**
+     * Returns the number of agents
+     *
+     * @return the number of agents
+     */
+    std::size_t getNumAgents() const;
+
+    /**
+     * Chooses a new velocity for each controlled agent that avoids every other agent
+     * for TIME_HORIZON_SECONDS
+     */
+    void solve();
+
+    /**
+     * Returns the velocity chosen for the given agent by the last call to solve(), or
+     * its current velocity if it is uncontrolled
+     *
+     * @param agent The index of the agent
+     *
+     * @return the new velocity of the agent
+     */
+    Vector getNewVelocity(std::size_t agent) const;
+
+   private:
+    /**
+     * The velocities on the left of a directed line, which must have a unit direction
+     */
+    typedef struct
+    {
+        Point point;
+        Vector direction;
+    } HalfPlane;
+
+    /**
+     * Adds an agent to the solver
+     *
+     * @return the index of the agent
+     */
+    std::size_t addAgent(const Point& position, const Vector& velocity, double radius,
+                         const Vector& preferred_velocity, double max_speed,
+                         bool controlled);
+
+    /**
+     * Builds the half-plane of velocities that keep one agent from colliding with
+     * another within the time horizon
+     *
+     * @param agent The agent the half-plane is for
+     * @param other The agent to avoid
+     *
+     * @return the half-plane of allowed velocities for the agent
+     */
+    HalfPlane buildHalfPlane(std::size_t agent, std::size_t other) const;
+
+    /**
+     * Finds the velocity closest to the optimal velocity on the boundary of the given
+     * half-plane, within the max speed and the half-planes before it
+     *
+     * @param half_planes The half-planes
+     * @param half_plane The index of the half-plane whose boundary the result is on
+     * @param max_speed The fastest velocity allowed
+     * @param optimal_velocity The velocity to get close to, or the direction to go as
+     * far as possible in if optimize_direction is true
+     * @param optimize_direction Whether optimal_velocity is a direction instead of a
+     * velocity
+     * @param result Set to the velocity found, if there is one
+     *
+     * @return true if a velocity was found, and false if the half-planes have no
+     * velocity in common on the boundary
+     */
+    static bool solveOnBoundary(const HalfPlane* half_planes, std::size_t half_plane,
+                                double max_speed, const Vector& optimal_velocity,
+                                bool optimize_direction, Vector& result);
+
+    /**
+     * Finds the velocity closest to the optimal velocity that is in all the given
+     * half-planes and within the max speed
+     *
+     * @param half_planes The half-planes
+     * @param num_half_planes The number of half-planes
+     * @param max_speed The fastest velocity allowed
+     * @param optimal_velocity The velocity to get close to, or the direction to go as
+     * far as possible in if optimize_direction is true
+     * @param optimize_direction Whether optimal_velocity is a direction instead of a
+     * velocity
+     * @param result Set to the velocity found
+     *
+     * @return num_half_planes if every half-plane was satisfied, and otherwise the index
+     * of the half-plane that couldn't be, with the result satisfying those before it
+     */
+    static std::size_t solveLinearProgram(const HalfPlane* half_planes,
+                                          std::size_t num_half_planes, double max_speed,
+                                          const Vector& optimal_velocity,
+                                          bool optimize_direction, Vector& result);
+
+    /**
+     * Finds the velocity that violates the half-planes from the given one onwards by as
+     * little as possible, for when they have no velocity in common
+     *
+     * @param num_half_planes The number of half-planes
+     * @param first_failed_half_plane The first half-plane solveLinearProgram couldn't
+     * satisfy
+     * @param max_speed The fastest velocity allowed
+     * @param result The velocity from solveLinearProgram, which is replaced with the
+     * least violating velocity
+     */
+    void solveLeastViolation(std::size_t num_half_planes,
+                             std::size_t first_failed_half_plane, double max_speed,
+                             Vector& result);
+
+    std::size_t num_agents;
+    std::array<Point, MAX_NUM_AGENTS> positions;
+    std::array<Vector, MAX_NUM_AGENTS> velocities;
+    std::array<double, MAX_NUM_AGENTS> radii;
+    std::array<Vector, MAX_NUM_AGENTS> preferred_velocities;
+    std::array<double, MAX_NUM_AGENTS> max_speeds;
+    // Bit i is set if agent i is controlled
+    uint32_t controlled_agent_mask;
+    std::array<Vector, MAX_NUM_AGENTS> new_velocities;
+
+    // Scratch space for the half-planes of the agent being solved
+    std::array<HalfPlane, MAX_NUM_AGENTS> half_planes;
+    std::array<HalfPlane, MAX_NUM_AGENTS> projected_half_planes;
+};
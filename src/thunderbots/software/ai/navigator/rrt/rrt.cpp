@@ -1,41 +1,85 @@
 #include "rrt.h"
 
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
 #include "ai/intent/move_intent.h"
 #include "ai/navigator/RobotObstacle.h"
 #include "ai/primitive/move_primitive.h"
+#include "shared/constants.h"
 
-RRTNav::RRTNav() {}
+RRTNav::RRTNav(ThreadPool &thread_pool,
+               const std::optional<AITimestamp> &planning_time_budget)
+    : planning_thread_pool(thread_pool),
+      planning_time_budget(planning_time_budget),
+      deadline(std::nullopt),
+      planning_queries(),
+      planners(),
+      num_planning_queries(0),
+      cached_paths(),
+      orca_solver()
+{
+}
 
 std::vector<std::unique_ptr<Primitive>> RRTNav::getAssignedPrimitives(
-    const World &world, const std::vector<std::unique_ptr<Intent>> &assignedIntents) const
+    const World &world, const std::vector<std::unique_ptr<Intent>> &assignedIntents)
 {
     std::vector<std::unique_ptr<Primitive>> assigned_primitives =
         std::vector<std::unique_ptr<Primitive>>();
 
-    // Hand the different types of Intents here
-    for (const auto &intent : assignedIntents)
+    const double avoid_dist =
+        Util::DynamicParameters::Navigator::default_avoid_dist.value();
+
+    // Paths are planned inside the field boundary. The signed distance field keeps them
+    // clear of the edge of the field and the defense areas too, but the goalie has to
+    // be able to go into the defense area, so it is only kept inside the bounds
+    const Field &field                = world.field();
+    const std::optional<Robot> goalie = world.friendlyTeam().goalie();
+    const Rect bounds(Point(-field.totalLength() / 2 + ROBOT_MAX_RADIUS_METERS,
+                            -field.totalWidth() / 2 + ROBOT_MAX_RADIUS_METERS),
+                      Point(field.totalLength() / 2 - ROBOT_MAX_RADIUS_METERS,
+                            field.totalWidth() / 2 - ROBOT_MAX_RADIUS_METERS));
+
+    // Set up a query for each MoveIntent whose robot we can see, and remember which
+    // query each intent uses so the results can be joined in order
+    num_planning_queries = 0;
+    std::vector<std::optional<std::size_t>> intent_query_indices(assignedIntents.size());
+    for (std::size_t i = 0; i < assignedIntents.size(); i++)
     {
+        const auto &intent = assignedIntents[i];
         if (intent->getIntentName() == MOVE_INTENT_NAME)
         {
-            // TODO: Implement this
-            // https://github.com/UBC-Thunderbots/Software/issues/23
             // Cast down to the MoveIntent class so we can access its members
-            MoveIntent move_intent = dynamic_cast<MoveIntent &>(*intent);
+            const MoveIntent &move_intent = dynamic_cast<const MoveIntent &>(*intent);
 
-            // Get vectors of robot obstacles
-            // TODO: do something with these for path planning
-            std::vector<RobotObstacle> friendly_obsts = generate_friendly_obstacles(
-                world.friendlyTeam(),
-                Util::DynamicParameters::Navigator::default_avoid_dist.value());
-            std::vector<RobotObstacle> enemy_obsts = generate_enemy_obstacles(
-                world.enemyTeam(),
-                Util::DynamicParameters::Navigator::default_avoid_dist.value());
+            std::optional<Robot> robot =
+                world.friendlyTeam().getRobotById(move_intent.getRobotId());
+            if (robot)
+            {
+                if (num_planning_queries == planning_queries.size())
+                {
+                    planning_queries.push_back(
+                        {0, Point(), Vector(), Point(), bounds, {}, nullptr, Point(), 0});
+                    planners.emplace_back(planning_time_budget);
+                }
+                PlanningQuery &query   = planning_queries[num_planning_queries];
+                query.robot_id         = robot->id();
+                query.start            = robot->position();
+                query.velocity         = robot->velocity();
+                query.destination      = move_intent.getDestination();
+                query.waypoint         = query.destination;
+                query.final_speed      = move_intent.getFinalSpeed();
+                query.static_obstacles = &world.signedDistanceField();
+                if (goalie && goalie->id() == robot->id())
+                {
+                    query.static_obstacles = nullptr;
+                }
+                setQueryObstacles(world, bounds, avoid_dist, query);
 
-            std::unique_ptr<Primitive> move_prim = std::make_unique<MovePrimitive>(
-                move_intent.getRobotId(), move_intent.getDestination(),
-                move_intent.getFinalAngle(), move_intent.getFinalSpeed());
-
-            assigned_primitives.emplace_back(std::move(move_prim));
+                intent_query_indices[i] = num_planning_queries;
+                num_planning_queries++;
+            }
         }
         else
         {
@@ -46,5 +90,239 @@ std::vector<std::unique_ptr<Primitive>> RRTNav::getAssignedPrimitives(
         }
     }
 
+    const std::optional<AITimestamp> path_time_budget =
+        getPathTimeBudget(num_planning_queries);
+    for (std::size_t i = 0; i < num_planning_queries; i++)
+    {
+        planners[i].setTimeBudget(path_time_budget);
+    }
+    planning_thread_pool.parallelFor(
+        num_planning_queries, [this](std::size_t query_index) { planPath(query_index); });
+    avoidCollisions(world);
+
+    for (std::size_t i = 0; i < assignedIntents.size(); i++)
+    {
+        const MoveIntent &move_intent =
+            dynamic_cast<const MoveIntent &>(*assignedIntents[i]);
+        Point destination  = move_intent.getDestination();
+        double final_speed = move_intent.getFinalSpeed();
+        if (intent_query_indices[i])
+        {
+            const PlanningQuery &query = planning_queries[*intent_query_indices[i]];
+            destination                = query.waypoint;
+            final_speed                = query.final_speed;
+        }
+
+        std::unique_ptr<Primitive> move_prim =
+            std::make_unique<MovePrimitive>(move_intent.getRobotId(), destination,
+                                            move_intent.getFinalAngle(), final_speed);
+
+        assigned_primitives.emplace_back(std::move(move_prim));
+    }
+
     return assigned_primitives;
 }
+
+void RRTNav::setDeadline(const AITimestamp &deadline)
+{
+    this->deadline = deadline;
+}
+
+std::optional<AITimestamp> RRTNav::getPathTimeBudget(std::size_t num_paths) const
+{
+    if (!planning_time_budget || !deadline || num_paths == 0)
+    {
+        return planning_time_budget;
+    }
+
+    const std::size_t num_threads = planning_thread_pool.getNumThreads();
+    const auto num_rounds =
+        static_cast<AITimestamp::rep>((num_paths + num_threads - 1) / num_threads);
+    const AITimestamp time_left =
+        *deadline - Timestamp::getTimestampNow() - NON_PLANNING_TIME_RESERVE;
+    return std::clamp(time_left / num_rounds, MIN_PLANNING_TIME_BUDGET,
+                      std::max(MIN_PLANNING_TIME_BUDGET, *planning_time_budget));
+}
+
+void RRTNav::setQueryObstacles(const World &world, const Rect &field_bounds,
+                               double avoid_dist, PlanningQuery &query)
+{
+    const Point sw_corner(std::max(field_bounds.swCorner().x(),
+                                   std::min(query.start.x(), query.destination.x()) -
+                                       PLANNING_MARGIN_METERS),
+                          std::max(field_bounds.swCorner().y(),
+                                   std::min(query.start.y(), query.destination.y()) -
+                                       PLANNING_MARGIN_METERS));
+    const Point ne_corner(std::min(field_bounds.neCorner().x(),
+                                   std::max(query.start.x(), query.destination.x()) +
+                                       PLANNING_MARGIN_METERS),
+                          std::min(field_bounds.neCorner().y(),
+                                   std::max(query.start.y(), query.destination.y()) +
+                                       PLANNING_MARGIN_METERS));
+    query.bounds = Rect(sw_corner, ne_corner);
+
+    // Every robot that overlaps the box is within this distance of its centre
+    const Point centre = sw_corner + (ne_corner - sw_corner) / 2;
+    const double search_radius =
+        (ne_corner - sw_corner).len() / 2 + ROBOT_MAX_RADIUS_METERS + avoid_dist;
+
+    // Avoid every robot except the one we're planning for
+    query.obstacles.clear();
+    for (const SpatialObject &object : world.spatialIndex().findWithinRadius(
+             centre, search_radius, SPATIAL_FRIENDLY_ROBOT | SPATIAL_ENEMY_ROBOT))
+    {
+        const bool is_friendly = object.type == SPATIAL_FRIENDLY_ROBOT;
+        if (is_friendly && object.id == query.robot_id)
+        {
+            continue;
+        }
+        const Team &team = is_friendly ? world.friendlyTeam() : world.enemyTeam();
+        std::optional<Robot> robot = team.getRobotById(object.id);
+        if (robot)
+        {
+            query.obstacles.emplace_back(RobotObstacle(*robot, avoid_dist).getBoundary());
+        }
+    }
+}
+
+void RRTNav::planPath(std::size_t query_index)
+{
+    PlanningQuery &query    = planning_queries[query_index];
+    RRTStarPlanner &planner = planners[query_index];
+    CachedPath &cached_path = cached_paths[query.robot_id];
+
+    const bool destination_moved =
+        !cached_path.destination || (*cached_path.destination - query.destination).len() >
+                                        DESTINATION_CHANGE_THRESHOLD_METERS;
+    // Robots outside the bounds aren't obstacles, so a path through waypoints outside
+    // them can't be checked. The destination itself may be off the field
+    const bool path_in_bounds = std::all_of(
+        cached_path.waypoints.begin(),
+        cached_path.waypoints.end() -
+            std::min<std::size_t>(1, cached_path.waypoints.size()),
+        [&query](const Point &waypoint) { return query.bounds.containsPoint(waypoint); });
+    planner.setStaticObstacles(query.static_obstacles, ROBOT_MAX_RADIUS_METERS);
+    bool repaired = false;
+    if (!destination_moved && path_in_bounds)
+    {
+        cached_path.waypoints.back() = query.destination;
+        repaired = planner.repairPath(query.start, cached_path.waypoints, query.bounds,
+                                      query.obstacles, query.robot_id);
+    }
+    if (!repaired)
+    {
+        const std::vector<Point> &path =
+            planner.findPath(query.start, query.destination, query.bounds,
+                             query.obstacles, query.robot_id);
+        cached_path.waypoints.assign(path.begin(), path.end());
+    }
+    query.waypoint = cached_path.waypoints.front();
+
+    // A path that stops short of the destination isn't worth repairing, and the robot
+    // stops at the end of it. Otherwise the final speed from the intent is only for
+    // the destination itself
+    cached_path.destination = std::nullopt;
+    if (planner.lastPathReachesGoal())
+    {
+        cached_path.destination = query.destination;
+    }
+    else
+    {
+        query.final_speed = 0;
+    }
+    if (cached_path.waypoints.size() > 1)
+    {
+        query.final_speed =
+            getCornerSpeed(query.start, cached_path.waypoints, query.final_speed);
+    }
+}
+
+double RRTNav::getCornerSpeed(const Point &start, const std::vector<Point> &waypoints,
+                              double final_speed)
+{
+    // Slow down in time to reach the end of the path at the final speed
+    double remaining_length = 0;
+    for (std::size_t i = 1; i < waypoints.size(); i++)
+    {
+        remaining_length += (waypoints[i] - waypoints[i - 1]).len();
+    }
+    const double stopping_speed = std::sqrt(
+        final_speed * final_speed +
+        2 * ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED * remaining_length);
+
+    // Scale down by how sharply the path turns, from full speed when it goes straight
+    // on to a stop when it doubles back
+    const Vector incoming = waypoints[0] - start;
+    const Vector outgoing = waypoints[1] - waypoints[0];
+    double turn_scale     = 1;
+    if (incoming.len() > 0 && outgoing.len() > 0)
+    {
+        turn_scale = (1 + incoming.norm().dot(outgoing.norm())) / 2;
+    }
+    return std::min(ROBOT_MAX_SPEED_METERS_PER_SECOND, stopping_speed) * turn_scale;
+}
+
+void RRTNav::avoidCollisions(const World &world)
+{
+    // Each robot would like to head straight for its waypoint, slowing down in time to
+    // reach it at its final speed
+    orca_solver.reset();
+    std::array<Vector, OrcaSolver::MAX_NUM_AGENTS> preferred_velocities;
+    uint32_t planned_robot_mask = 0;
+    for (std::size_t i = 0; i < num_planning_queries &&
+                            orca_solver.getNumAgents() < OrcaSolver::MAX_NUM_AGENTS;
+         i++)
+    {
+        const PlanningQuery &query = planning_queries[i];
+        const Vector to_waypoint   = query.waypoint - query.start;
+        const double preferred_speed =
+            std::min(ROBOT_MAX_SPEED_METERS_PER_SECOND,
+                     std::sqrt(query.final_speed * query.final_speed +
+                               2 * ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED *
+                                   to_waypoint.len()));
+        preferred_velocities[i] = to_waypoint.norm(preferred_speed);
+        orca_solver.addControlledAgent(query.start, query.velocity,
+                                       ROBOT_MAX_RADIUS_METERS, preferred_velocities[i],
+                                       ROBOT_MAX_SPEED_METERS_PER_SECOND);
+        planned_robot_mask |= 1u << query.robot_id;
+    }
+
+    // Every other robot is assumed to keep going the way it is, including friendly
+    // robots that are running other primitives
+    auto add_uncontrolled_robot = [this](const Robot &robot) {
+        if (orca_solver.getNumAgents() < OrcaSolver::MAX_NUM_AGENTS)
+        {
+            orca_solver.addUncontrolledAgent(robot.position(), robot.velocity(),
+                                             ROBOT_MAX_RADIUS_METERS);
+        }
+    };
+    for (const Robot &robot : world.friendlyTeam().robots())
+    {
+        if (!(planned_robot_mask & (1u << robot.id())))
+        {
+            add_uncontrolled_robot(robot);
+        }
+    }
+    for (const Robot &robot : world.enemyTeam().robots())
+    {
+        add_uncontrolled_robot(robot);
+    }
+
+    orca_solver.solve();
+
+    // Only robots that have to dodge something are redirected, so the rest keep
+    // following their paths exactly. A redirected robot is sent to where its new
+    // velocity would take it by the end of the time horizon, without slowing down
+    for (std::size_t i = 0; i < num_planning_queries && i < orca_solver.getNumAgents();
+         i++)
+    {
+        const Vector new_velocity = orca_solver.getNewVelocity(i);
+        if (!new_velocity.isClose(preferred_velocities[i]))
+        {
+            PlanningQuery &query = planning_queries[i];
+            query.waypoint =
+                query.start + new_velocity * OrcaSolver::TIME_HORIZON_SECONDS;
+            query.final_speed = new_velocity.len();
+        }
+    }
+}
@@ -1,6 +1,13 @@
 #pragma once
 
+#include <array>
+#include <optional>
+#include <vector>
+
 #include "ai/navigator/navigator.h"
+#include "ai/navigator/orca/orca_solver.h"
+#include "ai/navigator/rrt/rrt_star_planner.h"
+#include "util/thread_pool.h"
 
 class RRTNav : public Navigator
 {
@@ -8,10 +15,170 @@ class RRTNav : public Navigator
     /**
      * Creates a new Navigator that uses RRT (Rapidly Expanding Random Trees)
      * to generate paths
+     *
+     * @param thread_pool The threads to plan the paths on, which may be shared with
+     * other modules that don't use it at the same time. Must outlive the RRTNav
+     * @param planning_time_budget The longest time planning one path may take, or
+     * std::nullopt to only limit the number of iterations, which is meant for tests and
+     * benchmarks. Without a budget, deadlines are ignored
      */
-    RRTNav();
+    explicit RRTNav(ThreadPool &thread_pool,
+                    const std::optional<AITimestamp> &planning_time_budget =
+                        RRTStarPlanner::PLANNING_TIME_BUDGET);
 
+    /**
+     * Plans a path around the other robots for each MoveIntent, and returns a
+     * MovePrimitive to the first waypoint of each path. Only the primitive to the
+     * destination itself uses the MoveIntent's final speed. Robots are sent through
+     * the intermediate waypoints as fast as they can turn the corner there and still
+     * stop in time for the rest of the path.
+     *
+     * The paths are planned at the same time on a pool of threads, and each one is
+     * seeded with its robot's id, so the same world always gives the same primitives
+     * unless a planner runs out of time.
+     *
+     * Each path is only planned inside a box around its robot and destination, and
+     * only the robots the spatial index finds near that box are obstacles for it.
+     * Paths also keep a robot's radius away from the edge of the field and both
+     * defense areas, using the world's signed distance field, except for the goalie's
+     * path, which may go into the defense areas.
+     *
+     * Each robot's path is kept until the next tick, when it is repaired around the
+     * obstacles that have moved into its way. It is only planned again from scratch if
+     * its destination moved or it couldn't be repaired.
+     *
+     * Paths only avoid where robots are now, so once they are planned, the velocities
+     * the robots would follow them at are checked against every other robot's velocity.
+     * A robot that would collide with another one soon is sent a short way along a
+     * velocity that avoids it instead.
+     *
+     * If a deadline has been set, each path's time budget is shortened so that every
+     * path can still be planned by then. The paths are planned in rounds of as many
+     * paths as there are threads, so each round gets an equal share of the time left
+     */
     std::vector<std::unique_ptr<Primitive>> getAssignedPrimitives(
         const World &world,
-        const std::vector<std::unique_ptr<Intent>> &assignedIntents) const override;
+        const std::vector<std::unique_ptr<Intent>> &assignedIntents) override;
+
+    void setDeadline(const AITimestamp &deadline) override;
+
+   private:
+    // How far a robot's destination can move between ticks before its path is planned
+    // again from scratch instead of repaired
+    static constexpr double DESTINATION_CHANGE_THRESHOLD_METERS = 0.05;
+
+    // How much room a path has to go around obstacles, on every side of the box
+    // between its robot and destination
+    static constexpr double PLANNING_MARGIN_METERS = 1.0;
+
+    // The time kept back from the deadline for everything but planning the paths, such
+    // as avoiding collisions and creating the primitives
+    static constexpr AITimestamp NON_PLANNING_TIME_RESERVE =
+        std::chrono::microseconds(200);
+    // The shortest time budget a path is given, however close the deadline is, so a
+    // tick that is already late still gets paths that are better than nothing
+    static constexpr AITimestamp MIN_PLANNING_TIME_BUDGET = std::chrono::microseconds(50);
+
+    /**
+     * The last path planned for a robot, and the destination it leads to if it reached
+     * it
+     */
+    typedef struct
+    {
+        std::optional<Point> destination;
+        std::vector<Point> waypoints;
+    } CachedPath;
+
+    /**
+     * A path to plan for one MoveIntent, and the first waypoint of the path once it has
+     * been planned
+     */
+    typedef struct
+    {
+        unsigned int robot_id;
+        Point start;
+        Vector velocity;
+        Point destination;
+        Rect bounds;
+        std::vector<Circle> obstacles;
+        // The field's static obstacles, or nullptr if the robot may go anywhere inside
+        // the bounds
+        const SignedDistanceField *static_obstacles;
+        Point waypoint;
+        double final_speed;
+    } PlanningQuery;
+
+    /**
+     * Sets the bounds of the given query to the part of the field it plans in, and its
+     * obstacles to the other robots that could be in the way there
+     *
+     * @param world The world to plan in
+     * @param field_bounds Where robots can drive on the field
+     * @param avoid_dist How far paths keep away from other robots
+     * @param query The query, with its robot, start and destination set
+     */
+    static void setQueryObstacles(const World &world, const Rect &field_bounds,
+                                  double avoid_dist, PlanningQuery &query);
+
+    /**
+     * Returns how fast a robot should be going when it reaches the first waypoint of a
+     * path, so it can turn onto the next leg of the path and still slow down to the
+     * final speed by the end of it. Robots cut straight through waypoints on straight
+     * paths, and come to a stop at waypoints where the path turns back on itself
+     *
+     * @param start Where the robot is now
+     * @param waypoints The path, with at least two waypoints
+     * @param final_speed How fast the robot should be going at the end of the path
+     *
+     * @return how fast the robot should be going at the first waypoint
+     */
+    static double getCornerSpeed(const Point &start, const std::vector<Point> &waypoints,
+                                 double final_speed);
+
+    /**
+     * Plans the path for a query, by repairing its robot's cached path if it can, and
+     * stores its first waypoint and the speed to reach it at in the query
+     *
+     * @param query_index The index of the query to plan, which is also the index of the
+     * planner it uses
+     */
+    void planPath(std::size_t query_index);
+
+    /**
+     * Returns the time budget for each of the given number of paths, so they can all be
+     * planned by the deadline
+     *
+     * @param num_paths The number of paths to plan
+     *
+     * @return the time budget for each path, or std::nullopt if the paths are only
+     * limited by the number of iterations
+     */
+    std::optional<AITimestamp> getPathTimeBudget(std::size_t num_paths) const;
+
+    /**
+     * Changes the waypoint and final speed of each query whose robot would collide with
+     * another robot on its way to the waypoint, so the robot moves at a velocity that
+     * avoids them instead
+     *
+     * @param world The world the queries were planned in
+     */
+    void avoidCollisions(const World &world);
+
+    ThreadPool &planning_thread_pool;
+    std::optional<AITimestamp> planning_time_budget;
+    // When getAssignedPrimitives() should return by, if a deadline has been set
+    std::optional<AITimestamp> deadline;
+
+    // The queries for the current tick and a planner for each, so queries planned at
+    // the same time never share a planner. Both only grow, so a tick with no more
+    // queries than the last one doesn't allocate
+    std::vector<PlanningQuery> planning_queries;
+    std::vector<RRTStarPlanner> planners;
+    std::size_t num_planning_queries;
+
+    // Indexed by robot id. Each robot's path is only used by the thread planning its
+    // query
+    std::array<CachedPath, Team::MAX_ROBOT_IDS> cached_paths;
+
+    OrcaSolver orca_solver;
 };
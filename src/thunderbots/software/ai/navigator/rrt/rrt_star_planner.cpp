@@ -0,0 +1,520 @@
+#include "ai/navigator/rrt/rrt_star_planner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    /**
+     * Returns the squared distance from the point (px, py) to the segment from (ax, ay)
+     * to (bx, by)
+     */
+    double distanceSquaredToSegment(double px, double py, double ax, double ay, double bx,
+                                    double by)
+    {
+        const double dx            = bx - ax;
+        const double dy            = by - ay;
+        const double length_square = dx * dx + dy * dy;
+        double t                   = 0;
+        if (length_square > 0)
+        {
+            t = std::clamp(((px - ax) * dx + (py - ay) * dy) / length_square, 0.0, 1.0);
+        }
+        const double ex = ax + t * dx - px;
+        const double ey = ay + t * dy - py;
+        return ex * ex + ey * ey;
+    }
+}  // namespace
+
+RRTStarPlanner::RRTStarPlanner(const std::optional<AITimestamp> &time_budget)
+    : node_x_positions(MAX_NUM_NODES),
+      node_y_positions(MAX_NUM_NODES),
+      node_costs(MAX_NUM_NODES),
+      node_parents(MAX_NUM_NODES),
+      next_nodes_in_cell(MAX_NUM_NODES),
+      num_nodes(0),
+      min_x(0),
+      min_y(0),
+      bounds_width(0),
+      bounds_height(0),
+      num_columns(1),
+      num_rows(1),
+      cell_first_nodes(1, NO_NODE),
+      obstacle_x_positions(),
+      obstacle_y_positions(),
+      obstacle_radii_squared(),
+      static_obstacles(nullptr),
+      static_obstacle_clearance(0),
+      avoid_static_obstacles(false),
+      neighbours(),
+      path(),
+      path_reaches_goal(false),
+      repaired_path(),
+      random_generator(),
+      time_budget(time_budget)
+{
+    path.reserve(MAX_NUM_NODES + 1);
+    repaired_path.reserve(MAX_NUM_NODES + 1);
+}
+
+void RRTStarPlanner::setStaticObstacles(const SignedDistanceField *static_obstacles,
+                                        double clearance)
+{
+    this->static_obstacles    = static_obstacles;
+    static_obstacle_clearance = clearance;
+}
+
+void RRTStarPlanner::setTimeBudget(const std::optional<AITimestamp> &time_budget)
+{
+    this->time_budget = time_budget;
+}
+
+const std::vector<Point> &RRTStarPlanner::findPath(const Point &start, const Point &goal,
+                                                   const Rect &bounds,
+                                                   const std::vector<Circle> &obstacles,
+                                                   uint32_t seed)
+{
+    const AITimestamp start_time = Timestamp::getTimestampNow();
+    reset(start, goal, bounds, obstacles);
+    random_generator.seed(seed);
+    addNode(start, NO_NODE, 0);
+
+    // Most of the time nothing is in the way
+    if (isSegmentFree(start, goal))
+    {
+        path.clear();
+        path.emplace_back(goal);
+        path_reaches_goal = true;
+        return path;
+    }
+
+    std::uniform_real_distribution<double> sample_x(min_x, min_x + bounds_width);
+    std::uniform_real_distribution<double> sample_y(min_y, min_y + bounds_height);
+    std::uniform_real_distribution<double> sample_goal(0, 1);
+    unsigned int iterations_left = MAX_ITERATIONS;
+    bool reached_goal            = false;
+    for (unsigned int iteration = 0; iterations_left > 0 && num_nodes < MAX_NUM_NODES;
+         iteration++, iterations_left--)
+    {
+        // Checking the clock is slow compared to an iteration, so only do it sometimes
+        if (time_budget && iteration % 32 == 31 &&
+            Timestamp::getTimestampNow() - start_time > *time_budget)
+        {
+            break;
+        }
+
+        Point sample = goal;
+        if (sample_goal(random_generator) >= GOAL_SAMPLE_PROBABILITY)
+        {
+            sample = Point(sample_x(random_generator), sample_y(random_generator));
+        }
+
+        // Steer from the nearest node towards the sample, no further than one step
+        const int32_t nearest = findNearestNode(sample);
+        const Point nearest_position(node_x_positions[nearest],
+                                     node_y_positions[nearest]);
+        Vector step = sample - nearest_position;
+        if (step.len() > STEP_SIZE_METERS)
+        {
+            step = step.norm(STEP_SIZE_METERS);
+        }
+        if (step.lensq() == 0)
+        {
+            continue;
+        }
+        const Point position = nearest_position + step;
+        if (!isSegmentFree(nearest_position, position))
+        {
+            continue;
+        }
+
+        // Connect the new node through whichever nearby node gives the shortest path
+        const std::size_t num_neighbours =
+            findNodesWithinRadius(position, REWIRE_RADIUS_METERS);
+        int32_t parent = nearest;
+        double cost    = node_costs[nearest] + step.len();
+        for (std::size_t i = 0; i < num_neighbours; i++)
+        {
+            const int32_t neighbour = neighbours[i];
+            const Point neighbour_position(node_x_positions[neighbour],
+                                           node_y_positions[neighbour]);
+            const double neighbour_cost =
+                node_costs[neighbour] + (position - neighbour_position).len();
+            if (neighbour_cost < cost && isSegmentFree(neighbour_position, position))
+            {
+                parent = neighbour;
+                cost   = neighbour_cost;
+            }
+        }
+        const int32_t node = addNode(position, parent, cost);
+
+        // Reroute nearby nodes through the new node if it gives them shorter paths. The
+        // costs of their descendants aren't updated, so they can only be too high
+        for (std::size_t i = 0; i < num_neighbours; i++)
+        {
+            const int32_t neighbour = neighbours[i];
+            const Point neighbour_position(node_x_positions[neighbour],
+                                           node_y_positions[neighbour]);
+            const double rerouted_cost = cost + (position - neighbour_position).len();
+            if (neighbour != parent && rerouted_cost < node_costs[neighbour] &&
+                isSegmentFree(position, neighbour_position))
+            {
+                node_parents[neighbour] = node;
+                node_costs[neighbour]   = rerouted_cost;
+            }
+        }
+
+        // Once the goal is reached, keep improving the tree for a while longer
+        if (!reached_goal && (goal - position).len() <= STEP_SIZE_METERS &&
+            isSegmentFree(position, goal))
+        {
+            reached_goal    = true;
+            iterations_left = std::min(iterations_left, REFINEMENT_ITERATIONS);
+        }
+    }
+
+    const int32_t goal_parent = reached_goal ? findBestGoalParent(goal) : NO_NODE;
+    if (goal_parent != NO_NODE)
+    {
+        extractPath(goal_parent, goal, true);
+    }
+    else
+    {
+        extractPath(findNearestNode(goal), goal, false);
+    }
+    return path;
+}
+
+bool RRTStarPlanner::repairPath(const Point &start, std::vector<Point> &waypoints,
+                                const Rect &bounds, const std::vector<Circle> &obstacles,
+                                uint32_t seed)
+{
+    path_reaches_goal = false;
+    if (waypoints.empty())
+    {
+        return false;
+    }
+    const Point goal = waypoints.back();
+    setObstacles(start, goal, obstacles);
+
+    // An obstacle has moved onto a waypoint, so the path around it has to be found again
+    for (std::size_t i = 0; i + 1 < waypoints.size(); i++)
+    {
+        if (!isSegmentFree(waypoints[i], waypoints[i]))
+        {
+            return false;
+        }
+    }
+
+    repaired_path.clear();
+    Point from = start;
+    for (const Point &waypoint : waypoints)
+    {
+        if (!isSegmentFree(from, waypoint))
+        {
+            // Plan a detour for just this segment, which replaces the obstacles
+            const std::vector<Point> &detour =
+                findPath(from, waypoint, bounds, obstacles, seed);
+            if (!path_reaches_goal)
+            {
+                return false;
+            }
+            repaired_path.insert(repaired_path.end(), detour.begin(), detour.end() - 1);
+            setObstacles(start, goal, obstacles);
+        }
+        repaired_path.emplace_back(waypoint);
+        from = waypoint;
+    }
+
+    // This also drops the waypoints the start has already moved past
+    shortenPath(start, repaired_path);
+    waypoints.assign(repaired_path.begin(), repaired_path.end());
+    path_reaches_goal = true;
+    return true;
+}
+
+bool RRTStarPlanner::isSegmentFree(const Point &start, const Point &end) const
+{
+    if (!isClearOfStaticObstacles(start, end))
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < obstacle_x_positions.size(); i++)
+    {
+        if (distanceSquaredToSegment(obstacle_x_positions[i], obstacle_y_positions[i],
+                                     start.x(), start.y(), end.x(),
+                                     end.y()) < obstacle_radii_squared[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RRTStarPlanner::isClearOfStaticObstacles(const Point &start, const Point &end) const
+{
+    if (!avoid_static_obstacles)
+    {
+        return true;
+    }
+
+    // Nothing is closer to a point than its clearance, so that much of the segment
+    // can be skipped
+    const Vector segment   = end - start;
+    const double length    = segment.len();
+    const Vector direction = length > 0 ? segment / length : Vector();
+    double distance_along  = 0;
+    while (true)
+    {
+        const double margin =
+            static_obstacles->getClearance(start + direction * distance_along) -
+            static_obstacle_clearance;
+        if (margin < 0)
+        {
+            return false;
+        }
+        if (distance_along >= length)
+        {
+            return true;
+        }
+        distance_along = std::min(
+            length, distance_along + std::max(margin, MIN_STATIC_OBSTACLE_STEP_METERS));
+    }
+}
+
+bool RRTStarPlanner::lastPathReachesGoal() const
+{
+    return path_reaches_goal;
+}
+
+std::size_t RRTStarPlanner::getNumNodes() const
+{
+    return num_nodes;
+}
+
+void RRTStarPlanner::reset(const Point &start, const Point &goal, const Rect &bounds,
+                           const std::vector<Circle> &obstacles)
+{
+    min_x         = bounds.swCorner().x();
+    min_y         = bounds.swCorner().y();
+    bounds_width  = bounds.width();
+    bounds_height = bounds.height();
+    num_columns =
+        std::max(1, static_cast<int32_t>(std::ceil(bounds_width / REWIRE_RADIUS_METERS)));
+    num_rows = std::max(
+        1, static_cast<int32_t>(std::ceil(bounds_height / REWIRE_RADIUS_METERS)));
+    cell_first_nodes.assign(num_columns * num_rows, NO_NODE);
+    num_nodes = 0;
+
+    setObstacles(start, goal, obstacles);
+}
+
+void RRTStarPlanner::setObstacles(const Point &start, const Point &goal,
+                                  const std::vector<Circle> &obstacles)
+{
+    obstacle_x_positions.clear();
+    obstacle_y_positions.clear();
+    obstacle_radii_squared.clear();
+    for (const Circle &obstacle : obstacles)
+    {
+        const double radius_squared = obstacle.radius * obstacle.radius;
+        if ((start - obstacle.origin).lensq() < radius_squared ||
+            (goal - obstacle.origin).lensq() < radius_squared)
+        {
+            continue;
+        }
+        obstacle_x_positions.emplace_back(obstacle.origin.x());
+        obstacle_y_positions.emplace_back(obstacle.origin.y());
+        obstacle_radii_squared.emplace_back(radius_squared);
+    }
+
+    avoid_static_obstacles =
+        static_obstacles &&
+        static_obstacles->getClearance(start) >= static_obstacle_clearance &&
+        static_obstacles->getClearance(goal) >= static_obstacle_clearance;
+}
+
+int32_t RRTStarPlanner::addNode(const Point &position, int32_t parent, double cost)
+{
+    const int32_t node       = static_cast<int32_t>(num_nodes++);
+    const int32_t cell       = getCell(position);
+    node_x_positions[node]   = position.x();
+    node_y_positions[node]   = position.y();
+    node_costs[node]         = cost;
+    node_parents[node]       = parent;
+    next_nodes_in_cell[node] = cell_first_nodes[cell];
+    cell_first_nodes[cell]   = node;
+    return node;
+}
+
+int32_t RRTStarPlanner::findNearestNode(const Point &point) const
+{
+    int32_t nearest                 = NO_NODE;
+    double nearest_distance_squared = std::numeric_limits<double>::infinity();
+    auto visit_cell                 = [&](int32_t column, int32_t row) {
+        if (column < 0 || column >= num_columns || row < 0 || row >= num_rows)
+        {
+            return;
+        }
+        for (int32_t node = cell_first_nodes[row * num_columns + column]; node != NO_NODE;
+             node         = next_nodes_in_cell[node])
+        {
+            const double dx               = node_x_positions[node] - point.x();
+            const double dy               = node_y_positions[node] - point.y();
+            const double distance_squared = dx * dx + dy * dy;
+            if (distance_squared < nearest_distance_squared)
+            {
+                nearest                  = node;
+                nearest_distance_squared = distance_squared;
+            }
+        }
+    };
+
+    // Search rings of cells outwards from the point. Every node in ring r + 1 or further
+    // out is more than r cells away from the point, so once we have a node closer than
+    // that we are done
+    const int32_t column = getColumn(point.x());
+    const int32_t row    = getRow(point.y());
+    const int32_t max_ring =
+        std::max({column, num_columns - 1 - column, row, num_rows - 1 - row});
+    for (int32_t ring = 0; ring <= max_ring; ring++)
+    {
+        for (int32_t c = column - ring; c <= column + ring; c++)
+        {
+            visit_cell(c, row - ring);
+            if (ring > 0)
+            {
+                visit_cell(c, row + ring);
+            }
+        }
+        for (int32_t r = row - ring + 1; r <= row + ring - 1; r++)
+        {
+            visit_cell(column - ring, r);
+            visit_cell(column + ring, r);
+        }
+
+        const double searched_distance = ring * REWIRE_RADIUS_METERS;
+        if (nearest != NO_NODE &&
+            nearest_distance_squared <= searched_distance * searched_distance)
+        {
+            break;
+        }
+    }
+    return nearest;
+}
+
+std::size_t RRTStarPlanner::findNodesWithinRadius(const Point &point, double radius)
+{
+    const double radius_squared = radius * radius;
+    std::size_t num_found       = 0;
+    const int32_t first_column  = std::max(getColumn(point.x() - radius), 0);
+    const int32_t last_column = std::min(getColumn(point.x() + radius), num_columns - 1);
+    const int32_t first_row   = std::max(getRow(point.y() - radius), 0);
+    const int32_t last_row    = std::min(getRow(point.y() + radius), num_rows - 1);
+    for (int32_t row = first_row; row <= last_row; row++)
+    {
+        for (int32_t column = first_column; column <= last_column; column++)
+        {
+            for (int32_t node = cell_first_nodes[row * num_columns + column];
+                 node != NO_NODE && num_found < MAX_NUM_NEIGHBOURS;
+                 node = next_nodes_in_cell[node])
+            {
+                const double dx = node_x_positions[node] - point.x();
+                const double dy = node_y_positions[node] - point.y();
+                if (dx * dx + dy * dy <= radius_squared)
+                {
+                    neighbours[num_found++] = node;
+                }
+            }
+        }
+    }
+    return num_found;
+}
+
+int32_t RRTStarPlanner::findBestGoalParent(const Point &goal)
+{
+    const std::size_t num_neighbours = findNodesWithinRadius(goal, REWIRE_RADIUS_METERS);
+    int32_t best_parent              = NO_NODE;
+    double best_cost                 = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < num_neighbours; i++)
+    {
+        const int32_t node = neighbours[i];
+        const Point position(node_x_positions[node], node_y_positions[node]);
+        const double cost = node_costs[node] + (goal - position).len();
+        if (cost < best_cost && isSegmentFree(position, goal))
+        {
+            best_parent = node;
+            best_cost   = cost;
+        }
+    }
+    return best_parent;
+}
+
+void RRTStarPlanner::extractPath(int32_t last_node, const Point &goal, bool reached_goal)
+{
+    // Walk back up the tree, then put the waypoints in order from the start
+    path.clear();
+    path_reaches_goal = reached_goal;
+    if (reached_goal)
+    {
+        path.emplace_back(goal);
+    }
+    for (int32_t node = last_node; node != NO_NODE && node_parents[node] != NO_NODE;
+         node         = node_parents[node])
+    {
+        path.emplace_back(node_x_positions[node], node_y_positions[node]);
+    }
+    const Point start(node_x_positions[0], node_y_positions[0]);
+    std::reverse(path.begin(), path.end());
+    shortenPath(start, path);
+
+    if (path.empty())
+    {
+        // The tree never grew, so the start is boxed in and the closest we can get to
+        // the goal is staying where we are
+        path.emplace_back(start);
+    }
+}
+
+void RRTStarPlanner::shortenPath(const Point &start, std::vector<Point> &waypoints) const
+{
+    // Skip every waypoint that the waypoint before it can see past
+    Point from           = start;
+    std::size_t num_kept = 0;
+    std::size_t next     = 0;
+    while (next < waypoints.size())
+    {
+        std::size_t furthest_visible = next;
+        for (std::size_t i = waypoints.size() - 1; i > next; i--)
+        {
+            if (isSegmentFree(from, waypoints[i]))
+            {
+                furthest_visible = i;
+                break;
+            }
+        }
+        from                  = waypoints[furthest_visible];
+        waypoints[num_kept++] = from;
+        next                  = furthest_visible + 1;
+    }
+    waypoints.resize(num_kept);
+}
+
+int32_t RRTStarPlanner::getCell(const Point &point) const
+{
+    return getRow(point.y()) * num_columns + getColumn(point.x());
+}
+
+int32_t RRTStarPlanner::getColumn(double x) const
+{
+    // Clamp before converting, since points can be far outside the bounds
+    return static_cast<int32_t>(std::clamp(std::floor((x - min_x) / REWIRE_RADIUS_METERS),
+                                           0.0, num_columns - 1.0));
+}
+
+int32_t RRTStarPlanner::getRow(double y) const
+{
+    return static_cast<int32_t>(
+        std::clamp(std::floor((y - min_y) / REWIRE_RADIUS_METERS), 0.0, num_rows - 1.0));
+}
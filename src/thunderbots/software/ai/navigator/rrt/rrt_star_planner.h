@@ -0,0 +1,264 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "ai/world/signed_distance_field.h"
+#include "geom/point.h"
+#include "geom/rect.h"
+#include "geom/shapes.h"
+#include "util/timestamp.h"
+
+/**
+ * Finds short paths around circular obstacles using RRT* (an asymptotically optimal
+ * Rapidly-exploring Random Tree).
+ *
+ * The tree grows from the start by sampling random points in the bounds, steering
+ * towards them from the nearest node, and connecting each new node to whichever nearby
+ * node gives it the shortest path. Nearby nodes are then rewired through the new node if
+ * that shortens their paths. Once the goal is reached, the tree keeps improving for a
+ * while before the best path is taken, and the path is shortened by skipping any
+ * waypoints that can be seen past.
+ *
+ * The nodes are stored in an arena of fixed size that is reset for each query, and are
+ * bucketed into a uniform grid so nearest neighbour and rewiring queries only check a
+ * few cells. Each query stops after MAX_ITERATIONS iterations or its time budget,
+ * whichever comes first, and returns the best path found so far. A planner without a
+ * time budget always runs the same iterations, so its paths only depend on the query
+ * and not on how fast the machine is. Nothing is allocated unless the bounds or number
+ * of obstacles grow.
+ *
+ * The static obstacles on the field, like the defense areas and the edge of the field,
+ * can also be avoided by looking up the clearance from a SignedDistanceField along each
+ * segment. The lookups step along the segment by the clearance at each point, so
+ * segments across open field only take a few of them.
+ *
+ * When the obstacles have only moved a little, a path from an earlier query can be
+ * repaired instead, which only plans detours around the segments that became blocked.
+ */
+class RRTStarPlanner final
+{
+   public:
+    // The most nodes the tree can have
+    static constexpr std::size_t MAX_NUM_NODES = 2000;
+    // The most times the tree tries to grow in one query
+    static constexpr unsigned int MAX_ITERATIONS = 2000;
+    // How many more times the tree tries to grow after first reaching the goal
+    static constexpr unsigned int REFINEMENT_ITERATIONS = 300;
+    // The longest time one query may take by default
+    static constexpr AITimestamp PLANNING_TIME_BUDGET = std::chrono::microseconds(800);
+    // The longest edge added to the tree, in metres
+    static constexpr double STEP_SIZE_METERS = 0.3;
+    // How far away nodes can be to be considered as parents or rewired, in metres
+    static constexpr double REWIRE_RADIUS_METERS = 0.6;
+    // How often the goal is sampled instead of a random point
+    static constexpr double GOAL_SAMPLE_PROBABILITY = 0.1;
+
+    /**
+     * Creates a new RRTStarPlanner
+     *
+     * @param time_budget The longest time one query may take, or std::nullopt to only
+     * limit the number of iterations, which is meant for tests and benchmarks
+     */
+    explicit RRTStarPlanner(
+        const std::optional<AITimestamp>& time_budget = PLANNING_TIME_BUDGET);
+
+    /**
+     * Sets the static obstacles that every query from now on must also avoid, by
+     * keeping the given clearance from them. Like the other obstacles, they are ignored
+     * by queries whose start or goal is already closer than that, so a robot that is
+     * too close to a static obstacle can still move away from it
+     *
+     * @param static_obstacles The signed distance field of the static obstacles, or
+     * nullptr to not avoid any. Must stay valid while it is used
+     * @param clearance How far paths must keep from the static obstacles, in metres
+     */
+    void setStaticObstacles(const SignedDistanceField* static_obstacles,
+                            double clearance);
+
+    /**
+     * Sets the longest time each query from now on may take
+     *
+     * @param time_budget The longest time one query may take, or std::nullopt to only
+     * limit the number of iterations
+     */
+    void setTimeBudget(const std::optional<AITimestamp>& time_budget);
+
+    /**
+     * Finds a path from the start to the goal that doesn't pass through any obstacles.
+     * Obstacles that contain the start or goal are ignored, so a robot that is already
+     * too close to an obstacle can still move away from it
+     *
+     * @param start Where the path starts
+     * @param goal Where the path should end
+     * @param bounds The area the path must stay inside, apart from the start and goal
+     * @param obstacles The obstacles the path must avoid
+     * @param seed The seed for the random samples, so the same query always gives the
+     * same path
+     *
+     * @return the waypoints of the path, not including the start. The last waypoint is
+     * the goal if a path to it was found, and otherwise the point the tree got closest
+     * to the goal, which is the start itself if it is boxed in by obstacles. The path
+     * is valid until the next query
+     */
+    const std::vector<Point>& findPath(const Point& start, const Point& goal,
+                                       const Rect& bounds,
+                                       const std::vector<Circle>& obstacles,
+                                       uint32_t seed);
+
+    /**
+     * Fixes up a path from an earlier query so it avoids the given obstacles, which may
+     * have moved since then. Only the segments that now pass through an obstacle are
+     * planned again, and then any waypoints the start can see past are skipped, so a
+     * path that is still clear costs little more than checking it
+     *
+     * @param start Where the path starts now, which may be partway along it
+     * @param waypoints The waypoints of the path, not including the start, which are
+     * replaced with the repaired path if it could be repaired
+     * @param bounds The area the detours must stay inside
+     * @param obstacles The obstacles the path must avoid
+     * @param seed The seed for the random samples of the detours
+     *
+     * @return true if the path was repaired, and false if a waypoint is now inside an
+     * obstacle or a detour couldn't be found, in which case the path should be planned
+     * again from scratch
+     */
+    bool repairPath(const Point& start, std::vector<Point>& waypoints, const Rect& bounds,
+                    const std::vector<Circle>& obstacles, uint32_t seed);
+
+    /**
+     * Returns whether the segment between the given points avoids all the obstacles
+     * used by the last query, including the static obstacles
+     *
+     * @param start, end The ends of the segment
+     *
+     * @return true if the segment doesn't pass through any obstacle, and false otherwise
+     */
+    bool isSegmentFree(const Point& start, const Point& end) const;
+
+    /**
+     * Returns whether the path from the last call to findPath() or repairPath() reaches
+     * its goal. Compare with this rather than with the last waypoint, since a path can
+     * end anywhere when the goal can't be reached
+     *
+     * @return true if the last path reaches its goal, and false otherwise
+     */
+    bool lastPathReachesGoal() const;
+
+    /**
+     * Returns how many nodes the tree had at the end of the last query
+     *
+     * @return how many nodes the tree had at the end of the last query
+     */
+    std::size_t getNumNodes() const;
+
+   private:
+    // Marks the end of a cell's list of nodes, and the parent of the root
+    static constexpr int32_t NO_NODE = -1;
+    // The most nearby nodes considered when connecting a new node
+    static constexpr std::size_t MAX_NUM_NEIGHBOURS = 64;
+    // The shortest step taken along a segment when checking it against the static
+    // obstacles, so segments that graze them still finish quickly
+    static constexpr double MIN_STATIC_OBSTACLE_STEP_METERS =
+        SignedDistanceField::RESOLUTION_METERS / 2;
+
+    /**
+     * Sets up the grid and obstacles for a new query
+     */
+    void reset(const Point& start, const Point& goal, const Rect& bounds,
+               const std::vector<Circle>& obstacles);
+
+    /**
+     * Sets the obstacles for a query, leaving out any that contain the start or goal,
+     * and the clearance to keep from the static obstacles
+     */
+    void setObstacles(const Point& start, const Point& goal,
+                      const std::vector<Circle>& obstacles);
+
+    /**
+     * Returns whether the segment between the given points keeps the clearance from the
+     * static obstacles, if the current query avoids them
+     */
+    bool isClearOfStaticObstacles(const Point& start, const Point& end) const;
+
+    /**
+     * Adds a node to the tree and the grid
+     *
+     * @return the index of the new node
+     */
+    int32_t addNode(const Point& position, int32_t parent, double cost);
+
+    /**
+     * Returns the index of the node closest to the given point
+     */
+    int32_t findNearestNode(const Point& point) const;
+
+    /**
+     * Finds the nodes within the given radius of a point, up to MAX_NUM_NEIGHBOURS of
+     * them
+     *
+     * @return the number of nodes found, which are stored in neighbours
+     */
+    std::size_t findNodesWithinRadius(const Point& point, double radius);
+
+    /**
+     * Connects the goal to the node that gives it the shortest path, if any can see it
+     *
+     * @return the node the goal is connected to, or NO_NODE if no node can see it
+     */
+    int32_t findBestGoalParent(const Point& goal);
+
+    /**
+     * Fills the path with the nodes from the root to the given node, followed by the
+     * goal if it was reached, and then removes the waypoints that can be skipped
+     */
+    void extractPath(int32_t last_node, const Point& goal, bool reached_goal);
+
+    /**
+     * Removes every waypoint that the waypoint before it, or the start, can see past
+     */
+    void shortenPath(const Point& start, std::vector<Point>& waypoints) const;
+
+    int32_t getCell(const Point& point) const;
+    int32_t getColumn(double x) const;
+    int32_t getRow(double y) const;
+
+    // The tree. Each node's cost is the length of its path from the root
+    std::vector<double> node_x_positions;
+    std::vector<double> node_y_positions;
+    std::vector<double> node_costs;
+    std::vector<int32_t> node_parents;
+    std::vector<int32_t> next_nodes_in_cell;
+    std::size_t num_nodes;
+
+    // The grid of nodes covering the bounds, with the first node in each cell
+    double min_x;
+    double min_y;
+    double bounds_width;
+    double bounds_height;
+    int32_t num_columns;
+    int32_t num_rows;
+    std::vector<int32_t> cell_first_nodes;
+
+    // The obstacles used by the current query
+    std::vector<double> obstacle_x_positions;
+    std::vector<double> obstacle_y_positions;
+    std::vector<double> obstacle_radii_squared;
+    const SignedDistanceField* static_obstacles;
+    double static_obstacle_clearance;
+    // Whether the current query avoids the static obstacles
+    bool avoid_static_obstacles;
+
+    std::array<int32_t, MAX_NUM_NEIGHBOURS> neighbours;
+    std::vector<Point> path;
+    // Whether the path from the last findPath() or repairPath() reaches its goal
+    bool path_reaches_goal;
+    std::vector<Point> repaired_path;
+    std::mt19937 random_generator;
+    std::optional<AITimestamp> time_budget;
+};
@@ -38,10 +38,10 @@ void Ball::updateStateToPredictedState(std::chrono::steady_clock::time_point tim
         exit(1);
     }
 
-    auto milliseconds_in_future = std::chrono::duration_cast<std::chrono::milliseconds>(
+    auto microseconds_in_future = std::chrono::duration_cast<std::chrono::microseconds>(
         timestamp - last_update_timestamp);
-    Point new_position = estimatePositionAtFutureTime(milliseconds_in_future);
-    Point new_velocity = estimateVelocityAtFutureTime(milliseconds_in_future);
+    Point new_position = estimatePositionAtFutureTime(microseconds_in_future);
+    Point new_velocity = estimateVelocityAtFutureTime(microseconds_in_future);
 
     updateState(new_position, new_velocity, timestamp);
 }
@@ -57,9 +57,9 @@ Point Ball::position() const
 }
 
 Point Ball::estimatePositionAtFutureTime(
-    const std::chrono::milliseconds &milliseconds_in_future) const
+    const std::chrono::microseconds &microseconds_in_future) const
 {
-    if (milliseconds_in_future < std::chrono::milliseconds(0))
+    if (microseconds_in_future < std::chrono::microseconds(0))
     {
         // TODO: Error. We should never be updating with times from the past
         // TODO: Throw a proper exception here
@@ -71,7 +71,7 @@ Point Ball::estimatePositionAtFutureTime(
     // https://github.com/UBC-Thunderbots/Software/issues/47
     typedef std::chrono::duration<double> double_seconds;
     double seconds_in_future =
-        std::chrono::duration_cast<double_seconds>(milliseconds_in_future).count();
+        std::chrono::duration_cast<double_seconds>(microseconds_in_future).count();
     return position_ + (velocity_.norm(seconds_in_future * velocity_.len()));
 }
 
@@ -81,9 +81,9 @@ Vector Ball::velocity() const
 }
 
 Vector Ball::estimateVelocityAtFutureTime(
-    const std::chrono::milliseconds &milliseconds_in_future) const
+    const std::chrono::microseconds &microseconds_in_future) const
 {
-    if (milliseconds_in_future < std::chrono::milliseconds(0))
+    if (microseconds_in_future < std::chrono::microseconds(0))
     {
         // TODO: Error. We should never be updating with times from the past
         // TODO: Throw a proper exception here
@@ -95,7 +95,7 @@ Vector Ball::estimateVelocityAtFutureTime(
     // improved as outlined in https://github.com/UBC-Thunderbots/Software/issues/47
     typedef std::chrono::duration<double> double_seconds;
     double seconds_in_future =
-        std::chrono::duration_cast<double_seconds>(milliseconds_in_future).count();
+        std::chrono::duration_cast<double_seconds>(microseconds_in_future).count();
     return velocity_ * exp(-0.1 * seconds_in_future);
 }
 
@@ -66,16 +66,16 @@ class Ball final
      * Returns the estimated position of the ball at a future time, relative to when the
      * ball was last updated.
      *
-     * @param milliseconds_in_future The relative amount of time in the future
-     * (in milliseconds) at which to predict the ball's position. Value must be >= 0.
-     * For example, a value of 1500 would return the estimated position of the ball
+     * @param microseconds_in_future The relative amount of time in the future
+     * (in microseconds) at which to predict the ball's position. Value must be >= 0.
+     * For example, a value of 1500000 would return the estimated position of the ball
      * 1.5 seconds in the future.
      *
-     * @return the estimated position of the ball at the given number of milliseconds
+     * @return the estimated position of the ball at the given number of microseconds
      * in the future. Coordinates are in metres.
      */
     Point estimatePositionAtFutureTime(
-        const std::chrono::milliseconds& milliseconds_in_future) const;
+        const std::chrono::microseconds& microseconds_in_future) const;
 
     /**
      * Returns the current velocity of the ball
@@ -88,16 +88,16 @@ class Ball final
      * Returns the estimated velocity of the ball at a future time, relative to when the
      * ball was last updated
      *
-     * @param milliseconds_in_future The relative amount of time in the future
-     * (in milliseconds) at which to predict the ball's velocity. Value must be >= 0.
-     * For example, a value of 1500 would return the estimated velocity of the ball
+     * @param microseconds_in_future The relative amount of time in the future
+     * (in microseconds) at which to predict the ball's velocity. Value must be >= 0.
+     * For example, a value of 1500000 would return the estimated velocity of the ball
      * 1.5 seconds in the future.
      *
-     * @return the estimated velocity of the ball at the given number of milliseconds
+     * @return the estimated velocity of the ball at the given number of microseconds
      * in the future. Coordinates are in metres.
      */
     Vector estimateVelocityAtFutureTime(
-        const std::chrono::milliseconds& milliseconds_in_future) const;
+        const std::chrono::microseconds& microseconds_in_future) const;
 
     /**
      * Defines the equality operator for a Ball. Balls are equal if their positions and
@@ -0,0 +1,245 @@
+#include "ai/world/ball_trajectory.h"
+
+#include <algorithm>
+#include <cmath>
+
+constexpr std::chrono::milliseconds BallTrajectory::SAMPLE_PERIOD;
+
+BallTrajectory::BallTrajectory(const Ball &ball)
+    : start_position(ball.position()),
+      direction(),
+      start_speed(0),
+      start_timestamp(ball.lastUpdateTimestamp()),
+      rolling_speed(0),
+      rolling_start_seconds(0),
+      rolling_start_distance(0),
+      stop_seconds(0),
+      stop_distance(0),
+      sample_x_positions(),
+      sample_y_positions(),
+      sample_speeds()
+{
+    sample_x_positions.reserve(MAX_NUM_SAMPLES);
+    sample_y_positions.reserve(MAX_NUM_SAMPLES);
+    sample_speeds.reserve(MAX_NUM_SAMPLES);
+
+    start_speed   = ball.velocity().len();
+    rolling_speed = start_speed;
+    if (start_speed > 0)
+    {
+        direction = ball.velocity() / start_speed;
+    }
+    build();
+}
+
+BallTrajectory::BallTrajectory(const BallTrajectory &other)
+    : start_position(other.start_position),
+      direction(other.direction),
+      start_speed(other.start_speed),
+      start_timestamp(other.start_timestamp),
+      rolling_speed(other.rolling_speed),
+      rolling_start_seconds(other.rolling_start_seconds),
+      rolling_start_distance(other.rolling_start_distance),
+      stop_seconds(other.stop_seconds),
+      stop_distance(other.stop_distance),
+      sample_x_positions(),
+      sample_y_positions(),
+      sample_speeds()
+{
+    sample_x_positions.reserve(MAX_NUM_SAMPLES);
+    sample_y_positions.reserve(MAX_NUM_SAMPLES);
+    sample_speeds.reserve(MAX_NUM_SAMPLES);
+    sample_x_positions = other.sample_x_positions;
+    sample_y_positions = other.sample_y_positions;
+    sample_speeds      = other.sample_speeds;
+}
+
+void BallTrajectory::update(const Ball &new_ball_data)
+{
+    auto microseconds_since_start = std::chrono::duration_cast<std::chrono::microseconds>(
+        new_ball_data.lastUpdateTimestamp() - start_timestamp);
+    double predicted_speed = estimateVelocityAtFutureTime(microseconds_since_start).len();
+
+    start_position  = new_ball_data.position();
+    start_speed     = new_ball_data.velocity().len();
+    start_timestamp = new_ball_data.lastUpdateTimestamp();
+    direction       = start_speed > 0 ? new_ball_data.velocity() / start_speed : Vector();
+
+    // Only a kick makes the ball faster than we predicted. The ball slides after a kick,
+    // and keeps sliding over later updates until it slows to its rolling speed
+    if (start_speed > predicted_speed + KICK_SPEED_INCREASE_METERS_PER_SECOND)
+    {
+        rolling_speed = start_speed * ROLLING_SPEED_RATIO;
+    }
+    rolling_speed = std::min(rolling_speed, start_speed);
+
+    build();
+}
+
+std::chrono::steady_clock::time_point BallTrajectory::getStartTimestamp() const
+{
+    return start_timestamp;
+}
+
+Point BallTrajectory::estimatePositionAtFutureTime(
+    const std::chrono::microseconds &microseconds_in_future) const
+{
+    typedef std::chrono::duration<double> double_seconds;
+    double seconds_in_future =
+        std::chrono::duration_cast<double_seconds>(microseconds_in_future).count();
+    return start_position + direction * getDistanceAtTime(seconds_in_future);
+}
+
+Vector BallTrajectory::estimateVelocityAtFutureTime(
+    const std::chrono::microseconds &microseconds_in_future) const
+{
+    typedef std::chrono::duration<double> double_seconds;
+    double seconds_in_future =
+        std::chrono::duration_cast<double_seconds>(microseconds_in_future).count();
+    return direction * getSpeedAtTime(seconds_in_future);
+}
+
+std::optional<std::chrono::microseconds> BallTrajectory::estimateTimeToTravelDistance(
+    double distance) const
+{
+    if (distance <= 0)
+    {
+        return std::chrono::microseconds(0);
+    }
+    if (distance > stop_distance)
+    {
+        return std::nullopt;
+    }
+
+    // Invert distance = speed * t - deceleration * t^2 / 2 for the phase the ball is in
+    // when it has travelled the distance, taking the earlier root
+    double seconds;
+    if (distance < rolling_start_distance)
+    {
+        double a = SLIDING_DECELERATION_METERS_PER_SECOND_SQUARED;
+        seconds =
+            (start_speed -
+             std::sqrt(std::max(0.0, start_speed * start_speed - 2 * a * distance))) /
+            a;
+    }
+    else
+    {
+        double a                = ROLLING_DECELERATION_METERS_PER_SECOND_SQUARED;
+        double rolling_distance = distance - rolling_start_distance;
+        seconds =
+            rolling_start_seconds +
+            (rolling_speed - std::sqrt(std::max(0.0, rolling_speed * rolling_speed -
+                                                         2 * a * rolling_distance))) /
+                a;
+    }
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::duration<double>(seconds));
+}
+
+std::chrono::microseconds BallTrajectory::getTimeUntilStopped() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::duration<double>(stop_seconds));
+}
+
+Point BallTrajectory::getRestingPosition() const
+{
+    return start_position + direction * stop_distance;
+}
+
+bool BallTrajectory::isSliding() const
+{
+    return start_speed > rolling_speed;
+}
+
+std::size_t BallTrajectory::getNumSamples() const
+{
+    return sample_speeds.size();
+}
+
+const std::vector<double> &BallTrajectory::getSampleXPositions() const
+{
+    return sample_x_positions;
+}
+
+const std::vector<double> &BallTrajectory::getSampleYPositions() const
+{
+    return sample_y_positions;
+}
+
+const std::vector<double> &BallTrajectory::getSampleSpeeds() const
+{
+    return sample_speeds;
+}
+
+double BallTrajectory::getDistanceAtTime(double seconds) const
+{
+    if (seconds <= 0)
+    {
+        return 0;
+    }
+    if (seconds >= stop_seconds)
+    {
+        return stop_distance;
+    }
+    if (seconds < rolling_start_seconds)
+    {
+        return start_speed * seconds -
+               0.5 * SLIDING_DECELERATION_METERS_PER_SECOND_SQUARED * seconds * seconds;
+    }
+
+    double rolling_seconds = seconds - rolling_start_seconds;
+    return rolling_start_distance + rolling_speed * rolling_seconds -
+           0.5 * ROLLING_DECELERATION_METERS_PER_SECOND_SQUARED * rolling_seconds *
+               rolling_seconds;
+}
+
+double BallTrajectory::getSpeedAtTime(double seconds) const
+{
+    if (seconds <= 0)
+    {
+        return start_speed;
+    }
+    if (seconds >= stop_seconds)
+    {
+        return 0;
+    }
+    if (seconds < rolling_start_seconds)
+    {
+        return start_speed - SLIDING_DECELERATION_METERS_PER_SECOND_SQUARED * seconds;
+    }
+
+    return rolling_speed - ROLLING_DECELERATION_METERS_PER_SECOND_SQUARED *
+                               (seconds - rolling_start_seconds);
+}
+
+void BallTrajectory::build()
+{
+    rolling_start_seconds =
+        (start_speed - rolling_speed) / SLIDING_DECELERATION_METERS_PER_SECOND_SQUARED;
+    rolling_start_distance = (start_speed + rolling_speed) / 2 * rolling_start_seconds;
+    stop_seconds           = rolling_start_seconds +
+                   rolling_speed / ROLLING_DECELERATION_METERS_PER_SECOND_SQUARED;
+    stop_distance = rolling_start_distance +
+                    rolling_speed / 2 * (stop_seconds - rolling_start_seconds);
+
+    typedef std::chrono::duration<double> double_seconds;
+    const double sample_period_seconds =
+        std::chrono::duration_cast<double_seconds>(SAMPLE_PERIOD).count();
+    std::size_t num_samples = std::min(
+        MAX_NUM_SAMPLES,
+        static_cast<std::size_t>(std::ceil(stop_seconds / sample_period_seconds)) + 1);
+
+    sample_x_positions.resize(num_samples);
+    sample_y_positions.resize(num_samples);
+    sample_speeds.resize(num_samples);
+    for (std::size_t i = 0; i < num_samples; i++)
+    {
+        double seconds        = static_cast<double>(i) * sample_period_seconds;
+        double distance       = getDistanceAtTime(seconds);
+        sample_x_positions[i] = start_position.x() + direction.x() * distance;
+        sample_y_positions[i] = start_position.y() + direction.y() * distance;
+        sample_speeds[i]      = getSpeedAtTime(seconds);
+    }
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "ai/world/ball.h"
+#include "geom/point.h"
+
+/**
+ * The path the ball will follow from its latest known state until it comes to rest,
+ * assuming nothing touches it.
+ *
+ * A kicked ball first slides along the carpet, decelerating quickly, until friction has
+ * it rolling without slipping at 5/7 of the speed it was kicked at. It then rolls,
+ * decelerating much more slowly, until it stops. Friction always acts against the
+ * ball's velocity, so the ball moves in a straight line. Bounces off the field walls
+ * and robots are not modelled.
+ *
+ * The trajectory is built once each time the ball is updated, and shared by everything
+ * that needs to know where the ball will be. Lookups by time or by distance along the
+ * path are closed form, so they take constant time. The trajectory is also sampled on a
+ * fixed time grid, with the positions stored as separate x and y arrays, for code that
+ * checks the whole trajectory at once.
+ */
+class BallTrajectory final
+{
+   public:
+    // How quickly a sliding ball slows down, in metres per second^2
+    static constexpr double SLIDING_DECELERATION_METERS_PER_SECOND_SQUARED = 3.6;
+    // How quickly a rolling ball slows down, in metres per second^2
+    static constexpr double ROLLING_DECELERATION_METERS_PER_SECOND_SQUARED = 0.35;
+    // A sliding ball starts rolling once it has slowed to this fraction of the speed it
+    // was kicked at. This is 5/7 for a solid sphere
+    static constexpr double ROLLING_SPEED_RATIO = 5.0 / 7.0;
+    // If the ball is this much faster than the trajectory predicted, it is assumed to
+    // have been kicked, and so to be sliding
+    static constexpr double KICK_SPEED_INCREASE_METERS_PER_SECOND = 0.5;
+
+    // The time between samples of the trajectory
+    static constexpr std::chrono::milliseconds SAMPLE_PERIOD{10};
+    // The most samples that are stored. Lookups past the last sample are still exact,
+    // they just aren't sampled
+    static constexpr std::size_t MAX_NUM_SAMPLES = 1000;
+
+    /**
+     * Creates the trajectory of the given ball. The ball is assumed to be rolling
+     *
+     * @param ball The ball to create the trajectory of
+     */
+    explicit BallTrajectory(const Ball& ball);
+
+    /**
+     * Copies the given trajectory. Every trajectory has room for MAX_NUM_SAMPLES
+     * samples, so assigning one trajectory to another never allocates memory
+     *
+     * @param other The trajectory to copy
+     */
+    BallTrajectory(const BallTrajectory& other);
+    BallTrajectory& operator=(const BallTrajectory& other) = default;
+
+    /**
+     * Rebuilds the trajectory from the new state of the ball. If the ball is moving
+     * faster than the old trajectory predicted, it is assumed to have just been kicked
+     * and to be sliding. The samples are rebuilt in place, so this does not allocate
+     * memory once the trajectory has been built once.
+     *
+     * @param new_ball_data The latest state of the ball. Its timestamp must be >= the
+     * start of this trajectory
+     */
+    void update(const Ball& new_ball_data);
+
+    /**
+     * Returns the time the trajectory starts at, which is the timestamp of the ball it
+     * was built from. Times in the future are relative to this time
+     *
+     * @return the time the trajectory starts at
+     */
+    std::chrono::steady_clock::time_point getStartTimestamp() const;
+
+    /**
+     * Returns the estimated position of the ball at a future time, relative to the
+     * start of the trajectory
+     *
+     * @param microseconds_in_future The relative amount of time in the future
+     * (in microseconds) at which to predict the ball's position. Value must be >= 0.
+     *
+     * @return the estimated position of the ball at the given number of microseconds in
+     * the future. Coordinates are in metres.
+     */
+    Point estimatePositionAtFutureTime(
+        const std::chrono::microseconds& microseconds_in_future) const;
+
+    /**
+     * Returns the estimated velocity of the ball at a future time, relative to the
+     * start of the trajectory
+     *
+     * @param microseconds_in_future The relative amount of time in the future
+     * (in microseconds) at which to predict the ball's velocity. Value must be >= 0.
+     *
+     * @return the estimated velocity of the ball at the given number of microseconds in
+     * the future, in metres per second
+     */
+    Vector estimateVelocityAtFutureTime(
+        const std::chrono::microseconds& microseconds_in_future) const;
+
+    /**
+     * Returns how long after the start of the trajectory the ball will have travelled
+     * the given distance along its path
+     *
+     * @param distance The distance along the path, in metres
+     *
+     * @return how long after the start of the trajectory the ball will have travelled
+     * the given distance, or std::nullopt if the ball stops before then
+     */
+    std::optional<std::chrono::microseconds> estimateTimeToTravelDistance(
+        double distance) const;
+
+    /**
+     * Returns how long after the start of the trajectory the ball stops
+     *
+     * @return how long after the start of the trajectory the ball stops
+     */
+    std::chrono::microseconds getTimeUntilStopped() const;
+
+    /**
+     * Returns where the ball stops
+     *
+     * @return where the ball stops. Coordinates are in metres
+     */
+    Point getRestingPosition() const;
+
+    /**
+     * Returns whether the ball is sliding at the start of the trajectory
+     *
+     * @return true if the ball is sliding at the start of the trajectory, and false if
+     * it is rolling or not moving
+     */
+    bool isSliding() const;
+
+    /**
+     * Returns the number of samples of the trajectory. Sample i is at
+     * i * SAMPLE_PERIOD after the start of the trajectory. The samples stop at the first
+     * one after the ball stops, or at MAX_NUM_SAMPLES
+     *
+     * @return the number of samples of the trajectory
+     */
+    std::size_t getNumSamples() const;
+
+    /**
+     * Returns the x coordinates of the sampled positions of the ball, in metres
+     *
+     * @return the x coordinates of the sampled positions of the ball
+     */
+    const std::vector<double>& getSampleXPositions() const;
+
+    /**
+     * Returns the y coordinates of the sampled positions of the ball, in metres
+     *
+     * @return the y coordinates of the sampled positions of the ball
+     */
+    const std::vector<double>& getSampleYPositions() const;
+
+    /**
+     * Returns the sampled speeds of the ball, in metres per second. The ball always
+     * moves in the same direction, so these are the lengths of the sampled velocities
+     *
+     * @return the sampled speeds of the ball
+     */
+    const std::vector<double>& getSampleSpeeds() const;
+
+   private:
+    /**
+     * Returns how far along its path the ball has travelled at the given time
+     *
+     * @param seconds The time since the start of the trajectory, in seconds
+     *
+     * @return how far along its path the ball has travelled, in metres
+     */
+    double getDistanceAtTime(double seconds) const;
+
+    /**
+     * Returns the speed of the ball at the given time
+     *
+     * @param seconds The time since the start of the trajectory, in seconds
+     *
+     * @return the speed of the ball, in metres per second
+     */
+    double getSpeedAtTime(double seconds) const;
+
+    /**
+     * Calculates the phases of the trajectory and samples it, from the start state
+     */
+    void build();
+
+    Point start_position;
+    // The direction the ball moves in, which is a unit vector unless the ball isn't
+    // moving
+    Vector direction;
+    double start_speed;
+    std::chrono::steady_clock::time_point start_timestamp;
+
+    // The ball slides until it slows to this speed, and then rolls
+    double rolling_speed;
+    // The times after the start of the trajectory that the ball starts rolling and
+    // stops, and how far it has travelled at those times
+    double rolling_start_seconds;
+    double rolling_start_distance;
+    double stop_seconds;
+    double stop_distance;
+
+    std::vector<double> sample_x_positions;
+    std::vector<double> sample_y_positions;
+    std::vector<double> sample_speeds;
+};
@@ -1,11 +1,17 @@
 #include "robot.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "shared/constants.h"
+
 Robot::Robot(unsigned int id, const Point &position, const Vector &velocity,
              const Angle &orientation, const AngularVelocity &angular_velocity,
-             std::chrono::steady_clock::time_point timestamp)
+             std::chrono::steady_clock::time_point timestamp, const Vector &acceleration)
     : id_(id),
       position_(position),
       velocity_(velocity),
+      acceleration_(acceleration),
       orientation_(orientation),
       angularVelocity_(angular_velocity),
       last_update_timestamp(timestamp)
@@ -25,6 +31,26 @@ void Robot::updateState(const Point &new_position, const Vector &new_velocity,
         exit(1);
     }
 
+    typedef std::chrono::duration<double> double_seconds;
+    double seconds_since_last_update =
+        std::chrono::duration_cast<double_seconds>(timestamp - last_update_timestamp)
+            .count();
+    if (seconds_since_last_update > 0)
+    {
+        // The robot can't accelerate faster than its motors allow, so anything larger
+        // than that is noise
+        Vector measured_acceleration =
+            (new_velocity - velocity_) / seconds_since_last_update;
+        if (measured_acceleration.len() >
+            ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED)
+        {
+            measured_acceleration = measured_acceleration.norm(
+                ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED);
+        }
+        acceleration_ = acceleration_ * (1 - ACCELERATION_SMOOTHING_FACTOR) +
+                        measured_acceleration * ACCELERATION_SMOOTHING_FACTOR;
+    }
+
     position_             = new_position;
     velocity_             = new_velocity;
     orientation_          = new_orientation;
@@ -59,16 +85,32 @@ void Robot::updateStateToPredictedState(std::chrono::steady_clock::time_point ti
         exit(1);
     }
 
-    auto milliseconds_in_future = std::chrono::duration_cast<std::chrono::milliseconds>(
+    auto microseconds_in_future = std::chrono::duration_cast<std::chrono::microseconds>(
         timestamp - last_update_timestamp);
-    Point new_position    = estimatePositionAtFutureTime(milliseconds_in_future);
-    Vector new_velocity   = estimateVelocityAtFutureTime(milliseconds_in_future);
-    Angle new_orientation = estimateOrientationAtFutureTime(milliseconds_in_future);
+    typedef std::chrono::duration<double> double_seconds;
+    double seconds_in_future =
+        std::chrono::duration_cast<double_seconds>(microseconds_in_future).count();
+    // A robot that finishes braking before then stays stopped, rather than speeding up
+    // again the other way from its new state
+    bool stops_braking = velocity_.dot(acceleration_) < 0 &&
+                         getSecondsAccelerating(seconds_in_future) < seconds_in_future;
+    Point new_position    = estimatePositionAtFutureTime(microseconds_in_future);
+    Vector new_velocity   = estimateVelocityAtFutureTime(microseconds_in_future);
+    Angle new_orientation = estimateOrientationAtFutureTime(microseconds_in_future);
     AngularVelocity new_angular_velocity =
-        estimateAngularVelocityAtFutureTime(milliseconds_in_future);
+        estimateAngularVelocityAtFutureTime(microseconds_in_future);
 
-    updateState(new_position, new_velocity, new_orientation, new_angular_velocity,
-                timestamp);
+    // The predicted velocity follows from the acceleration, so the acceleration isn't
+    // re-estimated from it
+    if (stops_braking)
+    {
+        acceleration_ = Vector();
+    }
+    position_             = new_position;
+    velocity_             = new_velocity;
+    orientation_          = new_orientation;
+    angularVelocity_      = new_angular_velocity;
+    last_update_timestamp = timestamp;
 }
 
 std::chrono::steady_clock::time_point Robot::lastUpdateTimestamp() const
@@ -87,22 +129,25 @@ Point Robot::position() const
 }
 
 Point Robot::estimatePositionAtFutureTime(
-    const std::chrono::milliseconds &milliseconds_in_future) const
+    const std::chrono::microseconds &microseconds_in_future) const
 {
-    if (milliseconds_in_future < std::chrono::milliseconds(0))
+    if (microseconds_in_future < std::chrono::microseconds(0))
     {
         // TODO: Error. We should never be updating with times from the past
         // TODO: Throw a proper exception here
         // https://github.com/UBC-Thunderbots/Software/issues/16
     }
 
-    // TODO: This is a simple linear implementation that does not necessarily reflect
-    // real-world behavior. Position prediction should be improved as outlined in
-    // https://github.com/UBC-Thunderbots/Software/issues/50
+    // The robot keeps accelerating until it reaches its maximum speed, or stops if it
+    // is braking, and then keeps moving at that velocity
     typedef std::chrono::duration<double> double_seconds;
     double seconds_in_future =
-        std::chrono::duration_cast<double_seconds>(milliseconds_in_future).count();
-    return position_ + velocity_.norm(velocity_.len() * seconds_in_future);
+        std::chrono::duration_cast<double_seconds>(microseconds_in_future).count();
+    double seconds_accelerating = getSecondsAccelerating(seconds_in_future);
+    Vector final_velocity       = velocity_ + acceleration_ * seconds_accelerating;
+    return position_ + velocity_ * seconds_accelerating +
+           acceleration_ * (0.5 * seconds_accelerating * seconds_accelerating) +
+           final_velocity * (seconds_in_future - seconds_accelerating);
 }
 
 Vector Robot::velocity() const
@@ -111,19 +156,24 @@ Vector Robot::velocity() const
 }
 
 Vector Robot::estimateVelocityAtFutureTime(
-    const std::chrono::milliseconds &milliseconds_in_future) const
+    const std::chrono::microseconds &microseconds_in_future) const
 {
-    if (milliseconds_in_future < std::chrono::milliseconds(0))
+    if (microseconds_in_future < std::chrono::microseconds(0))
     {
         // TODO: Error. We should never be updating with times from the past
         // TODO: Throw a proper exception here
         // https://github.com/UBC-Thunderbots/Software/issues/16
     }
 
-    // TODO: This simple implementation that assumes the robot maintains the same velocity
-    // and does not necessarily reflect real-world behavior. Velocity prediction should be
-    // improved as outlined in https://github.com/UBC-Thunderbots/Software/issues/50
-    return velocity_;
+    typedef std::chrono::duration<double> double_seconds;
+    double seconds_in_future =
+        std::chrono::duration_cast<double_seconds>(microseconds_in_future).count();
+    return velocity_ + acceleration_ * getSecondsAccelerating(seconds_in_future);
+}
+
+Vector Robot::acceleration() const
+{
+    return acceleration_;
 }
 
 Angle Robot::orientation() const
@@ -132,9 +182,9 @@ Angle Robot::orientation() const
 }
 
 Angle Robot::estimateOrientationAtFutureTime(
-    const std::chrono::milliseconds &milliseconds_in_future) const
+    const std::chrono::microseconds &microseconds_in_future) const
 {
-    if (milliseconds_in_future < std::chrono::milliseconds(0))
+    if (microseconds_in_future < std::chrono::microseconds(0))
     {
         // TODO: Error. We should never be updating with times from the past
         // TODO: Throw a proper exception here
@@ -146,7 +196,7 @@ Angle Robot::estimateOrientationAtFutureTime(
     // https://github.com/UBC-Thunderbots/Software/issues/50
     typedef std::chrono::duration<double> double_seconds;
     double seconds_in_future =
-        std::chrono::duration_cast<double_seconds>(milliseconds_in_future).count();
+        std::chrono::duration_cast<double_seconds>(microseconds_in_future).count();
     return orientation_ + angularVelocity_ * seconds_in_future;
 }
 
@@ -156,9 +206,9 @@ AngularVelocity Robot::angularVelocity() const
 }
 
 AngularVelocity Robot::estimateAngularVelocityAtFutureTime(
-    const std::chrono::milliseconds &milliseconds_in_future) const
+    const std::chrono::microseconds &microseconds_in_future) const
 {
-    if (milliseconds_in_future < std::chrono::milliseconds(0))
+    if (microseconds_in_future < std::chrono::microseconds(0))
     {
         // TODO: Error. We should never be updating with times from the past
         // TODO: Throw a proper exception here
@@ -172,6 +222,36 @@ AngularVelocity Robot::estimateAngularVelocityAtFutureTime(
     return angularVelocity_;
 }
 
+double Robot::getSecondsAccelerating(double seconds_in_future) const
+{
+    double acceleration_squared = acceleration_.lensq();
+    if (seconds_in_future <= 0 || acceleration_squared == 0)
+    {
+        return std::max(0.0, seconds_in_future);
+    }
+
+    // A robot accelerating against its velocity is braking, and only brakes until its
+    // velocity along the acceleration reaches zero. It slows down the whole time, so it
+    // never reaches its speed limit. Braking in a straight line leaves it stopped,
+    // rather than speeding up again the other way
+    double b = velocity_.dot(acceleration_);
+    if (b < 0)
+    {
+        return std::min(seconds_in_future, -b / acceleration_squared);
+    }
+
+    // Solve |velocity + acceleration * t| = speed_limit for the positive t. The robot
+    // may already be faster than its maximum speed if its velocity is noisy, in which
+    // case it is not allowed to get any faster
+    double speed_limit = std::max(ROBOT_MAX_SPEED_METERS_PER_SECOND, velocity_.len());
+    double c           = velocity_.lensq() - speed_limit * speed_limit;
+    double seconds_to_speed_limit =
+        (-b + std::sqrt(std::max(0.0, b * b - acceleration_squared * c))) /
+        acceleration_squared;
+
+    return std::min(seconds_in_future, seconds_to_speed_limit);
+}
+
 bool Robot::operator==(const Robot &other) const
 {
     return this->id_ == other.id_ && this->position_ == other.position_ &&
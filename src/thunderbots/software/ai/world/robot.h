@@ -22,13 +22,17 @@ class Robot
      * per second
      * @param timestamp The timestamp at which the robot was observed to be in the given
      * state. The timestamp must be >= the robot's latest update timestamp
+     * @param acceleration the acceleration of the robot, in metres / second^2. This is
+     * normally estimated from the velocities the robot is updated with
      */
     explicit Robot(unsigned int id, const Point& position, const Vector& velocity,
                    const Angle& orientation, const AngularVelocity& angular_velocity,
-                   std::chrono::steady_clock::time_point timestamp);
+                   std::chrono::steady_clock::time_point timestamp,
+                   const Vector& acceleration = Vector());
 
     /**
-     * Updates the state of the robot.
+     * Updates the state of the robot. The robot's acceleration is estimated from how
+     * much its velocity has changed since it was last updated.
      *
      * @param new_position the new position of the robot. Coordinates are in metres.
      * @param new_velocity the new velocity of the robot, in metres / second.
@@ -85,16 +89,16 @@ class Robot
      * Returns the estimated position of the robot at a future time, relative to when
      * the robot was last updated
      *
-     * @param milliseconds_in_future The relative amount of time in the future
-     * (in milliseconds) at which to predict the robot's position. Value must be >= 0.
-     * For example, a value of 1500 would return the estimated position of the robot
+     * @param microseconds_in_future The relative amount of time in the future
+     * (in microseconds) at which to predict the robot's position. Value must be >= 0.
+     * For example, a value of 1500000 would return the estimated position of the robot
      * 1.5 seconds in the future.
      *
-     * @return the estimated position of the robot at the given number of milliseconds
+     * @return the estimated position of the robot at the given number of microseconds
      * in the future. Coordinates are in metres.
      */
     Point estimatePositionAtFutureTime(
-        const std::chrono::milliseconds& milliseconds_in_future) const;
+        const std::chrono::microseconds& microseconds_in_future) const;
 
     /**
      * Returns the current velocity of the robot
@@ -107,16 +111,24 @@ class Robot
      * Returns the estimated velocity of the robot at a future time, relative to when
      * the robot was last updated
      *
-     * @param milliseconds_in_future The relative amount of time in the future
-     * (in milliseconds) at which to predict the robot's velocity. Value must be >= 0.
-     * For example, a value of 1500 would return the estimated velocity of the robot
+     * @param microseconds_in_future The relative amount of time in the future
+     * (in microseconds) at which to predict the robot's velocity. Value must be >= 0.
+     * For example, a value of 1500000 would return the estimated velocity of the robot
      * 1.5 seconds in the future.
      *
-     * @return the estimated velocity of the robot at the given number of milliseconds
+     * @return the estimated velocity of the robot at the given number of microseconds
      * in the future, in metres per second
      */
     Vector estimateVelocityAtFutureTime(
-        const std::chrono::milliseconds& milliseconds_in_future) const;
+        const std::chrono::microseconds& microseconds_in_future) const;
+
+    /**
+     * Returns the current acceleration of the robot, as estimated from the changes in
+     * its velocity
+     *
+     * @return the current acceleration of the robot, in metres per second^2
+     */
+    Vector acceleration() const;
 
     /**
      * Returns the current orientation of the robot
@@ -129,16 +141,16 @@ class Robot
      * Returns the estimated orientation of the robot at a future time, relative to when
      * the robot was last updated
      *
-     * @param milliseconds_in_future The relative amount of time in the future
-     * (in milliseconds) at which to predict the robot's orientation. Value must be >= 0.
-     * For example, a value of 1500 would return the estimated orientation of the robot
+     * @param microseconds_in_future The relative amount of time in the future
+     * (in microseconds) at which to predict the robot's orientation. Value must be >= 0.
+     * For example, a value of 1500000 would return the estimated orientation of the robot
      * 1.5 seconds in the future.
      *
-     * @return the estimated orientation of the robot at the given number of milliseconds
+     * @return the estimated orientation of the robot at the given number of microseconds
      * in the future. Coordinates are in metres.
      */
     Angle estimateOrientationAtFutureTime(
-        const std::chrono::milliseconds& milliseconds_in_future) const;
+        const std::chrono::microseconds& microseconds_in_future) const;
 
     /**
      * Returns the current angular velocity of the robot
@@ -152,21 +164,21 @@ class Robot
      * when
      * the robot was last updated
      *
-     * @param milliseconds_in_future The relative amount of time in the future
-     * (in milliseconds) at which to predict the robot's angular velocity. Value must be
-     * >= 0. For example, a value of 1500 would return the estimated angular velocity of
-     * the robot 1.5 seconds in the future.
+     * @param microseconds_in_future The relative amount of time in the future
+     * (in microseconds) at which to predict the robot's angular velocity. Value must be
+     * >= 0. For example, a value of 1500000 would return the estimated angular velocity
+     * of the robot 1.5 seconds in the future.
      *
      * @return the estimated angular velocity of the robot at the given number of
-     * milliseconds in the future. Coordinates are in metres. Coordinates are in metres.
+     * microseconds in the future. Coordinates are in metres. Coordinates are in metres.
      */
     AngularVelocity estimateAngularVelocityAtFutureTime(
-        const std::chrono::milliseconds& milliseconds_in_future) const;
+        const std::chrono::microseconds& microseconds_in_future) const;
 
     /**
      * Defines the equality operator for a Robot. Robots are equal if their IDs and
      * all other parameters (position, orientation, etc) are equal. The last update
-     * timestamp is not part of the equality.
+     * timestamp and the estimated acceleration are not part of the equality.
      *
      * @param other The robot to compare against for equality
      * @return True if the other robot is equal to this robot, and false otherwise
@@ -182,12 +194,30 @@ class Robot
     bool operator!=(const Robot& other) const;
 
    private:
+    // How much of each new estimate of the robot's acceleration is used. The
+    // acceleration is estimated from the difference between noisy velocities, so it is
+    // smoothed over a few updates
+    static constexpr double ACCELERATION_SMOOTHING_FACTOR = 0.3;
+
+    /**
+     * Returns how long the robot keeps accelerating for over the given amount of time.
+     * The robot stops accelerating once it reaches its maximum speed, or once it stops
+     * if the acceleration is against its velocity
+     *
+     * @param seconds_in_future The amount of time in the future, in seconds
+     *
+     * @return how many of the given seconds the robot spends accelerating
+     */
+    double getSecondsAccelerating(double seconds_in_future) const;
+
     // The id of this robot
     const unsigned int id_;
     // The current position of the robot, with coordinates in metres
     Point position_;
     // The current velocity of the robot, in metres per second
     Vector velocity_;
+    // The current acceleration of the robot, in metres per second^2
+    Vector acceleration_;
     // The current orientation of the robot, in radians
     Angle orientation_;
     // The current angular velocity of the robot, in radians per second
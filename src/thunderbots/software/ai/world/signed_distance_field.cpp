@@ -0,0 +1,119 @@
+#include "ai/world/signed_distance_field.h"
+
+#include <algorithm>
+#include <cmath>
+
+SignedDistanceField::SignedDistanceField(const Field &field)
+    : min_x(0), min_y(0), max_x(0), max_y(0), num_columns(1), num_rows(1), samples()
+{
+    updateFieldGeometry(field);
+}
+
+void SignedDistanceField::updateFieldGeometry(const Field &field)
+{
+    min_x = -field.totalLength() / 2;
+    min_y = -field.totalWidth() / 2;
+    max_x = field.totalLength() / 2;
+    max_y = field.totalWidth() / 2;
+
+    // Put a sample on every edge of the field, with the last column and row a little
+    // past it if the field isn't a whole number of samples across
+    num_columns = std::max(
+        2, static_cast<int32_t>(std::ceil(field.totalLength() / RESOLUTION_METERS)) + 1);
+    num_rows = std::max(
+        2, static_cast<int32_t>(std::ceil(field.totalWidth() / RESOLUTION_METERS)) + 1);
+    samples.resize(num_columns * num_rows);
+    for (int32_t row = 0; row < num_rows; row++)
+    {
+        for (int32_t column = 0; column < num_columns; column++)
+        {
+            samples[row * num_columns + column] =
+                calculateClearance(field, Point(min_x + column * RESOLUTION_METERS,
+                                                min_y + row * RESOLUTION_METERS));
+        }
+    }
+}
+
+double SignedDistanceField::getClearance(const Point &point) const
+{
+    // Off the field, we are outside the edge by however far we are from it
+    const Point clamped_point = clampToField(point);
+    int32_t column, row;
+    double x_fraction, y_fraction;
+    findCell(clamped_point, column, row, x_fraction, y_fraction);
+
+    const double bottom = getSample(column, row) * (1 - x_fraction) +
+                          getSample(column + 1, row) * x_fraction;
+    const double top = getSample(column, row + 1) * (1 - x_fraction) +
+                       getSample(column + 1, row + 1) * x_fraction;
+    return bottom * (1 - y_fraction) + top * y_fraction - (point - clamped_point).len();
+}
+
+Vector SignedDistanceField::getGradient(const Point &point) const
+{
+    const Point clamped_point = clampToField(point);
+    if (clamped_point != point)
+    {
+        // Off the field, the fastest way out is straight back towards it
+        return (clamped_point - point).norm();
+    }
+
+    int32_t column, row;
+    double x_fraction, y_fraction;
+    findCell(point, column, row, x_fraction, y_fraction);
+
+    const double bottom_left  = getSample(column, row);
+    const double bottom_right = getSample(column + 1, row);
+    const double top_left     = getSample(column, row + 1);
+    const double top_right    = getSample(column + 1, row + 1);
+    return Vector((bottom_right - bottom_left) * (1 - y_fraction) +
+                      (top_right - top_left) * y_fraction,
+                  (top_left - bottom_left) * (1 - x_fraction) +
+                      (top_right - bottom_right) * x_fraction) /
+           RESOLUTION_METERS;
+}
+
+double SignedDistanceField::calculateClearance(const Field &field, const Point &point)
+{
+    // Being inside the field is the same as being outside the obstacle around it
+    const Rect whole_field(Point(-field.totalLength() / 2, -field.totalWidth() / 2),
+                           Point(field.totalLength() / 2, field.totalWidth() / 2));
+    return std::min({-signedDistanceToRect(whole_field, point),
+                     signedDistanceToRect(field.friendlyDefenseArea(), point),
+                     signedDistanceToRect(field.enemyDefenseArea(), point)});
+}
+
+double SignedDistanceField::signedDistanceToRect(const Rect &rect, const Point &point)
+{
+    // How far outside each pair of edges the point is, which is negative if it is
+    // between them
+    const Point min_corner = rect.swCorner();
+    const Point max_corner = rect.neCorner();
+    const double dx = std::max(min_corner.x() - point.x(), point.x() - max_corner.x());
+    const double dy = std::max(min_corner.y() - point.y(), point.y() - max_corner.y());
+    const double outside_distance = std::hypot(std::max(dx, 0.0), std::max(dy, 0.0));
+    const double inside_distance  = std::min(std::max(dx, dy), 0.0);
+    return outside_distance + inside_distance;
+}
+
+void SignedDistanceField::findCell(const Point &point, int32_t &column, int32_t &row,
+                                   double &x_fraction, double &y_fraction) const
+{
+    const double x = (point.x() - min_x) / RESOLUTION_METERS;
+    const double y = (point.y() - min_y) / RESOLUTION_METERS;
+    column         = std::clamp(static_cast<int32_t>(x), 0, num_columns - 2);
+    row            = std::clamp(static_cast<int32_t>(y), 0, num_rows - 2);
+    x_fraction     = x - column;
+    y_fraction     = y - row;
+}
+
+Point SignedDistanceField::clampToField(const Point &point) const
+{
+    return Point(std::clamp(point.x(), min_x, max_x),
+                 std::clamp(point.y(), min_y, max_y));
+}
+
+double SignedDistanceField::getSample(int32_t column, int32_t row) const
+{
+    return samples[row * num_columns + column];
+}
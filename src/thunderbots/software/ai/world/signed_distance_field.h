@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ai/world/field.h"
+#include "geom/point.h"
+#include "geom/rect.h"
+
+/**
+ * A precomputed map of how far every point on the field is from the static obstacles on
+ * it: both defense areas, and the edge of the field including its boundary area.
+ *
+ * The signed distance to the nearest obstacle is sampled on a uniform grid of points
+ * covering the whole field, and lookups interpolate bilinearly between the four samples
+ * around a point, so they take the same short time no matter how many obstacles there
+ * are. Distances are positive outside every obstacle (the clearance), and negative
+ * inside one (how deep the point is). The field geometry rarely changes, so the grid is
+ * only rebuilt when it does, and only moving obstacles like robots need to be checked
+ * exactly.
+ */
+class SignedDistanceField final
+{
+   public:
+    // The distance between neighbouring samples, in metres. Lookups are exact along
+    // straight obstacle edges, and off by at most this much near corners
+    static constexpr double RESOLUTION_METERS = 0.05;
+
+    /**
+     * Creates a new SignedDistanceField covering the given field
+     *
+     * @param field The field whose obstacles are sampled
+     */
+    explicit SignedDistanceField(const Field& field);
+
+    /**
+     * Samples the obstacles of the given field, resizing the grid to cover it
+     *
+     * @param field The field whose obstacles are sampled
+     */
+    void updateFieldGeometry(const Field& field);
+
+    /**
+     * Returns the signed distance from the given point to the nearest static obstacle.
+     * Points off the edge of the field get the distance to the nearest point on the
+     * edge, as a negative number
+     *
+     * @param point The point
+     *
+     * @return how far the point is outside every obstacle, or the negative of how far it
+     * is inside one
+     */
+    double getClearance(const Point& point) const;
+
+    /**
+     * Returns the gradient of the signed distance at the given point, which points in
+     * the direction that moves away from the nearest obstacle fastest. Its length is
+     * about 1 everywhere except near the middle of an obstacle, or halfway between two
+     * of them
+     *
+     * @param point The point
+     *
+     * @return the gradient of the signed distance at the point
+     */
+    Vector getGradient(const Point& point) const;
+
+    /**
+     * Returns the signed distance from the given point to the nearest static obstacle,
+     * calculated exactly from the field geometry instead of looked up. This is what the
+     * grid is sampled from
+     *
+     * @param field The field whose obstacles to use
+     * @param point The point
+     *
+     * @return how far the point is outside every obstacle, or the negative of how far it
+     * is inside one
+     */
+    static double calculateClearance(const Field& field, const Point& point);
+
+   private:
+    /**
+     * Returns the signed distance from a point to an axis-aligned rectangle, which is
+     * positive outside it and negative inside it
+     */
+    static double signedDistanceToRect(const Rect& rect, const Point& point);
+
+    /**
+     * Finds the grid cell containing the given point, which must be on the field, and
+     * where the point is within the cell
+     *
+     * @param point The point
+     * @param column, row Set to the column and row of the bottom left sample of the cell
+     * @param x_fraction, y_fraction Set to how far across the cell the point is, from 0
+     * to 1
+     */
+    void findCell(const Point& point, int32_t& column, int32_t& row, double& x_fraction,
+                  double& y_fraction) const;
+
+    /**
+     * Returns the point on the field closest to the given point
+     */
+    Point clampToField(const Point& point) const;
+
+    double getSample(int32_t column, int32_t row) const;
+
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+    int32_t num_columns;
+    int32_t num_rows;
+    // The signed distance at each sample, indexed by row * num_columns + column
+    std::vector<double> samples;
+};
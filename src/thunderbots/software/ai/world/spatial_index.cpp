@@ -0,0 +1,379 @@
+#include "ai/world/spatial_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "geom/util.h"
+
+SpatialQueryResult::SpatialQueryResult() : objects(), num_objects(0) {}
+
+const SpatialObject *SpatialQueryResult::begin() const
+{
+    return objects.data();
+}
+
+const SpatialObject *SpatialQueryResult::end() const
+{
+    return objects.data() + num_objects;
+}
+
+std::size_t SpatialQueryResult::size() const
+{
+    return num_objects;
+}
+
+bool SpatialQueryResult::empty() const
+{
+    return num_objects == 0;
+}
+
+const SpatialObject &SpatialQueryResult::operator[](std::size_t index) const
+{
+    return objects[index];
+}
+
+template <typename Visitor>
+bool SpatialIndex::visitCells(int32_t first_column, int32_t last_column,
+                              int32_t first_row, int32_t last_row, unsigned int filter,
+                              Visitor visit) const
+{
+    first_column = std::max(first_column, 0);
+    last_column  = std::min(last_column, num_columns - 1);
+    first_row    = std::max(first_row, 0);
+    last_row     = std::min(last_row, num_rows - 1);
+    for (int32_t row = first_row; row <= last_row; row++)
+    {
+        for (int32_t column = first_column; column <= last_column; column++)
+        {
+            for (int32_t index = cell_first_objects[row * num_columns + column];
+                 index != NO_OBJECT; index = next_objects_in_cell[index])
+            {
+                if ((getType(index) & filter) && !visit(index))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+template <typename Visitor>
+void SpatialIndex::visitNearSegment(const Seg &segment, double radius,
+                                    unsigned int filter, Visitor visit) const
+{
+    const double radius_squared = radius * radius;
+    const double dx             = segment.end.x() - segment.start.x();
+    const double dy             = segment.end.y() - segment.start.y();
+    const int32_t first_column =
+        getColumn(std::min(segment.start.x(), segment.end.x()) - radius);
+    const int32_t last_column =
+        getColumn(std::max(segment.start.x(), segment.end.x()) + radius);
+
+    // Sweep the columns the segment passes near, only checking the rows it passes near
+    // in each column
+    for (int32_t column = first_column; column <= last_column; column++)
+    {
+        // The cells on the edges of the grid hold everything past them too
+        const double column_min_x = column == 0
+                                        ? -std::numeric_limits<double>::infinity()
+                                        : min_x + column * CELL_SIZE_METERS - radius;
+        const double column_max_x =
+            column == num_columns - 1 ? std::numeric_limits<double>::infinity()
+                                      : min_x + (column + 1) * CELL_SIZE_METERS + radius;
+
+        // The part of the segment near enough to this column for objects in it to be
+        // within the radius of the segment
+        double first_t = 0;
+        double last_t  = 1;
+        if (dx != 0)
+        {
+            double t_at_min = (column_min_x - segment.start.x()) / dx;
+            double t_at_max = (column_max_x - segment.start.x()) / dx;
+            first_t         = std::max(first_t, std::min(t_at_min, t_at_max));
+            last_t          = std::min(last_t, std::max(t_at_min, t_at_max));
+        }
+        else if (segment.start.x() < column_min_x || segment.start.x() > column_max_x)
+        {
+            continue;
+        }
+        if (first_t > last_t)
+        {
+            continue;
+        }
+
+        const double first_y     = segment.start.y() + dy * first_t;
+        const double last_y      = segment.start.y() + dy * last_t;
+        const bool keep_visiting = visitCells(
+            column, column, getRow(std::min(first_y, last_y) - radius),
+            getRow(std::max(first_y, last_y) + radius), filter, [&](unsigned int index) {
+                Point position(object_x_positions[index], object_y_positions[index]);
+                if (distsq(position, segment) <= radius_squared)
+                {
+                    return visit(index);
+                }
+                return true;
+            });
+        if (!keep_visiting)
+        {
+            return;
+        }
+    }
+}
+
+SpatialIndex::SpatialIndex(const Field &field)
+    : min_x(0),
+      min_y(0),
+      num_columns(1),
+      num_rows(1),
+      cell_first_objects(),
+      object_x_positions(),
+      object_y_positions(),
+      object_cells(),
+      next_objects_in_cell(),
+      previous_objects_in_cell()
+{
+    object_cells.fill(NO_CELL);
+    next_objects_in_cell.fill(NO_OBJECT);
+    previous_objects_in_cell.fill(NO_OBJECT);
+    updateFieldGeometry(field);
+}
+
+void SpatialIndex::updateFieldGeometry(const Field &field)
+{
+    min_x       = -field.totalLength() / 2;
+    min_y       = -field.totalWidth() / 2;
+    num_columns = std::max(
+        1, static_cast<int32_t>(std::ceil(field.totalLength() / CELL_SIZE_METERS)));
+    num_rows = std::max(
+        1, static_cast<int32_t>(std::ceil(field.totalWidth() / CELL_SIZE_METERS)));
+    cell_first_objects.assign(num_columns * num_rows, NO_OBJECT);
+
+    // Every object's cell may have changed, so put them all back in
+    for (unsigned int i = 0; i < MAX_NUM_OBJECTS; i++)
+    {
+        if (object_cells[i] != NO_CELL)
+        {
+            object_cells[i] = NO_CELL;
+            setPosition(i, Point(object_x_positions[i], object_y_positions[i]));
+        }
+    }
+}
+
+void SpatialIndex::updateBall(const Ball &ball)
+{
+    setPosition(BALL_INDEX, ball.position());
+}
+
+void SpatialIndex::updateFriendlyTeam(const Team &friendly_team)
+{
+    updateTeam(friendly_team, 0);
+}
+
+void SpatialIndex::updateEnemyTeam(const Team &enemy_team)
+{
+    updateTeam(enemy_team, Team::MAX_ROBOT_IDS);
+}
+
+SpatialQueryResult SpatialIndex::findKNearest(const Point &point, std::size_t k,
+                                              unsigned int filter) const
+{
+    SpatialQueryResult result;
+    k = std::min<std::size_t>(k, MAX_NUM_OBJECTS);
+    if (k == 0)
+    {
+        return result;
+    }
+
+    // The squared distances of the objects in the result, which is kept sorted
+    std::array<double, MAX_NUM_OBJECTS> distances_squared;
+    auto add_candidate = [&](unsigned int index) {
+        double dx               = object_x_positions[index] - point.x();
+        double dy               = object_y_positions[index] - point.y();
+        double distance_squared = dx * dx + dy * dy;
+        if (result.num_objects == k &&
+            distance_squared >= distances_squared[result.num_objects - 1])
+        {
+            return true;
+        }
+
+        std::size_t i = std::min(result.num_objects, k - 1);
+        while (i > 0 && distances_squared[i - 1] > distance_squared)
+        {
+            distances_squared[i] = distances_squared[i - 1];
+            result.objects[i]    = result.objects[i - 1];
+            i--;
+        }
+        distances_squared[i] = distance_squared;
+        result.objects[i]    = getObject(index);
+        result.num_objects   = std::min(result.num_objects + 1, k);
+        return true;
+    };
+
+    // Search rings of cells outwards from the cell containing the point. Every object
+    // in ring r + 1 or further out is more than r cells away from the point, so once we
+    // have k objects closer than that we are done
+    const int32_t column = getColumn(point.x());
+    const int32_t row    = getRow(point.y());
+    const int32_t max_ring =
+        std::max({column, num_columns - 1 - column, row, num_rows - 1 - row});
+    for (int32_t ring = 0; ring <= max_ring; ring++)
+    {
+        visitCells(column - ring, column + ring, row - ring, row - ring, filter,
+                   add_candidate);
+        if (ring > 0)
+        {
+            visitCells(column - ring, column + ring, row + ring, row + ring, filter,
+                       add_candidate);
+            visitCells(column - ring, column - ring, row - ring + 1, row + ring - 1,
+                       filter, add_candidate);
+            visitCells(column + ring, column + ring, row - ring + 1, row + ring - 1,
+                       filter, add_candidate);
+        }
+
+        const double searched_distance = ring * CELL_SIZE_METERS;
+        if (result.num_objects == k &&
+            distances_squared[k - 1] <= searched_distance * searched_distance)
+        {
+            break;
+        }
+    }
+
+    return result;
+}
+
+SpatialQueryResult SpatialIndex::findWithinRadius(const Point &point, double radius,
+                                                  unsigned int filter) const
+{
+    SpatialQueryResult result;
+    const double radius_squared = radius * radius;
+    visitCells(getColumn(point.x() - radius), getColumn(point.x() + radius),
+               getRow(point.y() - radius), getRow(point.y() + radius), filter,
+               [&](unsigned int index) {
+                   double dx = object_x_positions[index] - point.x();
+                   double dy = object_y_positions[index] - point.y();
+                   if (dx * dx + dy * dy <= radius_squared)
+                   {
+                       result.objects[result.num_objects++] = getObject(index);
+                   }
+                   return true;
+               });
+    return result;
+}
+
+SpatialQueryResult SpatialIndex::findNearSegment(const Seg &segment, double radius,
+                                                 unsigned int filter) const
+{
+    SpatialQueryResult result;
+    visitNearSegment(segment, radius, filter, [&](unsigned int index) {
+        result.objects[result.num_objects++] = getObject(index);
+        return true;
+    });
+    return result;
+}
+
+bool SpatialIndex::isSegmentClear(const Seg &segment, double radius,
+                                  unsigned int filter) const
+{
+    bool clear = true;
+    visitNearSegment(segment, radius, filter, [&](unsigned int index) {
+        clear = false;
+        return false;
+    });
+    return clear;
+}
+
+void SpatialIndex::updateTeam(const Team &team, unsigned int first_index)
+{
+    const uint32_t presence_mask = team.getRobotPresenceMask();
+    for (unsigned int id = 0; id < Team::MAX_ROBOT_IDS; id++)
+    {
+        if (presence_mask & (1u << id))
+        {
+            setPosition(first_index + id, team.getRobotPositions()[id]);
+        }
+        else
+        {
+            remove(first_index + id);
+        }
+    }
+}
+
+void SpatialIndex::setPosition(unsigned int index, const Point &position)
+{
+    object_x_positions[index] = position.x();
+    object_y_positions[index] = position.y();
+
+    const int32_t cell = getRow(position.y()) * num_columns + getColumn(position.x());
+    if (cell == object_cells[index])
+    {
+        return;
+    }
+
+    remove(index);
+    object_cells[index]             = cell;
+    previous_objects_in_cell[index] = NO_OBJECT;
+    next_objects_in_cell[index]     = cell_first_objects[cell];
+    if (cell_first_objects[cell] != NO_OBJECT)
+    {
+        previous_objects_in_cell[cell_first_objects[cell]] = index;
+    }
+    cell_first_objects[cell] = index;
+}
+
+void SpatialIndex::remove(unsigned int index)
+{
+    const int32_t cell = object_cells[index];
+    if (cell == NO_CELL)
+    {
+        return;
+    }
+
+    const int32_t previous = previous_objects_in_cell[index];
+    const int32_t next     = next_objects_in_cell[index];
+    if (previous != NO_OBJECT)
+    {
+        next_objects_in_cell[previous] = next;
+    }
+    else
+    {
+        cell_first_objects[cell] = next;
+    }
+    if (next != NO_OBJECT)
+    {
+        previous_objects_in_cell[next] = previous;
+    }
+    object_cells[index] = NO_CELL;
+}
+
+int32_t SpatialIndex::getColumn(double x) const
+{
+    // Clamp before converting, since points can be far outside the grid. fmax and fmin
+    // return the other argument for NaN, so NaN coordinates end up in the first column
+    return static_cast<int32_t>(std::fmin(
+        std::fmax(std::floor((x - min_x) / CELL_SIZE_METERS), 0.0), num_columns - 1.0));
+}
+
+int32_t SpatialIndex::getRow(double y) const
+{
+    return static_cast<int32_t>(std::fmin(
+        std::fmax(std::floor((y - min_y) / CELL_SIZE_METERS), 0.0), num_rows - 1.0));
+}
+
+SpatialObjectType SpatialIndex::getType(unsigned int index)
+{
+    if (index == BALL_INDEX)
+    {
+        return SPATIAL_BALL;
+    }
+    return index < Team::MAX_ROBOT_IDS ? SPATIAL_FRIENDLY_ROBOT : SPATIAL_ENEMY_ROBOT;
+}
+
+SpatialObject SpatialIndex::getObject(unsigned int index)
+{
+    SpatialObject object;
+    object.type = getType(index);
+    object.id   = index == BALL_INDEX ? 0 : index % Team::MAX_ROBOT_IDS;
+    return object;
+}
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ai/world/ball.h"
+#include "ai/world/field.h"
+#include "ai/world/team.h"
+#include "geom/point.h"
+#include "geom/shapes.h"
+
+/**
+ * The kinds of objects in a SpatialIndex. Each is a separate bit, so they can be
+ * combined into a filter for the kinds of objects a query should find
+ */
+typedef enum
+{
+    SPATIAL_FRIENDLY_ROBOT = 1 << 0,
+    SPATIAL_ENEMY_ROBOT    = 1 << 1,
+    SPATIAL_BALL           = 1 << 2
+} SpatialObjectType;
+
+/**
+ * An object found by a SpatialIndex query
+ */
+typedef struct
+{
+    SpatialObjectType type;
+    // The id of the robot, or 0 for the ball
+    unsigned int id;
+} SpatialObject;
+
+class SpatialIndex;
+
+/**
+ * The objects found by a SpatialIndex query. There is room for every object in the
+ * index, so queries never allocate memory
+ */
+class SpatialQueryResult final
+{
+   public:
+    static constexpr unsigned int MAX_NUM_OBJECTS = 2 * Team::MAX_ROBOT_IDS + 1;
+
+    /**
+     * Creates an empty result
+     */
+    explicit SpatialQueryResult();
+
+    const SpatialObject* begin() const;
+    const SpatialObject* end() const;
+
+    /**
+     * Returns the number of objects found
+     *
+     * @return the number of objects found
+     */
+    std::size_t size() const;
+
+    /**
+     * Returns whether no objects were found
+     *
+     * @return true if no objects were found, and false otherwise
+     */
+    bool empty() const;
+
+    /**
+     * Returns the object found at the given index
+     *
+     * @param index The index of the object. Must be < size()
+     *
+     * @return the object found at the given index
+     */
+    const SpatialObject& operator[](std::size_t index) const;
+
+   private:
+    friend class SpatialIndex;
+
+    std::array<SpatialObject, MAX_NUM_OBJECTS> objects;
+    std::size_t num_objects;
+};
+
+/**
+ * An index of where the robots on both teams and the ball are, so we can find the
+ * objects near a point or a path without checking every object.
+ *
+ * The field is divided into a uniform grid of square cells, each of which keeps a
+ * linked list of the objects in it. Objects off the edge of the field are kept in the
+ * nearest cell. When an object is updated it is only moved between lists if it has
+ * changed cells, so keeping the index up to date is cheap. Nothing is allocated except
+ * when the field geometry changes and the grid is resized.
+ */
+class SpatialIndex final
+{
+   public:
+    // The width and height of each cell of the grid, in metres. This is a bit larger
+    // than a robot, so most queries only need to check a few cells
+    static constexpr double CELL_SIZE_METERS = 0.5;
+    // A filter that matches every kind of object
+    static constexpr unsigned int ALL_OBJECTS =
+        SPATIAL_FRIENDLY_ROBOT | SPATIAL_ENEMY_ROBOT | SPATIAL_BALL;
+
+    /**
+     * Creates an empty index with a grid covering the given field, including its
+     * boundary
+     *
+     * @param field The field the grid covers
+     */
+    explicit SpatialIndex(const Field& field);
+
+    /**
+     * Resizes the grid to cover the given field, and puts every object back into it
+     *
+     * @param field The field the grid covers
+     */
+    void updateFieldGeometry(const Field& field);
+
+    /**
+     * Moves the ball in the index to the position of the given ball
+     *
+     * @param ball The ball
+     */
+    void updateBall(const Ball& ball);
+
+    /**
+     * Updates the friendly robots in the index to match the given team. Robots that are
+     * no longer on the team are removed
+     *
+     * @param friendly_team The friendly team
+     */
+    void updateFriendlyTeam(const Team& friendly_team);
+
+    /**
+     * Updates the enemy robots in the index to match the given team. Robots that are no
+     * longer on the team are removed
+     *
+     * @param enemy_team The enemy team
+     */
+    void updateEnemyTeam(const Team& enemy_team);
+
+    /**
+     * Finds the k objects closest to the given point, closest first
+     *
+     * @param point The point to search around
+     * @param k The number of objects to find. Fewer are found if there aren't enough
+     * objects in the index
+     * @param filter The kinds of objects to find, as a combination of
+     * SpatialObjectTypes
+     *
+     * @return the k objects closest to the point, ordered by increasing distance
+     */
+    SpatialQueryResult findKNearest(const Point& point, std::size_t k,
+                                    unsigned int filter = ALL_OBJECTS) const;
+
+    /**
+     * Finds every object within the given distance of a point
+     *
+     * @param point The point to search around
+     * @param radius The distance from the point to search, in metres
+     * @param filter The kinds of objects to find, as a combination of
+     * SpatialObjectTypes
+     *
+     * @return the objects whose centres are within the radius of the point, in no
+     * particular order
+     */
+    SpatialQueryResult findWithinRadius(const Point& point, double radius,
+                                        unsigned int filter = ALL_OBJECTS) const;
+
+    /**
+     * Finds every object within the given distance of a segment. This is every object
+     * that would be hit by sweeping a circle of the given radius along the segment
+     *
+     * @param segment The segment to search along
+     * @param radius The distance from the segment to search, in metres
+     * @param filter The kinds of objects to find, as a combination of
+     * SpatialObjectTypes
+     *
+     * @return the objects whose centres are within the radius of the segment, in no
+     * particular order
+     */
+    SpatialQueryResult findNearSegment(const Seg& segment, double radius,
+                                       unsigned int filter = ALL_OBJECTS) const;
+
+    /**
+     * Returns whether there are no objects within the given distance of a segment
+     *
+     * @param segment The segment to check
+     * @param radius The distance from the segment to check, in metres
+     * @param filter The kinds of objects to check for, as a combination of
+     * SpatialObjectTypes
+     *
+     * @return true if no object's centre is within the radius of the segment, and false
+     * otherwise
+     */
+    bool isSegmentClear(const Seg& segment, double radius,
+                        unsigned int filter = ALL_OBJECTS) const;
+
+   private:
+    // Objects are numbered with the friendly robots first, indexed by robot id, then
+    // the enemy robots, and then the ball
+    static constexpr unsigned int MAX_NUM_OBJECTS = SpatialQueryResult::MAX_NUM_OBJECTS;
+    static constexpr unsigned int BALL_INDEX      = 2 * Team::MAX_ROBOT_IDS;
+    // Marks the end of a cell's list, and objects that are not in the index
+    static constexpr int32_t NO_OBJECT = -1;
+    static constexpr int32_t NO_CELL   = -1;
+
+    /**
+     * Updates the robots in the index to match the given team
+     *
+     * @param team The team
+     * @param first_index The index of the robot with id 0 on the team
+     */
+    void updateTeam(const Team& team, unsigned int first_index);
+
+    /**
+     * Moves the object with the given index to the given position, moving it to a new
+     * cell if needed
+     *
+     * @param index The index of the object
+     * @param position The new position of the object
+     */
+    void setPosition(unsigned int index, const Point& position);
+
+    /**
+     * Removes the object with the given index from the index, if it is in it
+     *
+     * @param index The index of the object
+     */
+    void remove(unsigned int index);
+
+    /**
+     * Returns the column of the cell containing the given x coordinate. Coordinates
+     * off the edge of the grid are in the nearest column
+     */
+    int32_t getColumn(double x) const;
+
+    /**
+     * Returns the row of the cell containing the given y coordinate. Coordinates off
+     * the edge of the grid are in the nearest row
+     */
+    int32_t getRow(double y) const;
+
+    /**
+     * Returns the type of the object with the given index
+     */
+    static SpatialObjectType getType(unsigned int index);
+
+    /**
+     * Returns the object with the given index
+     */
+    static SpatialObject getObject(unsigned int index);
+
+    /**
+     * Calls the given function with the index of every object in the given range of
+     * cells that matches the filter. The range is clamped to the grid
+     *
+     * @param first_column, last_column The range of columns, inclusive
+     * @param first_row, last_row The range of rows, inclusive
+     * @param filter The kinds of objects to visit
+     * @param visit The function to call with the index of each object. Returns false
+     * to stop visiting objects
+     *
+     * @return false if visit returned false, and true otherwise
+     */
+    template <typename Visitor>
+    bool visitCells(int32_t first_column, int32_t last_column, int32_t first_row,
+                    int32_t last_row, unsigned int filter, Visitor visit) const;
+
+    /**
+     * Calls the given function with the index of every object within the given
+     * distance of a segment that matches the filter
+     *
+     * @param segment The segment
+     * @param radius The distance from the segment
+     * @param filter The kinds of objects to visit
+     * @param visit The function to call with the index of each object. Returns false
+     * to stop visiting objects
+     */
+    template <typename Visitor>
+    void visitNearSegment(const Seg& segment, double radius, unsigned int filter,
+                          Visitor visit) const;
+
+    // The grid starts at the negative corner of the field boundary
+    double min_x;
+    double min_y;
+    int32_t num_columns;
+    int32_t num_rows;
+
+    // The first object in each cell, indexed by row * num_columns + column
+    std::vector<int32_t> cell_first_objects;
+
+    // The state of each object, indexed by object index
+    std::array<double, MAX_NUM_OBJECTS> object_x_positions;
+    std::array<double, MAX_NUM_OBJECTS> object_y_positions;
+    std::array<int32_t, MAX_NUM_OBJECTS> object_cells;
+    std::array<int32_t, MAX_NUM_OBJECTS> next_objects_in_cell;
+    std::array<int32_t, MAX_NUM_OBJECTS> previous_objects_in_cell;
+};
@@ -1,11 +1,71 @@
 #include "ai/world/team.h"
 
-#include <set>
+#include <algorithm>
 
 #include "shared/constants.h"
 
+TeamRobotsView::Iterator::Iterator(const Team* team, uint32_t remaining_robots)
+    : team(team), remaining_robots(remaining_robots)
+{
+}
+
+Robot TeamRobotsView::Iterator::operator*() const
+{
+    // The lowest set bit is the id of the current robot
+    unsigned int id = static_cast<unsigned int>(__builtin_ctz(remaining_robots));
+    return *team->getRobotById(id);
+}
+
+TeamRobotsView::Iterator& TeamRobotsView::Iterator::operator++()
+{
+    // Clear the lowest set bit to move on to the robot with the next highest id
+    remaining_robots &= remaining_robots - 1;
+    return *this;
+}
+
+bool TeamRobotsView::Iterator::operator==(const Iterator& other) const
+{
+    return this->team == other.team && this->remaining_robots == other.remaining_robots;
+}
+
+bool TeamRobotsView::Iterator::operator!=(const Iterator& other) const
+{
+    return !(*this == other);
+}
+
+TeamRobotsView::TeamRobotsView(const Team& team, uint32_t robots)
+    : team(&team), robots(robots)
+{
+}
+
+TeamRobotsView::Iterator TeamRobotsView::begin() const
+{
+    return Iterator(team, robots);
+}
+
+TeamRobotsView::Iterator TeamRobotsView::end() const
+{
+    return Iterator(team, 0);
+}
+
+std::size_t TeamRobotsView::size() const
+{
+    return static_cast<std::size_t>(__builtin_popcount(robots));
+}
+
+bool TeamRobotsView::empty() const
+{
+    return robots == 0;
+}
+
 Team::Team(const std::chrono::milliseconds robot_expiry_buffer_milliseconds)
-    : team_robots(),
+    : robot_presence_mask(0),
+      robot_positions(),
+      robot_velocities(),
+      robot_accelerations(),
+      robot_orientations(),
+      robot_angular_velocities(),
+      robot_last_update_timestamps(),
       goalie_id(),
       robot_expiry_buffer_milliseconds(robot_expiry_buffer_milliseconds)
 {
@@ -14,35 +74,34 @@ Team::Team(const std::chrono::milliseconds robot_expiry_buffer_milliseconds)
 void Team::updateRobots(const std::vector<Robot>& new_robots)
 {
     // Update the robots, checking that there are no duplicate IDs in the given data
-    std::set<unsigned int> robot_ids;
+    uint32_t updated_robots = 0;
     for (const auto& robot : new_robots)
     {
-        // The second value of the pair that is returned indicates whether or not the
-        // value was already present in the set. We use this to detect duplicate robots
-        auto duplicate_id = robot_ids.insert(robot.id());
-        if (!duplicate_id.second)
+        if (robot.id() >= MAX_ROBOT_IDS)
         {
-            // TODO: Multiple robots on the same team with the same id. Throw exception
-            // See https://github.com/UBC-Thunderbots/Software/issues/16
+            // TODO: This robot's id is too large to be a valid SSL robot id. Throw
+            // exception. See https://github.com/UBC-Thunderbots/Software/issues/16
+            continue;
         }
 
-        auto it = team_robots.find(robot.id());
-        if (it != team_robots.end())
-        {
-            // The robot already exists on the team. Find and update the robot
-            team_robots.at(robot.id()).updateState(robot);
-        }
-        else
+        uint32_t robot_bit = 1u << robot.id();
+        if (updated_robots & robot_bit)
         {
-            // This robot does not exist as part of the team yet. Add the new robot
-            team_robots.insert(std::make_pair(robot.id(), robot));
+            // TODO: Multiple robots on the same team with the same id. Throw exception
+            // See https://github.com/UBC-Thunderbots/Software/issues/16
         }
+        updated_robots |= robot_bit;
+
+        updateRobot(robot);
     }
 }
 
 void Team::updateState(const Team& new_team_data)
 {
-    updateRobots(new_team_data.getAllRobots());
+    for (const Robot& robot : new_team_data.robots())
+    {
+        updateRobot(robot);
+    }
     this->goalie_id = new_team_data.goalie_id;
 }
 
@@ -50,9 +109,10 @@ void Team::updateStateToPredictedState(
     const std::chrono::steady_clock::time_point timestamp)
 {
     // Update the state of all robots to their predicted state
-    for (auto it = team_robots.begin(); it != team_robots.end(); it++)
+    for (Robot robot : robots())
     {
-        it->second.updateStateToPredictedState(timestamp);
+        robot.updateStateToPredictedState(timestamp);
+        setRobot(robot);
     }
 }
 
@@ -60,23 +120,20 @@ void Team::removeExpiredRobots(const std::chrono::steady_clock::time_point times
 {
     // Check to see if any Robots have "expired". If it more time than the expiry_buffer
     // has passed, then remove the robot from the team
-    for (auto it = team_robots.begin(); it != team_robots.end();)
+    for (unsigned int id = 0; id < MAX_ROBOT_IDS; id++)
     {
-        if (std::chrono::duration(timestamp - it->second.lastUpdateTimestamp()) >
-            robot_expiry_buffer_milliseconds)
+        if (hasRobot(id) &&
+            std::chrono::duration(timestamp - robot_last_update_timestamps[id]) >
+                robot_expiry_buffer_milliseconds)
         {
-            it = team_robots.erase(it);
-        }
-        else
-        {
-            it++;
+            robot_presence_mask &= ~(1u << id);
         }
     }
 }
 
 void Team::assignGoalie(unsigned int new_goalie_id)
 {
-    if (getRobotById(new_goalie_id))
+    if (hasRobot(new_goalie_id))
     {
         goalie_id = new_goalie_id;
     }
@@ -93,7 +150,7 @@ void Team::clearGoalie()
 
 std::size_t Team::numRobots() const
 {
-    return team_robots.size();
+    return robots().size();
 }
 
 std::chrono::milliseconds Team::getRobotExpiryBufferMilliseconds()
@@ -109,10 +166,11 @@ void Team::setRobotExpiryBuffer(
 
 std::optional<Robot> Team::getRobotById(const unsigned int id) const
 {
-    auto it = team_robots.find(id);
-    if (it != team_robots.end())
+    if (hasRobot(id))
     {
-        return it->second;
+        return Robot(id, robot_positions[id], robot_velocities[id],
+                     robot_orientations[id], robot_angular_velocities[id],
+                     robot_last_update_timestamps[id], robot_accelerations[id]);
     }
 
     return std::nullopt;
@@ -131,28 +189,133 @@ std::optional<Robot> Team::goalie() const
 std::vector<Robot> Team::getAllRobots() const
 {
     std::vector<Robot> all_robots;
-    for (auto it = team_robots.begin(); it != team_robots.end(); it++)
+    all_robots.reserve(numRobots());
+    for (const Robot& robot : robots())
     {
-        all_robots.emplace_back(it->second);
+        all_robots.emplace_back(robot);
     }
 
     return all_robots;
 }
 
+TeamRobotsView Team::robots() const
+{
+    return TeamRobotsView(*this, robot_presence_mask);
+}
+
+bool Team::hasRobot(unsigned int id) const
+{
+    return id < MAX_ROBOT_IDS && (robot_presence_mask & (1u << id));
+}
+
+uint32_t Team::getRobotPresenceMask() const
+{
+    return robot_presence_mask;
+}
+
+const std::array<Point, Team::MAX_ROBOT_IDS>& Team::getRobotPositions() const
+{
+    return robot_positions;
+}
+
+const std::array<Vector, Team::MAX_ROBOT_IDS>& Team::getRobotVelocities() const
+{
+    return robot_velocities;
+}
+
+const std::array<Angle, Team::MAX_ROBOT_IDS>& Team::getRobotOrientations() const
+{
+    return robot_orientations;
+}
+
+const std::array<AngularVelocity, Team::MAX_ROBOT_IDS>& Team::getRobotAngularVelocities()
+    const
+{
+    return robot_angular_velocities;
+}
+
+const std::array<std::chrono::steady_clock::time_point, Team::MAX_ROBOT_IDS>&
+Team::getRobotLastUpdateTimestamps() const
+{
+    return robot_last_update_timestamps;
+}
+
+std::chrono::steady_clock::time_point Team::getMostRecentTimestamp() const
+{
+    std::chrono::steady_clock::time_point most_recent_timestamp =
+        std::chrono::steady_clock::time_point::min();
+    for (unsigned int id = 0; id < MAX_ROBOT_IDS; id++)
+    {
+        if (hasRobot(id))
+        {
+            most_recent_timestamp =
+                std::max(most_recent_timestamp, robot_last_update_timestamps[id]);
+        }
+    }
+
+    return most_recent_timestamp;
+}
+
 void Team::clearAllRobots()
 {
-    team_robots.clear();
+    robot_presence_mask = 0;
 }
 
 bool Team::operator==(const Team& other) const
 {
-    return this->getAllRobots() == other.getAllRobots() &&
-           this->goalie_id == other.goalie_id &&
-           this->robot_expiry_buffer_milliseconds ==
-               other.robot_expiry_buffer_milliseconds;
+    if (this->robot_presence_mask != other.robot_presence_mask ||
+        this->goalie_id != other.goalie_id ||
+        this->robot_expiry_buffer_milliseconds != other.robot_expiry_buffer_milliseconds)
+    {
+        return false;
+    }
+
+    // Robots are compared the same way as Robot::operator==, which ignores timestamps
+    for (unsigned int id = 0; id < MAX_ROBOT_IDS; id++)
+    {
+        if (hasRobot(id) &&
+            !(this->robot_positions[id] == other.robot_positions[id] &&
+              this->robot_velocities[id] == other.robot_velocities[id] &&
+              this->robot_orientations[id] == other.robot_orientations[id] &&
+              this->robot_angular_velocities[id] == other.robot_angular_velocities[id]))
+        {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 bool Team::operator!=(const Team& other) const
 {
     return !(*this == other);
 }
+
+void Team::updateRobot(const Robot& new_robot_data)
+{
+    std::optional<Robot> existing_robot = getRobotById(new_robot_data.id());
+    if (existing_robot)
+    {
+        // The robot already exists on the team. Update it as a Robot so that the same
+        // checks are made as when updating a Robot directly
+        existing_robot->updateState(new_robot_data);
+        setRobot(*existing_robot);
+    }
+    else
+    {
+        // This robot does not exist as part of the team yet. Add the new robot
+        setRobot(new_robot_data);
+    }
+}
+
+void Team::setRobot(const Robot& robot)
+{
+    unsigned int id                  = robot.id();
+    robot_positions[id]              = robot.position();
+    robot_velocities[id]             = robot.velocity();
+    robot_accelerations[id]          = robot.acceleration();
+    robot_orientations[id]           = robot.orientation();
+    robot_angular_velocities[id]     = robot.angularVelocity();
+    robot_last_update_timestamps[id] = robot.lastUpdateTimestamp();
+    robot_presence_mask |= 1u << id;
+}
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
-#include <map>
+#include <iterator>
 #include <optional>
 #include <vector>
 
@@ -18,12 +21,83 @@ typedef enum
     YELLOW = 1
 } TeamColour;
 
+class Team;
+
+/**
+ * A non-allocating view of the robots on a Team, in order of increasing id. Each Robot
+ * is constructed from the Team's data as the view is iterated, so iterating never
+ * allocates. The view is only valid while the Team it came from is not modified.
+ */
+class TeamRobotsView
+{
+   public:
+    class Iterator
+    {
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Robot;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = Robot;
+
+        Iterator(const Team* team, uint32_t remaining_robots);
+
+        Robot operator*() const;
+        Iterator& operator++();
+        bool operator==(const Iterator& other) const;
+        bool operator!=(const Iterator& other) const;
+
+       private:
+        const Team* team;
+        // A bit is set for every robot that has not been iterated over yet
+        uint32_t remaining_robots;
+    };
+
+    /**
+     * Creates a view of the given robots of a team
+     *
+     * @param team The team to view
+     * @param robots A bitmask with the bit for each robot id to include set
+     */
+    TeamRobotsView(const Team& team, uint32_t robots);
+
+    Iterator begin() const;
+    Iterator end() const;
+
+    /**
+     * Returns the number of robots in this view
+     *
+     * @return the number of robots in this view
+     */
+    std::size_t size() const;
+
+    /**
+     * Returns whether this view has no robots
+     *
+     * @return true if this view has no robots, and false otherwise
+     */
+    bool empty() const;
+
+   private:
+    const Team* team;
+    uint32_t robots;
+};
+
 /**
  * A team of robots
+ *
+ * SSL robot ids are small, so the robots are stored in fixed-size arrays indexed by id,
+ * with a separate array for each part of the robots' state, and a bitmask that tracks
+ * which ids are on the team. None of the operations on a Team allocate memory, except
+ * for getAllRobots(). Use robots() to iterate over the team instead.
  */
 class Team
 {
    public:
+    // The number of different robot ids a team can have. Robots with larger ids are
+    // ignored
+    static constexpr unsigned int MAX_ROBOT_IDS = 16;
+
     /**
      * Create a new team
      *
@@ -136,12 +210,87 @@ class Team
     std::optional<Robot> goalie() const;
 
     /**
-     * Returns a vector of all the robots on this team.
+     * Returns a vector of all the robots on this team. This allocates a new vector every
+     * time it is called, so prefer robots() where possible.
      *
      * @return a vector of all the robots on this team.
      */
     std::vector<Robot> getAllRobots() const;
 
+    /**
+     * Returns a view of all the robots on this team, in order of increasing id. The
+     * view does not allocate, and is only valid until this team is next modified.
+     *
+     * @return a view of all the robots on this team
+     */
+    TeamRobotsView robots() const;
+
+    /**
+     * Returns whether this team has a robot with the given id
+     *
+     * @param id the id of the robot
+     *
+     * @return true if this team has a robot with the given id, and false otherwise
+     */
+    bool hasRobot(unsigned int id) const;
+
+    /**
+     * Returns a bitmask with the bit for each robot id on this team set. For example,
+     * if the team has robots 0 and 3 the mask is 0b1001.
+     *
+     * @return a bitmask of the robot ids on this team
+     */
+    uint32_t getRobotPresenceMask() const;
+
+    /**
+     * Returns the positions of the robots on this team, indexed by robot id. Only the
+     * entries for ids in getRobotPresenceMask() are meaningful.
+     *
+     * @return the positions of the robots on this team, indexed by robot id
+     */
+    const std::array<Point, MAX_ROBOT_IDS>& getRobotPositions() const;
+
+    /**
+     * Returns the velocities of the robots on this team, indexed by robot id. Only the
+     * entries for ids in getRobotPresenceMask() are meaningful.
+     *
+     * @return the velocities of the robots on this team, indexed by robot id
+     */
+    const std::array<Vector, MAX_ROBOT_IDS>& getRobotVelocities() const;
+
+    /**
+     * Returns the orientations of the robots on this team, indexed by robot id. Only
+     * the entries for ids in getRobotPresenceMask() are meaningful.
+     *
+     * @return the orientations of the robots on this team, indexed by robot id
+     */
+    const std::array<Angle, MAX_ROBOT_IDS>& getRobotOrientations() const;
+
+    /**
+     * Returns the angular velocities of the robots on this team, indexed by robot id.
+     * Only the entries for ids in getRobotPresenceMask() are meaningful.
+     *
+     * @return the angular velocities of the robots on this team, indexed by robot id
+     */
+    const std::array<AngularVelocity, MAX_ROBOT_IDS>& getRobotAngularVelocities() const;
+
+    /**
+     * Returns the times the robots on this team were last updated, indexed by robot id.
+     * Only the entries for ids in getRobotPresenceMask() are meaningful.
+     *
+     * @return the times the robots on this team were last updated, indexed by robot id
+     */
+    const std::array<std::chrono::steady_clock::time_point, MAX_ROBOT_IDS>&
+    getRobotLastUpdateTimestamps() const;
+
+    /**
+     * Returns the most recent time any robot on this team was updated
+     *
+     * @return the most recent time any robot on this team was updated, or
+     * std::chrono::steady_clock::time_point::min() if the team has no robots
+     */
+    std::chrono::steady_clock::time_point getMostRecentTimestamp() const;
+
     /**
      * Removes all Robots from this team. Does not affect the goalie id.
      */
@@ -165,9 +314,37 @@ class Team
     bool operator!=(const Team& other) const;
 
    private:
-    // The map that contains the Robots for this team. The map makes it easier to
-    // guarantee we only have robots with unique IDs.
-    std::map<unsigned int, Robot> team_robots;
+    /**
+     * Updates the robot on this team with the same id as the given robot, or adds the
+     * given robot to the team if it is not on the team yet
+     *
+     * @param new_robot_data The new data for the robot. Its id must be less than
+     * MAX_ROBOT_IDS
+     */
+    void updateRobot(const Robot& new_robot_data);
+
+    /**
+     * Stores the state of the given robot in the entry for its id, and marks the robot
+     * as being on the team
+     *
+     * @param robot The robot to store. Its id must be less than MAX_ROBOT_IDS
+     */
+    void setRobot(const Robot& robot);
+
+    static_assert(MAX_ROBOT_IDS <= 32, "The robot presence mask must fit in 32 bits");
+
+    // A bit is set for each robot id that is on this team
+    uint32_t robot_presence_mask;
+
+    // The state of each robot on the team, indexed by robot id. The entries for ids that
+    // are not on the team are meaningless
+    std::array<Point, MAX_ROBOT_IDS> robot_positions;
+    std::array<Vector, MAX_ROBOT_IDS> robot_velocities;
+    std::array<Vector, MAX_ROBOT_IDS> robot_accelerations;
+    std::array<Angle, MAX_ROBOT_IDS> robot_orientations;
+    std::array<AngularVelocity, MAX_ROBOT_IDS> robot_angular_velocities;
+    std::array<std::chrono::steady_clock::time_point, MAX_ROBOT_IDS>
+        robot_last_update_timestamps;
 
     // The robot id of the goalie for this team
     std::optional<unsigned int> goalie_id;
@@ -1,33 +1,54 @@
 #include "world.h"
 
+#include <algorithm>
+
 World::World(const Field &field, const Ball &ball, const Team &friendly_team,
              const Team &enemy_team)
     : field_(field),
       ball_(ball),
+      ball_trajectory_(ball),
       friendly_team_(friendly_team),
       enemy_team_(enemy_team),
-      game_state_()
+      game_state_(),
+      spatial_index_(field),
+      signed_distance_field_(std::make_shared<const SignedDistanceField>(field))
 {
+    spatial_index_.updateBall(ball_);
+    spatial_index_.updateFriendlyTeam(friendly_team_);
+    spatial_index_.updateEnemyTeam(enemy_team_);
 }
 
 void World::updateFieldGeometry(const Field &new_field_data)
 {
+    // The field geometry rarely changes, so we don't rebuild anything if it hasn't
+    if (field_ == new_field_data)
+    {
+        return;
+    }
+
     field_.updateDimensions(new_field_data);
+    spatial_index_.updateFieldGeometry(field_);
+    // Copies of this World may still be using the old distances
+    signed_distance_field_ = std::make_shared<const SignedDistanceField>(field_);
 }
 
 void World::updateBallState(const Ball &new_ball_data)
 {
     ball_.updateState(new_ball_data);
+    ball_trajectory_.update(ball_);
+    spatial_index_.updateBall(ball_);
 }
 
 void World::updateFriendlyTeamState(const Team &new_friendly_team_data)
 {
     friendly_team_.updateState(new_friendly_team_data);
+    spatial_index_.updateFriendlyTeam(friendly_team_);
 }
 
 void World::updateEnemyTeamState(const Team &new_enemy_team_data)
 {
     enemy_team_.updateState(new_enemy_team_data);
+    spatial_index_.updateEnemyTeam(enemy_team_);
 }
 
 const Field &World::field() const
@@ -50,6 +71,16 @@ Ball &World::mutableBall()
     return ball_;
 }
 
+const BallTrajectory &World::ballTrajectory() const
+{
+    return ball_trajectory_;
+}
+
+BallTrajectory &World::mutableBallTrajectory()
+{
+    return ball_trajectory_;
+}
+
 const Team &World::friendlyTeam() const
 {
     return friendly_team_;
@@ -70,11 +101,56 @@ Team &World::mutableEnemyTeam()
     return enemy_team_;
 }
 
+void World::updateStateToPredictedState(
+    const std::chrono::steady_clock::time_point timestamp)
+{
+    // The trajectory models friction better than the ball's own prediction does
+    auto microseconds_since_trajectory_start =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            timestamp - ball_trajectory_.getStartTimestamp());
+    ball_.updateState(ball_trajectory_.estimatePositionAtFutureTime(
+                          microseconds_since_trajectory_start),
+                      ball_trajectory_.estimateVelocityAtFutureTime(
+                          microseconds_since_trajectory_start),
+                      timestamp);
+    friendly_team_.updateStateToPredictedState(timestamp);
+    enemy_team_.updateStateToPredictedState(timestamp);
+    spatial_index_.updateBall(ball_);
+    spatial_index_.updateFriendlyTeam(friendly_team_);
+    spatial_index_.updateEnemyTeam(enemy_team_);
+}
+
+std::chrono::steady_clock::time_point World::getMostRecentTimestamp() const
+{
+    return std::max({ball_.lastUpdateTimestamp(), friendly_team_.getMostRecentTimestamp(),
+                     enemy_team_.getMostRecentTimestamp()});
+}
+
 void World::updateRefboxGameState(const RefboxGameState &game_state)
 {
     game_state_.updateRefboxGameState(game_state);
 }
 
+const SpatialIndex &World::spatialIndex() const
+{
+    return spatial_index_;
+}
+
+SpatialIndex &World::mutableSpatialIndex()
+{
+    return spatial_index_;
+}
+
+const SignedDistanceField &World::signedDistanceField() const
+{
+    return *signed_distance_field_;
+}
+
+std::shared_ptr<const SignedDistanceField> &World::mutableSignedDistanceField()
+{
+    return signed_distance_field_;
+}
+
 const GameState &World::gameState() const
 {
     return game_state_;
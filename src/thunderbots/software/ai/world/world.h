@@ -1,8 +1,13 @@
 #pragma once
 
+#include <memory>
+
 #include "ai/world/ball.h"
+#include "ai/world/ball_trajectory.h"
 #include "ai/world/field.h"
 #include "ai/world/game_state.h"
+#include "ai/world/signed_distance_field.h"
+#include "ai/world/spatial_index.h"
 #include "ai/world/team.h"
 #include "util/refbox_constants.h"
 
@@ -10,6 +15,12 @@
  * The world object describes the entire state of the world, which for us is all the
  * information we have about the field, robots, and ball. The world object acts as a
  * convenient way to pass all this information around to modules that may need it.
+ *
+ * The timestamps of the ball and robots are the times SSL Vision captured the frames
+ * they were seen in. These are on SSL Vision's system clock, since the epoch, even
+ * though they are stored in std::chrono::steady_clock::time_points, so they can only be
+ * compared with each other and with Timestamp::getSystemTimestampNow(), not with the
+ * steady clock.
  */
 class World final
 {
@@ -26,7 +37,8 @@ class World final
                    const Team& enemy_team);
 
     /**
-     * Updates the state of the field in the world with the new field data
+     * Updates the state of the field in the world with the new field data. Nothing is
+     * updated if the new field data is the same as the current field
      *
      * @param new_field_data A Field containing new field information
      */
@@ -53,6 +65,24 @@ class World final
      */
     void updateEnemyTeamState(const Team& new_enemy_team_data);
 
+    /**
+     * Updates the state of the ball and every robot in the world to their predicted
+     * state at the given timestamp. The ball is predicted with its trajectory, which
+     * is left as it is. The timestamp must be >= getMostRecentTimestamp()
+     *
+     * @param timestamp The timestamp at which to predict the state of the world. Must
+     * be >= getMostRecentTimestamp()
+     */
+    void updateStateToPredictedState(
+        const std::chrono::steady_clock::time_point timestamp);
+
+    /**
+     * Returns the most recent time the ball or any robot in the world was updated
+     *
+     * @return the most recent time the ball or any robot in the world was updated
+     */
+    std::chrono::steady_clock::time_point getMostRecentTimestamp() const;
+
     /**
      * Updates the refbox game state
      *
@@ -88,6 +118,21 @@ class World final
      */
     Ball& mutableBall();
 
+    /**
+     * Returns a const reference to the trajectory of the Ball in the world, which is
+     * rebuilt every time the ball is updated
+     *
+     * @return a const reference to the trajectory of the Ball in the world
+     */
+    const BallTrajectory& ballTrajectory() const;
+
+    /**
+     * Returns a mutable reference to the trajectory of the Ball in the world
+     *
+     * @return a mutable reference to the trajectory of the Ball in the world
+     */
+    BallTrajectory& mutableBallTrajectory();
+
     /**
      * Returns a const reference to the Friendly Team in the world
      *
@@ -116,6 +161,41 @@ class World final
      */
     Team& mutableEnemyTeam();
 
+    /**
+     * Returns a const reference to the index of where the robots and ball in the world
+     * are, which is kept up to date as the world is updated
+     *
+     * @return a const reference to the spatial index of the world
+     */
+    const SpatialIndex& spatialIndex() const;
+
+    /**
+     * Returns a mutable reference to the index of where the robots and ball in the
+     * world are
+     *
+     * @return a mutable reference to the spatial index of the world
+     */
+    SpatialIndex& mutableSpatialIndex();
+
+    /**
+     * Returns a const reference to the precomputed distances to the static obstacles on
+     * the field, which are rebuilt whenever the field geometry changes
+     *
+     * @return a const reference to the signed distance field of the world
+     */
+    const SignedDistanceField& signedDistanceField() const;
+
+    /**
+     * Returns a mutable reference to the pointer to the precomputed distances to the
+     * static obstacles on the field. The distances themselves never change, so copies
+     * of a World share them, and a World can be pointed at another World's distances
+     * to share them too
+     *
+     * @return a mutable reference to the pointer to the signed distance field of the
+     * world
+     */
+    std::shared_ptr<const SignedDistanceField>& mutableSignedDistanceField();
+
     /**
      * Returns a const reference to the Game State
      *
@@ -133,7 +213,12 @@ class World final
    private:
     Field field_;
     Ball ball_;
+    BallTrajectory ball_trajectory_;
     Team friendly_team_;
     Team enemy_team_;
     GameState game_state_;
+    SpatialIndex spatial_index_;
+    // This is much larger than the rest of the World, so it is shared rather than
+    // copied with it, and replaced rather than changed when the field geometry changes
+    std::shared_ptr<const SignedDistanceField> signed_distance_field_;
 };
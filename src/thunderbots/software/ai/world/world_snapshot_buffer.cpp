@@ -0,0 +1,140 @@
+#include "ai/world/world_snapshot_buffer.h"
+
+WorldSnapshotBuffer::WorldSnapshotBuffer(const World &initial_world)
+    : next_world(initial_world),
+      next_component_versions(),
+      next_version(0),
+      next_world_changed(false),
+      snapshots(3, Snapshot{initial_world, {}, 0}),
+      write_index(0),
+      shared_index(1),
+      read_index(2)
+{
+}
+
+void WorldSnapshotBuffer::updateFieldGeometry(const Field &new_field_data)
+{
+    // The field geometry is sent constantly but rarely changes, so we only copy it
+    // into the snapshots when it actually does
+    if (next_world.field() == new_field_data)
+    {
+        return;
+    }
+
+    next_world.updateFieldGeometry(new_field_data);
+    markChanged(FIELD);
+}
+
+void WorldSnapshotBuffer::updateBallState(const Ball &new_ball_data)
+{
+    next_world.updateBallState(new_ball_data);
+    markChanged(BALL);
+}
+
+void WorldSnapshotBuffer::updateFriendlyTeamState(const Team &new_friendly_team_data)
+{
+    next_world.updateFriendlyTeamState(new_friendly_team_data);
+    markChanged(FRIENDLY_TEAM);
+}
+
+void WorldSnapshotBuffer::updateEnemyTeamState(const Team &new_enemy_team_data)
+{
+    next_world.updateEnemyTeamState(new_enemy_team_data);
+    markChanged(ENEMY_TEAM);
+}
+
+void WorldSnapshotBuffer::updateRefboxGameState(const RefboxGameState &game_state)
+{
+    next_world.updateRefboxGameState(game_state);
+    markChanged(GAME_STATE);
+}
+
+bool WorldSnapshotBuffer::publish()
+{
+    if (!next_world_changed)
+    {
+        return false;
+    }
+
+    // The buffer we write to may hold a snapshot from a few versions ago, so we copy
+    // every component that changed since then
+    Snapshot &snapshot = snapshots[write_index];
+    if (snapshot.component_versions[FIELD] != next_component_versions[FIELD])
+    {
+        // The signed distance field is shared with the next World rather than copied
+        snapshot.world.mutableField() = next_world.field();
+        snapshot.world.mutableSignedDistanceField() =
+            next_world.mutableSignedDistanceField();
+    }
+    if (snapshot.component_versions[BALL] != next_component_versions[BALL])
+    {
+        snapshot.world.mutableBall()           = next_world.ball();
+        snapshot.world.mutableBallTrajectory() = next_world.ballTrajectory();
+    }
+    if (snapshot.component_versions[FRIENDLY_TEAM] !=
+        next_component_versions[FRIENDLY_TEAM])
+    {
+        snapshot.world.mutableFriendlyTeam() = next_world.friendlyTeam();
+    }
+    if (snapshot.component_versions[ENEMY_TEAM] != next_component_versions[ENEMY_TEAM])
+    {
+        snapshot.world.mutableEnemyTeam() = next_world.enemyTeam();
+    }
+    if (snapshot.component_versions[FIELD] != next_component_versions[FIELD] ||
+        snapshot.component_versions[BALL] != next_component_versions[BALL] ||
+        snapshot.component_versions[FRIENDLY_TEAM] !=
+            next_component_versions[FRIENDLY_TEAM] ||
+        snapshot.component_versions[ENEMY_TEAM] != next_component_versions[ENEMY_TEAM])
+    {
+        snapshot.world.mutableSpatialIndex() = next_world.spatialIndex();
+    }
+    if (snapshot.component_versions[GAME_STATE] != next_component_versions[GAME_STATE])
+    {
+        snapshot.world.mutableGameState() = next_world.gameState();
+    }
+    snapshot.component_versions = next_component_versions;
+    snapshot.version            = next_version;
+
+    // Releasing makes the writes to the snapshot visible to the planning thread when it
+    // takes this buffer, and acquiring makes sure it's done reading the buffer we get
+    // back before we write to it
+    uint8_t old_shared_index =
+        shared_index.exchange(write_index | NEW_SNAPSHOT_FLAG, std::memory_order_acq_rel);
+    write_index = old_shared_index & BUFFER_INDEX_MASK;
+
+    next_world_changed = false;
+    return true;
+}
+
+bool WorldSnapshotBuffer::hasNewSnapshot() const
+{
+    return (shared_index.load(std::memory_order_relaxed) & NEW_SNAPSHOT_FLAG) != 0;
+}
+
+const World &WorldSnapshotBuffer::getLatestSnapshot()
+{
+    if (hasNewSnapshot())
+    {
+        uint8_t old_shared_index =
+            shared_index.exchange(read_index, std::memory_order_acq_rel);
+        read_index = old_shared_index & BUFFER_INDEX_MASK;
+    }
+
+    return snapshots[read_index].world;
+}
+
+uint64_t WorldSnapshotBuffer::getSnapshotVersion() const
+{
+    return snapshots[read_index].version;
+}
+
+void WorldSnapshotBuffer::markChanged(WorldComponent component)
+{
+    // All changes until the next publish are part of the same version
+    if (!next_world_changed)
+    {
+        next_version++;
+        next_world_changed = true;
+    }
+    next_component_versions[component] = next_version;
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "ai/world/world.h"
+
+/**
+ * Passes immutable snapshots of the World from the thread that receives new data (the
+ * ingest thread) to the thread that plans with it (the planning thread), so that
+ * receiving new data and planning can run at the same time without ever blocking each
+ * other.
+ *
+ * The ingest thread updates the next World with the update functions, then publishes
+ * it as a snapshot. The planning thread gets the latest published snapshot at the
+ * start of each tick, and the snapshot it gets never changes until it asks for the
+ * next one, so every tick sees one coherent World.
+ *
+ * Snapshots are passed between the threads by atomically swapping the index of the
+ * buffer holding them, with three buffers so that neither thread ever waits: one is
+ * being written by the ingest thread, one is being read by the planning thread, and
+ * one holds the latest published snapshot. When a snapshot is published, only the
+ * parts of the World that changed since the buffer being written last held a snapshot
+ * are copied into it.
+ *
+ * Only one thread may call the update functions and publish(), and only one (possibly
+ * different) thread may call getLatestSnapshot() and hasNewSnapshot().
+ */
+class WorldSnapshotBuffer
+{
+   public:
+    /**
+     * Creates a new WorldSnapshotBuffer
+     *
+     * @param initial_world The World to use as the first snapshot
+     */
+    explicit WorldSnapshotBuffer(const World &initial_world);
+
+    // The planning thread keeps references to the snapshots in the buffer, so it
+    // can't be copied
+    WorldSnapshotBuffer(const WorldSnapshotBuffer &) = delete;
+    WorldSnapshotBuffer &operator=(const WorldSnapshotBuffer &) = delete;
+
+    /**
+     * Updates the field in the next World. Must only be called by the ingest thread
+     *
+     * @param new_field_data A Field containing new field information
+     */
+    void updateFieldGeometry(const Field &new_field_data);
+
+    /**
+     * Updates the ball in the next World. Must only be called by the ingest thread
+     *
+     * @param new_ball_data A Ball containing new ball information
+     */
+    void updateBallState(const Ball &new_ball_data);
+
+    /**
+     * Updates the friendly team in the next World. Must only be called by the ingest
+     * thread
+     *
+     * @param new_friendly_team_data A Team containing new friendly team information
+     */
+    void updateFriendlyTeamState(const Team &new_friendly_team_data);
+
+    /**
+     * Updates the enemy team in the next World. Must only be called by the ingest
+     * thread
+     *
+     * @param new_enemy_team_data A Team containing new enemy team information
+     */
+    void updateEnemyTeamState(const Team &new_enemy_team_data);
+
+    /**
+     * Updates the refbox game state in the next World. Must only be called by the
+     * ingest thread
+     *
+     * @param game_state the game state sent by refbox
+     */
+    void updateRefboxGameState(const RefboxGameState &game_state);
+
+    /**
+     * Publishes the next World as the latest snapshot, if it has been updated since the
+     * last time it was published. Must only be called by the ingest thread
+     *
+     * @return true if a new snapshot was published, and false if nothing had changed
+     */
+    bool publish();
+
+    /**
+     * Returns whether a snapshot has been published since the last call to
+     * getLatestSnapshot(). Must only be called by the planning thread
+     *
+     * @return true if a new snapshot has been published, and false otherwise
+     */
+    bool hasNewSnapshot() const;
+
+    /**
+     * Returns the latest published snapshot. The snapshot is not changed by the ingest
+     * thread, and the reference stays valid, until the next call to this function. Must
+     * only be called by the planning thread
+     *
+     * @return the latest published snapshot of the World
+     */
+    const World &getLatestSnapshot();
+
+    /**
+     * Returns the version of the snapshot last returned by getLatestSnapshot(). Each
+     * published snapshot has a higher version than the one before it, and the initial
+     * World has version 0. Must only be called by the planning thread
+     *
+     * @return the version of the snapshot last returned by getLatestSnapshot()
+     */
+    uint64_t getSnapshotVersion() const;
+
+   private:
+    // The parts of the World that are tracked separately, so that only the ones that
+    // changed need to be copied
+    enum WorldComponent
+    {
+        FIELD,
+        BALL,
+        FRIENDLY_TEAM,
+        ENEMY_TEAM,
+        GAME_STATE,
+        NUM_WORLD_COMPONENTS
+    };
+
+    typedef struct
+    {
+        World world;
+        // The version of the next World each component was last copied from
+        std::array<uint64_t, NUM_WORLD_COMPONENTS> component_versions;
+        uint64_t version;
+    } Snapshot;
+
+    /**
+     * Marks a component of the next World as changed
+     *
+     * @param component The component that changed
+     */
+    void markChanged(WorldComponent component);
+
+    // Set in the shared buffer index when it holds a snapshot the planning thread
+    // hasn't seen yet
+    static constexpr uint8_t NEW_SNAPSHOT_FLAG = 0x4;
+    static constexpr uint8_t BUFFER_INDEX_MASK = 0x3;
+
+    // The World being updated by the ingest thread, and the version of the World each
+    // of its components was last changed in
+    World next_world;
+    std::array<uint64_t, NUM_WORLD_COMPONENTS> next_component_versions;
+    uint64_t next_version;
+    bool next_world_changed;
+
+    std::vector<Snapshot> snapshots;
+    // The buffer the ingest thread writes the next snapshot to
+    uint8_t write_index;
+    // The buffer holding the latest published snapshot, with NEW_SNAPSHOT_FLAG set if
+    // the planning thread hasn't taken it yet
+    std::atomic<uint8_t> shared_index;
+    // The buffer holding the snapshot the planning thread is using
+    uint8_t read_index;
+};
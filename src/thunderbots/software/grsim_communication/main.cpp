@@ -1,17 +1,22 @@
 #include <ros/ros.h>
 #include <ros/time.h>
+#include <thunderbots_msgs/Metrics.h>
 #include <thunderbots_msgs/Primitive.h>
 #include <thunderbots_msgs/PrimitiveArray.h>
 
 #include "ai/primitive/directwheels_primitive.h"
 #include "ai/primitive/move_primitive.h"
-#include "ai/primitive/movespin_primitive.h"g
+#include "ai/primitive/movespin_primitive.h"
 #include "ai/primitive/primitive.h"
 #include "geom/point.h"
 #include "grsim_communication/grsim_backend.h"
 #include "util/constants.h"
+#include "util/latency_tracer.h"
 #include "util/logger/init.h"
+#include "util/metrics/metrics_exporter.h"
+#include "util/metrics/metrics_registry.h"
 #include "util/ros_messages.h"
+#include "util/timestamp.h"
 
 // Constants
 const std::string NETWORK_ADDRESS       = "127.0.0.1";
@@ -29,6 +34,40 @@ namespace
     std::vector<std::unique_ptr<Primitive>> primitives;
 
     Team friendly_team = Team(std::chrono::milliseconds(1000));
+
+    // The stages of the capture-to-command pipeline that this node measures the
+    // latency of
+    enum GrSimLatencyStage
+    {
+        // From SSL Vision capturing a frame to us receiving the primitives decided
+        // with it
+        CAPTURE_TO_COMMAND_RECEIVE,
+        // The time taken to send the primitives to grSim
+        SEND_PRIMITIVES,
+        // From SSL Vision capturing a frame to us sending the commands decided with it
+        CAPTURE_TO_COMMAND_SENT
+    };
+
+    LatencyTracer latency_tracer = LatencyTracer(
+        {"capture_to_command_receive", "send_primitives", "capture_to_command_sent"},
+        Util::Constants::LATENCY_REPORT_PERIOD);
+
+    // The node's metrics. The callbacks and the main loop use the references to the
+    // metrics they update, so they never have to look them up by name
+    MetricsRegistry metrics;
+    MetricCounter& primitive_arrays_received_metric =
+        metrics.getCounter("grsim_communication.primitive_arrays_received");
+    MetricCounter& primitives_received_metric =
+        metrics.getCounter("grsim_communication.primitives_received");
+    MetricCounter& primitives_sent_metric =
+        metrics.getCounter("grsim_communication.primitives_sent");
+    MetricHistogram& send_time_metric =
+        metrics.getHistogram("grsim_communication.send_time_us",
+                             MetricHistogram::createExponentialBucketBounds(1, 1.25, 64));
+
+    // The capture time of the latest SSL Vision frame the primitives received this tick
+    // were decided with, if any primitives were received this tick
+    std::optional<int64_t> primitives_capture_timestamp_microseconds;
 }  // namespace
 
 // Callbacks
@@ -39,6 +78,21 @@ void primitiveUpdateCallback(const thunderbots_msgs::PrimitiveArray::ConstPtr& m
     {
         primitives.emplace_back(Primitive::createPrimitive(prim_msg));
     }
+    primitive_arrays_received_metric.increment();
+    primitives_received_metric.increment(prim_array_msg.primitives.size());
+
+    // The AI sends a capture time of 0 until it has received data from a frame, and
+    // there is no latency to trace from those
+    if (msg->capture_timestamp_microseconds == 0)
+    {
+        return;
+    }
+
+    latency_tracer.recordLatency(
+        CAPTURE_TO_COMMAND_RECEIVE,
+        Timestamp::getSystemTimestampNow() -
+            Timestamp::fromMicroseconds(msg->capture_timestamp_microseconds));
+    primitives_capture_timestamp_microseconds = msg->capture_timestamp_microseconds;
 }
 
 // Update the friendly team
@@ -68,6 +122,17 @@ int main(int argc, char** argv)
     // Initialize the logger
     Util::Logger::LoggerSingleton::initializeLogger(node_handle);
 
+    // A snapshot of the node's metrics is periodically written to metrics_file, which
+    // is a private parameter, and published on the diagnostics topic
+    ros::NodeHandle private_node_handle("~");
+    std::string metrics_file_path;
+    private_node_handle.param<std::string>(
+        "metrics_file", metrics_file_path,
+        Util::Constants::METRICS_FILE_DIRECTORY + "/grsim_communication_metrics.txt");
+    ros::Publisher metrics_publisher = node_handle.advertise<thunderbots_msgs::Metrics>(
+        Util::Constants::DIAGNOSTICS_METRICS_TOPIC, 1);
+    MetricsExporter metrics_exporter(metrics, Util::Constants::METRICS_EXPORT_PERIOD);
+
     // Initialize variables
     primitives                 = std::vector<std::unique_ptr<Primitive>>();
     GrSimBackend grsim_backend = GrSimBackend(NETWORK_ADDRESS, NETWORK_PORT);
@@ -80,13 +145,50 @@ int main(int argc, char** argv)
     {
         // Clear all primitives each tick
         primitives.clear();
+        primitives_capture_timestamp_microseconds = std::nullopt;
 
 
         // Spin once to let all necessary callbacks run
         // The callbacks will populate the primitives vector
         ros::spinOnce();
 
+        AITimestamp send_start_time = Timestamp::getTimestampNow();
         grsim_backend.sendPrimitives(primitives, friendly_team);
+        AITimestamp send_time = Timestamp::getTimestampNow() - send_start_time;
+        latency_tracer.recordLatency(SEND_PRIMITIVES, send_time);
+        send_time_metric.record(
+            static_cast<double>(Timestamp::getMicroseconds(send_time)));
+        primitives_sent_metric.increment(primitives.size());
+
+        if (primitives_capture_timestamp_microseconds)
+        {
+            latency_tracer.recordLatency(
+                CAPTURE_TO_COMMAND_SENT,
+                Timestamp::getSystemTimestampNow() -
+                    Timestamp::fromMicroseconds(
+                        *primitives_capture_timestamp_microseconds));
+        }
+
+        std::optional<std::string> latency_report =
+            latency_tracer.getPeriodicReport(Timestamp::getTimestampNow());
+        if (latency_report)
+        {
+            LOG(INFO) << *latency_report << std::endl;
+        }
+
+        std::optional<std::vector<MetricSample>> metrics_snapshot =
+            metrics_exporter.getPeriodicSnapshot(Timestamp::getTimestampNow());
+        if (metrics_snapshot)
+        {
+            if (!MetricsExporter::writeSnapshotToFile(
+                    metrics_file_path, "grsim_communication", *metrics_snapshot))
+            {
+                LOG(WARNING) << "Could not write metrics to " << metrics_file_path
+                             << std::endl;
+            }
+            metrics_publisher.publish(MetricsExporter::createMetricsMsg(
+                "grsim_communication", *metrics_snapshot));
+        }
 
         tick_rate.sleep();
     }
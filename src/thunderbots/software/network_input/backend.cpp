@@ -3,146 +3,163 @@
 #include "network_input/util/ros_messages.h"
 #include "proto/messages_robocup_ssl_detection.pb.h"
 #include "proto/messages_robocup_ssl_geometry.pb.h"
-#include "shared/constants.h"
 #include "util/constants.h"
 
-Backend::Backend() : ball_filter(), friendly_team_filter(), enemy_team_filter() {}
+Backend::Backend()
+    : frame_assembler(Util::Constants::NUMBER_OF_SSL_VISION_CAMERAS,
+                      Util::Constants::SSL_VISION_FRAME_ASSEMBLY_TIMEOUT,
+                      Util::Constants::SSL_VISION_CAMERA_OVERLAP_MERGE_DISTANCE_METERS),
+      ball_filter(),
+      friendly_team_filter(),
+      enemy_team_filter(),
+      ball_detections(),
+      robot_detections(),
+      last_field_geometry_bytes(),
+      field_geometry_bytes()
+{
+    ball_detections.reserve(SSLDetectionFrameData::MAX_BALL_DETECTIONS);
+    robot_detections.reserve(SSLDetectionFrameData::MAX_ROBOT_DETECTIONS_PER_TEAM);
+}
 
-std::optional<thunderbots_msgs::Field> Backend::getFieldMsg(
-    const SSL_WrapperPacket &packet)
+void Backend::processPacket(const SSL_WrapperPacket &packet,
+                            const AITimestamp &receive_time, BackendMessages &messages)
 {
-    if (packet.has_geometry())
+    clearUpdatedFlags(messages);
+
+    if (packet.has_geometry() && hasFieldGeometryChanged(packet.geometry().field()))
     {
-        const SSL_GeometryData &geom       = packet.geometry();
-        const SSL_GeometryFieldSize &field = geom.field();
-        thunderbots_msgs::Field field_msg =
-            MessageUtil::createFieldMsgFromFieldGeometry(field);
-        return std::optional<thunderbots_msgs::Field>(field_msg);
+        messages.field_msg =
+            MessageUtil::createFieldMsgFromFieldGeometry(packet.geometry().field());
+        messages.field_msg_updated = true;
     }
 
-    return std::nullopt;
-}
-
-std::optional<thunderbots_msgs::Ball> Backend::getFilteredBallMsg(
-    const SSL_WrapperPacket &packet)
-{
     if (packet.has_detection())
     {
-        const SSL_DetectionFrame &detection = packet.detection();
-
-        if (!detection.balls().empty())
+        std::optional<SSLDetectionFrameData> merged_frame =
+            frame_assembler.addDetectionFrame(
+                createDetectionFrameData(packet.detection()), receive_time);
+        if (merged_frame)
         {
-            std::vector<SSLBallData> ball_detections = std::vector<SSLBallData>();
-            for (const SSL_DetectionBall &ball : detection.balls())
-            {
-                // Convert all data to meters and radians
-                SSLBallData ball_data;
-                ball_data.position   = Point(ball.x() * METERS_PER_MILLIMETER,
-                                           ball.y() * METERS_PER_MILLIMETER);
-                ball_data.confidence = ball.confidence();
-                ball_data.timestamp  = detection.t_capture();
-                ball_detections.push_back(ball_data);
-            }
-
-            FilteredBallData filtered_ball_data =
-                ball_filter.getFilteredData(ball_detections);
-            thunderbots_msgs::Ball ball_msg =
-                MessageUtil::createBallMsgFromFilteredBallData(filtered_ball_data);
-            return ball_msg;
+            processDetectionFrame(*merged_frame, messages);
         }
     }
-
-    return std::nullopt;
 }
 
-std::optional<thunderbots_msgs::Team> Backend::getFilteredFriendlyTeamMsg(
-    const SSL_WrapperPacket &packet)
+void Backend::processTimedOutFrames(const AITimestamp &now, BackendMessages &messages)
 {
-    if (packet.has_detection())
-    {
-        const SSL_DetectionFrame &detection                = packet.detection();
-        std::vector<SSLRobotData> friendly_team_robot_data = std::vector<SSLRobotData>();
+    clearUpdatedFlags(messages);
 
-        auto ssl_robots = detection.robots_yellow();
-        if (Util::Constants::FRIENDLY_TEAM_COLOUR == BLUE)
-        {
-            ssl_robots = detection.robots_blue();
-        }
-
-        if (!ssl_robots.empty())
-        {
-            for (const SSL_DetectionRobot &friendly_robot : ssl_robots)
-            {
-                SSLRobotData new_robot_data;
-
-                new_robot_data.id = friendly_robot.robot_id();
-                new_robot_data.position =
-                    Point(friendly_robot.x() * METERS_PER_MILLIMETER,
-                          friendly_robot.y() * METERS_PER_MILLIMETER);
-                new_robot_data.orientation =
-                    Angle::ofRadians(friendly_robot.orientation());
-                new_robot_data.confidence = friendly_robot.confidence();
-                new_robot_data.timestamp =
-                    detection.t_capture();  // Units of t_capture is seconds
-
-                friendly_team_robot_data.emplace_back(new_robot_data);
-            }
-
-            std::vector<FilteredRobotData> filtered_friendly_team_data =
-                friendly_team_filter.getFilteredData(friendly_team_robot_data);
-
-            thunderbots_msgs::Team friendly_team_msg =
-                MessageUtil::createTeamMsgFromFilteredRobotData(
-                    filtered_friendly_team_data);
-
-            return friendly_team_msg;
-        }
+    std::optional<SSLDetectionFrameData> timed_out_frame =
+        frame_assembler.getTimedOutFrame(now);
+    if (timed_out_frame)
+    {
+        processDetectionFrame(*timed_out_frame, messages);
     }
-
-    return std::nullopt;
 }
 
-
-std::optional<thunderbots_msgs::Team> Backend::getFilteredEnemyTeamMsg(
-    const SSL_WrapperPacket &packet)
+void Backend::processDetectionFrame(const SSLDetectionFrameData &frame,
+                                    BackendMessages &messages)
 {
-    if (packet.has_detection())
+    const AITimestamp filter_update_start_time = Timestamp::getTimestampNow();
+    messages.ball_msg_updated                  = false;
+    messages.friendly_team_msg_updated         = false;
+    messages.enemy_team_msg_updated            = false;
+
+    // We update the ball filter even if no balls were detected, so that it can keep
+    // track of the ball while it is hidden from the cameras
+    ball_detections.assign(frame.balls.begin(), frame.balls.begin() + frame.num_balls);
+    std::optional<FilteredBallData> filtered_ball_data =
+        ball_filter.getFilteredData(ball_detections);
+    if (filtered_ball_data)
     {
-        const SSL_DetectionFrame &detection = packet.detection();
-
-        std::vector<SSLRobotData> enemy_team_robot_data = std::vector<SSLRobotData>();
+        messages.ball_msg =
+            MessageUtil::createBallMsgFromFilteredBallData(*filtered_ball_data);
+        messages.ball_msg.frame_sequence_id = frame.frame_number;
+        messages.ball_msg_updated           = true;
+    }
 
-        auto ssl_robots = detection.robots_yellow();
-        if (Util::Constants::FRIENDLY_TEAM_COLOUR == YELLOW)
+    const int64_t capture_timestamp_microseconds =
+        Timestamp::getMicroseconds(std::chrono::duration_cast<AITimestamp>(
+            std::chrono::duration<double>(frame.t_capture)));
+
+    const bool friendly_team_is_blue = Util::Constants::FRIENDLY_TEAM_COLOUR == BLUE;
+    for (auto [robots, num_robots, team_filter, team_msg, team_msg_updated] :
+         {std::make_tuple(
+              friendly_team_is_blue ? &frame.blue_robots : &frame.yellow_robots,
+              friendly_team_is_blue ? frame.num_blue_robots : frame.num_yellow_robots,
+              &friendly_team_filter, &messages.friendly_team_msg,
+              &messages.friendly_team_msg_updated),
+          std::make_tuple(
+              friendly_team_is_blue ? &frame.yellow_robots : &frame.blue_robots,
+              friendly_team_is_blue ? frame.num_yellow_robots : frame.num_blue_robots,
+              &enemy_team_filter, &messages.enemy_team_msg,
+              &messages.enemy_team_msg_updated)})
+    {
+        if (num_robots == 0)
         {
-            ssl_robots = detection.robots_blue();
+            continue;
         }
 
-        if (!ssl_robots.empty())
-        {
-            for (const SSL_DetectionRobot &enemy_robot : ssl_robots)
-            {
-                SSLRobotData new_robot_data;
+        robot_detections.assign(robots->begin(), robots->begin() + num_robots);
+        MessageUtil::updateTeamMsgFromFilteredRobotData(
+            team_filter->getFilteredData(robot_detections), *team_msg);
+        // So the time taken to act on this data can be traced through the system
+        team_msg->capture_timestamp_microseconds = capture_timestamp_microseconds;
+        team_msg->frame_sequence_id              = frame.frame_number;
+        *team_msg_updated                        = true;
+    }
 
-                new_robot_data.id       = enemy_robot.robot_id();
-                new_robot_data.position = Point(enemy_robot.x() * METERS_PER_MILLIMETER,
-                                                enemy_robot.y() * METERS_PER_MILLIMETER);
-                new_robot_data.orientation = Angle::ofRadians(enemy_robot.orientation());
-                new_robot_data.confidence  = enemy_robot.confidence();
-                new_robot_data.timestamp   = detection.t_capture();
+    messages.filter_update_time = Timestamp::getTimestampNow() - filter_update_start_time;
+}
 
-                enemy_team_robot_data.emplace_back(new_robot_data);
-            }
+bool Backend::hasFieldGeometryChanged(const SSL_GeometryFieldSize &field_geometry)
+{
+    // Serializing into a string we keep around reuses its storage, so this doesn't
+    // allocate once the first geometry has been seen
+    field_geometry.SerializePartialToString(&field_geometry_bytes);
+    if (field_geometry_bytes == last_field_geometry_bytes)
+    {
+        return false;
+    }
 
-            std::vector<FilteredRobotData> filtered_enemy_team_data =
-                enemy_team_filter.getFilteredData(enemy_team_robot_data);
+    std::swap(field_geometry_bytes, last_field_geometry_bytes);
+    return true;
+}
 
-            thunderbots_msgs::Team enemy_team_msg =
-                MessageUtil::createTeamMsgFromFilteredRobotData(filtered_enemy_team_data);
+void Backend::clearUpdatedFlags(BackendMessages &messages)
+{
+    messages.field_msg_updated         = false;
+    messages.ball_msg_updated          = false;
+    messages.friendly_team_msg_updated = false;
+    messages.enemy_team_msg_updated    = false;
+    messages.filter_update_time        = std::nullopt;
+}
 
-            return enemy_team_msg;
-        }
+SSLDetectionFrameData Backend::createDetectionFrameData(
+    const SSL_DetectionFrame &detection)
+{
+    SSLDetectionFrameData frame_data;
+    frame_data.frame_number = detection.frame_number();
+    frame_data.camera_id    = detection.camera_id();
+    frame_data.t_capture    = detection.t_capture();
+    frame_data.t_sent       = detection.t_sent();
+    frame_data.clearDetections();
+
+    for (const SSL_DetectionBall &ball : detection.balls())
+    {
+        frame_data.addBallDetection(ball.x(), ball.y(), ball.confidence());
+    }
+    for (const SSL_DetectionRobot &robot : detection.robots_yellow())
+    {
+        frame_data.addYellowRobotDetection(robot.robot_id(), robot.x(), robot.y(),
+                                           robot.orientation(), robot.confidence());
+    }
+    for (const SSL_DetectionRobot &robot : detection.robots_blue())
+    {
+        frame_data.addBlueRobotDetection(robot.robot_id(), robot.x(), robot.y(),
+                                         robot.orientation(), robot.confidence());
     }
+    frame_data.setDetectionTimestamps();
 
-    return std::nullopt;
+    return frame_data;
 }
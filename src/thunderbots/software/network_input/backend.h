@@ -1,10 +1,14 @@
 #pragma once
 
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "network_input/filter/ball_filter.h"
 #include "network_input/filter/robot_filter.h"
 #include "network_input/filter/robot_team_filter.h"
+#include "network_input/networking/ssl_wire_decoder.h"
+#include "network_input/vision_frame_assembler.h"
 #include "proto/messages_robocup_ssl_wrapper.pb.h"
 #include "thunderbots_msgs/Ball.h"
 #include "thunderbots_msgs/Field.h"
@@ -12,6 +16,30 @@
 #include "thunderbots_msgs/Team.h"
 #include "util/timestamp.h"
 
+/**
+ * The messages produced by the Backend from SSL Vision packets. These are owned by the
+ * caller and reused for every packet, so that the Backend can update them in place
+ * rather than creating new messages every time.
+ */
+typedef struct
+{
+    thunderbots_msgs::Field field_msg;
+    thunderbots_msgs::Ball ball_msg;
+    thunderbots_msgs::Team friendly_team_msg;
+    thunderbots_msgs::Team enemy_team_msg;
+
+    // Whether or not each message was updated by the last call to the Backend. Messages
+    // that were not updated keep their old contents, and should not be published again
+    bool field_msg_updated;
+    bool ball_msg_updated;
+    bool friendly_team_msg_updated;
+    bool enemy_team_msg_updated;
+
+    // How long the filters took to update from the detection frame filtered by the last
+    // call to the Backend, or std::nullopt if no frame was filtered
+    std::optional<AITimestamp> filter_update_time;
+} BackendMessages;
+
 class Backend
 {
    public:
@@ -21,56 +49,97 @@ class Backend
     explicit Backend();
 
     /**
-     * Given a new protobuf packet, updates the Ball filter and returns a Ball message
-     * containing the most up to date filtered Ball data
+     * Processes a new SSL Vision packet, and updates the given messages with any new
+     * data it produces.
+     *
+     * Detection frames from each camera are merged into a single frame covering the
+     * whole field before they are filtered, so most packets will not produce new ball
+     * or team data. When a merged frame is complete, all the filters are updated from
+     * it in a single pass.
      *
-     * @param packet The SSL Vision packet containing new data
+     * The field message is only updated when the field geometry changes, since SSL
+     * Vision repeats the same geometry constantly.
      *
-     * @return a Ball message containing the most up to date filtered Ball data. If the
-     * packet does not contain any new Ball information, returns std::nullopt
+     * @param packet The SSL Vision packet to process
+     * @param receive_time The time the packet was received
+     * @param messages The messages to update. The updated flags are set for each
+     * message that was updated, and cleared for the others
      */
-    std::optional<thunderbots_msgs::Ball> getFilteredBallMsg(
-        const SSL_WrapperPacket &packet);
+    void processPacket(const SSL_WrapperPacket &packet, const AITimestamp &receive_time,
+                       BackendMessages &messages);
 
     /**
-     * Given a new protobuf packet, returns a Field message containing the most up to date
-     * Field geometry
+     * Checks if the merged frame currently being assembled has been waiting for the
+     * remaining cameras for too long, and if so filters it and updates the given
+     * messages with the result. This should be called regularly so we still produce
+     * data if some of the cameras stop sending it.
      *
-     * @param packet The SSL Vision packet containing new data
-     *
-     * @return a Field message containing the most up to date Field geometry. If the
-     * packet does not contain any new Field geometry, returns std::nullopt
+     * @param now The current time
+     * @param messages The messages to update. The updated flags are set for each
+     * message that was updated, and cleared for the others
      */
-    std::optional<thunderbots_msgs::Field> getFieldMsg(const SSL_WrapperPacket &packet);
+    void processTimedOutFrames(const AITimestamp &now, BackendMessages &messages);
 
     /**
-     * Given a new protobuf packet, updates the friendly team filter and returns a Team
-     * message containing the most up to date filtered friendly team data
-     *
-     * @param packet The SSL Vision packet containing new data
+     * Updates all the filters from a detection frame covering the whole field, and
+     * updates the ball and team messages with the filtered data. The messages are
+     * tagged with the frame's number and capture time, so the latency from capture to
+     * the robots acting on the data can be traced through the system
      *
-     * @return a Team message containing the most up to date filtered friendly team data.
-     * If the packet does not contain any new Team or Robot data, returns std::nullopt
+     * @param frame The detection frame containing new data
+     * @param messages The messages to update. The updated flags are set for each
+     * ball and team message that was updated, and cleared for the others, and the
+     * time taken to update the filters is set
      */
-    std::optional<thunderbots_msgs::Team> getFilteredFriendlyTeamMsg(
-        const SSL_WrapperPacket &packet);
+    void processDetectionFrame(const SSLDetectionFrameData &frame,
+                               BackendMessages &messages);
 
     /**
-     * Given a new protobuf packet, updates the enemy team filter and returns a Team
-     * message containing the most up to date filtered enemy team data
+     * Converts an SSL_DetectionFrame from protobuf into SSLDetectionFrameData, which is
+     * the data we pass to the VisionFrameAssembler and the filters
      *
-     * @param packet The SSL Vision packet containing new data
+     * @param detection The SSL_DetectionFrame to convert
      *
-     * @return a Team message containing the most up to date filtered enemy team data.
-     * If the packet does not contain any new Team or Robot data, returns std::nullopt
+     * @return The detection data from the given frame
      */
-    std::optional<thunderbots_msgs::Team> getFilteredEnemyTeamMsg(
-        const SSL_WrapperPacket &packet);
+    static SSLDetectionFrameData createDetectionFrameData(
+        const SSL_DetectionFrame &detection);
 
     virtual ~Backend() = default;
 
    private:
+    /**
+     * Checks if the given field geometry is different from the last field geometry we
+     * saw, and remembers it for next time if it is. SSL Vision sends the same field
+     * geometry over and over, so this lets us skip converting and publishing it when
+     * nothing has changed.
+     *
+     * @param field_geometry The field geometry to check
+     *
+     * @return true if the field geometry has changed, and false otherwise
+     */
+    bool hasFieldGeometryChanged(const SSL_GeometryFieldSize &field_geometry);
+
+    /**
+     * Clears the updated flags of all the given messages
+     *
+     * @param messages The messages to clear the updated flags of
+     */
+    static void clearUpdatedFlags(BackendMessages &messages);
+
+    VisionFrameAssembler frame_assembler;
     BallFilter ball_filter;
     RobotTeamFilter friendly_team_filter;
     RobotTeamFilter enemy_team_filter;
+
+    // The detections passed to the filters. We keep these around so we don't need to
+    // allocate new lists every frame
+    std::vector<SSLBallData> ball_detections;
+    std::vector<SSLRobotData> robot_detections;
+
+    // The serialized bytes of the last field geometry we saw, and of the field geometry
+    // being checked. Comparing the serialized bytes is a cheap way to compare every field
+    // of the geometry, including ones we don't use yet
+    std::string last_field_geometry_bytes;
+    std::string field_geometry_bytes;
 };
@@ -1,15 +1,268 @@
 #include "ball_filter.h"
 
-BallFilter::BallFilter() {}
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
-FilteredBallData BallFilter::getFilteredData(std::vector<SSLBallData> new_ball_data)
+namespace
 {
+    // The variance of the ball positions reported by SSL Vision, in m^2. SSL Vision is
+    // usually accurate to within a few millimeters
+    constexpr double POSITION_MEASUREMENT_VARIANCE = 0.005 * 0.005;
+
+    // How much the ball's velocity is expected to change due to things our model does
+    // not account for (friction, bounces, kicks, ...), as the spectral density of the
+    // ball's acceleration in m^2/s^3. Larger values follow sudden changes in velocity
+    // more quickly but give noisier estimates
+    constexpr double ACCELERATION_NOISE = 5.0;
+
+    // The variance of the velocity of a newly detected ball, in m^2/s^2. We don't know
+    // anything about how a new ball is moving, so this is large enough to cover any
+    // velocity the ball could reasonably have
+    constexpr double INITIAL_VELOCITY_VARIANCE = 4.0 * 4.0;
+
+    // Detections whose squared Mahalanobis distance from a hypothesis is greater than
+    // this are too unlikely to be the same ball to update it with. This is roughly the
+    // 99.97th percentile of the chi-squared distribution with 2 degrees of freedom
+    constexpr double GATE_MAHALANOBIS_DISTANCE_SQUARED = 16.0;
+
+    // How much of each hypothesis' score is kept from one update to the next. Lower
+    // values switch to a new hypothesis more quickly when the ball is kicked
+    constexpr double SCORE_DECAY = 0.7;
+
+    // How long a hypothesis can go without being detected before we stop tracking it,
+    // in seconds
+    constexpr double HYPOTHESIS_TIMEOUT_SECONDS = 0.5;
+
+    // The maximum number of detections used in a single update. A single frame can
+    // never have more ball detections than this
+    constexpr std::size_t MAX_DETECTIONS_PER_UPDATE = 32;
+
+    /**
+     * Converts a capture time in seconds to an AITimestamp
+     */
+    AITimestamp captureTimeToTimestamp(double capture_time)
+    {
+        return std::chrono::duration_cast<AITimestamp>(
+            std::chrono::duration<double>(capture_time));
+    }
+}  // namespace
+
+BallFilter::BallFilter()
+    : hypotheses(),
+      num_hypotheses(0),
+      last_output_timestamp(-std::numeric_limits<double>::infinity())
+{
+}
+
+std::optional<FilteredBallData> BallFilter::getFilteredData(
+    const std::vector<SSLBallData> &new_ball_data)
+{
+    const std::size_t num_detections =
+        std::min(new_ball_data.size(), MAX_DETECTIONS_PER_UPDATE);
+    if (num_detections == 0 && num_hypotheses == 0)
+    {
+        return std::nullopt;
+    }
+
+    double latest_timestamp = -std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < num_detections; i++)
+    {
+        latest_timestamp = std::max(latest_timestamp, new_ball_data[i].timestamp);
+    }
+    for (std::size_t i = 0; i < num_hypotheses; i++)
+    {
+        hypotheses[i].updated = false;
+        latest_timestamp      = std::max(latest_timestamp, hypotheses[i].timestamp);
+    }
+
+    // Match detections to hypotheses greedily, most likely pair first. Each hypothesis
+    // is updated with at most one detection, and each detection updates at most one
+    // hypothesis
+    std::array<bool, MAX_DETECTIONS_PER_UPDATE> detection_used = {};
+    while (true)
+    {
+        double best_distance_squared      = GATE_MAHALANOBIS_DISTANCE_SQUARED;
+        std::optional<std::size_t> best_h = std::nullopt;
+        std::size_t best_d                = 0;
+
+        for (std::size_t h = 0; h < num_hypotheses; h++)
+        {
+            if (hypotheses[h].updated)
+            {
+                continue;
+            }
+            for (std::size_t d = 0; d < num_detections; d++)
+            {
+                if (detection_used[d])
+                {
+                    continue;
+                }
+                double distance_squared =
+                    mahalanobisDistanceSquared(hypotheses[h], new_ball_data[d]);
+                if (distance_squared <= best_distance_squared)
+                {
+                    best_distance_squared = distance_squared;
+                    best_h                = h;
+                    best_d                = d;
+                }
+            }
+        }
+
+        if (!best_h)
+        {
+            break;
+        }
+
+        BallHypothesis &hypothesis = hypotheses[*best_h];
+        updateHypothesis(hypothesis, new_ball_data[best_d]);
+        hypothesis.score =
+            SCORE_DECAY * hypothesis.score + new_ball_data[best_d].confidence;
+        hypothesis.updated     = true;
+        detection_used[best_d] = true;
+    }
+
+    // Hypotheses that were not detected this time become less likely, and are removed
+    // once they have not been seen for too long
+    for (std::size_t h = num_hypotheses; h-- > 0;)
+    {
+        BallHypothesis &hypothesis = hypotheses[h];
+        if (!hypothesis.updated)
+        {
+            hypothesis.score *= SCORE_DECAY;
+            if (std::fabs(latest_timestamp - hypothesis.last_detection_timestamp) >
+                HYPOTHESIS_TIMEOUT_SECONDS)
+            {
+                removeHypothesis(h);
+            }
+        }
+    }
+
+    // Any detections that could not be matched with a hypothesis may be new balls
+    for (std::size_t d = 0; d < num_detections; d++)
+    {
+        if (!detection_used[d])
+        {
+            addHypothesis(new_ball_data[d]);
+        }
+    }
+
+    if (num_hypotheses == 0)
+    {
+        // We have lost track of every ball, so the next ball we see may come from a
+        // restarted vision system with an unrelated time base
+        last_output_timestamp = -std::numeric_limits<double>::infinity();
+        return std::nullopt;
+    }
+
+    const BallHypothesis &best_hypothesis =
+        *std::max_element(hypotheses.begin(), hypotheses.begin() + num_hypotheses,
+                          [](const BallHypothesis &a, const BallHypothesis &b) {
+                              return a.score < b.score;
+                          });
+
+    // Report where we think the ball is at the latest time we have data for
+    double output_timestamp = std::max(latest_timestamp, last_output_timestamp);
+    double dt               = std::max(0.0, output_timestamp - best_hypothesis.timestamp);
+    ConstantVelocityAxisState x =
+        ConstantVelocityAxisFilter::predict(best_hypothesis.x, dt, ACCELERATION_NOISE);
+    ConstantVelocityAxisState y =
+        ConstantVelocityAxisFilter::predict(best_hypothesis.y, dt, ACCELERATION_NOISE);
+    last_output_timestamp = output_timestamp;
+
     FilteredBallData filtered_data;
-    filtered_data.position = new_ball_data[0].position;
-    filtered_data.velocity = Vector();
-    // This is a placeholder timestamp for now. Timestamps should be fixed in
-    // https://github.com/UBC-Thunderbots/Software/issues/228
-    filtered_data.timestamp = Timestamp::getTimestampNow();
+    filtered_data.position  = Point(x.position, y.position);
+    filtered_data.velocity  = Vector(x.velocity, y.velocity);
+    filtered_data.timestamp = captureTimeToTimestamp(output_timestamp);
 
     return filtered_data;
 }
+
+std::size_t BallFilter::getNumHypotheses() const
+{
+    return num_hypotheses;
+}
+
+double BallFilter::mahalanobisDistanceSquared(const BallHypothesis &hypothesis,
+                                              const SSLBallData &detection)
+{
+    const double dt = std::max(0.0, detection.timestamp - hypothesis.timestamp);
+
+    // Both axes are independent, so the distance is just the sum of each axis'
+    // normalized squared innovation
+    double distance_squared = 0;
+    for (const auto &[axis, measured_position] :
+         {std::make_pair(&hypothesis.x, detection.position.x()),
+          std::make_pair(&hypothesis.y, detection.position.y())})
+    {
+        ConstantVelocityAxisState predicted =
+            ConstantVelocityAxisFilter::predict(*axis, dt, ACCELERATION_NOISE);
+        double innovation          = measured_position - predicted.position;
+        double innovation_variance = ConstantVelocityAxisFilter::getInnovationVariance(
+            predicted, POSITION_MEASUREMENT_VARIANCE);
+        distance_squared += innovation * innovation / innovation_variance;
+    }
+
+    return distance_squared;
+}
+
+void BallFilter::updateHypothesis(BallHypothesis &hypothesis,
+                                  const SSLBallData &detection)
+{
+    const double dt = std::max(0.0, detection.timestamp - hypothesis.timestamp);
+
+    for (auto [axis, measured_position] :
+         {std::make_pair(&hypothesis.x, detection.position.x()),
+          std::make_pair(&hypothesis.y, detection.position.y())})
+    {
+        ConstantVelocityAxisState predicted =
+            ConstantVelocityAxisFilter::predict(*axis, dt, ACCELERATION_NOISE);
+        *axis = ConstantVelocityAxisFilter::update(predicted,
+                                                   measured_position - predicted.position,
+                                                   POSITION_MEASUREMENT_VARIANCE);
+    }
+    hypothesis.timestamp = std::max(hypothesis.timestamp, detection.timestamp);
+    hypothesis.last_detection_timestamp = hypothesis.timestamp;
+}
+
+void BallFilter::addHypothesis(const SSLBallData &detection)
+{
+    std::size_t index = num_hypotheses;
+    if (num_hypotheses == MAX_HYPOTHESES)
+    {
+        // Replace the worst hypothesis, but only if the new ball is more likely to be
+        // real than it is
+        auto worst =
+            std::min_element(hypotheses.begin(), hypotheses.end(),
+                             [](const BallHypothesis &a, const BallHypothesis &b) {
+                                 return a.score < b.score;
+                             });
+        if (worst->score >= detection.confidence)
+        {
+            return;
+        }
+        index = static_cast<std::size_t>(worst - hypotheses.begin());
+    }
+    else
+    {
+        num_hypotheses++;
+    }
+
+    BallHypothesis &hypothesis = hypotheses[index];
+    hypothesis.x               = ConstantVelocityAxisFilter::createState(
+        detection.position.x(), POSITION_MEASUREMENT_VARIANCE, INITIAL_VELOCITY_VARIANCE);
+    hypothesis.y = ConstantVelocityAxisFilter::createState(
+        detection.position.y(), POSITION_MEASUREMENT_VARIANCE, INITIAL_VELOCITY_VARIANCE);
+    hypothesis.timestamp                = detection.timestamp;
+    hypothesis.last_detection_timestamp = detection.timestamp;
+    hypothesis.score                    = detection.confidence;
+    hypothesis.updated                  = true;
+}
+
+void BallFilter::removeHypothesis(std::size_t index)
+{
+    // The order of the hypotheses doesn't matter, so we just move the last one into
+    // the removed one's place
+    hypotheses[index] = hypotheses[num_hypotheses - 1];
+    num_hypotheses--;
+}
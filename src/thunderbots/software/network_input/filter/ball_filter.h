@@ -1,8 +1,11 @@
 #pragma once
 
+#include <array>
+#include <optional>
 #include <vector>
 
 #include "geom/point.h"
+#include "network_input/filter/constant_velocity_axis_filter.h"
 #include "util/timestamp.h"
 
 /**
@@ -33,10 +36,25 @@ typedef struct
 /**
  * Given ball data from SSL Vision, filters for and returns the position/velocity of the
  * "real" ball
+ *
+ * SSL Vision often reports several balls at once, since other objects on the field can
+ * look like a ball to the cameras. To handle this, the filter tracks several candidate
+ * balls (hypotheses) at the same time, each with its own constant-velocity Kalman
+ * filter for each axis. Each detection is used to update the hypothesis it is most likely
+ * to belong to, if it is close enough to be plausible (gating), and otherwise starts a
+ * new hypothesis. Each hypothesis is scored by how consistently and confidently it has
+ * been detected recently, and the best scoring hypothesis is reported as the real ball.
+ *
+ * All times are the capture times reported by SSL Vision, in seconds.
+ *
+ * The filter allocates all of its memory up front, so updating it never allocates.
  */
 class BallFilter
 {
    public:
+    // The maximum number of ball hypotheses that are tracked at once
+    static constexpr std::size_t MAX_HYPOTHESES = 6;
+
     /**
      * Creates a new Ball Filter
      */
@@ -47,7 +65,80 @@ class BallFilter
      * filtered data for the ball.
      *
      * @param new_ball_data A list of new datapoints for the ball
-     * @return The filtered data for the ball
+     *
+     * @return The filtered data for the ball, or std::nullopt if the filter is not
+     * tracking any balls
+     */
+    std::optional<FilteredBallData> getFilteredData(
+        const std::vector<SSLBallData> &new_ball_data);
+
+    /**
+     * Returns the number of ball hypotheses currently being tracked
+     *
+     * @return the number of ball hypotheses currently being tracked
+     */
+    std::size_t getNumHypotheses() const;
+
+   private:
+    /**
+     * A candidate ball being tracked by the filter
+     */
+    struct BallHypothesis
+    {
+        ConstantVelocityAxisState x;
+        ConstantVelocityAxisState y;
+        // The capture time the state was last updated to
+        double timestamp;
+        // The capture time the hypothesis was last matched with a detection
+        double last_detection_timestamp;
+        // How consistently and confidently this hypothesis has been detected recently
+        double score;
+        // Whether or not this hypothesis has been matched with a detection this update
+        bool updated;
+    };
+
+    /**
+     * Returns the squared Mahalanobis distance of a detection from a hypothesis,
+     * which measures how many standard deviations the detection is from where the
+     * hypothesis expects the ball to be
+     *
+     * @param hypothesis The hypothesis
+     * @param detection The detection
+     *
+     * @return the squared Mahalanobis distance of the detection from the hypothesis
      */
-    FilteredBallData getFilteredData(std::vector<SSLBallData> new_ball_data);
+    static double mahalanobisDistanceSquared(const BallHypothesis &hypothesis,
+                                             const SSLBallData &detection);
+
+    /**
+     * Predicts the given hypothesis forwards to the given time, and updates it with the
+     * given detection
+     *
+     * @param hypothesis The hypothesis to update
+     * @param detection The detection to update the hypothesis with
+     */
+    static void updateHypothesis(BallHypothesis &hypothesis,
+                                 const SSLBallData &detection);
+
+    /**
+     * Starts tracking a new hypothesis from the given detection, replacing the worst
+     * hypothesis if we are already tracking the maximum number of them
+     *
+     * @param detection The detection to start the new hypothesis from
+     */
+    void addHypothesis(const SSLBallData &detection);
+
+    /**
+     * Removes the hypothesis at the given index
+     *
+     * @param index The index of the hypothesis to remove
+     */
+    void removeHypothesis(std::size_t index);
+
+    // The hypotheses being tracked. Only the first num_hypotheses are valid
+    std::array<BallHypothesis, MAX_HYPOTHESES> hypotheses;
+    std::size_t num_hypotheses;
+    // The timestamp of the last filtered data we returned, so our output never goes
+    // back in time when we switch hypotheses
+    double last_output_timestamp;
 };
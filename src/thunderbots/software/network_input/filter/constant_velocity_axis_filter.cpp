@@ -0,0 +1,57 @@
+#include "network_input/filter/constant_velocity_axis_filter.h"
+
+ConstantVelocityAxisState ConstantVelocityAxisFilter::createState(
+    double position, double position_variance, double velocity_variance)
+{
+    ConstantVelocityAxisState state;
+    state.position                     = position;
+    state.velocity                     = 0;
+    state.position_variance            = position_variance;
+    state.position_velocity_covariance = 0;
+    state.velocity_variance            = velocity_variance;
+    return state;
+}
+
+ConstantVelocityAxisState ConstantVelocityAxisFilter::predict(
+    const ConstantVelocityAxisState &state, double dt, double acceleration_noise)
+{
+    // x' = F * x, and P' = F * P * F^T + Q, where F = [1 dt; 0 1] and Q is the
+    // covariance of the continuous white noise acceleration model
+    ConstantVelocityAxisState predicted;
+    predicted.position = state.position + state.velocity * dt;
+    predicted.velocity = state.velocity;
+    predicted.position_variance =
+        state.position_variance + 2 * dt * state.position_velocity_covariance +
+        dt * dt * state.velocity_variance + acceleration_noise * dt * dt * dt / 3;
+    predicted.position_velocity_covariance = state.position_velocity_covariance +
+                                             dt * state.velocity_variance +
+                                             acceleration_noise * dt * dt / 2;
+    predicted.velocity_variance = state.velocity_variance + acceleration_noise * dt;
+    return predicted;
+}
+
+double ConstantVelocityAxisFilter::getInnovationVariance(
+    const ConstantVelocityAxisState &state, double measurement_variance)
+{
+    return state.position_variance + measurement_variance;
+}
+
+ConstantVelocityAxisState ConstantVelocityAxisFilter::update(
+    const ConstantVelocityAxisState &state, double innovation,
+    double measurement_variance)
+{
+    // We only measure position, so H = [1 0]
+    const double innovation_variance = getInnovationVariance(state, measurement_variance);
+    const double position_gain       = state.position_variance / innovation_variance;
+    const double velocity_gain = state.position_velocity_covariance / innovation_variance;
+
+    ConstantVelocityAxisState updated;
+    updated.position          = state.position + position_gain * innovation;
+    updated.velocity          = state.velocity + velocity_gain * innovation;
+    updated.position_variance = (1 - position_gain) * state.position_variance;
+    updated.position_velocity_covariance =
+        (1 - position_gain) * state.position_velocity_covariance;
+    updated.velocity_variance =
+        state.velocity_variance - velocity_gain * state.position_velocity_covariance;
+    return updated;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+/**
+ * The state of a 1-dimensional constant-velocity Kalman filter, along with the
+ * covariance matrix of its position and velocity (which is symmetric, so we only store
+ * 3 of its entries)
+ */
+typedef struct
+{
+    double position;
+    double velocity;
+    double position_variance;
+    double position_velocity_covariance;
+    double velocity_variance;
+} ConstantVelocityAxisState;
+
+/**
+ * The predict and update steps of a 1-dimensional constant-velocity Kalman filter that
+ * measures position only.
+ *
+ * The filters in network_input model the motion along each axis (x, y, and orientation)
+ * as independent of the others, so each axis can be filtered separately. This gives
+ * exactly the same results as filtering all the axes together with one large filter,
+ * but only needs a handful of scalar operations instead of matrix multiplications and
+ * inversions.
+ */
+class ConstantVelocityAxisFilter
+{
+   public:
+    /**
+     * Returns the state of a newly detected object
+     *
+     * @param position The measured position of the object
+     * @param position_variance The variance of the measured position
+     * @param velocity_variance The variance of our initial guess of the velocity,
+     * which is 0
+     *
+     * @return the state of the newly detected object
+     */
+    static ConstantVelocityAxisState createState(double position,
+                                                 double position_variance,
+                                                 double velocity_variance);
+
+    /**
+     * Returns the given state predicted forwards by the given amount of time
+     *
+     * @param state The state to predict
+     * @param dt The amount of time to predict forwards, in seconds
+     * @param acceleration_noise The spectral density of the unmodelled acceleration,
+     * in units^2/s^3. Larger values follow sudden changes in velocity more quickly but
+     * give noisier estimates
+     *
+     * @return the predicted state
+     */
+    static ConstantVelocityAxisState predict(const ConstantVelocityAxisState &state,
+                                             double dt, double acceleration_noise);
+
+    /**
+     * Returns the variance of the innovation (the difference between a measured
+     * position and the position of the given state)
+     *
+     * @param state The state being measured
+     * @param measurement_variance The variance of the measurement
+     *
+     * @return the variance of the innovation
+     */
+    static double getInnovationVariance(const ConstantVelocityAxisState &state,
+                                        double measurement_variance);
+
+    /**
+     * Returns the given state updated with a measurement of the position.
+     *
+     * This takes the innovation rather than the measured position so that axes like
+     * orientation, where the difference between two positions must be wrapped, can use
+     * the same filter
+     *
+     * @param state The state to update
+     * @param innovation The measured position minus the position of the state
+     * @param measurement_variance The variance of the measurement
+     *
+     * @return the updated state
+     */
+    static ConstantVelocityAxisState update(const ConstantVelocityAxisState &state,
+                                            double innovation,
+                                            double measurement_variance);
+};
@@ -1,16 +1,151 @@
 #include "robot_filter.h"
 
-#include <ros/console.h>
+#include <cmath>
 
-RobotFilter::RobotFilter(unsigned int id) : robot_id(id) {}
+#include "shared/constants.h"
 
-FilteredRobotData RobotFilter::getFilteredData(
+namespace
+{
+    // The variance of the robot positions reported by SSL Vision, in m^2
+    constexpr double POSITION_MEASUREMENT_VARIANCE = 0.005 * 0.005;
+
+    // The variance of the robot orientations reported by SSL Vision, in rad^2
+    constexpr double ORIENTATION_MEASUREMENT_VARIANCE = 0.02 * 0.02;
+
+    // How much the robot's velocity and angular velocity are expected to change, as the
+    // spectral densities of its acceleration in m^2/s^3 and its angular acceleration in
+    // rad^2/s^3
+    constexpr double ACCELERATION_NOISE         = 10.0;
+    constexpr double ANGULAR_ACCELERATION_NOISE = 50.0;
+
+    // If a robot has not been detected for longer than this, in seconds, we no longer
+    // trust our estimate of how it is moving and start filtering it from scratch. This
+    // also handles the vision system restarting with a different time base
+    constexpr double ROBOT_TIMEOUT_SECONDS = 0.5;
+
+    /**
+     * Wraps the given angle in radians to [-pi, pi]
+     */
+    double wrapRadians(double radians)
+    {
+        return Angle::ofRadians(radians).angleMod().toRadians();
+    }
+}  // namespace
+
+RobotFilter::RobotFilter(unsigned int id)
+    : robot_id(id), initialized(false), x(), y(), orientation(), timestamp(0)
+{
+}
+
+std::optional<FilteredRobotData> RobotFilter::getFilteredData(
     const std::vector<SSLRobotData> &new_robot_data)
 {
-    return FilteredRobotData();
+    const SSLRobotData *best_detection = nullptr;
+    for (const SSLRobotData &robot_data : new_robot_data)
+    {
+        if (robot_data.id == robot_id &&
+            (!best_detection || robot_data.confidence > best_detection->confidence))
+        {
+            best_detection = &robot_data;
+        }
+    }
+
+    if (best_detection)
+    {
+        return getFilteredData(*best_detection);
+    }
+    if (initialized)
+    {
+        return getCurrentData();
+    }
+
+    return std::nullopt;
+}
+
+std::optional<FilteredRobotData> RobotFilter::getFilteredData(
+    const SSLRobotData &new_robot_data)
+{
+    if (new_robot_data.id == robot_id)
+    {
+        double dt = new_robot_data.timestamp - timestamp;
+        if (!initialized || std::fabs(dt) > ROBOT_TIMEOUT_SECONDS)
+        {
+            initialize(new_robot_data);
+        }
+        else if (dt > 0)
+        {
+            update(new_robot_data);
+        }
+        // Otherwise we have already used this or newer data, so there is nothing to do
+    }
+
+    if (initialized)
+    {
+        return getCurrentData();
+    }
+
+    return std::nullopt;
 }
 
 unsigned int RobotFilter::getRobotId() const
 {
     return robot_id;
 }
+
+void RobotFilter::initialize(const SSLRobotData &new_robot_data)
+{
+    x = ConstantVelocityAxisFilter::createState(
+        new_robot_data.position.x(), POSITION_MEASUREMENT_VARIANCE,
+        ROBOT_MAX_SPEED_METERS_PER_SECOND * ROBOT_MAX_SPEED_METERS_PER_SECOND);
+    y = ConstantVelocityAxisFilter::createState(
+        new_robot_data.position.y(), POSITION_MEASUREMENT_VARIANCE,
+        ROBOT_MAX_SPEED_METERS_PER_SECOND * ROBOT_MAX_SPEED_METERS_PER_SECOND);
+    orientation = ConstantVelocityAxisFilter::createState(
+        wrapRadians(new_robot_data.orientation.toRadians()),
+        ORIENTATION_MEASUREMENT_VARIANCE,
+        ROBOT_MAX_ANG_SPEED_RAD_PER_SECOND * ROBOT_MAX_ANG_SPEED_RAD_PER_SECOND);
+    timestamp   = new_robot_data.timestamp;
+    initialized = true;
+}
+
+void RobotFilter::update(const SSLRobotData &new_robot_data)
+{
+    const double dt = new_robot_data.timestamp - timestamp;
+
+    for (auto [axis, measured_position] :
+         {std::make_pair(&x, new_robot_data.position.x()),
+          std::make_pair(&y, new_robot_data.position.y())})
+    {
+        ConstantVelocityAxisState predicted =
+            ConstantVelocityAxisFilter::predict(*axis, dt, ACCELERATION_NOISE);
+        *axis = ConstantVelocityAxisFilter::update(predicted,
+                                                   measured_position - predicted.position,
+                                                   POSITION_MEASUREMENT_VARIANCE);
+    }
+
+    // The predicted orientation can leave [-pi, pi], and the measured orientation can
+    // be on the other side of +/-pi from it, so both the innovation and the result
+    // are wrapped
+    ConstantVelocityAxisState predicted_orientation =
+        ConstantVelocityAxisFilter::predict(orientation, dt, ANGULAR_ACCELERATION_NOISE);
+    double orientation_innovation = wrapRadians(new_robot_data.orientation.toRadians() -
+                                                predicted_orientation.position);
+    orientation                   = ConstantVelocityAxisFilter::update(
+        predicted_orientation, orientation_innovation, ORIENTATION_MEASUREMENT_VARIANCE);
+    orientation.position = wrapRadians(orientation.position);
+
+    timestamp = new_robot_data.timestamp;
+}
+
+FilteredRobotData RobotFilter::getCurrentData() const
+{
+    FilteredRobotData filtered_data;
+    filtered_data.id               = robot_id;
+    filtered_data.position         = Point(x.position, y.position);
+    filtered_data.velocity         = Vector(x.velocity, y.velocity);
+    filtered_data.orientation      = Angle::ofRadians(orientation.position);
+    filtered_data.angular_velocity = AngularVelocity::ofRadians(orientation.velocity);
+    filtered_data.timestamp =
+        std::chrono::duration_cast<AITimestamp>(std::chrono::duration<double>(timestamp));
+    return filtered_data;
+}
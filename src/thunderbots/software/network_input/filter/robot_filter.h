@@ -1,9 +1,11 @@
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include "geom/angle.h"
 #include "geom/point.h"
+#include "network_input/filter/constant_velocity_axis_filter.h"
 #include "util/timestamp.h"
 
 /**
@@ -34,6 +36,22 @@ typedef struct
     AITimestamp timestamp;
 } FilteredRobotData;
 
+/**
+ * Given robot data from SSL Vision, filters for and returns the position, velocity,
+ * orientation, and angular velocity of a single robot.
+ *
+ * This is an extended Kalman filter with a constant velocity model, whose state is the
+ * robot's position, velocity, orientation, and angular velocity. Our robots are
+ * holonomic, so their motion along x, y, and orientation is independent and each axis
+ * is filtered separately. Orientation is the only non-linear part of the model: it is
+ * wrapped to [-pi, pi] after every step, and the difference between the measured and
+ * estimated orientation is wrapped the same way, so the filter behaves correctly when
+ * the robot turns through +/-pi.
+ *
+ * All times are the capture times reported by SSL Vision, in seconds.
+ *
+ * The filter keeps all of its state in place, so updating it never allocates.
+ */
 class RobotFilter
 {
    public:
@@ -51,10 +69,25 @@ class RobotFilter
      * @param new_robot_data A list of SSLRobot detections containing new robot data.
      * The data does not all have to be for a particular Robot, the filter will only use
      * the new Robot data that matches the robot id the filter was constructed with.
+     * If there are several detections of the robot, the most confident one is used.
      *
-     * @return The filtered data for the robot
+     * @return The filtered data for the robot, or std::nullopt if the robot has never
+     * been detected
      */
-    FilteredRobotData getFilteredData(const std::vector<SSLRobotData> &new_robot_data);
+    std::optional<FilteredRobotData> getFilteredData(
+        const std::vector<SSLRobotData> &new_robot_data);
+
+    /**
+     * Updates the filter given a single new detection of the robot, and returns the
+     * most up to date filtered data for the Robot.
+     *
+     * @param new_robot_data A detection of the robot. Detections of other robots are
+     * ignored
+     *
+     * @return The filtered data for the robot, or std::nullopt if the robot has never
+     * been detected
+     */
+    std::optional<FilteredRobotData> getFilteredData(const SSLRobotData &new_robot_data);
 
     /**
      * Returns the id of the Robot that this filter is filtering for
@@ -64,5 +97,38 @@ class RobotFilter
     unsigned int getRobotId() const;
 
    private:
+    /**
+     * Starts filtering the robot from scratch, using the given detection as its
+     * initial state
+     *
+     * @param new_robot_data The detection to start from
+     */
+    void initialize(const SSLRobotData &new_robot_data);
+
+    /**
+     * Predicts the state of the robot forwards to the time of the given detection, and
+     * updates it with the detection
+     *
+     * @param new_robot_data The detection to update the state with
+     */
+    void update(const SSLRobotData &new_robot_data);
+
+    /**
+     * Returns the current state of the filter as FilteredRobotData
+     *
+     * @return the current state of the filter
+     */
+    FilteredRobotData getCurrentData() const;
+
     unsigned int robot_id;
+
+    // Whether or not the robot has been detected yet. None of the other state is
+    // valid until it has
+    bool initialized;
+    ConstantVelocityAxisState x;
+    ConstantVelocityAxisState y;
+    // The orientation in radians, always in [-pi, pi]
+    ConstantVelocityAxisState orientation;
+    // The capture time of the last detection used to update the filter
+    double timestamp;
 };
@@ -1,15 +1,28 @@
 #pragma once
 
-#include <map>
+#include <array>
+#include <optional>
 #include <vector>
 
 #include "geom/angle.h"
 #include "geom/point.h"
 #include "robot_filter.h"
 
+/**
+ * Filters the data for a whole team of robots, using a RobotFilter for each robot.
+ *
+ * The filters are stored in a flat array indexed by robot id, so finding a robot's
+ * filter is a single array access. A robot's filter is created the first time it is
+ * detected and kept from then on, and the filtered data is stored in a list that is
+ * reused between updates, so updating the filter never allocates.
+ */
 class RobotTeamFilter
 {
    public:
+    // The number of robot ids SSL Vision can report. Detections of robots with larger
+    // ids are ignored
+    static constexpr unsigned int MAX_ROBOT_IDS = 16;
+
     /**
      * Creates a new Robot Team Filter
      */
@@ -17,30 +30,25 @@ class RobotTeamFilter
 
     /**
      * Updates the filter given a new set of data, and returns the most up to date
-     * filtered data for the team of robots
+     * filtered data for the robots that were detected
      *
      * @param new_team_data A list of new SSL Robot detections
      *
-     * @return The filtered data for the team of robots
+     * @return The filtered data for each robot in new_team_data, ordered by robot id.
+     * The returned list is only valid until the next time this function is called
      */
-    std::vector<FilteredRobotData> getFilteredData(
+    const std::vector<FilteredRobotData> &getFilteredData(
         const std::vector<SSLRobotData> &new_team_data);
 
    private:
-    // This struct is just a placeholder for now. A proper team filter that utilizes the
-    // Robot filters should be completed as part of
-    // https://github.com/UBC-Thunderbots/Software/issues/200
-    struct RobotData
-    {
-        RobotData(Point position, Angle orientation, double timestamp)
-            : position(position), orientation(orientation), timestamp(timestamp)
-        {
-        }
-
-        Point position;
-        Angle orientation;
-        double timestamp;
-    };
-
-    std::map<unsigned int, RobotData> robot_map;
+    // The filter for each robot id, or std::nullopt if the robot with that id has never
+    // been detected
+    std::array<std::optional<RobotFilter>, MAX_ROBOT_IDS> robot_filters;
+
+    // The most confident detection of each robot id in the current update
+    std::array<const SSLRobotData *, MAX_ROBOT_IDS> robot_detections;
+
+    // The filtered data returned by getFilteredData. We keep this around so we don't
+    // need to allocate a new list every update
+    std::vector<FilteredRobotData> filtered_team_data;
 };
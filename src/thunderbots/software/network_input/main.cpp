@@ -5,13 +5,79 @@
 #include "geom/point.h"
 #include "network_input/backend.h"
 #include "network_input/networking/ssl_vision_client.h"
+#include "network_input/networking/vision_packet_recorder.h"
+#include "network_input/networking/vision_packet_replayer.h"
 #include "thunderbots_msgs/Ball.h"
 #include "thunderbots_msgs/Field.h"
+#include "thunderbots_msgs/Metrics.h"
 #include "thunderbots_msgs/Team.h"
 #include "util/constants.h"
+#include "util/latency_tracer.h"
 #include "util/logger/init.h"
+#include "util/metrics/metrics_exporter.h"
+#include "util/metrics/metrics_registry.h"
 #include "util/timestamp.h"
 
+// The stages of the capture-to-command pipeline that this node measures the latency of
+enum NetworkInputLatencyStage
+{
+    // From SSL Vision capturing a frame to us processing the packet containing it
+    CAPTURE_TO_PROCESS,
+    // The time taken to process a packet and publish the messages it produced
+    PROCESS_PACKET,
+    // From SSL Vision capturing a frame to us publishing the data filtered from it
+    CAPTURE_TO_PUBLISH
+};
+
+// The metrics we keep for each SSL Vision camera
+typedef struct
+{
+    // The number of packets received from the camera
+    MetricCounter* packets;
+    // The number of frames from the camera that we never received, found from gaps
+    // in the frame numbers
+    MetricCounter* missed_frames;
+    // The frame number of the last packet from the camera
+    unsigned int last_frame_number;
+} CameraMetrics;
+
+/**
+ * Counts a packet from an SSL Vision camera in the camera's metrics, and counts any
+ * frames from the camera we missed since the last packet from it
+ *
+ * @param detection The detection frame in the packet
+ * @param metrics The registry to create the camera's metrics in, if this is the first
+ * packet from the camera
+ * @param camera_metrics The metrics for each camera, by camera id
+ */
+void recordCameraPacket(const SSL_DetectionFrame& detection, MetricsRegistry& metrics,
+                        std::map<unsigned int, CameraMetrics>& camera_metrics)
+{
+    auto camera = camera_metrics.find(detection.camera_id());
+    if (camera == camera_metrics.end())
+    {
+        std::string camera_name = "camera_" + std::to_string(detection.camera_id());
+        CameraMetrics new_camera_metrics;
+        new_camera_metrics.packets =
+            &metrics.getCounter("network_input.vision_packets." + camera_name);
+        new_camera_metrics.missed_frames =
+            &metrics.getCounter("network_input.missed_vision_frames." + camera_name);
+        new_camera_metrics.last_frame_number = detection.frame_number();
+        new_camera_metrics.packets->increment();
+        camera_metrics.emplace(detection.camera_id(), new_camera_metrics);
+        return;
+    }
+
+    camera->second.packets->increment();
+    // Frame numbers that go backwards mean SSL Vision was restarted, which isn't a gap
+    if (detection.frame_number() > camera->second.last_frame_number + 1)
+    {
+        camera->second.missed_frames->increment(detection.frame_number() -
+                                                camera->second.last_frame_number - 1);
+    }
+    camera->second.last_frame_number = detection.frame_number();
+}
+
 int main(int argc, char** argv)
 {
     // Init ROS node
@@ -27,9 +93,10 @@ int main(int argc, char** argv)
     ros::Publisher ball_publisher = node_handle.advertise<thunderbots_msgs::Ball>(
         Util::Constants::NETWORK_INPUT_BALL_TOPIC,
         Util::Constants::NUMBER_OF_SSL_VISION_CAMERAS);
+    // The field geometry is only published when it changes, so its topic is latched to
+    // make sure nodes that subscribe later still receive the latest geometry
     ros::Publisher field_publisher = node_handle.advertise<thunderbots_msgs::Field>(
-        Util::Constants::NETWORK_INPUT_FIELD_TOPIC,
-        Util::Constants::NUMBER_OF_SSL_VISION_CAMERAS);
+        Util::Constants::NETWORK_INPUT_FIELD_TOPIC, 1, true);
     ros::Publisher friendly_team_publisher =
         node_handle.advertise<thunderbots_msgs::Team>(
             Util::Constants::NETWORK_INPUT_FRIENDLY_TEAM_TOPIC,
@@ -41,16 +108,70 @@ int main(int argc, char** argv)
     // Initialize the logger
     Util::Logger::LoggerSingleton::initializeLogger(node_handle);
 
+    // Recording and playing back SSL Vision packets is set up with private parameters,
+    // which can be given to the node from a launch file. If replay_file is set we play
+    // back that recording instead of listening to SSL Vision. If record_file is set we
+    // record every packet we receive from SSL Vision to that file. replay_speed is
+    // relative to the recorded speed, and replay_as_fast_as_possible ignores it and plays
+    // back the recording as fast as we can process it
+    ros::NodeHandle private_node_handle("~");
+    std::string record_file_path;
+    std::string replay_file_path;
+    double replay_speed;
+    bool replay_as_fast_as_possible;
+    private_node_handle.param<std::string>("record_file", record_file_path, "");
+    private_node_handle.param<std::string>("replay_file", replay_file_path, "");
+    private_node_handle.param<double>("replay_speed", replay_speed, 1.0);
+    private_node_handle.param<bool>("replay_as_fast_as_possible",
+                                    replay_as_fast_as_possible, false);
+    // Written so that NaN is rejected too
+    if (!(replay_speed > 0))
+    {
+        std::cerr << "replay_speed must be greater than 0, but it is " << replay_speed
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // A snapshot of the node's metrics is periodically written to metrics_file and
+    // published on the diagnostics topic
+    std::string metrics_file_path;
+    private_node_handle.param<std::string>(
+        "metrics_file", metrics_file_path,
+        Util::Constants::METRICS_FILE_DIRECTORY + "/network_input_metrics.txt");
+    ros::Publisher metrics_publisher = node_handle.advertise<thunderbots_msgs::Metrics>(
+        Util::Constants::DIAGNOSTICS_METRICS_TOPIC, 1);
+
     // Set up our connection over udp to receive camera packets
     // NOTE: We do this before initializing the ROS node so that if it
     // fails because there is another instance of this node running
     // and connected to the port we want, we don't kill that other node.
-    std::unique_ptr<SSLVisionClient> ssl_vision_client;
+    std::unique_ptr<VisionPacketSource> vision_packet_source;
     try
     {
-        ssl_vision_client = std::make_unique<SSLVisionClient>(
-            Util::Constants::SSL_VISION_MULTICAST_ADDRESS,
-            Util::Constants::SSL_VISION_MULTICAST_PORT);
+        if (!replay_file_path.empty())
+        {
+            vision_packet_source = std::make_unique<VisionPacketReplayer>(
+                replay_file_path, replay_as_fast_as_possible
+                                      ? VisionPacketReplayer::AS_FAST_AS_POSSIBLE
+                                      : replay_speed);
+        }
+        else
+        {
+            std::unique_ptr<VisionPacketRecorder> packet_recorder;
+            if (!record_file_path.empty())
+            {
+                packet_recorder =
+                    std::make_unique<VisionPacketRecorder>(record_file_path);
+            }
+
+            // We receive packets on a separate thread so that they are parsed as soon
+            // as they arrive, rather than waiting in the socket until the next loop
+            // iteration
+            vision_packet_source = std::make_unique<SSLVisionClient>(
+                Util::Constants::SSL_VISION_MULTICAST_ADDRESS,
+                Util::Constants::SSL_VISION_MULTICAST_PORT, true,
+                std::move(packet_recorder));
+        }
     }
     catch (const boost::exception& ex)
     {
@@ -59,46 +180,165 @@ int main(int argc, char** argv)
                   << boost::diagnostic_information(ex) << std::endl;
         return EXIT_FAILURE;
     }
+    catch (const std::runtime_error& ex)
+    {
+        std::cerr << "An error occured while setting up SSL Vision packet recording or "
+                     "playback:"
+                  << std::endl
+                  << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
 
     // Init our backend class
     Backend backend = Backend();
 
+    // The messages the backend fills in. We reuse these for every packet so that we
+    // don't create new messages every time
+    BackendMessages messages = BackendMessages();
+
+    LatencyTracer latency_tracer(
+        {"capture_to_process", "process_packet", "capture_to_publish"},
+        Util::Constants::LATENCY_REPORT_PERIOD);
+
+    MetricsRegistry metrics;
+    MetricsExporter metrics_exporter(metrics, Util::Constants::METRICS_EXPORT_PERIOD);
+    const std::vector<double> processing_time_bucket_bounds_us =
+        MetricHistogram::createExponentialBucketBounds(1, 1.25, 64);
+    MetricCounter& vision_packets_metric =
+        metrics.getCounter("network_input.vision_packets");
+    MetricCounter& dropped_vision_packets_metric =
+        metrics.getCounter("network_input.dropped_vision_packets");
+    MetricHistogram& packet_processing_time_metric = metrics.getHistogram(
+        "network_input.packet_processing_time_us", processing_time_bucket_bounds_us);
+    MetricHistogram& filter_update_time_metric = metrics.getHistogram(
+        "network_input.filter_update_time_us", processing_time_bucket_bounds_us);
+    MetricCounter& field_msgs_published_metric =
+        metrics.getCounter("network_input.field_msgs_published");
+    MetricCounter& ball_msgs_published_metric =
+        metrics.getCounter("network_input.ball_msgs_published");
+    MetricCounter& team_msgs_published_metric =
+        metrics.getCounter("network_input.team_msgs_published");
+    // Cameras are added the first time we receive a packet from them
+    std::map<unsigned int, CameraMetrics> camera_metrics;
+
+    // Publishes each of the messages that were updated by the backend, and records how
+    // long the backend took to filter them
+    auto publish_updated_messages = [&]() {
+        if (messages.filter_update_time)
+        {
+            filter_update_time_metric.record(static_cast<double>(
+                Timestamp::getMicroseconds(*messages.filter_update_time)));
+        }
+
+        if (messages.field_msg_updated)
+        {
+            field_publisher.publish(messages.field_msg);
+            field_msgs_published_metric.increment();
+        }
+        if (messages.ball_msg_updated)
+        {
+            ball_publisher.publish(messages.ball_msg);
+            ball_msgs_published_metric.increment();
+        }
+        if (messages.friendly_team_msg_updated)
+        {
+            friendly_team_publisher.publish(messages.friendly_team_msg);
+            team_msgs_published_metric.increment();
+        }
+        if (messages.enemy_team_msg_updated)
+        {
+            enemy_team_publisher.publish(messages.enemy_team_msg);
+            team_msgs_published_metric.increment();
+        }
+
+        // Both teams are filtered from the same frame, so either one tells us when
+        // the frame was captured
+        if (messages.friendly_team_msg_updated || messages.enemy_team_msg_updated)
+        {
+            const thunderbots_msgs::Team& team_msg = messages.friendly_team_msg_updated
+                                                         ? messages.friendly_team_msg
+                                                         : messages.enemy_team_msg;
+            latency_tracer.recordLatency(
+                CAPTURE_TO_PUBLISH,
+                Timestamp::getSystemTimestampNow() -
+                    Timestamp::fromMicroseconds(team_msg.capture_timestamp_microseconds));
+        }
+    };
+
+    // The number of dropped vision packets the last time we checked
+    unsigned long num_dropped_packets = 0;
+
+    // The packets received each loop iteration. We reuse this so that we don't allocate
+    // a new container every time
+    std::vector<SSL_WrapperPacket> ssl_vision_packets;
+
     // Main loop
     while (ros::ok())
     {
-        auto ssl_vision_packet_queue = ssl_vision_client->getVisionPacketQueue();
-        while (!ssl_vision_packet_queue.empty())
+        // Sleep until a packet arrives, but wake up often enough to still publish the
+        // frames that time out if some of the cameras stop sending data
+        vision_packet_source->getVisionPackets(
+            ssl_vision_packets, Util::Constants::SSL_VISION_PACKET_WAIT_TIMEOUT);
+        for (const SSL_WrapperPacket& ssl_vision_packet : ssl_vision_packets)
         {
-            auto ssl_vision_packet = ssl_vision_packet_queue.front();
-            ssl_vision_packet_queue.pop();
-
-            std::optional<thunderbots_msgs::Field> field_msg =
-                backend.getFieldMsg(ssl_vision_packet);
-            if (field_msg)
+            AITimestamp process_start_time = Timestamp::getTimestampNow();
+            vision_packets_metric.increment();
+            if (ssl_vision_packet.has_detection())
             {
-                field_publisher.publish(*field_msg);
-            }
+                recordCameraPacket(ssl_vision_packet.detection(), metrics,
+                                   camera_metrics);
 
-            std::optional<thunderbots_msgs::Ball> ball_msg =
-                backend.getFilteredBallMsg(ssl_vision_packet);
-            if (ball_msg)
-            {
-                ball_publisher.publish(*ball_msg);
+                latency_tracer.recordLatency(
+                    CAPTURE_TO_PROCESS,
+                    Timestamp::getSystemTimestampNow() -
+                        std::chrono::duration_cast<AITimestamp>(
+                            std::chrono::duration<double>(
+                                ssl_vision_packet.detection().t_capture())));
             }
 
-            std::optional<thunderbots_msgs::Team> friendly_team_msg =
-                backend.getFilteredFriendlyTeamMsg(ssl_vision_packet);
-            if (friendly_team_msg)
-            {
-                friendly_team_publisher.publish(*friendly_team_msg);
-            }
+            backend.processPacket(ssl_vision_packet, process_start_time, messages);
+            publish_updated_messages();
+
+            AITimestamp processing_time =
+                Timestamp::getTimestampNow() - process_start_time;
+            latency_tracer.recordLatency(PROCESS_PACKET, processing_time);
+            packet_processing_time_metric.record(
+                static_cast<double>(Timestamp::getMicroseconds(processing_time)));
+        }
 
-            std::optional<thunderbots_msgs::Team> enemy_team_msg =
-                backend.getFilteredEnemyTeamMsg(ssl_vision_packet);
-            if (enemy_team_msg)
+        // Make sure we still publish data if some of the cameras stop sending it
+        backend.processTimedOutFrames(Timestamp::getTimestampNow(), messages);
+        publish_updated_messages();
+
+        if (vision_packet_source->getNumDroppedPackets() != num_dropped_packets)
+        {
+            dropped_vision_packets_metric.increment(
+                vision_packet_source->getNumDroppedPackets() - num_dropped_packets);
+            num_dropped_packets = vision_packet_source->getNumDroppedPackets();
+            LOG(WARNING) << "SSL Vision packets are being dropped because they are not "
+                            "being processed fast enough. Total dropped packets: "
+                         << num_dropped_packets << std::endl;
+        }
+
+        std::optional<std::string> latency_report =
+            latency_tracer.getPeriodicReport(Timestamp::getTimestampNow());
+        if (latency_report)
+        {
+            LOG(INFO) << *latency_report << std::endl;
+        }
+
+        std::optional<std::vector<MetricSample>> metrics_snapshot =
+            metrics_exporter.getPeriodicSnapshot(Timestamp::getTimestampNow());
+        if (metrics_snapshot)
+        {
+            if (!MetricsExporter::writeSnapshotToFile(metrics_file_path, "network_input",
+                                                      *metrics_snapshot))
             {
-                enemy_team_publisher.publish(*enemy_team_msg);
+                LOG(WARNING) << "Could not write metrics to " << metrics_file_path
+                             << std::endl;
             }
+            metrics_publisher.publish(
+                MetricsExporter::createMetricsMsg("network_input", *metrics_snapshot));
         }
 
         // We spin once here so any callbacks in this node can run (if we ever add them)
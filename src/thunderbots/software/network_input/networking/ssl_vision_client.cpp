@@ -1,9 +1,14 @@
 #include "network_input/networking/ssl_vision_client.h"
 
 #include "util/logger/init.h"
+#include "util/timestamp.h"
 
-SSLVisionClient::SSLVisionClient(const std::string ip_address, const unsigned short port)
-    : socket_(io_service)
+SSLVisionClient::SSLVisionClient(const std::string ip_address, const unsigned short port,
+                                 bool use_receive_thread,
+                                 std::unique_ptr<VisionPacketRecorder> packet_recorder)
+    : socket_(io_service),
+      num_dropped_packets(0),
+      packet_recorder(std::move(packet_recorder))
 {
     boost::asio::ip::udp::endpoint listen_endpoint(
         boost::asio::ip::address::from_string(ip_address), port);
@@ -31,6 +36,29 @@ SSLVisionClient::SSLVisionClient(const std::string ip_address, const unsigned sh
     // Start listening for data asynchronously
     // See here for a great explanation about asynchronous operations:
     // https://stackoverflow.com/questions/34680985/what-is-the-difference-between-asynchronous-programming-and-multithreading
+    startListening();
+
+    if (use_receive_thread)
+    {
+        // The receive thread blocks inside run() until a packet arrives, and then runs
+        // handleDataReception() for it immediately. Because handleDataReception() always
+        // starts listening again, run() does not return until the io_service is stopped
+        receive_thread = std::thread([this]() { io_service.run(); });
+    }
+}
+
+SSLVisionClient::~SSLVisionClient()
+{
+    // Stopping the io_service makes run() return, which ends the receive thread
+    io_service.stop();
+    if (receive_thread.joinable())
+    {
+        receive_thread.join();
+    }
+}
+
+void SSLVisionClient::startListening()
+{
     socket_.async_receive_from(boost::asio::buffer(raw_received_data_, max_buffer_length),
                                sender_endpoint_,
                                boost::bind(&SSLVisionClient::handleDataReception, this,
@@ -43,32 +71,46 @@ void SSLVisionClient::handleDataReception(const boost::system::error_code& error
 {
     if (!error)
     {
-        // This function will be run for EVERY packet received from the network since the
-        // last time poll() was called. This means that this function may be called
-        // several times to process several packets. This is why we immediately store any
-        // received and processed data into the packet_queue. If we didn't save the
-        // received data somewhere else, the data would be overwritten by the packet
-        // being handled in the next handleDataReception function call
-        auto packet_data = SSL_WrapperPacket();
-        packet_data.ParseFromArray(raw_received_data_.data(),
-                                   static_cast<int>(num_bytes_received));
-        packet_queue.emplace(packet_data);
+        // This function may be called several times in a row to process several
+        // packets. This is why we immediately store any received and processed data
+        // into the packet_buffer. If we didn't save the received data somewhere else,
+        // the data would be overwritten by the packet being handled in the next
+        // handleDataReception function call
+        if (packet_recorder &&
+            !packet_recorder->recordPacket(raw_received_data_.data(), num_bytes_received,
+                                           Timestamp::getTimestampNow()))
+        {
+            // The recorder stops after a failed write, so we stop using it too rather
+            // than warning about every packet
+            LOG(WARNING) << "Could not write to the SSL Vision packet recording, so "
+                            "recording has stopped"
+                         << std::endl;
+            packet_recorder.reset();
+        }
+        received_packet.ParseFromArray(raw_received_data_.data(),
+                                       static_cast<int>(num_bytes_received));
+        if (packet_buffer.push(std::move(received_packet)))
+        {
+            // Taking the mutex after the push means a consumer that found the buffer
+            // empty is already waiting by the time we notify it, so it can't miss the
+            // packet and sleep for its whole timeout
+            {
+                std::lock_guard<std::mutex> lock(packet_available_mutex);
+            }
+            packet_available.notify_one();
+        }
+        else
+        {
+            num_dropped_packets++;
+        }
 
         // Once we've handled the data, start listening again
-        socket_.async_receive_from(
-            boost::asio::buffer(raw_received_data_, max_buffer_length), sender_endpoint_,
-            boost::bind(&SSLVisionClient::handleDataReception, this,
-                        boost::asio::placeholders::error,
-                        boost::asio::placeholders::bytes_transferred));
+        startListening();
     }
     else
     {
         // Start listening again to receive the next data
-        socket_.async_receive_from(
-            boost::asio::buffer(raw_received_data_, max_buffer_length), sender_endpoint_,
-            boost::bind(&SSLVisionClient::handleDataReception, this,
-                        boost::asio::placeholders::error,
-                        boost::asio::placeholders::bytes_transferred));
+        startListening();
 
         LOG(WARNING)
             << "An unknown network error occurred when attempting to receive SSL Vision Data. The boost system error code is "
@@ -76,20 +118,34 @@ void SSLVisionClient::handleDataReception(const boost::system::error_code& error
     }
 }
 
-const std::queue<SSL_WrapperPacket> SSLVisionClient::getVisionPacketQueue()
+void SSLVisionClient::getVisionPackets(std::vector<SSL_WrapperPacket>& packets,
+                                       const AITimestamp& max_wait_time)
 {
-    // Calling the poll() function will cause a handleDataReception() function to run for
-    // EVERY packet of data that was received since the last time poll() was called.
-    // Note that handleDataReception() may run multiple times in order to handle the
-    // multiple received packets. This is why we move the data from the buffer into the
-    // packet_queue, so that any subsequent handleDataReception() calls do not overwrite
-    // the data
-    io_service.poll();
+    if (receive_thread.joinable())
+    {
+        std::unique_lock<std::mutex> lock(packet_available_mutex);
+        packet_available.wait_for(lock, max_wait_time,
+                                  [this]() { return !packet_buffer.empty(); });
+    }
+    else
+    {
+        // Calling the poll() function will cause a handleDataReception() function to
+        // run for EVERY packet of data that was received since the last time poll() was
+        // called. If the receive thread is being used it has already done this for us
+        io_service.poll();
+    }
 
-    // Make a copy of the data to return
-    std::queue<SSL_WrapperPacket> packet_queue_copy = packet_queue;
-    // Clear the packet_queue
-    packet_queue = {};
+    // Move the data out of the buffer, so the buffer is empty again. Only this thread
+    // pops from the buffer, so it can't become empty between the check and the pop
+    packets.clear();
+    while (!packet_buffer.empty())
+    {
+        packets.emplace_back();
+        packet_buffer.pop(packets.back());
+    }
+}
 
-    return packet_queue_copy;
+unsigned long SSLVisionClient::getNumDroppedPackets() const
+{
+    return num_dropped_packets.load();
 }
@@ -1,13 +1,21 @@
 #pragma once
 
+#include <atomic>
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
-#include <queue>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "network_input/networking/vision_packet_recorder.h"
+#include "network_input/networking/vision_packet_source.h"
 #include "proto/messages_robocup_ssl_wrapper.pb.h"
+#include "util/spsc_ring_buffer.h"
 
-class SSLVisionClient
+class SSLVisionClient : public VisionPacketSource
 {
    public:
     /**
@@ -17,24 +25,48 @@ class SSLVisionClient
      * @param ip_address The ip address of the multicast group on which to listen for
      * SSL Vision packets
      * @param port The port on which to listen for SSL Vision packets
+     * @param use_receive_thread If true, packets are received and parsed on a dedicated
+     * thread as soon as they arrive, rather than waiting for the next call to
+     * getVisionPackets(). If false, all packets are received and parsed on the
+     * calling thread when getVisionPackets() is called
+     * @param packet_recorder If not null, every packet is recorded with this recorder
+     * as it is received, before it is parsed
      */
-    SSLVisionClient(const std::string ip_address, const unsigned short port);
+    SSLVisionClient(const std::string ip_address, const unsigned short port,
+                    bool use_receive_thread                               = false,
+                    std::unique_ptr<VisionPacketRecorder> packet_recorder = nullptr);
+
+    ~SSLVisionClient() override;
+
+    /**
+     * Waits until there is at least one new SSL Vision WrapperPacket, or the given time
+     * has passed, and then fills the given vector with every packet that was received
+     * since the last time this function was called. If no new data was received, the
+     * vector will be empty. Only the receive thread lets us wait for a packet, so if it
+     * is not being used this returns immediately with whatever has already arrived
+     *
+     * @param packets The vector to fill with the packets received since the last time
+     * this function was called. Its previous contents are replaced
+     * @param max_wait_time The longest time to wait for a packet to arrive
+     */
+    void getVisionPackets(std::vector<SSL_WrapperPacket> &packets,
+                          const AITimestamp &max_wait_time) override;
 
     /**
-     * Returns a queue of new SSL Vision WrapperPackets that were received since last time
-     * this function was called. If no new data was received since the last time this
-     * function was called, the queue will be empty
+     * Returns the total number of packets that have been dropped because they were
+     * received while the packet buffer was full. Packets are dropped if they are not
+     * retrieved with getVisionPackets() quickly enough.
      *
-     * @return A queue of SSL_WrapperPackets received since the last time this function
-     * was called.
+     * @return the total number of packets that have been dropped
      */
-    const std::queue<SSL_WrapperPacket> getVisionPacketQueue();
+    unsigned long getNumDroppedPackets() const override;
 
    private:
     /**
      * The function that is called to process any data received by the io_service.
      * When io_service.poll() is called, this function will be run for EVERY packet
-     * received, which may be more than once.
+     * received, which may be more than once. If the receive thread is being used, this
+     * function is run on the receive thread as soon as each packet arrives.
      *
      * @param error The error code obtained when receiving the incoming data
      * @param num_bytes_received How many bytes of data were received
@@ -42,6 +74,12 @@ class SSLVisionClient
     void handleDataReception(const boost::system::error_code &error,
                              size_t num_bytes_received);
 
+    /**
+     * Starts listening asynchronously for the next packet. handleDataReception() will
+     * be called once it has been received
+     */
+    void startListening();
+
     boost::asio::io_service io_service;
     boost::asio::ip::udp::socket socket_;
     boost::asio::ip::udp::endpoint sender_endpoint_;
@@ -50,6 +88,29 @@ class SSLVisionClient
     static constexpr unsigned int max_buffer_length = 4096;
     // Acts as a buffer to store the raw received data from the network
     std::array<char, max_buffer_length> raw_received_data_;
-    // Stores the SSL_WrapperPackets that were received
-    std::queue<SSL_WrapperPacket> packet_queue;
+
+    // The maximum number of parsed packets that can be waiting to be retrieved with
+    // getVisionPackets(). With 4 cameras at 60Hz this gives us a bit over a quarter
+    // of a second of buffering before packets start getting dropped
+    static constexpr std::size_t max_buffered_packets = 64;
+    // Stores the SSL_WrapperPackets that were received. This is only ever written to by
+    // handleDataReception(), and only ever read from by getVisionPackets()
+    SPSCRingBuffer<SSL_WrapperPacket, max_buffered_packets> packet_buffer;
+    // Lets getVisionPackets() sleep until the receive thread pushes a packet into the
+    // packet_buffer. The buffer itself stays lock-free, the mutex only guards the wait
+    std::mutex packet_available_mutex;
+    std::condition_variable packet_available;
+    // The packet that received data is parsed into before being moved into the
+    // packet_buffer. We keep it around so we do not need to create a new one for
+    // every packet
+    SSL_WrapperPacket received_packet;
+    // The number of packets that were dropped because the packet_buffer was full
+    std::atomic<unsigned long> num_dropped_packets;
+
+    // Records every packet as it is received, if it is not null. This is only ever
+    // used by handleDataReception()
+    std::unique_ptr<VisionPacketRecorder> packet_recorder;
+
+    // The thread that receives and parses packets, if it is being used
+    std::thread receive_thread;
 };
@@ -0,0 +1,496 @@
+#include "network_input/networking/ssl_wire_decoder.h"
+
+#include <cstring>
+
+#include "shared/constants.h"
+
+namespace
+{
+    // The wire types used by protobuf to encode fields.
+    // See https://developers.google.com/protocol-buffers/docs/encoding#structure
+    enum WireType : uint32_t
+    {
+        VARINT           = 0,
+        FIXED_64         = 1,
+        LENGTH_DELIMITED = 2,
+        START_GROUP      = 3,
+        END_GROUP        = 4,
+        FIXED_32         = 5
+    };
+
+    /**
+     * Returns the tag that precedes a field with the given number and wire type
+     */
+    constexpr uint32_t makeTag(uint32_t field_number, WireType wire_type)
+    {
+        return (field_number << 3) | wire_type;
+    }
+
+    // The tags of the fields we decode from messages_robocup_ssl_wrapper.proto
+    constexpr uint32_t WRAPPER_DETECTION_TAG = makeTag(1, LENGTH_DELIMITED);
+    constexpr uint32_t WRAPPER_GEOMETRY_TAG  = makeTag(2, LENGTH_DELIMITED);
+
+    // The tags of the fields we decode from messages_robocup_ssl_detection.proto
+    constexpr uint32_t FRAME_FRAME_NUMBER_TAG  = makeTag(1, VARINT);
+    constexpr uint32_t FRAME_T_CAPTURE_TAG     = makeTag(2, FIXED_64);
+    constexpr uint32_t FRAME_T_SENT_TAG        = makeTag(3, FIXED_64);
+    constexpr uint32_t FRAME_CAMERA_ID_TAG     = makeTag(4, VARINT);
+    constexpr uint32_t FRAME_BALLS_TAG         = makeTag(5, LENGTH_DELIMITED);
+    constexpr uint32_t FRAME_ROBOTS_YELLOW_TAG = makeTag(6, LENGTH_DELIMITED);
+    constexpr uint32_t FRAME_ROBOTS_BLUE_TAG   = makeTag(7, LENGTH_DELIMITED);
+
+    // SSL_DetectionBall and SSL_DetectionRobot share the same field numbers for the
+    // fields they have in common
+    constexpr uint32_t DETECTION_CONFIDENCE_TAG  = makeTag(1, FIXED_32);
+    constexpr uint32_t DETECTION_ROBOT_ID_TAG    = makeTag(2, VARINT);
+    constexpr uint32_t DETECTION_X_TAG           = makeTag(3, FIXED_32);
+    constexpr uint32_t DETECTION_Y_TAG           = makeTag(4, FIXED_32);
+    constexpr uint32_t DETECTION_ORIENTATION_TAG = makeTag(5, FIXED_32);
+
+    /**
+     * Reads protobuf wire-format values from a buffer, checking that no read goes past
+     * the end of the buffer. Every read function returns false if the data is
+     * malformed, in which case the reader should not be used any further
+     */
+    class WireReader
+    {
+       public:
+        explicit WireReader(const uint8_t *data, std::size_t size)
+            : position(data), end(data + size)
+        {
+        }
+
+        bool atEnd() const
+        {
+            return position == end;
+        }
+
+        bool readVarint(uint64_t &value)
+        {
+            // Almost every varint we read (tags, ids, frame numbers) fits in a single
+            // byte, so we check for that case first
+            if (position != end && *position < 0x80)
+            {
+                value = *position++;
+                return true;
+            }
+
+            value = 0;
+            // A varint is at most 10 bytes long
+            for (unsigned int shift = 0; shift < 64; shift += 7)
+            {
+                if (position == end)
+                {
+                    return false;
+                }
+                const uint8_t byte = *position++;
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool readTag(uint32_t &tag)
+        {
+            uint64_t value;
+            if (!readVarint(value) || value > UINT32_MAX)
+            {
+                return false;
+            }
+            tag = static_cast<uint32_t>(value);
+            // Field number 0 is not valid
+            return tag >= (1 << 3);
+        }
+
+        // The wire format is little-endian, as are all the machines we run on, so
+        // fixed-size values can be copied straight out of the buffer
+        bool readFloat(float &value)
+        {
+            return readFixed(&value, sizeof(value));
+        }
+
+        bool readDouble(double &value)
+        {
+            return readFixed(&value, sizeof(value));
+        }
+
+        bool readLengthDelimited(WireReader &sub_reader)
+        {
+            uint64_t length;
+            if (!readVarint(length) || length > static_cast<uint64_t>(end - position))
+            {
+                return false;
+            }
+            sub_reader = WireReader(position, static_cast<std::size_t>(length));
+            position += length;
+            return true;
+        }
+
+        bool skipField(uint32_t tag)
+        {
+            uint64_t varint;
+            WireReader sub_reader(nullptr, 0);
+            switch (tag & 0x7)
+            {
+                case VARINT:
+                    return readVarint(varint);
+                case FIXED_64:
+                    return skipBytes(8);
+                case LENGTH_DELIMITED:
+                    return readLengthDelimited(sub_reader);
+                case FIXED_32:
+                    return skipBytes(4);
+                default:
+                    // Groups are deprecated and are not used by any SSL message
+                    return false;
+            }
+        }
+
+       private:
+        bool readFixed(void *value, std::size_t num_bytes)
+        {
+            if (static_cast<std::size_t>(end - position) < num_bytes)
+            {
+                return false;
+            }
+            std::memcpy(value, position, num_bytes);
+            position += num_bytes;
+            return true;
+        }
+
+        bool skipBytes(std::size_t num_bytes)
+        {
+            if (static_cast<std::size_t>(end - position) < num_bytes)
+            {
+                return false;
+            }
+            position += num_bytes;
+            return true;
+        }
+
+        const uint8_t *position;
+        const uint8_t *end;
+    };
+
+    /**
+     * Decodes a length-delimited SSL_DetectionBall and adds it to the given frame data.
+     * Only the fields we use are decoded, everything else is skipped
+     */
+    bool decodeBall(WireReader &reader, SSLDetectionFrameData &frame_data)
+    {
+        WireReader ball_reader(nullptr, 0);
+        if (!reader.readLengthDelimited(ball_reader))
+        {
+            return false;
+        }
+
+        float confidence = 0, x = 0, y = 0;
+        bool has_confidence = false, has_x = false, has_y = false;
+
+        while (!ball_reader.atEnd())
+        {
+            uint32_t tag;
+            if (!ball_reader.readTag(tag))
+            {
+                return false;
+            }
+
+            bool ok;
+            switch (tag)
+            {
+                case DETECTION_CONFIDENCE_TAG:
+                    ok = has_confidence = ball_reader.readFloat(confidence);
+                    break;
+                case DETECTION_X_TAG:
+                    ok = has_x = ball_reader.readFloat(x);
+                    break;
+                case DETECTION_Y_TAG:
+                    ok = has_y = ball_reader.readFloat(y);
+                    break;
+                default:
+                    ok = ball_reader.skipField(tag);
+            }
+
+            if (!ok)
+            {
+                return false;
+            }
+        }
+
+        if (!(has_confidence && has_x && has_y))
+        {
+            return false;
+        }
+
+        frame_data.addBallDetection(x, y, confidence);
+        return true;
+    }
+
+    /**
+     * Decodes a length-delimited SSL_DetectionRobot and adds it to the given frame data
+     * with the given function. Only the fields we use are decoded, everything else is
+     * skipped
+     */
+    bool decodeRobot(WireReader &reader, SSLDetectionFrameData &frame_data,
+                     void (SSLDetectionFrameData::*add_robot_detection)(
+                         unsigned int, double, double, double, double))
+    {
+        WireReader robot_reader(nullptr, 0);
+        if (!reader.readLengthDelimited(robot_reader))
+        {
+            return false;
+        }
+
+        float confidence = 0, x = 0, y = 0, orientation = 0;
+        uint64_t robot_id   = 0;
+        bool has_confidence = false, has_x = false, has_y = false;
+
+        while (!robot_reader.atEnd())
+        {
+            uint32_t tag;
+            if (!robot_reader.readTag(tag))
+            {
+                return false;
+            }
+
+            bool ok;
+            switch (tag)
+            {
+                case DETECTION_CONFIDENCE_TAG:
+                    ok = has_confidence = robot_reader.readFloat(confidence);
+                    break;
+                case DETECTION_ROBOT_ID_TAG:
+                    ok = robot_reader.readVarint(robot_id);
+                    break;
+                case DETECTION_X_TAG:
+                    ok = has_x = robot_reader.readFloat(x);
+                    break;
+                case DETECTION_Y_TAG:
+                    ok = has_y = robot_reader.readFloat(y);
+                    break;
+                case DETECTION_ORIENTATION_TAG:
+                    ok = robot_reader.readFloat(orientation);
+                    break;
+                default:
+                    ok = robot_reader.skipField(tag);
+            }
+
+            if (!ok)
+            {
+                return false;
+            }
+        }
+
+        if (!(has_confidence && has_x && has_y))
+        {
+            return false;
+        }
+
+        (frame_data.*add_robot_detection)(static_cast<unsigned int>(robot_id), x, y,
+                                          orientation, confidence);
+        return true;
+    }
+
+    /**
+     * Decodes an SSL_DetectionFrame into the given frame data
+     */
+    bool decodeFrame(WireReader &reader, SSLDetectionFrameData &frame_data)
+    {
+        frame_data.clearDetections();
+
+        bool has_frame_number = false, has_t_capture = false, has_t_sent = false,
+             has_camera_id = false;
+
+        while (!reader.atEnd())
+        {
+            uint32_t tag;
+            if (!reader.readTag(tag))
+            {
+                return false;
+            }
+
+            bool ok;
+            uint64_t varint;
+            switch (tag)
+            {
+                case FRAME_FRAME_NUMBER_TAG:
+                    ok = has_frame_number = reader.readVarint(varint);
+                    frame_data.frame_number = static_cast<unsigned int>(varint);
+                    break;
+                case FRAME_T_CAPTURE_TAG:
+                    ok = has_t_capture = reader.readDouble(frame_data.t_capture);
+                    break;
+                case FRAME_T_SENT_TAG:
+                    ok = has_t_sent = reader.readDouble(frame_data.t_sent);
+                    break;
+                case FRAME_CAMERA_ID_TAG:
+                    ok = has_camera_id   = reader.readVarint(varint);
+                    frame_data.camera_id = static_cast<unsigned int>(varint);
+                    break;
+                case FRAME_BALLS_TAG:
+                    ok = decodeBall(reader, frame_data);
+                    break;
+                case FRAME_ROBOTS_YELLOW_TAG:
+                    ok = decodeRobot(reader, frame_data,
+                                     &SSLDetectionFrameData::addYellowRobotDetection);
+                    break;
+                case FRAME_ROBOTS_BLUE_TAG:
+                    ok = decodeRobot(reader, frame_data,
+                                     &SSLDetectionFrameData::addBlueRobotDetection);
+                    break;
+                default:
+                    ok = reader.skipField(tag);
+            }
+
+            if (!ok)
+            {
+                return false;
+            }
+        }
+
+        // Fields may appear in any order on the wire, so we can only fill in the
+        // timestamps once we have seen the whole frame
+        frame_data.setDetectionTimestamps();
+
+        return has_frame_number && has_t_capture && has_t_sent && has_camera_id;
+    }
+}  // namespace
+
+void SSLDetectionFrameData::clearDetections()
+{
+    num_balls              = 0;
+    num_yellow_robots      = 0;
+    num_blue_robots        = 0;
+    num_dropped_detections = 0;
+}
+
+void SSLDetectionFrameData::addBallDetection(double x_millimeters, double y_millimeters,
+                                             double confidence)
+{
+    if (num_balls == balls.size())
+    {
+        num_dropped_detections++;
+        return;
+    }
+
+    // Convert all data to meters
+    SSLBallData &ball_data = balls[num_balls++];
+    ball_data.position =
+        Point(x_millimeters * METERS_PER_MILLIMETER, y_millimeters * METERS_PER_MILLIMETER);
+    ball_data.confidence = confidence;
+}
+
+namespace
+{
+    /**
+     * Adds a robot detection to the given array of robot detections, converting it from
+     * SSL Vision's units, or counts it as dropped if the array is full
+     */
+    void addRobotDetection(
+        std::array<SSLRobotData, SSLDetectionFrameData::MAX_ROBOT_DETECTIONS_PER_TEAM>
+            &robots,
+        std::size_t &num_robots, std::size_t &num_dropped_detections, unsigned int id,
+        double x_millimeters, double y_millimeters, double orientation_radians,
+        double confidence)
+    {
+        if (num_robots == robots.size())
+        {
+            num_dropped_detections++;
+            return;
+        }
+
+        // Convert all data to meters and radians
+        SSLRobotData &robot_data = robots[num_robots++];
+        robot_data.id            = id;
+        robot_data.position      = Point(x_millimeters * METERS_PER_MILLIMETER,
+                                    y_millimeters * METERS_PER_MILLIMETER);
+        robot_data.orientation   = Angle::ofRadians(orientation_radians);
+        robot_data.confidence    = confidence;
+    }
+}  // namespace
+
+void SSLDetectionFrameData::addYellowRobotDetection(unsigned int id, double x_millimeters,
+                                                    double y_millimeters,
+                                                    double orientation_radians,
+                                                    double confidence)
+{
+    addRobotDetection(yellow_robots, num_yellow_robots, num_dropped_detections, id,
+                      x_millimeters, y_millimeters, orientation_radians, confidence);
+}
+
+void SSLDetectionFrameData::addBlueRobotDetection(unsigned int id, double x_millimeters,
+                                                  double y_millimeters,
+                                                  double orientation_radians,
+                                                  double confidence)
+{
+    addRobotDetection(blue_robots, num_blue_robots, num_dropped_detections, id,
+                      x_millimeters, y_millimeters, orientation_radians, confidence);
+}
+
+void SSLDetectionFrameData::setDetectionTimestamps()
+{
+    // Units of t_capture is seconds
+    for (std::size_t i = 0; i < num_balls; i++)
+    {
+        balls[i].timestamp = t_capture;
+    }
+    for (std::size_t i = 0; i < num_yellow_robots; i++)
+    {
+        yellow_robots[i].timestamp = t_capture;
+    }
+    for (std::size_t i = 0; i < num_blue_robots; i++)
+    {
+        blue_robots[i].timestamp = t_capture;
+    }
+}
+
+bool SSLWireDecoder::decodeWrapperPacket(const void *data, std::size_t size,
+                                         SSLWrapperPacketData &packet_data)
+{
+    packet_data.has_detection = false;
+    packet_data.has_geometry  = false;
+
+    WireReader reader(static_cast<const uint8_t *>(data), size);
+    while (!reader.atEnd())
+    {
+        uint32_t tag;
+        if (!reader.readTag(tag))
+        {
+            return false;
+        }
+
+        bool ok;
+        WireReader sub_reader(nullptr, 0);
+        switch (tag)
+        {
+            case WRAPPER_DETECTION_TAG:
+                ok = reader.readLengthDelimited(sub_reader) &&
+                     decodeFrame(sub_reader, packet_data.detection);
+                packet_data.has_detection = true;
+                break;
+            case WRAPPER_GEOMETRY_TAG:
+                ok                       = reader.skipField(tag);
+                packet_data.has_geometry = true;
+                break;
+            default:
+                ok = reader.skipField(tag);
+        }
+
+        if (!ok)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SSLWireDecoder::decodeDetectionFrame(const void *data, std::size_t size,
+                                          SSLDetectionFrameData &frame_data)
+{
+    WireReader reader(static_cast<const uint8_t *>(data), size);
+    return decodeFrame(reader, frame_data);
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "network_input/filter/ball_filter.h"
+#include "network_input/filter/robot_filter.h"
+
+/**
+ * The detections from a single SSL_DetectionFrame, decoded into fixed-capacity arrays
+ * so that decoding a frame never allocates. All positions are in meters, orientations
+ * in radians, and timestamps in seconds, the same as the data passed to our filters.
+ *
+ * Only the first num_balls / num_yellow_robots / num_blue_robots entries of each array
+ * are valid. Any detections beyond the capacity of an array are counted in
+ * num_dropped_detections and otherwise ignored.
+ *
+ * Detections are added with the functions below, which are shared by everything that
+ * creates frames from SSL Vision data, so the conversions and capacity limits are the
+ * same whether a frame was decoded from the wire or converted from protobuf.
+ */
+struct SSLDetectionFrameData
+{
+    // The maximum number of ball detections we store from a single frame
+    static constexpr std::size_t MAX_BALL_DETECTIONS = 32;
+    // The maximum number of robot detections we store for each team from a single frame
+    static constexpr std::size_t MAX_ROBOT_DETECTIONS_PER_TEAM = 32;
+
+    unsigned int frame_number;
+    unsigned int camera_id;
+    double t_capture;
+    double t_sent;
+
+    std::array<SSLBallData, MAX_BALL_DETECTIONS> balls;
+    std::size_t num_balls;
+    std::array<SSLRobotData, MAX_ROBOT_DETECTIONS_PER_TEAM> yellow_robots;
+    std::size_t num_yellow_robots;
+    std::array<SSLRobotData, MAX_ROBOT_DETECTIONS_PER_TEAM> blue_robots;
+    std::size_t num_blue_robots;
+
+    std::size_t num_dropped_detections;
+
+    /**
+     * Removes every detection from the frame, so it can be filled again
+     */
+    void clearDetections();
+
+    /**
+     * Adds a ball detection to the frame, converting it from SSL Vision's units. If the
+     * frame can't store any more ball detections, it is counted as dropped instead
+     *
+     * @param x_millimeters The x coordinate of the ball, in millimeters
+     * @param y_millimeters The y coordinate of the ball, in millimeters
+     * @param confidence How confident SSL Vision is in the detection
+     */
+    void addBallDetection(double x_millimeters, double y_millimeters, double confidence);
+
+    /**
+     * Adds a yellow robot detection to the frame, converting it from SSL Vision's units.
+     * If the frame can't store any more yellow robot detections, it is counted as
+     * dropped instead
+     *
+     * @param id The id of the robot
+     * @param x_millimeters The x coordinate of the robot, in millimeters
+     * @param y_millimeters The y coordinate of the robot, in millimeters
+     * @param orientation_radians The orientation of the robot, in radians
+     * @param confidence How confident SSL Vision is in the detection
+     */
+    void addYellowRobotDetection(unsigned int id, double x_millimeters,
+                                 double y_millimeters, double orientation_radians,
+                                 double confidence);
+
+    /**
+     * Adds a blue robot detection to the frame, converting it from SSL Vision's units.
+     * If the frame can't store any more blue robot detections, it is counted as dropped
+     * instead
+     *
+     * @param id The id of the robot
+     * @param x_millimeters The x coordinate of the robot, in millimeters
+     * @param y_millimeters The y coordinate of the robot, in millimeters
+     * @param orientation_radians The orientation of the robot, in radians
+     * @param confidence How confident SSL Vision is in the detection
+     */
+    void addBlueRobotDetection(unsigned int id, double x_millimeters,
+                               double y_millimeters, double orientation_radians,
+                               double confidence);
+
+    /**
+     * Sets the timestamp of every detection in the frame to the frame's t_capture. This
+     * must be called once every detection has been added and t_capture has been set
+     */
+    void setDetectionTimestamps();
+};
+
+/**
+ * The contents of an SSL_WrapperPacket that the SSLWireDecoder understands. Geometry
+ * data is not decoded since it is rarely sent and not time critical. If has_geometry
+ * is true, the packet should also be parsed with protobuf to get the geometry.
+ */
+typedef struct
+{
+    bool has_detection;
+    SSLDetectionFrameData detection;
+    bool has_geometry;
+} SSLWrapperPacketData;
+
+/**
+ * Decodes SSL Vision packets directly from the protobuf wire format into our own
+ * datatypes, without building the intermediate protobuf message objects.
+ *
+ * This is an alternative to SSL_WrapperPacket::ParseFromArray() for the packets we
+ * receive every frame. It walks the wire bytes once, writes straight into caller-owned
+ * fixed-capacity arrays, and skips the fields we never use (pixel coordinates, area,
+ * height, etc.) without decoding them.
+ *
+ * See https://developers.google.com/protocol-buffers/docs/encoding for a description
+ * of the wire format.
+ */
+class SSLWireDecoder
+{
+   public:
+    /**
+     * Decodes a serialized SSL_WrapperPacket into the given packet data. The given
+     * packet data is always overwritten, so the same object can be reused for every
+     * packet.
+     *
+     * @param data The serialized SSL_WrapperPacket
+     * @param size The size of the serialized data, in bytes
+     * @param packet_data The packet data to decode into
+     *
+     * @return true if the data was decoded successfully, and false if it was malformed
+     * or missing required fields. If false is returned the contents of packet_data are
+     * unspecified
+     */
+    static bool decodeWrapperPacket(const void *data, std::size_t size,
+                                    SSLWrapperPacketData &packet_data);
+
+    /**
+     * Decodes a serialized SSL_DetectionFrame into the given frame data. The given frame
+     * data is always overwritten, so the same object can be reused for every frame.
+     *
+     * @param data The serialized SSL_DetectionFrame
+     * @param size The size of the serialized data, in bytes
+     * @param frame_data The frame data to decode into
+     *
+     * @return true if the data was decoded successfully, and false if it was malformed
+     * or missing required fields. If false is returned the contents of frame_data are
+     * unspecified
+     */
+    static bool decodeDetectionFrame(const void *data, std::size_t size,
+                                     SSLDetectionFrameData &frame_data);
+};
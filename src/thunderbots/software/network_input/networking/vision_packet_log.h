@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * The layout of the files that the VisionPacketRecorder writes and the
+ * VisionPacketReplayer reads. A log file contains:
+ *
+ * - A VisionPacketLogHeader
+ * - One record for every packet, in the order they were received. Each record is a
+ *   VisionPacketLogRecordHeader followed by the raw bytes of the SSL_WrapperPacket,
+ *   padded to a multiple of VisionPacketLog::ALIGNMENT bytes
+ * - An index with one VisionPacketLogIndexEntry for every record, followed by a
+ *   VisionPacketLogFooter. These are only written when the recording is closed
+ *
+ * The file is only ever appended to, so a recording that was interrupted before it
+ * was closed is still readable, it just doesn't have an index. All values are stored
+ * in the byte order of the machine that recorded them.
+ */
+namespace VisionPacketLog
+{
+    // Identifies the start of a log file, and the start of the footer
+    static constexpr char HEADER_MAGIC[8] = {'T', 'B', 'V', 'I', 'S', 'L', 'O', 'G'};
+    static constexpr char FOOTER_MAGIC[8] = {'T', 'B', 'V', 'I', 'S', 'I', 'D', 'X'};
+
+    // The version of the format described here
+    static constexpr uint32_t VERSION = 1;
+
+    // Every record and the index start at a multiple of this many bytes from the start
+    // of the file
+    static constexpr std::size_t ALIGNMENT = 8;
+
+    /**
+     * Returns the given size rounded up to a multiple of ALIGNMENT
+     *
+     * @param size The size to round up
+     *
+     * @return the given size rounded up to a multiple of ALIGNMENT
+     */
+    inline constexpr std::size_t alignedSize(std::size_t size)
+    {
+        return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+}  // namespace VisionPacketLog
+
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+} VisionPacketLogHeader;
+
+typedef struct
+{
+    // The time the packet was received, in nanoseconds on the recording machine's
+    // steady clock
+    int64_t receive_time_nanoseconds;
+    // The number of bytes in the packet, not including padding
+    uint32_t packet_size;
+    uint32_t reserved;
+} VisionPacketLogRecordHeader;
+
+typedef struct
+{
+    int64_t receive_time_nanoseconds;
+    // The offset of the record's VisionPacketLogRecordHeader from the start of the file
+    uint64_t record_offset;
+} VisionPacketLogIndexEntry;
+
+typedef struct
+{
+    // The offset of the first VisionPacketLogIndexEntry from the start of the file
+    uint64_t index_offset;
+    uint64_t num_index_entries;
+    char magic[8];
+} VisionPacketLogFooter;
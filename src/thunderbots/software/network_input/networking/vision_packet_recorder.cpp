@@ -0,0 +1,95 @@
+#include "network_input/networking/vision_packet_recorder.h"
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+VisionPacketRecorder::VisionPacketRecorder(const std::string &file_path)
+    : file(std::fopen(file_path.c_str(), "wb")),
+      write_failed(false),
+      file_offset(0),
+      index()
+{
+    if (!file)
+    {
+        throw std::runtime_error("Could not open vision packet log file " + file_path +
+                                 " for recording");
+    }
+
+    // A typical match is about 15 minutes of 4 cameras at 60Hz
+    index.reserve(4 * 60 * 60 * 15);
+
+    VisionPacketLogHeader header = {};
+    std::memcpy(header.magic, VisionPacketLog::HEADER_MAGIC, sizeof(header.magic));
+    header.version = VisionPacketLog::VERSION;
+    if (!append(&header, sizeof(header)))
+    {
+        std::fclose(file);
+        throw std::runtime_error("Could not write to vision packet log file " +
+                                 file_path);
+    }
+}
+
+VisionPacketRecorder::~VisionPacketRecorder()
+{
+    VisionPacketLogFooter footer = {};
+    footer.index_offset          = file_offset;
+    footer.num_index_entries     = index.size();
+    std::memcpy(footer.magic, VisionPacketLog::FOOTER_MAGIC, sizeof(footer.magic));
+
+    // Without a footer the replayer builds the index itself, which is all we can do if
+    // the index doesn't fit either
+    if (!write_failed &&
+        append(index.data(), index.size() * sizeof(VisionPacketLogIndexEntry)))
+    {
+        append(&footer, sizeof(footer));
+    }
+    std::fclose(file);
+}
+
+bool VisionPacketRecorder::recordPacket(const void *data, std::size_t size,
+                                        const AITimestamp &receive_time)
+{
+    if (write_failed)
+    {
+        return false;
+    }
+
+    VisionPacketLogIndexEntry index_entry;
+    index_entry.receive_time_nanoseconds =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(receive_time).count();
+    index_entry.record_offset = file_offset;
+
+    VisionPacketLogRecordHeader record_header = {};
+    record_header.receive_time_nanoseconds    = index_entry.receive_time_nanoseconds;
+    record_header.packet_size                 = static_cast<uint32_t>(size);
+    if (!append(&record_header, sizeof(record_header)) || !append(data, size))
+    {
+        return false;
+    }
+
+    // Only packets that were written in full are indexed
+    index.emplace_back(index_entry);
+    return true;
+}
+
+std::size_t VisionPacketRecorder::getNumRecordedPackets() const
+{
+    return index.size();
+}
+
+bool VisionPacketRecorder::append(const void *data, std::size_t size)
+{
+    static constexpr std::array<char, VisionPacketLog::ALIGNMENT> padding = {};
+
+    std::size_t padding_size = VisionPacketLog::alignedSize(size) - size;
+    if (std::fwrite(data, 1, size, file) != size ||
+        std::fwrite(padding.data(), 1, padding_size, file) != padding_size)
+    {
+        write_failed = true;
+        return false;
+    }
+    file_offset += size + padding_size;
+    return true;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "network_input/networking/vision_packet_log.h"
+#include "util/timestamp.h"
+
+/**
+ * Records raw SSL Vision packets, along with the time they were received, to a log
+ * file that can be played back with the VisionPacketReplayer.
+ *
+ * Packets are appended to the file as they are recorded. The index that lets the
+ * replayer seek quickly is kept in memory and appended to the end of the file when
+ * the recorder is destroyed. See vision_packet_log.h for the format of the file.
+ *
+ * If a write fails, for example because the disk is full, recording stops and the
+ * index is not written, so the replayer rebuilds it from the packets that were written
+ * in full.
+ */
+class VisionPacketRecorder
+{
+   public:
+    /**
+     * Creates a new VisionPacketRecorder that records to the given file, replacing the
+     * file if it already exists
+     *
+     * @param file_path The path of the file to record to
+     *
+     * @throws std::runtime_error if the file could not be opened or written to
+     */
+    explicit VisionPacketRecorder(const std::string &file_path);
+
+    /**
+     * Writes the index to the end of the log file, unless a write has failed, and
+     * closes it
+     */
+    ~VisionPacketRecorder();
+
+    // The recorder owns the file, so it can't be copied
+    VisionPacketRecorder(const VisionPacketRecorder &) = delete;
+    VisionPacketRecorder &operator=(const VisionPacketRecorder &) = delete;
+
+    /**
+     * Appends a packet to the log file
+     *
+     * @param data The raw bytes of the SSL_WrapperPacket
+     * @param size The number of bytes in the packet
+     * @param receive_time The time the packet was received
+     *
+     * @return true if the packet was recorded, and false if it could not be written,
+     * or a write failed earlier and recording has stopped
+     */
+    bool recordPacket(const void *data, std::size_t size,
+                      const AITimestamp &receive_time);
+
+    /**
+     * Returns the number of packets that have been recorded
+     *
+     * @return the number of packets that have been recorded
+     */
+    std::size_t getNumRecordedPackets() const;
+
+   private:
+    /**
+     * Writes the given bytes to the end of the file, followed by enough padding to
+     * keep the next write aligned
+     *
+     * @param data The bytes to write
+     * @param size The number of bytes to write
+     *
+     * @return true if all the bytes were written, and false otherwise
+     */
+    bool append(const void *data, std::size_t size);
+
+    std::FILE *file;
+    // Set once a write fails, after which nothing more is written
+    bool write_failed;
+    // The offset from the start of the file that the next write will be at
+    uint64_t file_offset;
+    // An index entry for every packet recorded so far
+    std::vector<VisionPacketLogIndexEntry> index;
+};
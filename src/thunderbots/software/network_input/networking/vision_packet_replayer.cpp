@@ -0,0 +1,303 @@
+#include "network_input/networking/vision_packet_replayer.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    /**
+     * Returns the object of the given type stored at the given offset in the given data.
+     * This copies the object out rather than casting the pointer, so the data does not
+     * need to be aligned for the type
+     */
+    template <typename T>
+    T readAt(const char *data, std::size_t offset)
+    {
+        T object;
+        std::memcpy(&object, data + offset, sizeof(T));
+        return object;
+    }
+}  // namespace
+
+VisionPacketReplayer::VisionPacketReplayer(const std::string &file_path, double speed)
+    : speed(speed),
+      file_data(nullptr),
+      file_size(0),
+      file_index(nullptr),
+      built_index(),
+      num_packets(0),
+      next_packet(0),
+      playback_start_time(std::nullopt),
+      playback_start_recording_time(std::nullopt)
+{
+    // Written so that NaN is rejected too
+    if (!(speed >= 0))
+    {
+        throw std::invalid_argument("Vision packet playback speed must not be negative");
+    }
+
+    int file_descriptor = open(file_path.c_str(), O_RDONLY);
+    if (file_descriptor < 0)
+    {
+        throw std::runtime_error("Could not open vision packet log file " + file_path);
+    }
+
+    struct stat file_status;
+    if (fstat(file_descriptor, &file_status) != 0 ||
+        static_cast<std::size_t>(file_status.st_size) < sizeof(VisionPacketLogHeader))
+    {
+        close(file_descriptor);
+        throw std::runtime_error(file_path + " is not a vision packet log file");
+    }
+    file_size = static_cast<std::size_t>(file_status.st_size);
+
+    void *mapping = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    // The mapping stays valid after the file is closed
+    close(file_descriptor);
+    if (mapping == MAP_FAILED)
+    {
+        throw std::runtime_error("Could not memory map vision packet log file " +
+                                 file_path);
+    }
+    file_data = static_cast<const char *>(mapping);
+
+    VisionPacketLogHeader header = readAt<VisionPacketLogHeader>(file_data, 0);
+    if (std::memcmp(header.magic, VisionPacketLog::HEADER_MAGIC, sizeof(header.magic)) !=
+            0 ||
+        header.version != VisionPacketLog::VERSION)
+    {
+        munmap(mapping, file_size);
+        throw std::runtime_error(file_path + " is not a vision packet log file");
+    }
+
+    // Use the index at the end of the file if it has a valid one, otherwise the
+    // recording was interrupted and we have to build the index ourselves
+    if (file_size >= sizeof(VisionPacketLogHeader) + sizeof(VisionPacketLogFooter))
+    {
+        const std::size_t footer_offset = file_size - sizeof(VisionPacketLogFooter);
+        VisionPacketLogFooter footer =
+            readAt<VisionPacketLogFooter>(file_data, footer_offset);
+        // The index must fit exactly between its offset and the footer. The number of
+        // entries is checked against the space left rather than multiplied out, so a
+        // corrupt footer can't overflow the calculation and pass the check
+        if (std::memcmp(footer.magic, VisionPacketLog::FOOTER_MAGIC,
+                        sizeof(footer.magic)) == 0 &&
+            footer.index_offset >= sizeof(VisionPacketLogHeader) &&
+            footer.index_offset <= footer_offset &&
+            footer.num_index_entries <=
+                (footer_offset - footer.index_offset) /
+                    sizeof(VisionPacketLogIndexEntry) &&
+            footer.index_offset +
+                    footer.num_index_entries * sizeof(VisionPacketLogIndexEntry) ==
+                footer_offset)
+        {
+            file_index  = file_data + footer.index_offset;
+            num_packets = footer.num_index_entries;
+        }
+    }
+    if (!file_index)
+    {
+        buildIndex();
+    }
+}
+
+VisionPacketReplayer::~VisionPacketReplayer()
+{
+    munmap(const_cast<char *>(file_data), file_size);
+}
+
+void VisionPacketReplayer::getVisionPackets(std::vector<SSL_WrapperPacket> &packets,
+                                            const AITimestamp &max_wait_time)
+{
+    const AITimestamp now = Timestamp::getTimestampNow();
+    AITimestamp wake_time = now + max_wait_time;
+    if (!isFinished())
+    {
+        // When playing back as fast as possible, or when playback hasn't started yet,
+        // the next packet is due immediately
+        wake_time = speed == AS_FAST_AS_POSSIBLE || !playback_start_time
+                        ? now
+                        : std::min(wake_time, getPlaybackTime(next_packet));
+    }
+    std::this_thread::sleep_until(std::chrono::steady_clock::time_point(wake_time));
+
+    getVisionPacketsDueBy(packets, Timestamp::getTimestampNow());
+}
+
+void VisionPacketReplayer::getVisionPacketsDueBy(std::vector<SSL_WrapperPacket> &packets,
+                                                 const AITimestamp &now)
+{
+    packets.clear();
+    if (isFinished())
+    {
+        return;
+    }
+
+    if (!playback_start_time)
+    {
+        playback_start_time           = now;
+        playback_start_recording_time = AITimestamp(std::chrono::nanoseconds(
+            getIndexEntry(next_packet).receive_time_nanoseconds));
+    }
+
+    SSL_WrapperPacket packet;
+    for (; next_packet < num_packets; next_packet++)
+    {
+        if (speed == AS_FAST_AS_POSSIBLE)
+        {
+            if (packets.size() == MAX_PACKETS_PER_CALL)
+            {
+                break;
+            }
+        }
+        else if (getPlaybackTime(next_packet) > now)
+        {
+            break;
+        }
+
+        // Packets that can't be parsed are skipped, just like a corrupted packet from
+        // the network would be
+        if (parsePacket(next_packet, packet))
+        {
+            packets.emplace_back(std::move(packet));
+        }
+    }
+}
+
+unsigned long VisionPacketReplayer::getNumDroppedPackets() const
+{
+    return 0;
+}
+
+void VisionPacketReplayer::seek(const AITimestamp &recording_time)
+{
+    const int64_t recording_time_nanoseconds =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(recording_time).count();
+
+    // Binary search for the first packet received at or after the given time
+    std::size_t first = 0;
+    std::size_t count = num_packets;
+    while (count > 0)
+    {
+        std::size_t step = count / 2;
+        if (getIndexEntry(first + step).receive_time_nanoseconds <
+            recording_time_nanoseconds)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    next_packet                   = first;
+    playback_start_time           = std::nullopt;
+    playback_start_recording_time = std::nullopt;
+}
+
+std::optional<AITimestamp> VisionPacketReplayer::getRecordingStartTime() const
+{
+    if (num_packets == 0)
+    {
+        return std::nullopt;
+    }
+    return AITimestamp(
+        std::chrono::nanoseconds(getIndexEntry(0).receive_time_nanoseconds));
+}
+
+std::optional<AITimestamp> VisionPacketReplayer::getRecordingEndTime() const
+{
+    if (num_packets == 0)
+    {
+        return std::nullopt;
+    }
+    return AITimestamp(std::chrono::nanoseconds(
+        getIndexEntry(num_packets - 1).receive_time_nanoseconds));
+}
+
+std::size_t VisionPacketReplayer::getNumPackets() const
+{
+    return num_packets;
+}
+
+bool VisionPacketReplayer::isFinished() const
+{
+    return next_packet >= num_packets;
+}
+
+VisionPacketLogIndexEntry VisionPacketReplayer::getIndexEntry(
+    std::size_t packet_index) const
+{
+    if (file_index)
+    {
+        return readAt<VisionPacketLogIndexEntry>(
+            file_index, packet_index * sizeof(VisionPacketLogIndexEntry));
+    }
+    return built_index[packet_index];
+}
+
+AITimestamp VisionPacketReplayer::getPlaybackTime(std::size_t packet_index) const
+{
+    AITimestamp recording_time(
+        std::chrono::nanoseconds(getIndexEntry(packet_index).receive_time_nanoseconds));
+    return *playback_start_time +
+           std::chrono::duration_cast<AITimestamp>(
+               (recording_time - *playback_start_recording_time) / speed);
+}
+
+void VisionPacketReplayer::buildIndex()
+{
+    std::size_t offset = sizeof(VisionPacketLogHeader);
+    while (offset + sizeof(VisionPacketLogRecordHeader) <= file_size)
+    {
+        VisionPacketLogRecordHeader record_header =
+            readAt<VisionPacketLogRecordHeader>(file_data, offset);
+        std::size_t packet_offset = offset + sizeof(VisionPacketLogRecordHeader);
+        if (packet_offset + record_header.packet_size > file_size)
+        {
+            // The recording was interrupted while this packet was being written
+            break;
+        }
+
+        VisionPacketLogIndexEntry index_entry;
+        index_entry.receive_time_nanoseconds = record_header.receive_time_nanoseconds;
+        index_entry.record_offset            = offset;
+        built_index.emplace_back(index_entry);
+
+        offset = packet_offset + VisionPacketLog::alignedSize(record_header.packet_size);
+    }
+
+    num_packets = built_index.size();
+}
+
+bool VisionPacketReplayer::parsePacket(std::size_t packet_index,
+                                       SSL_WrapperPacket &packet) const
+{
+    const std::size_t record_offset = getIndexEntry(packet_index).record_offset;
+    if (record_offset + sizeof(VisionPacketLogRecordHeader) > file_size)
+    {
+        return false;
+    }
+
+    VisionPacketLogRecordHeader record_header =
+        readAt<VisionPacketLogRecordHeader>(file_data, record_offset);
+    if (record_offset + sizeof(VisionPacketLogRecordHeader) + record_header.packet_size >
+        file_size)
+    {
+        return false;
+    }
+
+    return packet.ParseFromArray(
+        file_data + record_offset + sizeof(VisionPacketLogRecordHeader),
+        static_cast<int>(record_header.packet_size));
+}
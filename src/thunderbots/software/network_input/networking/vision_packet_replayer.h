@@ -0,0 +1,183 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "network_input/networking/vision_packet_log.h"
+#include "network_input/networking/vision_packet_source.h"
+#include "util/timestamp.h"
+
+/**
+ * Plays back a log file written by the VisionPacketRecorder, providing the recorded
+ * packets in the same way the SSLVisionClient provides live ones.
+ *
+ * Packets are played back with the same timing they were recorded with, optionally
+ * sped up or slowed down, or as fast as they can be processed. The file is memory
+ * mapped rather than read, so starting playback and seeking are fast no matter how
+ * large the recording is.
+ *
+ * Recordings that were not closed properly don't have an index, so one is built by
+ * scanning the file when it is opened.
+ */
+class VisionPacketReplayer : public VisionPacketSource
+{
+   public:
+    // Pass this as the speed to play back the packets as fast as they are retrieved
+    static constexpr double AS_FAST_AS_POSSIBLE = 0.0;
+
+    // The most packets that will be returned by a single call to getVisionPackets()
+    // when playing back as fast as possible
+    static constexpr std::size_t MAX_PACKETS_PER_CALL = 64;
+
+    /**
+     * Creates a new VisionPacketReplayer that plays back the given log file
+     *
+     * @param file_path The path of the log file to play back
+     * @param speed How fast to play back the packets, relative to how fast they were
+     * recorded. For example, 2.0 plays back at twice the recorded speed. If this is
+     * AS_FAST_AS_POSSIBLE, the recorded timing is ignored and packets are returned as
+     * fast as they are asked for
+     *
+     * @throws std::invalid_argument if the speed is negative
+     * @throws std::runtime_error if the file could not be opened or is not a valid
+     * log file
+     */
+    explicit VisionPacketReplayer(const std::string &file_path, double speed = 1.0);
+
+    ~VisionPacketReplayer() override;
+
+    // The replayer owns the memory mapping, so it can't be copied
+    VisionPacketReplayer(const VisionPacketReplayer &) = delete;
+    VisionPacketReplayer &operator=(const VisionPacketReplayer &) = delete;
+
+    /**
+     * Waits until the next recorded packet is due to be played back, or the given time
+     * has passed, and then fills the given vector with the packets that are due by
+     * then. Playback starts the first time this function is called. Nothing is waited
+     * for when playing back as fast as possible
+     *
+     * @param packets The vector to fill with the packets due to be played back since the
+     * last time this function was called. Its previous contents are replaced
+     * @param max_wait_time The longest time to wait for a packet to be due
+     */
+    void getVisionPackets(std::vector<SSL_WrapperPacket> &packets,
+                          const AITimestamp &max_wait_time) override;
+
+    /**
+     * Fills the given vector with the recorded packets that are due to be played back by
+     * the given time, without waiting. Playback starts the first time this function is
+     * called.
+     *
+     * @param packets The vector to fill with the packets due to be played back since the
+     * last time this function was called. Its previous contents are replaced
+     * @param now The current time
+     */
+    void getVisionPacketsDueBy(std::vector<SSL_WrapperPacket> &packets,
+                               const AITimestamp &now);
+
+    /**
+     * Packets are never dropped while playing back a recording
+     *
+     * @return 0
+     */
+    unsigned long getNumDroppedPackets() const override;
+
+    /**
+     * Moves playback to the first packet that was received at or after the given time
+     * in the recording. Playback continues from there with the recorded timing the next
+     * time getVisionPackets() is called. This takes O(log n) time in the number of
+     * packets in the recording.
+     *
+     * @param recording_time The time in the recording to seek to, on the same clock as
+     * getRecordingStartTime() and getRecordingEndTime()
+     */
+    void seek(const AITimestamp &recording_time);
+
+    /**
+     * Returns the time the first packet in the recording was received
+     *
+     * @return the time the first packet in the recording was received, or std::nullopt
+     * if the recording is empty
+     */
+    std::optional<AITimestamp> getRecordingStartTime() const;
+
+    /**
+     * Returns the time the last packet in the recording was received
+     *
+     * @return the time the last packet in the recording was received, or std::nullopt
+     * if the recording is empty
+     */
+    std::optional<AITimestamp> getRecordingEndTime() const;
+
+    /**
+     * Returns the number of packets in the recording
+     *
+     * @return the number of packets in the recording
+     */
+    std::size_t getNumPackets() const;
+
+    /**
+     * Returns whether every packet in the recording has been played back
+     *
+     * @return true if every packet in the recording has been played back, and false
+     * otherwise
+     */
+    bool isFinished() const;
+
+   private:
+    /**
+     * Returns the index entry for the given packet
+     *
+     * @param packet_index The index of the packet in the recording
+     *
+     * @return the index entry for the given packet
+     */
+    VisionPacketLogIndexEntry getIndexEntry(std::size_t packet_index) const;
+
+    /**
+     * Returns when the given packet should be played back. Must only be called once
+     * playback has started
+     *
+     * @param packet_index The index of the packet in the recording
+     *
+     * @return when the given packet should be played back
+     */
+    AITimestamp getPlaybackTime(std::size_t packet_index) const;
+
+    /**
+     * Builds the index by scanning through every record in the file. This is only
+     * needed when the file does not have an index
+     */
+    void buildIndex();
+
+    /**
+     * Parses the given packet from the file
+     *
+     * @param packet_index The index of the packet in the recording
+     * @param packet The packet to parse into
+     *
+     * @return true if the packet was parsed successfully, and false otherwise
+     */
+    bool parsePacket(std::size_t packet_index, SSL_WrapperPacket &packet) const;
+
+    double speed;
+
+    // The memory mapped log file
+    const char *file_data;
+    std::size_t file_size;
+
+    // The index is read directly from the memory mapped file when it has one. When it
+    // doesn't, it is built in built_index instead
+    const char *file_index;
+    std::vector<VisionPacketLogIndexEntry> built_index;
+    std::size_t num_packets;
+
+    // The index of the next packet to play back
+    std::size_t next_packet;
+    // When playback started or was last moved with seek(), and the recorded receive
+    // time of the next packet at that moment. These are std::nullopt until playback
+    // starts again
+    std::optional<AITimestamp> playback_start_time;
+    std::optional<AITimestamp> playback_start_recording_time;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+
+#include "proto/messages_robocup_ssl_wrapper.pb.h"
+#include "util/timestamp.h"
+
+/**
+ * Something that provides SSL Vision packets to network_input, such as a live
+ * connection to SSL Vision or a recording of one being played back
+ */
+class VisionPacketSource
+{
+   public:
+    /**
+     * Waits until there is at least one new SSL Vision WrapperPacket, or the given time
+     * has passed, and then fills the given vector with every packet that was received
+     * since the last time this function was called. If no new data was received, the
+     * vector will be empty. The vector is owned by the caller so it can be reused, and
+     * its previous contents are replaced
+     *
+     * @param packets The vector to fill with the packets received since the last time
+     * this function was called
+     * @param max_wait_time The longest time to wait for a packet to arrive
+     */
+    virtual void getVisionPackets(std::vector<SSL_WrapperPacket>& packets,
+                                  const AITimestamp& max_wait_time) = 0;
+
+    /**
+     * Returns the total number of packets that have been dropped because they could not
+     * be retrieved with getVisionPackets() quickly enough.
+     *
+     * @return the total number of packets that have been dropped
+     */
+    virtual unsigned long getNumDroppedPackets() const = 0;
+
+    virtual ~VisionPacketSource() = default;
+};
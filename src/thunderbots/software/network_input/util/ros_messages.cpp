@@ -124,13 +124,20 @@ thunderbots_msgs::Team MessageUtil::createTeamMsgFromFilteredRobotData(
     const std::vector<FilteredRobotData> &filtered_team_data)
 {
     thunderbots_msgs::Team team_msg;
+    updateTeamMsgFromFilteredRobotData(filtered_team_data, team_msg);
 
-    for (const FilteredRobotData &filtered_robot_data : filtered_team_data)
+    return team_msg;
+}
+
+void MessageUtil::updateTeamMsgFromFilteredRobotData(
+    const std::vector<FilteredRobotData> &filtered_team_data,
+    thunderbots_msgs::Team &team_msg)
+{
+    // Shrinking the list of robots keeps its capacity, so we only allocate when the
+    // message holds more robots than it ever has before
+    team_msg.robots.resize(filtered_team_data.size());
+    for (std::size_t i = 0; i < filtered_team_data.size(); i++)
     {
-        thunderbots_msgs::Robot robot_msg =
-            createRobotMsgFromFilteredRobotData(filtered_robot_data);
-        team_msg.robots.emplace_back(robot_msg);
+        team_msg.robots[i] = createRobotMsgFromFilteredRobotData(filtered_team_data[i]);
     }
-
-    return team_msg;
 }
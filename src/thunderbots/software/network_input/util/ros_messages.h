@@ -52,4 +52,16 @@ class MessageUtil
      */
     static thunderbots_msgs::Team createTeamMsgFromFilteredRobotData(
         const std::vector<FilteredRobotData> &filtered_team_data);
+
+    /**
+     * Updates an existing Team msg in place to contain the given team data. This reuses
+     * the storage of the message, so once the message has held a full team it never
+     * needs to allocate
+     *
+     * @param filtered_team_data A vector of robot data representing a team
+     * @param team_msg The Team message to update
+     */
+    static void updateTeamMsgFromFilteredRobotData(
+        const std::vector<FilteredRobotData> &filtered_team_data,
+        thunderbots_msgs::Team &team_msg);
 };
@@ -0,0 +1,179 @@
+#include "network_input/vision_frame_assembler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /**
+     * Returns true if the two detections could be the same ball
+     */
+    bool isSameObject(const SSLBallData &a, const SSLBallData &b, double merge_distance)
+    {
+        return (a.position - b.position).len() < merge_distance;
+    }
+
+    /**
+     * Returns true if the two detections could be the same robot
+     */
+    bool isSameObject(const SSLRobotData &a, const SSLRobotData &b, double merge_distance)
+    {
+        return a.id == b.id && (a.position - b.position).len() < merge_distance;
+    }
+
+    /**
+     * Merges the given new detections into the given merged detections. New detections
+     * that are the same object as one of the merged detections replace it if they have
+     * a higher confidence, and are discarded otherwise. All other new detections are
+     * appended, or dropped if there is no space left.
+     *
+     * The new detections are only compared against the detections that were already
+     * merged, and not against each other, since detections from the same camera are
+     * never of the same object.
+     */
+    template <typename T, std::size_t N>
+    void mergeDetections(const std::array<T, N> &new_detections,
+                         std::size_t num_new_detections,
+                         std::array<T, N> &merged_detections,
+                         std::size_t &num_merged_detections,
+                         std::size_t &num_dropped_detections, double merge_distance)
+    {
+        const std::size_t num_previously_merged = num_merged_detections;
+
+        for (std::size_t i = 0; i < num_new_detections; i++)
+        {
+            const T &new_detection = new_detections[i];
+
+            auto previously_merged_end =
+                merged_detections.begin() + num_previously_merged;
+            auto same_object = std::find_if(
+                merged_detections.begin(), previously_merged_end,
+                [&](const T &merged_detection) {
+                    return isSameObject(new_detection, merged_detection, merge_distance);
+                });
+
+            if (same_object != previously_merged_end)
+            {
+                if (new_detection.confidence > same_object->confidence)
+                {
+                    *same_object = new_detection;
+                }
+            }
+            else if (num_merged_detections < merged_detections.size())
+            {
+                merged_detections[num_merged_detections++] = new_detection;
+            }
+            else
+            {
+                num_dropped_detections++;
+            }
+        }
+    }
+}  // namespace
+
+VisionFrameAssembler::VisionFrameAssembler(unsigned int num_cameras,
+                                           std::chrono::milliseconds timeout,
+                                           double merge_distance_meters)
+    : num_cameras(num_cameras),
+      timeout(timeout),
+      merge_distance_meters(merge_distance_meters),
+      merged_frame(),
+      reported_cameras(0),
+      num_reported_cameras(0),
+      first_t_capture(0),
+      first_receive_time(),
+      num_merged_frames(0)
+{
+}
+
+std::optional<SSLDetectionFrameData> VisionFrameAssembler::addDetectionFrame(
+    const SSLDetectionFrameData &frame, const AITimestamp &receive_time)
+{
+    std::optional<SSLDetectionFrameData> completed_frame = std::nullopt;
+
+    // We only have room to keep track of a limited number of cameras. SSL Vision uses
+    // at most 8, so in practice every camera is tracked
+    const bool camera_is_tracked   = frame.camera_id < sizeof(reported_cameras) * 8;
+    const unsigned long camera_bit = camera_is_tracked ? (1ul << frame.camera_id) : 0ul;
+
+    // If this camera has already reported, or this frame was captured too long after
+    // the others, it belongs to the next vision tick. The frame being assembled can't
+    // get any more data so we emit it now
+    if (num_reported_cameras > 0 && ((reported_cameras & camera_bit) != 0 ||
+                                     std::abs(frame.t_capture - first_t_capture) >
+                                         std::chrono::duration<double>(timeout).count()))
+    {
+        completed_frame = takeFrame();
+    }
+
+    if (num_reported_cameras == 0)
+    {
+        first_t_capture    = frame.t_capture;
+        first_receive_time = receive_time;
+    }
+
+    mergeFrame(frame);
+    reported_cameras |= camera_bit;
+    num_reported_cameras++;
+
+    // The frame being assembled can only be complete here if it was empty before this
+    // frame was added, in which case we did not already take a completed frame above
+    if (num_reported_cameras >= num_cameras)
+    {
+        completed_frame = takeFrame();
+    }
+
+    return completed_frame;
+}
+
+std::optional<SSLDetectionFrameData> VisionFrameAssembler::getTimedOutFrame(
+    const AITimestamp &now)
+{
+    if (num_reported_cameras > 0 && now - first_receive_time >= timeout)
+    {
+        return takeFrame();
+    }
+
+    return std::nullopt;
+}
+
+void VisionFrameAssembler::mergeFrame(const SSLDetectionFrameData &frame)
+{
+    if (num_reported_cameras == 0)
+    {
+        merged_frame.t_capture              = frame.t_capture;
+        merged_frame.t_sent                 = frame.t_sent;
+        merged_frame.num_balls              = 0;
+        merged_frame.num_yellow_robots      = 0;
+        merged_frame.num_blue_robots        = 0;
+        merged_frame.num_dropped_detections = 0;
+    }
+    else
+    {
+        merged_frame.t_capture = std::max(merged_frame.t_capture, frame.t_capture);
+        merged_frame.t_sent    = std::max(merged_frame.t_sent, frame.t_sent);
+    }
+
+    merged_frame.num_dropped_detections += frame.num_dropped_detections;
+
+    mergeDetections(frame.balls, frame.num_balls, merged_frame.balls,
+                    merged_frame.num_balls, merged_frame.num_dropped_detections,
+                    merge_distance_meters);
+    mergeDetections(frame.yellow_robots, frame.num_yellow_robots,
+                    merged_frame.yellow_robots, merged_frame.num_yellow_robots,
+                    merged_frame.num_dropped_detections, merge_distance_meters);
+    mergeDetections(frame.blue_robots, frame.num_blue_robots, merged_frame.blue_robots,
+                    merged_frame.num_blue_robots, merged_frame.num_dropped_detections,
+                    merge_distance_meters);
+}
+
+SSLDetectionFrameData VisionFrameAssembler::takeFrame()
+{
+    merged_frame.frame_number = num_merged_frames++;
+    merged_frame.camera_id    = 0;
+
+    reported_cameras     = 0;
+    num_reported_cameras = 0;
+
+    return merged_frame;
+}
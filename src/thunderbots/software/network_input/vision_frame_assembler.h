@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+#include "network_input/networking/ssl_wire_decoder.h"
+#include "util/timestamp.h"
+
+/**
+ * Assembles the detection frames that each SSL Vision camera sends separately into
+ * a single frame covering the whole field.
+ *
+ * Each camera only sees part of the field, and sends its own detection frame once per
+ * vision tick. Frames are collected until every camera has reported, a camera reports
+ * for a second time, or the frame has been waiting for longer than the timeout. The
+ * collected detections are then emitted together as one merged frame, so that a single
+ * late or missing camera can never stall the output.
+ *
+ * Where the cameras' fields of view overlap the same object may be detected by
+ * several cameras. Detections from different cameras that are close enough to be the
+ * same object (and have the same id, for robots) are merged, keeping the detection
+ * with the highest confidence.
+ *
+ * The merged frames use the same datatype as a single camera frame. Each detection
+ * keeps the capture time of the camera that saw it. The frame_number of a merged frame
+ * counts the merged frames emitted so far, its t_capture and t_sent are the latest of
+ * the frames that were merged, and its camera_id is meaningless.
+ */
+class VisionFrameAssembler
+{
+   public:
+    /**
+     * Creates a new VisionFrameAssembler
+     *
+     * @param num_cameras The number of cameras SSL Vision is using. A merged frame is
+     * emitted as soon as this many cameras have reported
+     * @param timeout The longest time a merged frame will wait for more cameras to
+     * report after the first camera reports. Frames whose capture times are further
+     * apart than this are never merged together
+     * @param merge_distance_meters Detections from different cameras that are closer
+     * together than this distance are considered to be the same object
+     */
+    explicit VisionFrameAssembler(unsigned int num_cameras,
+                                  std::chrono::milliseconds timeout,
+                                  double merge_distance_meters);
+
+    /**
+     * Adds a new frame from a single camera. If this completes a merged frame, or if
+     * the frame belongs to the next vision tick and the merged frame for the previous
+     * tick must be emitted to make room for it, the merged frame is returned.
+     *
+     * @param frame The frame from a single camera
+     * @param receive_time The time the frame was received
+     *
+     * @return The merged frame if one was completed, otherwise std::nullopt
+     */
+    std::optional<SSLDetectionFrameData> addDetectionFrame(
+        const SSLDetectionFrameData &frame, const AITimestamp &receive_time);
+
+    /**
+     * Returns the frame currently being assembled if it has been waiting for longer
+     * than the timeout. This should be called regularly, so that we still emit frames
+     * when the remaining cameras stop sending data.
+     *
+     * @param now The current time
+     *
+     * @return The merged frame if it timed out, otherwise std::nullopt
+     */
+    std::optional<SSLDetectionFrameData> getTimedOutFrame(const AITimestamp &now);
+
+   private:
+    /**
+     * Merges the detections of the given frame into the frame being assembled
+     *
+     * @param frame The frame to merge
+     */
+    void mergeFrame(const SSLDetectionFrameData &frame);
+
+    /**
+     * Returns the frame being assembled and resets the assembler to start a new frame
+     *
+     * @return the frame being assembled
+     */
+    SSLDetectionFrameData takeFrame();
+
+    unsigned int num_cameras;
+    AITimestamp timeout;
+    double merge_distance_meters;
+
+    // The frame currently being assembled
+    SSLDetectionFrameData merged_frame;
+    // A bitmask of the ids of the cameras that have reported for the merged frame
+    unsigned long reported_cameras;
+    unsigned int num_reported_cameras;
+    // The capture time of the first camera frame in the merged frame
+    double first_t_capture;
+    // The time the first camera frame in the merged frame was received
+    AITimestamp first_receive_time;
+    // The number of merged frames emitted so far
+    unsigned int num_merged_frames;
+};
@@ -0,0 +1,313 @@
+/**
+ * Compares how long it takes the Backend to turn SSL Vision packets into messages with
+ * a single call to processPacket, against calling getFieldMsg, getFilteredBallMsg,
+ * getFilteredFriendlyTeamMsg and getFilteredEnemyTeamMsg separately the way we used to.
+ * Frames that have already been merged are also timed through processDetectionFrame,
+ * which is the part spent in the filters.
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <optional>
+
+#include "network_input/backend.h"
+#include "network_input/util/ros_messages.h"
+#include "util/constants.h"
+
+using namespace std::chrono;
+
+namespace
+{
+    /**
+     * The separate calls the Backend used to make for each message before
+     * processPacket, kept here so processPacket can still be compared against them
+     */
+    class SeparateCallsBackend
+    {
+       public:
+        std::optional<thunderbots_msgs::Field> getFieldMsg(const SSL_WrapperPacket &packet)
+        {
+            if (packet.has_geometry())
+            {
+                return MessageUtil::createFieldMsgFromFieldGeometry(
+                    packet.geometry().field());
+            }
+
+            return std::nullopt;
+        }
+
+        std::optional<thunderbots_msgs::Ball> getFilteredBallMsg(
+            const SSLDetectionFrameData &frame)
+        {
+            ball_detections.assign(frame.balls.begin(),
+                                   frame.balls.begin() + frame.num_balls);
+
+            std::optional<FilteredBallData> filtered_ball_data =
+                ball_filter.getFilteredData(ball_detections);
+            if (filtered_ball_data)
+            {
+                return MessageUtil::createBallMsgFromFilteredBallData(
+                    *filtered_ball_data);
+            }
+
+            return std::nullopt;
+        }
+
+        std::optional<thunderbots_msgs::Team> getFilteredFriendlyTeamMsg(
+            const SSLDetectionFrameData &frame)
+        {
+            return Util::Constants::FRIENDLY_TEAM_COLOUR == BLUE
+                       ? getFilteredTeamMsg(frame.blue_robots, frame.num_blue_robots,
+                                            friendly_team_filter)
+                       : getFilteredTeamMsg(frame.yellow_robots,
+                                            frame.num_yellow_robots,
+                                            friendly_team_filter);
+        }
+
+        std::optional<thunderbots_msgs::Team> getFilteredEnemyTeamMsg(
+            const SSLDetectionFrameData &frame)
+        {
+            return Util::Constants::FRIENDLY_TEAM_COLOUR == YELLOW
+                       ? getFilteredTeamMsg(frame.blue_robots, frame.num_blue_robots,
+                                            enemy_team_filter)
+                       : getFilteredTeamMsg(frame.yellow_robots,
+                                            frame.num_yellow_robots, enemy_team_filter);
+        }
+
+       private:
+        std::optional<thunderbots_msgs::Team> getFilteredTeamMsg(
+            const std::array<SSLRobotData,
+                             SSLDetectionFrameData::MAX_ROBOT_DETECTIONS_PER_TEAM>
+                &robots,
+            std::size_t num_robots, RobotTeamFilter &team_filter)
+        {
+            if (num_robots > 0)
+            {
+                robot_detections.assign(robots.begin(), robots.begin() + num_robots);
+                return MessageUtil::createTeamMsgFromFilteredRobotData(
+                    team_filter.getFilteredData(robot_detections));
+            }
+
+            return std::nullopt;
+        }
+
+        BallFilter ball_filter;
+        RobotTeamFilter friendly_team_filter;
+        RobotTeamFilter enemy_team_filter;
+        std::vector<SSLBallData> ball_detections;
+        std::vector<SSLRobotData> robot_detections;
+    };
+}  // namespace
+
+class BackendBenchmark : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        // A full field of robots and a ball, split between the cameras the way SSL
+        // Vision would send them
+        for (unsigned int camera = 0; camera < packets.size(); camera++)
+        {
+            SSL_DetectionFrame *frame = packets[camera].mutable_detection();
+            frame->set_frame_number(0);
+            frame->set_t_capture(0);
+            frame->set_t_sent(0);
+            frame->set_camera_id(camera);
+
+            if (camera == 0)
+            {
+                SSL_DetectionBall *ball = frame->add_balls();
+                ball->set_confidence(0.9f);
+                ball->set_x(100.0f);
+                ball->set_y(-200.0f);
+                ball->set_pixel_x(320.0f);
+                ball->set_pixel_y(240.0f);
+            }
+
+            for (unsigned int id = camera * 2; id < camera * 2 + 2; id++)
+            {
+                for (SSL_DetectionRobot *robot :
+                     {frame->add_robots_yellow(), frame->add_robots_blue()})
+                {
+                    robot->set_confidence(0.8f);
+                    robot->set_robot_id(id);
+                    robot->set_x(-3000.0f + 1000.0f * camera + 100.0f * id);
+                    robot->set_y(250.0f - 50.0f * id);
+                    robot->set_orientation(0.2f * id);
+                    robot->set_pixel_x(100.0f);
+                    robot->set_pixel_y(200.0f);
+                }
+            }
+        }
+    }
+
+    /**
+     * Returns the average time taken to run the given function, in nanoseconds
+     */
+    template <typename Function>
+    double averageNanoseconds(Function function)
+    {
+        // Warm up caches and the allocator before timing anything
+        for (unsigned int i = 0; i < NUM_ITERATIONS / 10; i++)
+        {
+            function();
+        }
+
+        auto start = steady_clock::now();
+        for (unsigned int i = 0; i < NUM_ITERATIONS; i++)
+        {
+            function();
+        }
+        auto end = steady_clock::now();
+
+        return static_cast<double>(duration_cast<nanoseconds>(end - start).count()) /
+               NUM_ITERATIONS;
+    }
+
+    /**
+     * Moves all the packets forwards to the next vision tick, so the filters have new
+     * data to process every iteration
+     */
+    void advancePackets()
+    {
+        vision_tick++;
+        for (SSL_WrapperPacket &packet : packets)
+        {
+            packet.mutable_detection()->set_frame_number(vision_tick);
+            packet.mutable_detection()->set_t_capture(vision_tick / 60.0);
+        }
+    }
+
+    static constexpr unsigned int NUM_ITERATIONS = 20000;
+
+    std::array<SSL_WrapperPacket, Util::Constants::NUMBER_OF_SSL_VISION_CAMERAS> packets;
+    unsigned int vision_tick = 0;
+};
+
+TEST_F(BackendBenchmark, process_one_vision_tick)
+{
+    SeparateCallsBackend separate_calls_backend;
+    VisionFrameAssembler frame_assembler(
+        Util::Constants::NUMBER_OF_SSL_VISION_CAMERAS,
+        Util::Constants::SSL_VISION_FRAME_ASSEMBLY_TIMEOUT,
+        Util::Constants::SSL_VISION_CAMERA_OVERLAP_MERGE_DISTANCE_METERS);
+    unsigned int num_separate_calls_team_msgs = 0;
+
+    // This mirrors what network_input used to do with each packet
+    double separate_calls_ns = averageNanoseconds([&]() {
+        advancePackets();
+        for (const SSL_WrapperPacket &packet : packets)
+        {
+            std::optional<thunderbots_msgs::Field> field_msg =
+                separate_calls_backend.getFieldMsg(packet);
+            if (packet.has_detection())
+            {
+                std::optional<SSLDetectionFrameData> merged_frame =
+                    frame_assembler.addDetectionFrame(
+                        Backend::createDetectionFrameData(packet.detection()),
+                        Timestamp::getTimestampNow());
+                if (merged_frame)
+                {
+                    std::optional<thunderbots_msgs::Ball> ball_msg =
+                        separate_calls_backend.getFilteredBallMsg(*merged_frame);
+                    std::optional<thunderbots_msgs::Team> friendly_team_msg =
+                        separate_calls_backend.getFilteredFriendlyTeamMsg(*merged_frame);
+                    std::optional<thunderbots_msgs::Team> enemy_team_msg =
+                        separate_calls_backend.getFilteredEnemyTeamMsg(*merged_frame);
+                    num_separate_calls_team_msgs += friendly_team_msg.has_value();
+                }
+            }
+        }
+    });
+
+    Backend process_packet_backend;
+    BackendMessages messages                  = BackendMessages();
+    unsigned int num_process_packet_team_msgs = 0;
+    double process_packet_ns                  = averageNanoseconds([&]() {
+        advancePackets();
+        for (const SSL_WrapperPacket &packet : packets)
+        {
+            process_packet_backend.processPacket(packet, Timestamp::getTimestampNow(),
+                                                 messages);
+            num_process_packet_team_msgs += messages.friendly_team_msg_updated;
+        }
+    });
+
+    std::cout << "Separate calls: " << separate_calls_ns << " ns/tick" << std::endl
+              << "processPacket: " << process_packet_ns << " ns/tick" << std::endl;
+
+    // Make sure both paths actually produced a message for every tick
+    EXPECT_EQ(NUM_ITERATIONS + NUM_ITERATIONS / 10, num_separate_calls_team_msgs);
+    EXPECT_EQ(NUM_ITERATIONS + NUM_ITERATIONS / 10, num_process_packet_team_msgs);
+    EXPECT_EQ(2 * Util::Constants::NUMBER_OF_SSL_VISION_CAMERAS,
+              messages.friendly_team_msg.robots.size());
+}
+
+TEST_F(BackendBenchmark, process_one_merged_frame)
+{
+    // Merge one tick's packets up front, so only the filters are timed
+    VisionFrameAssembler frame_assembler(
+        Util::Constants::NUMBER_OF_SSL_VISION_CAMERAS,
+        Util::Constants::SSL_VISION_FRAME_ASSEMBLY_TIMEOUT,
+        Util::Constants::SSL_VISION_CAMERA_OVERLAP_MERGE_DISTANCE_METERS);
+    std::optional<SSLDetectionFrameData> merged_frame;
+    for (const SSL_WrapperPacket &packet : packets)
+    {
+        merged_frame = frame_assembler.addDetectionFrame(
+            Backend::createDetectionFrameData(packet.detection()),
+            Timestamp::getTimestampNow());
+    }
+    ASSERT_TRUE(merged_frame);
+
+    Backend backend;
+    BackendMessages messages   = BackendMessages();
+    unsigned int num_team_msgs = 0;
+    double process_frame_ns    = averageNanoseconds([&]() {
+        vision_tick++;
+        merged_frame->frame_number = vision_tick;
+        merged_frame->t_capture    = vision_tick / 60.0;
+        for (SSLBallData &ball : merged_frame->balls)
+        {
+            ball.timestamp = merged_frame->t_capture;
+        }
+        for (auto robots : {&merged_frame->yellow_robots, &merged_frame->blue_robots})
+        {
+            for (SSLRobotData &robot : *robots)
+            {
+                robot.timestamp = merged_frame->t_capture;
+            }
+        }
+        backend.processDetectionFrame(*merged_frame, messages);
+        num_team_msgs += messages.friendly_team_msg_updated;
+    });
+
+    std::cout << "processDetectionFrame: " << process_frame_ns << " ns/frame"
+              << std::endl;
+
+    EXPECT_EQ(NUM_ITERATIONS + NUM_ITERATIONS / 10, num_team_msgs);
+}
+
+TEST_F(BackendBenchmark, tick_with_no_new_data)
+{
+    Backend backend;
+    BackendMessages messages = BackendMessages();
+
+    double no_data_ns = averageNanoseconds(
+        [&]() { backend.processTimedOutFrames(Timestamp::getTimestampNow(), messages); });
+
+    std::cout << "processTimedOutFrames with no new data: " << no_data_ns << " ns/tick"
+              << std::endl;
+
+    EXPECT_FALSE(messages.ball_msg_updated);
+    EXPECT_FALSE(messages.friendly_team_msg_updated);
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
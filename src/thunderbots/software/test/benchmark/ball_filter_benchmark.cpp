@@ -0,0 +1,194 @@
+/**
+ * Runs the BallFilter over synthetic noisy ball trajectories, and reports how accurate
+ * its estimates are and how long each update takes.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "network_input/filter/ball_filter.h"
+
+using namespace std::chrono;
+
+class BallFilterBenchmark : public ::testing::Test
+{
+   protected:
+    /**
+     * The true state of the simulated ball at a single frame, and what SSL Vision
+     * reported for that frame
+     */
+    struct SimulatedFrame
+    {
+        Point true_position;
+        Vector true_velocity;
+        std::vector<SSLBallData> detections;
+    };
+
+    /**
+     * Simulates a ball being kicked around the field, and SSL Vision detecting it with
+     * noise, occasional missed detections, and occasional false detections
+     *
+     * @param num_frames The number of frames to simulate
+     * @param seed The seed for the random number generator
+     *
+     * @return The simulated frames
+     */
+    static std::vector<SimulatedFrame> simulateTrajectory(unsigned int num_frames,
+                                                          unsigned int seed)
+    {
+        std::mt19937 random_generator(seed);
+        std::normal_distribution<double> measurement_noise(0, MEASUREMENT_NOISE_STDDEV);
+        std::uniform_real_distribution<double> unit(0, 1);
+        std::uniform_real_distribution<double> field_x(-4.5, 4.5);
+        std::uniform_real_distribution<double> field_y(-3, 3);
+        std::uniform_real_distribution<double> kick_speed(1, 6);
+        std::uniform_real_distribution<double> kick_angle(-M_PI, M_PI);
+
+        std::vector<SimulatedFrame> frames;
+        Point position(0, 0);
+        Vector velocity(0, 0);
+        for (unsigned int i = 0; i < num_frames; i++)
+        {
+            const double t = 100.0 + i * FRAME_PERIOD;
+
+            // Kick the ball in a random direction about once a second
+            if (unit(random_generator) < FRAME_PERIOD)
+            {
+                double angle = kick_angle(random_generator);
+                velocity     = Vector(std::cos(angle), std::sin(angle)) *
+                           kick_speed(random_generator);
+            }
+
+            // Rolling friction slows the ball down, and it bounces off the field walls
+            double speed = velocity.len();
+            if (speed > 0)
+            {
+                velocity = velocity.norm(
+                    std::max(0.0, speed - ROLLING_DECELERATION * FRAME_PERIOD));
+            }
+            position = position + velocity * FRAME_PERIOD;
+            if (std::fabs(position.x()) > 4.5)
+            {
+                velocity = Vector(-velocity.x(), velocity.y());
+            }
+            if (std::fabs(position.y()) > 3)
+            {
+                velocity = Vector(velocity.x(), -velocity.y());
+            }
+
+            SimulatedFrame frame;
+            frame.true_position = position;
+            frame.true_velocity = velocity;
+            if (unit(random_generator) > MISSED_DETECTION_PROBABILITY)
+            {
+                SSLBallData detection;
+                detection.position =
+                    position + Vector(measurement_noise(random_generator),
+                                      measurement_noise(random_generator));
+                detection.confidence = 0.9;
+                detection.timestamp  = t;
+                frame.detections.emplace_back(detection);
+            }
+            if (unit(random_generator) < FALSE_DETECTION_PROBABILITY)
+            {
+                SSLBallData detection;
+                detection.position =
+                    Point(field_x(random_generator), field_y(random_generator));
+                detection.confidence = unit(random_generator);
+                detection.timestamp  = t;
+                frame.detections.emplace_back(detection);
+            }
+            frames.emplace_back(frame);
+        }
+
+        return frames;
+    }
+
+    static constexpr double FRAME_PERIOD                 = 1.0 / 60.0;
+    static constexpr double MEASUREMENT_NOISE_STDDEV     = 0.003;
+    static constexpr double ROLLING_DECELERATION         = 0.5;
+    static constexpr double MISSED_DETECTION_PROBABILITY = 0.05;
+    static constexpr double FALSE_DETECTION_PROBABILITY  = 0.1;
+};
+
+TEST_F(BallFilterBenchmark, accuracy_and_update_cost_on_noisy_trajectories)
+{
+    static constexpr unsigned int NUM_TRAJECTORIES = 10;
+    static constexpr unsigned int NUM_FRAMES       = 3600;
+
+    double filtered_position_squared_error = 0;
+    double raw_position_squared_error      = 0;
+    double velocity_squared_error          = 0;
+    unsigned int num_position_samples      = 0;
+    unsigned int num_raw_position_samples  = 0;
+    unsigned int num_velocity_samples      = 0;
+    nanoseconds total_update_time(0);
+    unsigned int num_updates = 0;
+
+    for (unsigned int seed = 0; seed < NUM_TRAJECTORIES; seed++)
+    {
+        std::vector<SimulatedFrame> frames = simulateTrajectory(NUM_FRAMES, seed);
+        BallFilter ball_filter;
+
+        for (const SimulatedFrame &frame : frames)
+        {
+            auto start = steady_clock::now();
+            std::optional<FilteredBallData> filtered_data =
+                ball_filter.getFilteredData(frame.detections);
+            total_update_time += steady_clock::now() - start;
+            num_updates++;
+
+            if (!filtered_data)
+            {
+                continue;
+            }
+
+            filtered_position_squared_error +=
+                (filtered_data->position - frame.true_position).lensq();
+            velocity_squared_error +=
+                (filtered_data->velocity - frame.true_velocity).lensq();
+            num_position_samples++;
+            num_velocity_samples++;
+
+            // The error we would have if we just used the first detection, like we used
+            // to
+            if (!frame.detections.empty())
+            {
+                raw_position_squared_error +=
+                    (frame.detections[0].position - frame.true_position).lensq();
+                num_raw_position_samples++;
+            }
+        }
+    }
+
+    double filtered_position_rms =
+        std::sqrt(filtered_position_squared_error / num_position_samples);
+    double raw_position_rms =
+        std::sqrt(raw_position_squared_error / num_raw_position_samples);
+    double velocity_rms = std::sqrt(velocity_squared_error / num_velocity_samples);
+    double update_ns =
+        static_cast<double>(total_update_time.count()) / static_cast<double>(num_updates);
+
+    std::cout << "Raw first detection position RMS error: " << raw_position_rms << " m"
+              << std::endl
+              << "Filtered position RMS error: " << filtered_position_rms << " m"
+              << std::endl
+              << "Filtered velocity RMS error: " << velocity_rms << " m/s" << std::endl
+              << "Average update time: " << update_ns << " ns" << std::endl;
+
+    // The filter should do better than just using the first detection, which is
+    // thrown off by every false detection
+    EXPECT_LT(filtered_position_rms, raw_position_rms);
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
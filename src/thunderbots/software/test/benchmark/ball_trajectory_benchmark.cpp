@@ -0,0 +1,82 @@
+/**
+ * Measures how long it takes to rebuild the BallTrajectory when the ball is updated,
+ * and how long each position lookup into it takes.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ai/world/ball_trajectory.h"
+
+using namespace std::chrono;
+
+TEST(BallTrajectoryBenchmark, build_and_lookup_cost)
+{
+    static constexpr unsigned int NUM_UPDATES = 10000;
+    static constexpr unsigned int NUM_LOOKUPS = 100;
+
+    std::mt19937 random_generator(0);
+    std::uniform_real_distribution<double> speed(0, 6.5);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_int_distribution<int> lookup_milliseconds(0, 3000);
+
+    // Generate everything up front so only the trajectory is timed
+    std::vector<Ball> balls;
+    std::vector<microseconds> lookup_times;
+    auto timestamp = steady_clock::time_point() + seconds(10000);
+    for (unsigned int i = 0; i < NUM_UPDATES; i++)
+    {
+        double a = angle(random_generator);
+        balls.emplace_back(
+            Ball(Point(0, 0), Vector(std::cos(a), std::sin(a)) * speed(random_generator),
+                 timestamp + milliseconds(i * 16)));
+    }
+    for (unsigned int i = 0; i < NUM_LOOKUPS; i++)
+    {
+        lookup_times.emplace_back(milliseconds(lookup_milliseconds(random_generator)));
+    }
+
+    BallTrajectory trajectory(balls[0]);
+    nanoseconds total_build_time(0);
+    nanoseconds total_lookup_time(0);
+    double checksum = 0;
+    for (const Ball &ball : balls)
+    {
+        auto start = steady_clock::now();
+        trajectory.update(ball);
+        total_build_time += steady_clock::now() - start;
+
+        start = steady_clock::now();
+        for (const microseconds &time : lookup_times)
+        {
+            checksum += trajectory.estimatePositionAtFutureTime(time).x();
+        }
+        total_lookup_time += steady_clock::now() - start;
+    }
+
+    double build_ns =
+        static_cast<double>(total_build_time.count()) / static_cast<double>(NUM_UPDATES);
+    double lookup_ns = static_cast<double>(total_lookup_time.count()) /
+                       static_cast<double>(NUM_UPDATES * NUM_LOOKUPS);
+
+    std::cout << "Average trajectory build time: " << build_ns << " ns" << std::endl
+              << "Average position lookup time: " << lookup_ns << " ns" << std::endl
+              << "Checksum: " << checksum << std::endl;
+
+    // Every lookup should stay within the distance a ball could possibly travel
+    EXPECT_LE(std::fabs(checksum),
+              NUM_UPDATES * NUM_LOOKUPS * 6.5 * 6.5 /
+                  (2 * BallTrajectory::ROLLING_DECELERATION_METERS_PER_SECOND_SQUARED));
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,71 @@
+/**
+ * Measures how long the HungarianSolver takes to assign a full team of robots to the
+ * tactics of a play, for random costs.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "util/hungarian_solver.h"
+
+using namespace std::chrono;
+
+TEST(HungarianSolverBenchmark, solve_cost_for_eight_robots_and_tactics)
+{
+    static constexpr unsigned int NUM_PROBLEMS = 10000;
+    static constexpr std::size_t SIZE          = 8;
+
+    // Generate everything up front so only the solver is timed
+    std::mt19937 random_generator(0);
+    std::uniform_real_distribution<double> travel_time(0, 5);
+    std::vector<double> costs(NUM_PROBLEMS * SIZE * SIZE);
+    for (double &cost : costs)
+    {
+        cost = travel_time(random_generator);
+    }
+
+    HungarianSolver solver;
+    nanoseconds total_solve_time(0);
+    nanoseconds max_solve_time(0);
+    for (unsigned int i = 0; i < NUM_PROBLEMS; i++)
+    {
+        auto start = steady_clock::now();
+        solver.reset(SIZE, SIZE);
+        for (std::size_t row = 0; row < SIZE; row++)
+        {
+            for (std::size_t column = 0; column < SIZE; column++)
+            {
+                solver.setCost(row, column, costs[(i * SIZE + row) * SIZE + column]);
+            }
+        }
+        solver.solve();
+        auto solve_time = steady_clock::now() - start;
+        total_solve_time += solve_time;
+        max_solve_time = std::max(max_solve_time, duration_cast<nanoseconds>(solve_time));
+
+        std::set<std::size_t> assigned_columns;
+        for (std::size_t row = 0; row < SIZE; row++)
+        {
+            assigned_columns.insert(solver.getAssignedColumn(row));
+        }
+        ASSERT_EQ(SIZE, assigned_columns.size());
+    }
+
+    double solve_ns =
+        static_cast<double>(total_solve_time.count()) / static_cast<double>(NUM_PROBLEMS);
+    std::cout << "Problem size: " << SIZE << "x" << SIZE << std::endl
+              << "Average solve time: " << solve_ns << " ns" << std::endl
+              << "Max solve time: " << max_solve_time.count() << " ns" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,100 @@
+/**
+ * Measures how long the InterceptSolver takes to find the intercepts of every robot on
+ * both teams, for random robot and ball states.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ai/hl/stp/evaluation/intercept.h"
+
+using namespace std::chrono;
+
+TEST(InterceptBenchmark, solve_cost_for_full_teams)
+{
+    static constexpr unsigned int NUM_SCENARIOS       = 1000;
+    static constexpr unsigned int NUM_ROBOTS_PER_TEAM = 8;
+
+    std::mt19937 random_generator(0);
+    std::uniform_real_distribution<double> field_x(-4.5, 4.5);
+    std::uniform_real_distribution<double> field_y(-3, 3);
+    std::uniform_real_distribution<double> ball_speed(0, 6.5);
+    std::uniform_real_distribution<double> robot_speed(0, 2);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    // Generate everything up front so only the solver is timed
+    auto timestamp = steady_clock::time_point() + seconds(10000);
+    std::vector<BallTrajectory> trajectories;
+    std::vector<Team> friendly_teams;
+    std::vector<Team> enemy_teams;
+    for (unsigned int i = 0; i < NUM_SCENARIOS; i++)
+    {
+        double ball_angle = angle(random_generator);
+        trajectories.emplace_back(
+            Ball(Point(field_x(random_generator), field_y(random_generator)),
+                 Vector(std::cos(ball_angle), std::sin(ball_angle)) *
+                     ball_speed(random_generator),
+                 timestamp));
+
+        for (std::vector<Team> *teams : {&friendly_teams, &enemy_teams})
+        {
+            std::vector<Robot> robots;
+            for (unsigned int id = 0; id < NUM_ROBOTS_PER_TEAM; id++)
+            {
+                double robot_angle = angle(random_generator);
+                robots.emplace_back(
+                    Robot(id, Point(field_x(random_generator), field_y(random_generator)),
+                          Vector(std::cos(robot_angle), std::sin(robot_angle)) *
+                              robot_speed(random_generator),
+                          Angle::zero(), AngularVelocity::zero(), timestamp));
+            }
+            Team team(milliseconds(1000));
+            team.updateRobots(robots);
+            teams->emplace_back(team);
+        }
+    }
+
+    InterceptSolver solver;
+    nanoseconds total_solve_time(0);
+    nanoseconds max_solve_time(0);
+    unsigned int num_intercepts = 0;
+    for (unsigned int i = 0; i < NUM_SCENARIOS; i++)
+    {
+        auto start = steady_clock::now();
+        solver.solve(trajectories[i], friendly_teams[i], enemy_teams[i]);
+        auto solve_time = steady_clock::now() - start;
+        total_solve_time += solve_time;
+        max_solve_time = std::max(max_solve_time, duration_cast<nanoseconds>(solve_time));
+
+        for (unsigned int id = 0; id < NUM_ROBOTS_PER_TEAM; id++)
+        {
+            for (const std::optional<BallIntercept> &intercept :
+                 {solver.getFriendlyIntercept(id), solver.getEnemyIntercept(id)})
+            {
+                ASSERT_TRUE(intercept);
+                EXPECT_GE(intercept->timestamp, timestamp);
+                num_intercepts++;
+            }
+        }
+    }
+
+    double solve_ns = static_cast<double>(total_solve_time.count()) /
+                      static_cast<double>(NUM_SCENARIOS);
+    std::cout << "Robots per solve: " << 2 * NUM_ROBOTS_PER_TEAM << std::endl
+              << "Average solve time: " << solve_ns << " ns" << std::endl
+              << "Max solve time: " << max_solve_time.count() << " ns" << std::endl;
+
+    EXPECT_EQ(NUM_SCENARIOS * 2 * NUM_ROBOTS_PER_TEAM, num_intercepts);
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
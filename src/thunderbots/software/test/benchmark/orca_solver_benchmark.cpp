@@ -0,0 +1,81 @@
+/**
+ * Measures how long the OrcaSolver takes to choose velocities for a full team of
+ * robots, with a full enemy team on the field, for random positions and velocities.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ai/navigator/orca/orca_solver.h"
+
+using namespace std::chrono;
+
+TEST(OrcaSolverBenchmark, solve_cost_for_sixteen_robots_against_sixteen_enemies)
+{
+    static constexpr unsigned int NUM_PROBLEMS = 1000;
+    static constexpr std::size_t NUM_ROBOTS    = 16;
+    static constexpr double RADIUS             = 0.09;
+    static constexpr double MAX_SPEED          = 2;
+
+    // Generate everything up front so only the solver is timed. Every robot is packed
+    // into half the field, so plenty of them are about to collide
+    std::mt19937 random_generator(0);
+    std::uniform_real_distribution<double> position_x(-2, 2);
+    std::uniform_real_distribution<double> position_y(-1.5, 1.5);
+    std::uniform_real_distribution<double> velocity(-1.5, 1.5);
+    std::vector<Point> positions(NUM_PROBLEMS * 2 * NUM_ROBOTS);
+    std::vector<Vector> velocities(NUM_PROBLEMS * 2 * NUM_ROBOTS);
+    for (std::size_t i = 0; i < positions.size(); i++)
+    {
+        positions[i]  = Point(position_x(random_generator), position_y(random_generator));
+        velocities[i] = Vector(velocity(random_generator), velocity(random_generator));
+    }
+
+    OrcaSolver solver;
+    nanoseconds total_solve_time(0);
+    nanoseconds max_solve_time(0);
+    for (unsigned int i = 0; i < NUM_PROBLEMS; i++)
+    {
+        const std::size_t first = i * 2 * NUM_ROBOTS;
+        auto start              = steady_clock::now();
+        solver.reset();
+        for (std::size_t robot = 0; robot < NUM_ROBOTS; robot++)
+        {
+            solver.addControlledAgent(positions[first + robot], velocities[first + robot],
+                                      RADIUS, velocities[first + robot], MAX_SPEED);
+        }
+        for (std::size_t robot = NUM_ROBOTS; robot < 2 * NUM_ROBOTS; robot++)
+        {
+            solver.addUncontrolledAgent(positions[first + robot],
+                                        velocities[first + robot], RADIUS);
+        }
+        solver.solve();
+        auto solve_time = steady_clock::now() - start;
+        total_solve_time += solve_time;
+        max_solve_time = std::max(max_solve_time, duration_cast<nanoseconds>(solve_time));
+
+        for (std::size_t robot = 0; robot < NUM_ROBOTS; robot++)
+        {
+            ASSERT_LE(solver.getNewVelocity(robot).len(), MAX_SPEED + 1e-6);
+        }
+    }
+
+    std::cout << "Robots per problem: " << NUM_ROBOTS << " against " << NUM_ROBOTS
+              << " enemies" << std::endl
+              << "Average solve time: "
+              << duration_cast<microseconds>(total_solve_time).count() / NUM_PROBLEMS
+              << " us" << std::endl
+              << "Max solve time: " << duration_cast<microseconds>(max_solve_time).count()
+              << " us" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,97 @@
+/**
+ * Measures how long the RRTNav takes to plan paths for a whole team in one tick, with
+ * the enemy team standing in the way and drifting a little every tick. The first tick
+ * plans every path from scratch, and the rest repair the paths from the tick before.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "ai/intent/move_intent.h"
+#include "ai/navigator/rrt/rrt.h"
+#include "test/test_util/test_util.h"
+
+using namespace std::chrono;
+
+TEST(RRTNavBenchmark, tick_cost_with_eight_robots_crossing_the_field)
+{
+    static constexpr unsigned int NUM_TICKS  = 100;
+    static constexpr unsigned int NUM_ROBOTS = 8;
+
+    // Our robots line up on one side of the field and drive to the other side, through
+    // a wall of enemy robots in the middle
+    World world = ::Test::TestUtil::createBlankTestingWorld();
+    std::vector<Point> friendly_positions;
+    std::vector<Point> enemy_positions;
+    std::vector<std::unique_ptr<Intent>> intents;
+    for (unsigned int i = 0; i < NUM_ROBOTS; i++)
+    {
+        const double y = -2.8 + i * 0.8;
+        friendly_positions.emplace_back(-4, y);
+        enemy_positions.emplace_back(0, y + 0.4);
+        intents.emplace_back(
+            std::make_unique<MoveIntent>(i, Point(4, -y), Angle::zero(), 0));
+    }
+    world = ::Test::TestUtil::setFriendlyRobotPositions(world, friendly_positions);
+
+    // Only limit the iterations, so every run plans the same paths
+    ThreadPool thread_pool = ThreadPool(4);
+    RRTNav navigator       = RRTNav(thread_pool, std::nullopt);
+    nanoseconds first_tick_time(0);
+    nanoseconds total_tick_time(0);
+    nanoseconds max_tick_time(0);
+    for (unsigned int i = 0; i < NUM_TICKS; i++)
+    {
+        // Enemies move a couple of centimetres per tick, back and forth
+        std::vector<Point> drifted_enemy_positions;
+        for (const Point &position : enemy_positions)
+        {
+            drifted_enemy_positions.emplace_back(position +
+                                                 Vector(0, 0.2 * std::sin(i * 0.1)));
+        }
+        world = ::Test::TestUtil::setEnemyRobotPositions(world, drifted_enemy_positions);
+
+        auto start = steady_clock::now();
+        std::vector<std::unique_ptr<Primitive>> primitives =
+            navigator.getAssignedPrimitives(world, intents);
+        auto tick_time = steady_clock::now() - start;
+        if (i == 0)
+        {
+            first_tick_time = tick_time;
+        }
+        else
+        {
+            total_tick_time += tick_time;
+            max_tick_time =
+                std::max(max_tick_time, duration_cast<nanoseconds>(tick_time));
+        }
+
+        ASSERT_EQ(NUM_ROBOTS, primitives.size());
+        for (unsigned int robot_id = 0; robot_id < NUM_ROBOTS; robot_id++)
+        {
+            EXPECT_EQ(robot_id, primitives[robot_id]->getRobotId());
+        }
+    }
+
+    std::cout << "Robots planned per tick: " << NUM_ROBOTS << std::endl
+              << "First tick time: "
+              << duration_cast<microseconds>(first_tick_time).count() << " us"
+              << std::endl
+              << "Average tick time after that: "
+              << duration_cast<microseconds>(total_tick_time).count() / (NUM_TICKS - 1)
+              << " us" << std::endl
+              << "Max tick time after that: "
+              << duration_cast<microseconds>(max_tick_time).count() << " us" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
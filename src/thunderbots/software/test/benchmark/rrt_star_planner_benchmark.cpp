@@ -0,0 +1,71 @@
+/**
+ * Measures how long the RRTStarPlanner takes to plan one robot's path across a field
+ * full of robots, for random robot positions.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ai/navigator/rrt/rrt_star_planner.h"
+
+using namespace std::chrono;
+
+TEST(RRTStarPlannerBenchmark, plan_cost_with_fifteen_robots_in_the_way)
+{
+    static constexpr unsigned int NUM_QUERIES   = 500;
+    static constexpr unsigned int NUM_OBSTACLES = 15;
+
+    // Generate everything up front so only the planner is timed. Each robot drives
+    // across the middle of the field, where the other robots are
+    std::mt19937 random_generator(0);
+    std::uniform_real_distribution<double> field_x(-2.5, 2.5);
+    std::uniform_real_distribution<double> field_y(-2.5, 2.5);
+    std::vector<std::vector<Circle>> obstacles(NUM_QUERIES);
+    for (std::vector<Circle> &query_obstacles : obstacles)
+    {
+        for (unsigned int i = 0; i < NUM_OBSTACLES; i++)
+        {
+            query_obstacles.emplace_back(
+                Point(field_x(random_generator), field_y(random_generator)), 0.24);
+        }
+    }
+    const Rect bounds(Point(-4.6, -3.1), Point(4.6, 3.1));
+
+    // Only limit the iterations, so every run does the same work
+    RRTStarPlanner planner = RRTStarPlanner(std::nullopt);
+    nanoseconds total_plan_time(0);
+    nanoseconds max_plan_time(0);
+    unsigned int num_paths_to_goal = 0;
+    for (unsigned int i = 0; i < NUM_QUERIES; i++)
+    {
+        auto start = steady_clock::now();
+        const std::vector<Point> &path =
+            planner.findPath(Point(-4, 0), Point(4, 0), bounds, obstacles[i], i);
+        auto plan_time = steady_clock::now() - start;
+        total_plan_time += plan_time;
+        max_plan_time = std::max(max_plan_time, duration_cast<nanoseconds>(plan_time));
+
+        ASSERT_FALSE(path.empty());
+        num_paths_to_goal += path.back() == Point(4, 0);
+    }
+
+    std::cout << "Obstacles per query: " << NUM_OBSTACLES << std::endl
+              << "Paths that reached the goal: " << num_paths_to_goal << " of "
+              << NUM_QUERIES << std::endl
+              << "Average plan time: "
+              << duration_cast<microseconds>(total_plan_time).count() / NUM_QUERIES
+              << " us" << std::endl
+              << "Max plan time: " << duration_cast<microseconds>(max_plan_time).count()
+              << " us" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,126 @@
+/**
+ * Measures how long the ShotHeatmap takes to compute every cell on one thread and on
+ * several, and how long incremental updates take as a few robots move each tick.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ai/hl/stp/evaluation/shot_heatmap.h"
+
+using namespace std::chrono;
+
+class ShotHeatmapBenchmark : public ::testing::Test
+{
+   protected:
+    static constexpr double CELL_SIZE_METERS      = 0.05;
+    static constexpr unsigned int NUM_UPDATES     = 100;
+    static constexpr unsigned int ROBOTS_PER_TEAM = 8;
+
+    void SetUp() override
+    {
+        std::mt19937 random_generator(0);
+        std::uniform_real_distribution<double> field_x(-4.5, 4.5);
+        std::uniform_real_distribution<double> field_y(-3, 3);
+        std::uniform_real_distribution<double> step(-0.05, 0.05);
+        std::bernoulli_distribution moves(0.25);
+
+        // Each tick a quarter of the robots move a few centimetres, as they would
+        // between camera frames
+        std::vector<Point> positions;
+        for (unsigned int i = 0; i < 2 * ROBOTS_PER_TEAM; i++)
+        {
+            positions.emplace_back(field_x(random_generator), field_y(random_generator));
+        }
+        auto timestamp = steady_clock::time_point() + seconds(10000);
+        for (unsigned int update = 0; update < NUM_UPDATES; update++)
+        {
+            std::vector<Robot> friendly_robots, enemy_robots;
+            for (unsigned int i = 0; i < positions.size(); i++)
+            {
+                if (moves(random_generator))
+                {
+                    positions[i] = positions[i] +
+                                   Vector(step(random_generator), step(random_generator));
+                }
+                auto &robots = i < ROBOTS_PER_TEAM ? friendly_robots : enemy_robots;
+                robots.emplace_back(Robot(i % ROBOTS_PER_TEAM, positions[i], Vector(),
+                                          Angle::zero(), AngularVelocity::zero(),
+                                          timestamp));
+            }
+            Team friendly_team(milliseconds(1000));
+            friendly_team.updateRobots(friendly_robots);
+            Team enemy_team(milliseconds(1000));
+            enemy_team.updateRobots(enemy_robots);
+            friendly_teams.emplace_back(friendly_team);
+            enemy_teams.emplace_back(enemy_team);
+        }
+    }
+
+    Field field = Field(9, 6, 1, 2, 1, 0.3, 0.5);
+    std::vector<Team> friendly_teams;
+    std::vector<Team> enemy_teams;
+};
+
+TEST_F(ShotHeatmapBenchmark, full_update_cost)
+{
+    for (unsigned int num_threads : {1u, 4u})
+    {
+        ThreadPool pool(num_threads);
+        nanoseconds total_time(0);
+        for (unsigned int i = 0; i < NUM_UPDATES; i++)
+        {
+            // A new heatmap has to compute every cell
+            ShotHeatmap heatmap(CELL_SIZE_METERS, pool);
+            auto start = steady_clock::now();
+            heatmap.update(field, friendly_teams[i], enemy_teams[i]);
+            total_time += steady_clock::now() - start;
+
+            ASSERT_EQ(heatmap.getNumColumns() * heatmap.getNumRows(),
+                      heatmap.getNumCellsRecomputed());
+        }
+
+        std::cout << "Threads: " << num_threads << std::endl
+                  << "Average full update time: "
+                  << duration_cast<microseconds>(total_time).count() / NUM_UPDATES
+                  << " us" << std::endl;
+    }
+}
+
+TEST_F(ShotHeatmapBenchmark, incremental_update_cost)
+{
+    ThreadPool pool(4);
+    ShotHeatmap heatmap(CELL_SIZE_METERS, pool);
+    heatmap.update(field, friendly_teams[0], enemy_teams[0]);
+    const std::size_t num_cells = heatmap.getNumColumns() * heatmap.getNumRows();
+
+    nanoseconds total_time(0);
+    std::size_t total_cells_recomputed = 0;
+    for (unsigned int i = 1; i < NUM_UPDATES; i++)
+    {
+        auto start = steady_clock::now();
+        heatmap.update(field, friendly_teams[i], enemy_teams[i]);
+        total_time += steady_clock::now() - start;
+        total_cells_recomputed += heatmap.getNumCellsRecomputed();
+    }
+
+    std::cout << "Cells: " << num_cells << std::endl
+              << "Average cells recomputed: "
+              << total_cells_recomputed / (NUM_UPDATES - 1) << std::endl
+              << "Average incremental update time: "
+              << duration_cast<microseconds>(total_time).count() / (NUM_UPDATES - 1)
+              << " us" << std::endl;
+
+    EXPECT_LT(total_cells_recomputed, num_cells * (NUM_UPDATES - 1));
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
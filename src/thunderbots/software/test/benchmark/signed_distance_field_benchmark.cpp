@@ -0,0 +1,76 @@
+/**
+ * Measures how long the SignedDistanceField takes to rebuild for a new field, and to
+ * look up the clearance of random points compared to calculating it from the field
+ * geometry.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ai/world/signed_distance_field.h"
+#include "test/test_util/test_util.h"
+
+using namespace std::chrono;
+
+TEST(SignedDistanceFieldBenchmark, rebuild_and_lookup_cost_on_division_b_field)
+{
+    static constexpr unsigned int NUM_LOOKUPS = 1000000;
+
+    const Field field = ::Test::TestUtil::createSSLDivBField();
+    auto start        = steady_clock::now();
+    SignedDistanceField distance(field);
+    auto rebuild_time = steady_clock::now() - start;
+
+    // Generate everything up front so only the lookups are timed
+    std::mt19937 random_generator(0);
+    std::uniform_real_distribution<double> x(-field.totalLength() / 2,
+                                             field.totalLength() / 2);
+    std::uniform_real_distribution<double> y(-field.totalWidth() / 2,
+                                             field.totalWidth() / 2);
+    std::vector<Point> points;
+    for (unsigned int i = 0; i < NUM_LOOKUPS; i++)
+    {
+        points.emplace_back(x(random_generator), y(random_generator));
+    }
+
+    // Sum the results so the lookups can't be optimised away
+    double lookup_sum = 0;
+    start             = steady_clock::now();
+    for (const Point &point : points)
+    {
+        lookup_sum += distance.getClearance(point);
+    }
+    auto lookup_time = steady_clock::now() - start;
+
+    double exact_sum = 0;
+    start            = steady_clock::now();
+    for (const Point &point : points)
+    {
+        exact_sum += SignedDistanceField::calculateClearance(field, point);
+    }
+    auto exact_time = steady_clock::now() - start;
+
+    EXPECT_NEAR(exact_sum / NUM_LOOKUPS, lookup_sum / NUM_LOOKUPS,
+                SignedDistanceField::RESOLUTION_METERS);
+    std::cout << "Rebuild time: " << duration_cast<microseconds>(rebuild_time).count()
+              << " us" << std::endl
+              << "Average lookup time: "
+              << static_cast<double>(duration_cast<nanoseconds>(lookup_time).count()) /
+                     NUM_LOOKUPS
+              << " ns" << std::endl
+              << "Average exact calculation time: "
+              << static_cast<double>(duration_cast<nanoseconds>(exact_time).count()) /
+                     NUM_LOOKUPS
+              << " ns" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,161 @@
+/**
+ * Compares how long it takes to decode a typical SSL Vision detection packet with the
+ * SSLWireDecoder against parsing it with protobuf and converting it to SSLBallData and
+ * SSLRobotData the way the Backend does.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "network_input/networking/ssl_wire_decoder.h"
+#include "proto/messages_robocup_ssl_wrapper.pb.h"
+#include "shared/constants.h"
+
+using namespace std::chrono;
+
+class SSLWireDecoderBenchmark : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        // A full field of robots, with a few false positives, as seen by one camera
+        SSL_DetectionFrame *frame = packet.mutable_detection();
+        frame->set_frame_number(1234);
+        frame->set_t_capture(10.5);
+        frame->set_t_sent(10.52);
+        frame->set_camera_id(0);
+
+        for (unsigned int i = 0; i < 3; i++)
+        {
+            SSL_DetectionBall *ball = frame->add_balls();
+            ball->set_confidence(0.9f);
+            ball->set_area(78);
+            ball->set_x(1000.0f + i);
+            ball->set_y(-500.0f - i);
+            ball->set_z(0.0f);
+            ball->set_pixel_x(320.0f);
+            ball->set_pixel_y(240.0f);
+        }
+
+        for (unsigned int id = 0; id < 8; id++)
+        {
+            for (SSL_DetectionRobot *robot :
+                 {frame->add_robots_yellow(), frame->add_robots_blue()})
+            {
+                robot->set_confidence(0.8f);
+                robot->set_robot_id(id);
+                robot->set_x(-1500.0f + 100.0f * id);
+                robot->set_y(250.0f - 50.0f * id);
+                robot->set_orientation(0.2f * id);
+                robot->set_pixel_x(100.0f);
+                robot->set_pixel_y(200.0f);
+                robot->set_height(150.0f);
+            }
+        }
+
+        data = packet.SerializeAsString();
+    }
+
+    /**
+     * Returns the average time taken to run the given function, in nanoseconds
+     */
+    template <typename Function>
+    double averageNanoseconds(Function function)
+    {
+        // Warm up caches and the allocator before timing anything
+        for (unsigned int i = 0; i < NUM_ITERATIONS / 10; i++)
+        {
+            function();
+        }
+
+        auto start = steady_clock::now();
+        for (unsigned int i = 0; i < NUM_ITERATIONS; i++)
+        {
+            function();
+        }
+        auto end = steady_clock::now();
+
+        return static_cast<double>(duration_cast<nanoseconds>(end - start).count()) /
+               NUM_ITERATIONS;
+    }
+
+    static constexpr unsigned int NUM_ITERATIONS = 20000;
+
+    SSL_WrapperPacket packet;
+    std::string data;
+};
+
+TEST_F(SSLWireDecoderBenchmark, decode_detection_packet)
+{
+    SSL_WrapperPacket parsed_packet;
+    std::vector<SSLBallData> balls;
+    std::vector<SSLRobotData> yellow_robots;
+    std::vector<SSLRobotData> blue_robots;
+    std::size_t num_protobuf_detections = 0;
+
+    // This parses with protobuf and converts the detections into the lists the filters
+    // take, allocating new lists for every packet
+    double protobuf_ns = averageNanoseconds([&]() {
+        parsed_packet.ParseFromArray(data.data(), static_cast<int>(data.size()));
+        const SSL_DetectionFrame &detection = parsed_packet.detection();
+
+        balls = std::vector<SSLBallData>();
+        for (const SSL_DetectionBall &ball : detection.balls())
+        {
+            SSLBallData ball_data;
+            ball_data.position =
+                Point(ball.x() * METERS_PER_MILLIMETER, ball.y() * METERS_PER_MILLIMETER);
+            ball_data.confidence = ball.confidence();
+            ball_data.timestamp  = detection.t_capture();
+            balls.push_back(ball_data);
+        }
+
+        for (auto robots : {std::make_pair(&detection.robots_yellow(), &yellow_robots),
+                            std::make_pair(&detection.robots_blue(), &blue_robots)})
+        {
+            *robots.second = std::vector<SSLRobotData>();
+            for (const SSL_DetectionRobot &robot : *robots.first)
+            {
+                SSLRobotData robot_data;
+                robot_data.id          = robot.robot_id();
+                robot_data.position    = Point(robot.x() * METERS_PER_MILLIMETER,
+                                            robot.y() * METERS_PER_MILLIMETER);
+                robot_data.orientation = Angle::ofRadians(robot.orientation());
+                robot_data.confidence  = robot.confidence();
+                robot_data.timestamp   = detection.t_capture();
+                robots.second->emplace_back(robot_data);
+            }
+        }
+
+        num_protobuf_detections =
+            balls.size() + yellow_robots.size() + blue_robots.size();
+    });
+
+    SSLWrapperPacketData packet_data;
+    bool decoded_successfully = true;
+    double wire_decoder_ns    = averageNanoseconds([&]() {
+        decoded_successfully &=
+            SSLWireDecoder::decodeWrapperPacket(data.data(), data.size(), packet_data);
+    });
+
+    std::cout << "Packet size: " << data.size() << " bytes" << std::endl
+              << "protobuf ParseFromArray + conversion: " << protobuf_ns << " ns/packet"
+              << std::endl
+              << "SSLWireDecoder: " << wire_decoder_ns << " ns/packet" << std::endl;
+
+    // Make sure both paths actually did the same work
+    ASSERT_TRUE(decoded_successfully);
+    EXPECT_EQ(num_protobuf_detections, packet_data.detection.num_balls +
+                                           packet_data.detection.num_yellow_robots +
+                                           packet_data.detection.num_blue_robots);
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
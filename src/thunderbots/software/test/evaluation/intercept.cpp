@@ -0,0 +1,238 @@
+#include "ai/hl/stp/evaluation/intercept.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace std::chrono;
+
+class InterceptSolverTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        auto epoch       = time_point<std::chrono::steady_clock>();
+        auto since_epoch = std::chrono::seconds(10000);
+
+        // An arbitrary fixed point in time. 10000 seconds after the epoch.
+        // We use this fixed point in time to make the tests deterministic.
+        current_time = epoch + since_epoch;
+    }
+
+    /**
+     * Returns how many seconds after the current time the given intercept is
+     */
+    double secondsAfterCurrentTime(const BallIntercept &intercept)
+    {
+        return duration<double>(intercept.timestamp - current_time).count();
+    }
+
+    /**
+     * Returns a team with the given robots on it
+     */
+    static Team makeTeam(const std::vector<Robot> &robots)
+    {
+        Team team(milliseconds(1000));
+        team.updateRobots(robots);
+        return team;
+    }
+
+    steady_clock::time_point current_time;
+};
+
+TEST_F(InterceptSolverTest, robot_drives_to_stationary_ball)
+{
+    BallTrajectory trajectory(Ball(Point(1, 0), Vector(), current_time));
+    Team friendly_team = makeTeam({Robot(0, Point(0, 0), Vector(), Angle::zero(),
+                                         AngularVelocity::zero(), current_time)});
+
+    InterceptSolver solver;
+    solver.solve(trajectory, friendly_team, makeTeam({}));
+
+    // The robot accelerates to its maximum speed of 2m/s after 2/3 of a metre, and
+    // then covers the rest of the distance at that speed
+    const double distance         = 1 - InterceptSolver::INTERCEPT_DISTANCE_METERS;
+    const double expected_seconds = 2.0 / 3.0 + (distance - 2.0 / 3.0) / 2;
+
+    std::optional<BallIntercept> intercept = solver.getFriendlyIntercept(0);
+    ASSERT_TRUE(intercept);
+    EXPECT_EQ(Point(1, 0), intercept->position);
+    EXPECT_NEAR(expected_seconds, secondsAfterCurrentTime(*intercept), 1e-5);
+}
+
+TEST_F(InterceptSolverTest, robot_touching_the_ball_intercepts_immediately)
+{
+    BallTrajectory trajectory(Ball(Point(1, 0), Vector(1, 1), current_time));
+    Team enemy_team = makeTeam({Robot(4, Point(1.1, 0), Vector(), Angle::zero(),
+                                      AngularVelocity::zero(), current_time)});
+
+    InterceptSolver solver;
+    solver.solve(trajectory, makeTeam({}), enemy_team);
+
+    std::optional<BallIntercept> intercept = solver.getEnemyIntercept(4);
+    ASSERT_TRUE(intercept);
+    EXPECT_EQ(Point(1, 0), intercept->position);
+    EXPECT_EQ(current_time, intercept->timestamp);
+}
+
+TEST_F(InterceptSolverTest, moving_towards_the_ball_is_faster)
+{
+    BallTrajectory trajectory(Ball(Point(0, 0), Vector(), current_time));
+    Team friendly_team = makeTeam({Robot(0, Point(-2, 0), Vector(), Angle::zero(),
+                                         AngularVelocity::zero(), current_time),
+                                   Robot(1, Point(0, -2), Vector(0, 2), Angle::zero(),
+                                         AngularVelocity::zero(), current_time),
+                                   Robot(2, Point(2, 0), Vector(2, 0), Angle::zero(),
+                                         AngularVelocity::zero(), current_time)});
+
+    InterceptSolver solver;
+    solver.solve(trajectory, friendly_team, makeTeam({}));
+
+    double still_seconds   = secondsAfterCurrentTime(*solver.getFriendlyIntercept(0));
+    double towards_seconds = secondsAfterCurrentTime(*solver.getFriendlyIntercept(1));
+    double away_seconds    = secondsAfterCurrentTime(*solver.getFriendlyIntercept(2));
+    EXPECT_LT(towards_seconds, still_seconds);
+    EXPECT_LT(still_seconds, away_seconds);
+}
+
+TEST_F(InterceptSolverTest, robot_meets_ball_rolling_towards_it)
+{
+    BallTrajectory trajectory(Ball(Point(0, 0), Vector(2, 0), current_time));
+    Team friendly_team = makeTeam({Robot(0, Point(3, 0), Vector(), Angle::zero(),
+                                         AngularVelocity::zero(), current_time)});
+
+    InterceptSolver solver;
+    solver.solve(trajectory, friendly_team, makeTeam({}));
+
+    // The robot drives towards the ball, so they meet before the ball gets to where
+    // the robot started
+    std::optional<BallIntercept> intercept = solver.getFriendlyIntercept(0);
+    ASSERT_TRUE(intercept);
+    EXPECT_GT(intercept->position.x(), 0);
+    EXPECT_LT(intercept->position.x(), 3 - InterceptSolver::INTERCEPT_DISTANCE_METERS);
+    EXPECT_DOUBLE_EQ(0, intercept->position.y());
+    // The ball is at the intercept position at the intercept time
+    auto time_after_start = duration_cast<microseconds>(intercept->timestamp -
+                                                        trajectory.getStartTimestamp());
+    EXPECT_TRUE(trajectory.estimatePositionAtFutureTime(time_after_start)
+                    .isClose(intercept->position, 1e-5));
+}
+
+TEST_F(InterceptSolverTest, robot_that_cannot_catch_the_ball_goes_to_the_end)
+{
+    // The ball rolls away faster than the robot can drive for longer than the trajectory
+    // is sampled for
+    BallTrajectory trajectory(Ball(Point(0, 0), Vector(6, 0), current_time));
+    Team friendly_team = makeTeam({Robot(0, Point(-1, 0), Vector(), Angle::zero(),
+                                         AngularVelocity::zero(), current_time)});
+
+    InterceptSolver solver;
+    solver.solve(trajectory, friendly_team, makeTeam({}));
+
+    std::optional<BallIntercept> intercept = solver.getFriendlyIntercept(0);
+    ASSERT_TRUE(intercept);
+    EXPECT_DOUBLE_EQ(trajectory.getSampleXPositions().back(), intercept->position.x());
+    double last_sample_seconds =
+        duration<double>(BallTrajectory::SAMPLE_PERIOD * (trajectory.getNumSamples() - 1))
+            .count();
+    EXPECT_GT(secondsAfterCurrentTime(*intercept), last_sample_seconds);
+}
+
+TEST_F(InterceptSolverTest, robots_updated_after_the_ball_start_later)
+{
+    BallTrajectory trajectory(Ball(Point(1, 0), Vector(), current_time));
+    Team friendly_team =
+        makeTeam({Robot(0, Point(0, 0), Vector(), Angle::zero(), AngularVelocity::zero(),
+                        current_time),
+                  Robot(1, Point(0, 0), Vector(), Angle::zero(), AngularVelocity::zero(),
+                        current_time + milliseconds(500))});
+
+    InterceptSolver solver;
+    solver.solve(trajectory, friendly_team, makeTeam({}));
+
+    EXPECT_NEAR(secondsAfterCurrentTime(*solver.getFriendlyIntercept(0)) + 0.5,
+                secondsAfterCurrentTime(*solver.getFriendlyIntercept(1)), 0.01);
+}
+
+TEST_F(InterceptSolverTest, no_intercepts_for_robots_not_on_the_teams)
+{
+    BallTrajectory trajectory(Ball(Point(1, 0), Vector(), current_time));
+    Team friendly_team = makeTeam({Robot(3, Point(0, 0), Vector(), Angle::zero(),
+                                         AngularVelocity::zero(), current_time)});
+
+    InterceptSolver solver;
+    EXPECT_FALSE(solver.getFriendlyIntercept(3));
+
+    solver.solve(trajectory, friendly_team, makeTeam({}));
+    EXPECT_TRUE(solver.getFriendlyIntercept(3));
+    EXPECT_FALSE(solver.getFriendlyIntercept(0));
+    EXPECT_FALSE(solver.getEnemyIntercept(3));
+    EXPECT_FALSE(solver.getFriendlyIntercept(Team::MAX_ROBOT_IDS));
+
+    // Robots that leave the team no longer have intercepts
+    solver.solve(trajectory, makeTeam({}), makeTeam({}));
+    EXPECT_FALSE(solver.getFriendlyIntercept(3));
+}
+
+TEST_F(InterceptSolverTest, skipping_samples_finds_the_same_intercepts_as_checking_all)
+{
+    // How far a robot can drive in the given time, accelerating up to its maximum speed
+    auto reachable_distance = [](double seconds, double initial_speed) {
+        const double max_speed = ROBOT_MAX_SPEED_METERS_PER_SECOND;
+        const double max_accel = ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED;
+        initial_speed          = std::clamp(initial_speed, -max_speed, max_speed);
+        double accel_time = std::min(seconds, (max_speed - initial_speed) / max_accel);
+        return initial_speed * accel_time + 0.5 * max_accel * accel_time * accel_time +
+               max_speed * (seconds - accel_time);
+    };
+
+    std::mt19937 random_generator(0);
+    std::uniform_real_distribution<double> coordinate(-4, 4);
+    std::uniform_real_distribution<double> velocity(-3, 3);
+
+    InterceptSolver solver;
+    for (unsigned int scenario = 0; scenario < 200; scenario++)
+    {
+        BallTrajectory trajectory(
+            Ball(Point(coordinate(random_generator), coordinate(random_generator)),
+                 Vector(velocity(random_generator), velocity(random_generator)),
+                 current_time));
+        Robot robot(0, Point(coordinate(random_generator), coordinate(random_generator)),
+                    Vector(velocity(random_generator), velocity(random_generator)) / 2,
+                    Angle::zero(), AngularVelocity::zero(), current_time);
+        solver.solve(trajectory, makeTeam({robot}), makeTeam({}));
+
+        // Check every sample in order
+        std::optional<std::size_t> first_reachable_sample;
+        for (std::size_t i = 0; i < trajectory.getNumSamples(); i++)
+        {
+            Point ball_position(trajectory.getSampleXPositions()[i],
+                                trajectory.getSampleYPositions()[i]);
+            Vector to_ball  = ball_position - robot.position();
+            double distance = to_ball.len();
+            double initial_speed =
+                distance > 0 ? robot.velocity().dot(to_ball) / distance : 0;
+            double seconds = duration<double>(BallTrajectory::SAMPLE_PERIOD * i).count();
+            if (distance - InterceptSolver::INTERCEPT_DISTANCE_METERS <=
+                reachable_distance(seconds, initial_speed))
+            {
+                first_reachable_sample = i;
+                break;
+            }
+        }
+
+        if (first_reachable_sample)
+        {
+            EXPECT_EQ(
+                current_time + BallTrajectory::SAMPLE_PERIOD * *first_reachable_sample,
+                solver.getFriendlyIntercept(0)->timestamp);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,322 @@
+#include "ai/hl/stp/evaluation/shot_heatmap.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "geom/util.h"
+
+using namespace std::chrono;
+
+class ShotHeatmapTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        auto epoch       = time_point<std::chrono::steady_clock>();
+        auto since_epoch = std::chrono::seconds(10000);
+
+        // An arbitrary fixed point in time. 10000 seconds after the epoch.
+        // We use this fixed point in time to make the tests deterministic.
+        current_time = epoch + since_epoch;
+    }
+
+    /**
+     * Returns a team with robots at the given positions, with ids in order
+     */
+    Team makeTeam(const std::vector<Point> &positions)
+    {
+        std::vector<Robot> robots;
+        for (unsigned int id = 0; id < positions.size(); id++)
+        {
+            robots.emplace_back(Robot(id, positions[id], Vector(), Angle::zero(),
+                                      AngularVelocity::zero(), current_time));
+        }
+        Team team(milliseconds(1000));
+        team.updateRobots(robots);
+        return team;
+    }
+
+    /**
+     * Finds the largest open angle into the enemy goal from the given point by casting
+     * many evenly spaced rays at the goal, and measuring the longest run of rays that
+     * don't pass within the blocking radius of any robot before reaching the goal line
+     */
+    static double sampleOpenAngle(const Field &field, const Point &point,
+                                  const std::vector<Point> &robots)
+    {
+        static constexpr int NUM_RAYS = 4000;
+        const Point goalpost_neg      = field.enemyGoalpostNeg();
+        const Point goalpost_pos      = field.enemyGoalpostPos();
+        const double start_angle      = (goalpost_neg - point).orientation().toRadians();
+        const double end_angle        = (goalpost_pos - point).orientation().toRadians();
+        const double step             = (end_angle - start_angle) / NUM_RAYS;
+
+        double largest_gap = 0;
+        double gap         = 0;
+        for (int i = 0; i < NUM_RAYS; i++)
+        {
+            const double angle = start_angle + (i + 0.5) * step;
+            const Vector direction(std::cos(angle), std::sin(angle));
+            const double length = (goalpost_neg.x() - point.x()) / direction.x();
+            const Seg ray(point, point + direction * length);
+
+            bool blocked = false;
+            for (const Point &robot : robots)
+            {
+                blocked = blocked ||
+                          dist(robot, ray) < ShotHeatmap::ROBOT_BLOCKING_RADIUS_METERS;
+            }
+            gap         = blocked ? 0 : gap + step;
+            largest_gap = std::max(largest_gap, gap);
+        }
+        return largest_gap;
+    }
+
+    /**
+     * Expects every cell of the two heatmaps to be exactly equal
+     */
+    static void expectHeatmapsEqual(const ShotHeatmap &expected,
+                                    const ShotHeatmap &actual)
+    {
+        ASSERT_EQ(expected.getNumColumns(), actual.getNumColumns());
+        ASSERT_EQ(expected.getNumRows(), actual.getNumRows());
+        for (std::size_t row = 0; row < expected.getNumRows(); row++)
+        {
+            for (std::size_t column = 0; column < expected.getNumColumns(); column++)
+            {
+                ASSERT_EQ(expected.getOpenAngle(column, row).toRadians(),
+                          actual.getOpenAngle(column, row).toRadians())
+                    << "column " << column << ", row " << row;
+            }
+        }
+    }
+
+    steady_clock::time_point current_time;
+    Field field = Field(9, 6, 1, 2, 1, 0.3, 0.5);
+};
+
+TEST_F(ShotHeatmapTest, open_angle_is_zero_before_first_update)
+{
+    ThreadPool pool(1);
+    ShotHeatmap heatmap(0.1, pool);
+
+    EXPECT_EQ(0u, heatmap.getNumColumns());
+    EXPECT_EQ(Angle::zero(), heatmap.getOpenAngle(Point(0, 0)));
+}
+
+TEST_F(ShotHeatmapTest, grid_covers_field_at_given_resolution)
+{
+    ThreadPool pool(2);
+    ShotHeatmap heatmap(0.25, pool);
+    heatmap.update(field, makeTeam({}), makeTeam({}));
+
+    EXPECT_EQ(36u, heatmap.getNumColumns());
+    EXPECT_EQ(24u, heatmap.getNumRows());
+    EXPECT_EQ(Point(-4.375, -2.875), heatmap.getCellCentre(0, 0));
+    EXPECT_EQ(Point(4.375, 2.875), heatmap.getCellCentre(35, 23));
+    EXPECT_EQ(36u * 24u, heatmap.getNumCellsRecomputed());
+}
+
+TEST_F(ShotHeatmapTest, empty_field_sees_whole_goal)
+{
+    ThreadPool pool(2);
+    ShotHeatmap heatmap(0.25, pool);
+    heatmap.update(field, makeTeam({}), makeTeam({}));
+
+    // The goal is 1m wide, and the centre of this cell is 2.125m in front of it
+    const Point centre = heatmap.getCellCentre(26, 12);
+    ASSERT_EQ(Point(2.125, 0.125), centre);
+    const double expected = std::atan2(0.375, 2.375) + std::atan2(0.625, 2.375);
+    EXPECT_NEAR(expected, heatmap.getOpenAngle(centre).toRadians(), 1e-12);
+}
+
+TEST_F(ShotHeatmapTest, lookup_uses_cell_containing_point)
+{
+    ThreadPool pool(2);
+    ShotHeatmap heatmap(0.25, pool);
+    heatmap.update(field, makeTeam({}), makeTeam({Point(3, 0)}));
+
+    EXPECT_EQ(heatmap.getOpenAngle(26, 12), heatmap.getOpenAngle(Point(2.01, 0.01)));
+    EXPECT_EQ(heatmap.getOpenAngle(26, 12), heatmap.getOpenAngle(Point(2.24, 0.24)));
+    // Points off the field use the nearest cell
+    EXPECT_EQ(heatmap.getOpenAngle(0, 0), heatmap.getOpenAngle(Point(-10, -10)));
+    EXPECT_EQ(heatmap.getOpenAngle(35, 23), heatmap.getOpenAngle(Point(10, 10)));
+}
+
+TEST_F(ShotHeatmapTest, robot_in_front_of_goal_centre_splits_goal)
+{
+    ThreadPool pool(2);
+    ShotHeatmap heatmap(0.25, pool);
+    heatmap.update(field, makeTeam({}), makeTeam({Point(4, 0.125)}));
+
+    // The robot is straight between the cell and the middle of the goal, so the open
+    // angle is the larger of the two gaps on either side of it
+    const Point centre = heatmap.getCellCentre(26, 12);
+    const double blocked_half_width =
+        std::asin(ShotHeatmap::ROBOT_BLOCKING_RADIUS_METERS / 1.875);
+    const double expected = std::atan2(0.625, 2.375) - blocked_half_width;
+    EXPECT_NEAR(expected, heatmap.getOpenAngle(centre).toRadians(), 1e-12);
+}
+
+TEST_F(ShotHeatmapTest, cells_inside_robots_have_no_open_angle)
+{
+    ThreadPool pool(2);
+    ShotHeatmap heatmap(0.25, pool);
+    heatmap.update(field, makeTeam({Point(0.125, 0.125)}), makeTeam({}));
+
+    EXPECT_EQ(Angle::zero(), heatmap.getOpenAngle(Point(0.125, 0.125)));
+}
+
+TEST_F(ShotHeatmapTest, robots_behind_shooter_or_goal_do_not_block)
+{
+    ThreadPool pool(2);
+    ShotHeatmap empty_heatmap(0.25, pool);
+    empty_heatmap.update(field, makeTeam({}), makeTeam({}));
+    ShotHeatmap heatmap(0.25, pool);
+    heatmap.update(field, makeTeam({Point(1.5, 0.125)}), makeTeam({Point(4.7, 0)}));
+
+    EXPECT_EQ(empty_heatmap.getOpenAngle(Point(2.125, 0.125)),
+              heatmap.getOpenAngle(Point(2.125, 0.125)));
+}
+
+TEST_F(ShotHeatmapTest, open_angles_match_sampled_rays)
+{
+    std::mt19937 random_generator(0);
+    std::uniform_real_distribution<double> field_x(-4.5, 4.5);
+    std::uniform_real_distribution<double> field_y(-3, 3);
+    std::vector<Point> friendly_positions, enemy_positions, all_positions;
+    for (unsigned int i = 0; i < 8; i++)
+    {
+        friendly_positions.emplace_back(field_x(random_generator),
+                                        field_y(random_generator));
+        enemy_positions.emplace_back(field_x(random_generator) / 3 + 3,
+                                     field_y(random_generator) / 3);
+    }
+    all_positions.insert(all_positions.end(), friendly_positions.begin(),
+                         friendly_positions.end());
+    all_positions.insert(all_positions.end(), enemy_positions.begin(),
+                         enemy_positions.end());
+
+    ThreadPool pool(4);
+    ShotHeatmap heatmap(0.5, pool);
+    heatmap.update(field, makeTeam(friendly_positions), makeTeam(enemy_positions));
+
+    for (std::size_t row = 0; row < heatmap.getNumRows(); row++)
+    {
+        for (std::size_t column = 0; column < heatmap.getNumColumns(); column++)
+        {
+            const Point centre = heatmap.getCellCentre(column, row);
+            EXPECT_NEAR(sampleOpenAngle(field, centre, all_positions),
+                        heatmap.getOpenAngle(column, row).toRadians(), 1e-3)
+                << centre;
+        }
+    }
+}
+
+TEST_F(ShotHeatmapTest, small_movements_do_not_recompute_cells)
+{
+    ThreadPool pool(2);
+    ShotHeatmap heatmap(0.1, pool);
+    heatmap.update(field, makeTeam({Point(2, 0)}), makeTeam({Point(3, 0.5)}));
+    const Angle open_angle = heatmap.getOpenAngle(Point(0, 0));
+
+    heatmap.update(field, makeTeam({Point(2.01, 0)}), makeTeam({Point(3, 0.49)}));
+
+    EXPECT_EQ(0u, heatmap.getNumCellsRecomputed());
+    EXPECT_EQ(open_angle, heatmap.getOpenAngle(Point(0, 0)));
+}
+
+TEST_F(ShotHeatmapTest, moving_robot_only_recomputes_cells_it_shadows)
+{
+    ThreadPool pool(2);
+    ShotHeatmap heatmap(0.1, pool);
+    heatmap.update(field, makeTeam({Point(2, 0)}), makeTeam({Point(-2, 2)}));
+    const std::size_t num_cells = heatmap.getNumColumns() * heatmap.getNumRows();
+
+    heatmap.update(field, makeTeam({Point(2, 0)}), makeTeam({Point(-2.2, 2)}));
+
+    // Only the narrow shadows the robot casts away from the goal are affected
+    EXPECT_GT(heatmap.getNumCellsRecomputed(), 0u);
+    EXPECT_LT(heatmap.getNumCellsRecomputed(), num_cells / 20);
+}
+
+TEST_F(ShotHeatmapTest, field_change_recomputes_every_cell)
+{
+    ThreadPool pool(2);
+    ShotHeatmap heatmap(0.5, pool);
+    heatmap.update(field, makeTeam({}), makeTeam({}));
+    heatmap.update(Field(12, 9, 1.2, 2.4, 1.2, 0.3, 0.5), makeTeam({}), makeTeam({}));
+
+    EXPECT_EQ(24u, heatmap.getNumColumns());
+    EXPECT_EQ(18u, heatmap.getNumRows());
+    EXPECT_EQ(24u * 18u, heatmap.getNumCellsRecomputed());
+}
+
+TEST_F(ShotHeatmapTest, incremental_updates_match_full_recompute)
+{
+    std::mt19937 random_generator(1);
+    std::uniform_real_distribution<double> field_x(-4.5, 4.5);
+    std::uniform_real_distribution<double> field_y(-3, 3);
+    std::uniform_real_distribution<double> step(-0.3, 0.3);
+    std::bernoulli_distribution moves(0.3);
+    std::vector<Point> friendly_positions, enemy_positions;
+    for (unsigned int i = 0; i < 6; i++)
+    {
+        friendly_positions.emplace_back(field_x(random_generator),
+                                        field_y(random_generator));
+        enemy_positions.emplace_back(field_x(random_generator),
+                                     field_y(random_generator));
+    }
+
+    ThreadPool pool(4);
+    ShotHeatmap heatmap(0.2, pool);
+    heatmap.update(field, makeTeam(friendly_positions), makeTeam(enemy_positions));
+    for (unsigned int update = 0; update < 20; update++)
+    {
+        // Robots either stay exactly where they are or move further than the
+        // threshold, so the incremental heatmap uses the same positions as a new one
+        for (std::vector<Point> *positions : {&friendly_positions, &enemy_positions})
+        {
+            for (Point &position : *positions)
+            {
+                if (moves(random_generator))
+                {
+                    position = position + Vector(step(random_generator) > 0 ? 0.1 : -0.1,
+                                                 step(random_generator));
+                }
+            }
+        }
+        // Robots join and leave the teams too
+        std::vector<Point> enemies(enemy_positions.begin(),
+                                   enemy_positions.begin() + 3 + update % 4);
+
+        heatmap.update(field, makeTeam(friendly_positions), makeTeam(enemies));
+        ShotHeatmap expected(0.2, pool);
+        expected.update(field, makeTeam(friendly_positions), makeTeam(enemies));
+        expectHeatmapsEqual(expected, heatmap);
+    }
+}
+
+TEST_F(ShotHeatmapTest, result_does_not_depend_on_number_of_threads)
+{
+    Team friendly_team = makeTeam({Point(1, 1), Point(2, -1), Point(3.5, 0.2)});
+    Team enemy_team    = makeTeam({Point(4, -0.3), Point(0, 0), Point(-2, 2)});
+
+    ThreadPool single_thread_pool(1);
+    ShotHeatmap single_thread_heatmap(0.1, single_thread_pool);
+    single_thread_heatmap.update(field, friendly_team, enemy_team);
+    ThreadPool multi_thread_pool(8);
+    ShotHeatmap multi_thread_heatmap(0.1, multi_thread_pool);
+    multi_thread_heatmap.update(field, friendly_team, enemy_team);
+
+    expectHeatmapsEqual(single_thread_heatmap, multi_thread_heatmap);
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
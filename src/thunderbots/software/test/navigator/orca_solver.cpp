@@ -0,0 +1,201 @@
+#include "ai/navigator/orca/orca_solver.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+class OrcaSolverTest : public ::testing::Test
+{
+   protected:
+    /**
+     * Expects two agents moving at the given velocities to stay at least the given
+     * distance apart for the whole time horizon
+     */
+    static void expectNoCollision(const Point &first_position,
+                                  const Vector &first_velocity,
+                                  const Point &second_position,
+                                  const Vector &second_velocity, double min_distance)
+    {
+        const Vector relative_position = second_position - first_position;
+        const Vector relative_velocity = second_velocity - first_velocity;
+        // Find the time the agents are closest, within the time horizon
+        double t = 0;
+        if (relative_velocity.lensq() > 0)
+        {
+            t = std::clamp(
+                -relative_position.dot(relative_velocity) / relative_velocity.lensq(),
+                0.0, OrcaSolver::TIME_HORIZON_SECONDS);
+        }
+        EXPECT_GE((relative_position + t * relative_velocity).len(), min_distance - 1e-6)
+            << "closest at " << t << "s";
+    }
+
+    static constexpr double RADIUS    = 0.09;
+    static constexpr double MAX_SPEED = 2;
+    OrcaSolver solver;
+};
+
+TEST_F(OrcaSolverTest, keeps_preferred_velocity_with_nothing_in_the_way)
+{
+    const std::size_t agent = solver.addControlledAgent(Point(0, 0), Vector(), RADIUS,
+                                                        Vector(1, 0.5), MAX_SPEED);
+    solver.addUncontrolledAgent(Point(0, 3), Vector(), RADIUS);
+
+    solver.solve();
+
+    EXPECT_TRUE(solver.getNewVelocity(agent).isClose(Vector(1, 0.5)));
+}
+
+TEST_F(OrcaSolverTest, limits_preferred_velocity_to_max_speed)
+{
+    const std::size_t agent =
+        solver.addControlledAgent(Point(0, 0), Vector(), RADIUS, Vector(4, 0), MAX_SPEED);
+
+    solver.solve();
+
+    EXPECT_TRUE(solver.getNewVelocity(agent).isClose(Vector(MAX_SPEED, 0)));
+}
+
+TEST_F(OrcaSolverTest, avoids_stationary_uncontrolled_agent)
+{
+    const std::size_t agent = solver.addControlledAgent(Point(0, 0), Vector(1, 0), RADIUS,
+                                                        Vector(1, 0), MAX_SPEED);
+    const std::size_t obstacle =
+        solver.addUncontrolledAgent(Point(0.4, 0), Vector(), RADIUS);
+
+    solver.solve();
+
+    const Vector new_velocity = solver.getNewVelocity(agent);
+    EXPECT_FALSE(new_velocity.isClose(Vector(1, 0)));
+    EXPECT_LE(new_velocity.len(), MAX_SPEED + 1e-6);
+    EXPECT_EQ(Vector(), solver.getNewVelocity(obstacle));
+    expectNoCollision(Point(0, 0), new_velocity, Point(0.4, 0), Vector(), 2 * RADIUS);
+}
+
+TEST_F(OrcaSolverTest, avoids_moving_uncontrolled_agent)
+{
+    // An enemy is cutting across in front of the agent
+    const std::size_t agent = solver.addControlledAgent(
+        Point(0, 0), Vector(1.5, 0), RADIUS, Vector(1.5, 0), MAX_SPEED);
+    solver.addUncontrolledAgent(Point(0.5, -0.5), Vector(0, 1.5), RADIUS);
+
+    solver.solve();
+
+    expectNoCollision(Point(0, 0), solver.getNewVelocity(agent), Point(0.5, -0.5),
+                      Vector(0, 1.5), 2 * RADIUS);
+}
+
+TEST_F(OrcaSolverTest, head_on_agents_share_the_avoidance)
+{
+    const std::size_t first  = solver.addControlledAgent(Point(-0.5, 0), Vector(1, 0),
+                                                        RADIUS, Vector(1, 0), MAX_SPEED);
+    const std::size_t second = solver.addControlledAgent(
+        Point(0.5, 0), Vector(-1, 0), RADIUS, Vector(-1, 0), MAX_SPEED);
+
+    solver.solve();
+
+    const Vector first_velocity  = solver.getNewVelocity(first);
+    const Vector second_velocity = solver.getNewVelocity(second);
+    EXPECT_FALSE(first_velocity.isClose(Vector(1, 0)));
+    EXPECT_FALSE(second_velocity.isClose(Vector(-1, 0)));
+    expectNoCollision(Point(-0.5, 0), first_velocity, Point(0.5, 0), second_velocity,
+                      2 * RADIUS);
+}
+
+TEST_F(OrcaSolverTest, agents_moving_apart_are_unchanged)
+{
+    const std::size_t first  = solver.addControlledAgent(Point(-0.2, 0), Vector(-1, 0),
+                                                        RADIUS, Vector(-1, 0), MAX_SPEED);
+    const std::size_t second = solver.addControlledAgent(Point(0.2, 0), Vector(1, 0),
+                                                         RADIUS, Vector(1, 0), MAX_SPEED);
+
+    solver.solve();
+
+    EXPECT_TRUE(solver.getNewVelocity(first).isClose(Vector(-1, 0)));
+    EXPECT_TRUE(solver.getNewVelocity(second).isClose(Vector(1, 0)));
+}
+
+TEST_F(OrcaSolverTest, overlapping_agents_move_apart)
+{
+    const std::size_t agent =
+        solver.addControlledAgent(Point(0, 0), Vector(), RADIUS, Vector(), MAX_SPEED);
+    solver.addUncontrolledAgent(Point(0.1, 0), Vector(), RADIUS);
+
+    solver.solve();
+
+    EXPECT_LT(solver.getNewVelocity(agent).x(), 0);
+}
+
+TEST_F(OrcaSolverTest, crowded_agents_stay_within_max_speed)
+{
+    // Surrounded on every side, so there is no velocity that avoids everything
+    const std::size_t agent = solver.addControlledAgent(Point(0, 0), Vector(1, 0), RADIUS,
+                                                        Vector(1, 0), MAX_SPEED);
+    for (int i = 0; i < 8; i++)
+    {
+        const Vector offset = Vector::createFromAngle(Angle::ofDegrees(i * 45)) * 0.2;
+        solver.addUncontrolledAgent(Point() + offset, -offset * 5, RADIUS);
+    }
+
+    solver.solve();
+
+    EXPECT_LE(solver.getNewVelocity(agent).len(), MAX_SPEED + 1e-6);
+    EXPECT_FALSE(solver.getNewVelocity(agent).isnan());
+}
+
+TEST_F(OrcaSolverTest, reset_removes_agents)
+{
+    solver.addControlledAgent(Point(0, 0), Vector(), RADIUS, Vector(), MAX_SPEED);
+    solver.addUncontrolledAgent(Point(1, 0), Vector(), RADIUS);
+
+    solver.reset();
+
+    EXPECT_EQ(0u, solver.getNumAgents());
+}
+
+TEST_F(OrcaSolverTest, random_team_of_controlled_agents_avoid_each_other)
+{
+    std::mt19937 random_generator(0);
+    std::uniform_real_distribution<double> position(-2, 2);
+    std::uniform_real_distribution<double> velocity(-1.5, 1.5);
+
+    // Place agents so none of them start overlapping
+    std::vector<Point> positions;
+    std::vector<Vector> velocities;
+    while (positions.size() < 16)
+    {
+        const Point candidate(position(random_generator), position(random_generator));
+        bool overlaps = false;
+        for (const Point &placed : positions)
+        {
+            overlaps |= (candidate - placed).len() < 3 * RADIUS;
+        }
+        if (!overlaps)
+        {
+            positions.emplace_back(candidate);
+            velocities.emplace_back(velocity(random_generator),
+                                    velocity(random_generator));
+            solver.addControlledAgent(candidate, velocities.back(), RADIUS,
+                                      velocities.back(), MAX_SPEED);
+        }
+    }
+
+    solver.solve();
+
+    for (std::size_t i = 0; i < positions.size(); i++)
+    {
+        for (std::size_t j = i + 1; j < positions.size(); j++)
+        {
+            expectNoCollision(positions[i], solver.getNewVelocity(i), positions[j],
+                              solver.getNewVelocity(j), 2 * RADIUS);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,317 @@
+#include "ai/navigator/rrt/rrt_star_planner.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "geom/util.h"
+
+class RRTStarPlannerTest : public ::testing::Test
+{
+   protected:
+    /**
+     * Expects the path from the start to pass through none of the obstacles and stay
+     * inside the bounds
+     */
+    void expectPathValid(const Point &start, const std::vector<Point> &path,
+                         const std::vector<Circle> &obstacles)
+    {
+        ASSERT_FALSE(path.empty());
+        Point from = start;
+        for (const Point &waypoint : path)
+        {
+            EXPECT_TRUE(bounds.containsPoint(waypoint)) << waypoint;
+            for (const Circle &obstacle : obstacles)
+            {
+                EXPECT_GE(dist(obstacle.origin, Seg(from, waypoint)), obstacle.radius)
+                    << from << " to " << waypoint;
+            }
+            from = waypoint;
+        }
+    }
+
+    /**
+     * Returns the length of the path from the start
+     */
+    static double pathLength(const Point &start, const std::vector<Point> &path)
+    {
+        double length = 0;
+        Point from    = start;
+        for (const Point &waypoint : path)
+        {
+            length += (waypoint - from).len();
+            from = waypoint;
+        }
+        return length;
+    }
+
+    Rect bounds = Rect(Point(-5, -3.5), Point(5, 3.5));
+    // Without a time budget, the paths don't depend on how fast the machine is
+    RRTStarPlanner planner = RRTStarPlanner(std::nullopt);
+};
+
+TEST_F(RRTStarPlannerTest, goes_straight_to_goal_when_nothing_is_in_the_way)
+{
+    std::vector<Circle> obstacles = {Circle(Point(0, 2), 0.3)};
+
+    const std::vector<Point> &path =
+        planner.findPath(Point(-2, 0), Point(2, 0), bounds, obstacles, 0);
+
+    EXPECT_EQ(std::vector<Point>({Point(2, 0)}), path);
+    EXPECT_TRUE(planner.lastPathReachesGoal());
+    EXPECT_EQ(1u, planner.getNumNodes());
+}
+
+TEST_F(RRTStarPlannerTest, goes_around_obstacle_in_the_way)
+{
+    std::vector<Circle> obstacles = {Circle(Point(0, 0), 0.5)};
+
+    const std::vector<Point> path =
+        planner.findPath(Point(-2, 0), Point(2, 0), bounds, obstacles, 0);
+
+    expectPathValid(Point(-2, 0), path, obstacles);
+    EXPECT_EQ(Point(2, 0), path.back());
+    // The shortest path hugs the obstacle and is about 4.2m long
+    EXPECT_LT(pathLength(Point(-2, 0), path), 4.6);
+}
+
+TEST_F(RRTStarPlannerTest, goes_around_wall_of_robots)
+{
+    std::vector<Circle> obstacles;
+    for (double y = -2; y <= 2; y += 0.3)
+    {
+        obstacles.emplace_back(Point(0, y), 0.25);
+    }
+
+    const std::vector<Point> path =
+        planner.findPath(Point(-1, 0), Point(1, 0), bounds, obstacles, 0);
+
+    expectPathValid(Point(-1, 0), path, obstacles);
+    EXPECT_EQ(Point(1, 0), path.back());
+}
+
+TEST_F(RRTStarPlannerTest, same_seed_gives_same_path)
+{
+    std::vector<Circle> obstacles = {Circle(Point(0, 0), 0.5), Circle(Point(1, 1), 0.4)};
+
+    const std::vector<Point> first_path =
+        planner.findPath(Point(-2, 0), Point(2, 0.5), bounds, obstacles, 7);
+    planner.findPath(Point(3, 3), Point(-3, -3), bounds, obstacles, 8);
+    const std::vector<Point> second_path =
+        planner.findPath(Point(-2, 0), Point(2, 0.5), bounds, obstacles, 7);
+
+    EXPECT_EQ(first_path, second_path);
+}
+
+TEST_F(RRTStarPlannerTest, obstacles_containing_start_or_goal_are_ignored)
+{
+    std::vector<Circle> obstacles = {Circle(Point(-2, 0), 0.5), Circle(Point(2, 0), 0.5)};
+
+    const std::vector<Point> &path =
+        planner.findPath(Point(-2, 0), Point(2, 0), bounds, obstacles, 0);
+
+    EXPECT_EQ(std::vector<Point>({Point(2, 0)}), path);
+}
+
+TEST_F(RRTStarPlannerTest, unreachable_goal_gives_path_towards_it)
+{
+    // A ring of robots around the goal with no gaps in it
+    std::vector<Circle> obstacles;
+    for (int i = 0; i < 16; i++)
+    {
+        const double angle = i * 2 * M_PI / 16;
+        obstacles.emplace_back(Point(2 + std::cos(angle), std::sin(angle)), 0.3);
+    }
+
+    const std::vector<Point> path =
+        planner.findPath(Point(-2, 0), Point(2, 0), bounds, obstacles, 0);
+
+    expectPathValid(Point(-2, 0), path, obstacles);
+    EXPECT_FALSE(planner.lastPathReachesGoal());
+    EXPECT_NE(Point(2, 0), path.back());
+    EXPECT_LT((path.back() - Point(2, 0)).len(), 1.6);
+}
+
+TEST_F(RRTStarPlannerTest, enclosed_start_gives_path_that_stays_at_start)
+{
+    // A ring of robots around the start with no gaps in it, and too little room inside
+    // it for the tree to grow
+    std::vector<Circle> obstacles;
+    for (int i = 0; i < 16; i++)
+    {
+        const double angle = i * 2 * M_PI / 16;
+        obstacles.emplace_back(Point(-2 + 0.2 * std::cos(angle), 0.2 * std::sin(angle)),
+                               0.15);
+    }
+
+    const std::vector<Point> path =
+        planner.findPath(Point(-2, 0), Point(2, 0), bounds, obstacles, 0);
+
+    EXPECT_EQ(std::vector<Point>({Point(-2, 0)}), path);
+    EXPECT_FALSE(planner.lastPathReachesGoal());
+}
+
+TEST_F(RRTStarPlannerTest, goes_around_defense_area_in_the_way)
+{
+    const Field field = Field(9.0, 6.0, 1.0, 2.0, 1.0, 0.3, 0.5);
+    const SignedDistanceField signed_distance_field(field);
+    planner.setStaticObstacles(&signed_distance_field, 0.09);
+
+    const std::vector<Point> path =
+        planner.findPath(Point(-4, -1.5), Point(-4, 1.5), bounds, {}, 0);
+
+    EXPECT_EQ(Point(-4, 1.5), path.back());
+    // Check the exact clearance all along the path, allowing for the lookups being
+    // interpolated
+    Point from = Point(-4, -1.5);
+    for (const Point &waypoint : path)
+    {
+        for (double t = 0; t <= 1; t += 0.01)
+        {
+            const Point point = from + (waypoint - from) * t;
+            EXPECT_GE(SignedDistanceField::calculateClearance(field, point),
+                      0.09 - SignedDistanceField::RESOLUTION_METERS)
+                << point;
+        }
+        from = waypoint;
+    }
+}
+
+TEST_F(RRTStarPlannerTest, start_inside_static_obstacle_can_leave_it)
+{
+    const Field field = Field(9.0, 6.0, 1.0, 2.0, 1.0, 0.3, 0.5);
+    const SignedDistanceField signed_distance_field(field);
+    planner.setStaticObstacles(&signed_distance_field, 0.09);
+
+    const std::vector<Point> &path =
+        planner.findPath(Point(-4.2, 0), Point(0, 0), bounds, {}, 0);
+
+    EXPECT_EQ(std::vector<Point>({Point(0, 0)}), path);
+}
+
+TEST_F(RRTStarPlannerTest, stops_within_time_budget)
+{
+    // An unreachable goal makes the planner use its whole budget
+    std::vector<Circle> obstacles;
+    for (int i = 0; i < 16; i++)
+    {
+        const double angle = i * 2 * M_PI / 16;
+        obstacles.emplace_back(Point(2 + std::cos(angle), std::sin(angle)), 0.3);
+    }
+
+    RRTStarPlanner timed_planner;
+    auto start = std::chrono::steady_clock::now();
+    timed_planner.findPath(Point(-2, 0), Point(2, 0), bounds, obstacles, 0);
+    auto planning_time = std::chrono::steady_clock::now() - start;
+
+    // Leave plenty of room for slow test machines
+    EXPECT_LT(planning_time, RRTStarPlanner::PLANNING_TIME_BUDGET * 5);
+    EXPECT_LE(timed_planner.getNumNodes(), RRTStarPlanner::MAX_NUM_NODES);
+}
+
+TEST_F(RRTStarPlannerTest, planner_without_time_budget_always_gives_same_path)
+{
+    std::vector<Circle> obstacles;
+    for (int i = 0; i < 16; i++)
+    {
+        const double angle = i * 2 * M_PI / 16;
+        obstacles.emplace_back(Point(2 + std::cos(angle), std::sin(angle)), 0.3);
+    }
+
+    const std::vector<Point> first_path =
+        planner.findPath(Point(-2, 0), Point(2, 0), bounds, obstacles, 3);
+    const std::size_t first_num_nodes = planner.getNumNodes();
+    RRTStarPlanner other_planner      = RRTStarPlanner(std::nullopt);
+    const std::vector<Point> &second_path =
+        other_planner.findPath(Point(-2, 0), Point(2, 0), bounds, obstacles, 3);
+
+    EXPECT_EQ(first_path, second_path);
+    EXPECT_EQ(first_num_nodes, other_planner.getNumNodes());
+}
+
+TEST_F(RRTStarPlannerTest, repair_keeps_path_that_is_still_clear)
+{
+    std::vector<Point> waypoints  = {Point(0, 1), Point(2, 0)};
+    std::vector<Circle> obstacles = {Circle(Point(0, 0), 0.5)};
+
+    EXPECT_TRUE(planner.repairPath(Point(-2, 0), waypoints, bounds, obstacles, 0));
+
+    EXPECT_EQ(std::vector<Point>({Point(0, 1), Point(2, 0)}), waypoints);
+    // Nothing needed a detour, so no tree was grown
+    EXPECT_EQ(0u, planner.getNumNodes());
+}
+
+TEST_F(RRTStarPlannerTest, repair_skips_waypoints_the_start_has_moved_past)
+{
+    std::vector<Point> waypoints  = {Point(0, 1), Point(2, 0)};
+    std::vector<Circle> obstacles = {Circle(Point(0, 0), 0.5)};
+
+    EXPECT_TRUE(planner.repairPath(Point(0.5, 1), waypoints, bounds, obstacles, 0));
+
+    EXPECT_EQ(std::vector<Point>({Point(2, 0)}), waypoints);
+}
+
+TEST_F(RRTStarPlannerTest, repair_plans_detour_around_blocked_segment)
+{
+    std::vector<Point> waypoints = {Point(0, 1), Point(2, 0)};
+    // A robot has moved in between the second waypoint and the goal
+    std::vector<Circle> obstacles = {Circle(Point(0, 0), 0.5),
+                                     Circle(Point(1, 0.5), 0.3)};
+
+    EXPECT_TRUE(planner.repairPath(Point(-2, 0), waypoints, bounds, obstacles, 0));
+    EXPECT_TRUE(planner.lastPathReachesGoal());
+
+    expectPathValid(Point(-2, 0), waypoints, obstacles);
+    EXPECT_EQ(Point(2, 0), waypoints.back());
+}
+
+TEST_F(RRTStarPlannerTest, repair_fails_when_obstacle_covers_waypoint)
+{
+    std::vector<Point> waypoints  = {Point(0, 1), Point(2, 0)};
+    std::vector<Circle> obstacles = {Circle(Point(0, 0), 0.5), Circle(Point(0, 1), 0.3)};
+
+    EXPECT_FALSE(planner.repairPath(Point(-2, 0), waypoints, bounds, obstacles, 0));
+
+    // The path is left alone so the caller can plan a new one
+    EXPECT_EQ(std::vector<Point>({Point(0, 1), Point(2, 0)}), waypoints);
+}
+
+TEST_F(RRTStarPlannerTest, repair_fails_when_detour_cannot_be_found)
+{
+    // A ring of robots has closed around the goal
+    std::vector<Point> waypoints = {Point(2, 0)};
+    std::vector<Circle> obstacles;
+    for (int i = 0; i < 16; i++)
+    {
+        const double angle = i * 2 * M_PI / 16;
+        obstacles.emplace_back(Point(2 + std::cos(angle), std::sin(angle)), 0.3);
+    }
+
+    EXPECT_FALSE(planner.repairPath(Point(-2, 0), waypoints, bounds, obstacles, 0));
+    EXPECT_FALSE(planner.lastPathReachesGoal());
+}
+
+TEST_F(RRTStarPlannerTest, repair_fails_when_start_is_enclosed)
+{
+    // A ring of robots has closed around the start
+    std::vector<Point> waypoints = {Point(2, 0)};
+    std::vector<Circle> obstacles;
+    for (int i = 0; i < 16; i++)
+    {
+        const double angle = i * 2 * M_PI / 16;
+        obstacles.emplace_back(Point(-2 + 0.2 * std::cos(angle), 0.2 * std::sin(angle)),
+                               0.15);
+    }
+
+    EXPECT_FALSE(planner.repairPath(Point(-2, 0), waypoints, bounds, obstacles, 0));
+    EXPECT_FALSE(planner.lastPathReachesGoal());
+    // The path is left alone so the caller can plan a new one
+    EXPECT_EQ(std::vector<Point>({Point(2, 0)}), waypoints);
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,168 @@
+#include "network_input/backend.h"
+
+#include <gtest/gtest.h>
+
+class BackendTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        SSL_GeometryFieldSize *field = packet.mutable_geometry()->mutable_field();
+        field->set_field_length(9000);
+        field->set_field_width(6000);
+        field->set_goalwidth(1000);
+        field->set_goal_depth(180);
+        field->set_boundary_width(300);
+    }
+
+    Backend backend;
+    BackendMessages messages = BackendMessages();
+    SSL_WrapperPacket packet;
+};
+
+TEST_F(BackendTest, first_field_geometry_is_published)
+{
+    backend.processPacket(packet, AITimestamp(), messages);
+
+    EXPECT_TRUE(messages.field_msg_updated);
+    EXPECT_DOUBLE_EQ(9.0, messages.field_msg.field_length);
+    EXPECT_DOUBLE_EQ(6.0, messages.field_msg.field_width);
+}
+
+TEST_F(BackendTest, repeated_field_geometry_is_not_published_again)
+{
+    backend.processPacket(packet, AITimestamp(), messages);
+    backend.processPacket(packet, AITimestamp(), messages);
+
+    EXPECT_FALSE(messages.field_msg_updated);
+    // The message still holds the last geometry we saw
+    EXPECT_DOUBLE_EQ(9.0, messages.field_msg.field_length);
+}
+
+TEST_F(BackendTest, changed_field_geometry_is_published)
+{
+    backend.processPacket(packet, AITimestamp(), messages);
+
+    packet.mutable_geometry()->mutable_field()->set_field_length(12000);
+    backend.processPacket(packet, AITimestamp(), messages);
+
+    EXPECT_TRUE(messages.field_msg_updated);
+    EXPECT_DOUBLE_EQ(12.0, messages.field_msg.field_length);
+}
+
+TEST_F(BackendTest, packet_without_geometry_does_not_update_field)
+{
+    backend.processPacket(packet, AITimestamp(), messages);
+    backend.processPacket(SSL_WrapperPacket(), AITimestamp(), messages);
+
+    EXPECT_FALSE(messages.field_msg_updated);
+}
+
+TEST_F(BackendTest, filtered_messages_are_tagged_with_frame_number_and_capture_time)
+{
+    SSLDetectionFrameData frame = SSLDetectionFrameData();
+    frame.frame_number          = 42;
+    frame.t_capture             = 12.5;
+    frame.num_balls             = 1;
+    frame.balls[0].position     = Point(1, 2);
+    frame.balls[0].confidence   = 1.0;
+    frame.balls[0].timestamp    = frame.t_capture;
+    for (auto [robots, num_robots] :
+         {std::make_pair(&frame.yellow_robots, &frame.num_yellow_robots),
+          std::make_pair(&frame.blue_robots, &frame.num_blue_robots)})
+    {
+        *num_robots              = 1;
+        (*robots)[0].id          = 3;
+        (*robots)[0].position    = Point(-1, 0);
+        (*robots)[0].orientation = Angle::zero();
+        (*robots)[0].confidence  = 1.0;
+        (*robots)[0].timestamp   = frame.t_capture;
+    }
+
+    backend.processDetectionFrame(frame, messages);
+
+    ASSERT_TRUE(messages.ball_msg_updated);
+    EXPECT_EQ(42, messages.ball_msg.frame_sequence_id);
+    EXPECT_EQ(12500000, messages.ball_msg.timestamp_microseconds);
+    for (const thunderbots_msgs::Team &team_msg :
+         {messages.friendly_team_msg, messages.enemy_team_msg})
+    {
+        EXPECT_EQ(42, team_msg.frame_sequence_id);
+        EXPECT_EQ(12500000, team_msg.capture_timestamp_microseconds);
+    }
+}
+
+TEST_F(BackendTest, filter_update_time_is_only_set_when_a_frame_is_filtered)
+{
+    backend.processPacket(packet, AITimestamp(), messages);
+    EXPECT_FALSE(messages.filter_update_time);
+
+    backend.processDetectionFrame(SSLDetectionFrameData(), messages);
+    ASSERT_TRUE(messages.filter_update_time);
+    EXPECT_GE(*messages.filter_update_time, AITimestamp::zero());
+
+    backend.processTimedOutFrames(AITimestamp(), messages);
+    EXPECT_FALSE(messages.filter_update_time);
+}
+
+TEST_F(BackendTest, detection_frame_data_is_the_same_as_from_the_wire_decoder)
+{
+    SSL_DetectionFrame *detection = packet.mutable_detection();
+    detection->set_frame_number(7);
+    detection->set_t_capture(3.25);
+    detection->set_t_sent(3.3);
+    detection->set_camera_id(2);
+    SSL_DetectionBall *ball = detection->add_balls();
+    ball->set_confidence(0.9f);
+    ball->set_x(1000.0f);
+    ball->set_y(-500.0f);
+    ball->set_pixel_x(0);
+    ball->set_pixel_y(0);
+    // More yellow robots than the frame can store, so some are dropped
+    for (unsigned int i = 0; i < SSLDetectionFrameData::MAX_ROBOT_DETECTIONS_PER_TEAM + 2;
+         i++)
+    {
+        SSL_DetectionRobot *robot = detection->add_robots_yellow();
+        robot->set_confidence(0.8f);
+        robot->set_robot_id(i % 12);
+        robot->set_x(10.0f * i);
+        robot->set_y(-20.0f * i);
+        robot->set_orientation(0.1f * i);
+        robot->set_pixel_x(0);
+        robot->set_pixel_y(0);
+    }
+
+    const SSLDetectionFrameData frame = Backend::createDetectionFrameData(*detection);
+    const std::string data            = packet.SerializeAsString();
+    SSLWrapperPacketData decoded_packet;
+    ASSERT_TRUE(
+        SSLWireDecoder::decodeWrapperPacket(data.data(), data.size(), decoded_packet));
+    const SSLDetectionFrameData &decoded_frame = decoded_packet.detection;
+
+    EXPECT_EQ(decoded_frame.frame_number, frame.frame_number);
+    EXPECT_EQ(decoded_frame.camera_id, frame.camera_id);
+    EXPECT_EQ(decoded_frame.num_dropped_detections, frame.num_dropped_detections);
+    EXPECT_EQ(2, frame.num_dropped_detections);
+    ASSERT_EQ(decoded_frame.num_balls, frame.num_balls);
+    EXPECT_EQ(decoded_frame.balls[0].position, frame.balls[0].position);
+    EXPECT_EQ(decoded_frame.balls[0].timestamp, frame.balls[0].timestamp);
+    ASSERT_EQ(decoded_frame.num_yellow_robots, frame.num_yellow_robots);
+    for (std::size_t i = 0; i < frame.num_yellow_robots; i++)
+    {
+        EXPECT_EQ(decoded_frame.yellow_robots[i].id, frame.yellow_robots[i].id);
+        EXPECT_EQ(decoded_frame.yellow_robots[i].position,
+                  frame.yellow_robots[i].position);
+        EXPECT_EQ(decoded_frame.yellow_robots[i].orientation,
+                  frame.yellow_robots[i].orientation);
+        EXPECT_EQ(decoded_frame.yellow_robots[i].timestamp,
+                  frame.yellow_robots[i].timestamp);
+    }
+    EXPECT_EQ(decoded_frame.num_blue_robots, frame.num_blue_robots);
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
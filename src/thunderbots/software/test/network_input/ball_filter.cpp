@@ -0,0 +1,172 @@
+#include "network_input/filter/ball_filter.h"
+
+#include <gtest/gtest.h>
+
+class BallFilterTest : public ::testing::Test
+{
+   protected:
+    static SSLBallData createDetection(Point position, double timestamp,
+                                       double confidence = 0.9)
+    {
+        SSLBallData detection;
+        detection.position   = position;
+        detection.confidence = confidence;
+        detection.timestamp  = timestamp;
+        return detection;
+    }
+
+    // SSL Vision runs at 60Hz
+    static constexpr double FRAME_PERIOD = 1.0 / 60.0;
+
+    BallFilter ball_filter;
+};
+
+TEST_F(BallFilterTest, no_data_before_any_balls_are_seen)
+{
+    EXPECT_FALSE(ball_filter.getFilteredData({}));
+}
+
+TEST_F(BallFilterTest, first_detection_is_returned_with_zero_velocity)
+{
+    std::optional<FilteredBallData> filtered_data =
+        ball_filter.getFilteredData({createDetection(Point(1, -2), 10.0)});
+
+    ASSERT_TRUE(filtered_data);
+    EXPECT_EQ(Point(1, -2), filtered_data->position);
+    EXPECT_EQ(Vector(0, 0), filtered_data->velocity);
+    EXPECT_EQ(AITimestamp(std::chrono::seconds(10)), filtered_data->timestamp);
+}
+
+TEST_F(BallFilterTest, estimates_velocity_of_ball_moving_at_constant_velocity)
+{
+    const Vector velocity(2, -1);
+    std::optional<FilteredBallData> filtered_data;
+    for (unsigned int i = 0; i < 60; i++)
+    {
+        double t      = 10.0 + i * FRAME_PERIOD;
+        filtered_data = ball_filter.getFilteredData(
+            {createDetection(Point(0, 0) + velocity * (i * FRAME_PERIOD), t)});
+    }
+
+    ASSERT_TRUE(filtered_data);
+    EXPECT_TRUE(filtered_data->position.isClose(velocity * (59 * FRAME_PERIOD), 0.01));
+    EXPECT_TRUE(filtered_data->velocity.isClose(velocity, 0.05));
+}
+
+TEST_F(BallFilterTest, output_timestamp_is_the_capture_time)
+{
+    ball_filter.getFilteredData({createDetection(Point(0, 0), 10.0)});
+    std::optional<FilteredBallData> filtered_data =
+        ball_filter.getFilteredData({createDetection(Point(0, 0), 10.5)});
+
+    ASSERT_TRUE(filtered_data);
+    EXPECT_EQ(AITimestamp(std::chrono::milliseconds(10500)), filtered_data->timestamp);
+}
+
+TEST_F(BallFilterTest, single_false_detection_does_not_replace_the_real_ball)
+{
+    for (unsigned int i = 0; i < 30; i++)
+    {
+        ball_filter.getFilteredData(
+            {createDetection(Point(1, 1), 10.0 + i * FRAME_PERIOD)});
+    }
+
+    // A false detection far from the real ball, with a higher confidence than the real
+    // ball has for this frame
+    std::optional<FilteredBallData> filtered_data =
+        ball_filter.getFilteredData({createDetection(Point(1, 1), 10.5, 0.5),
+                                     createDetection(Point(-3, 2), 10.5, 1.0)});
+
+    ASSERT_TRUE(filtered_data);
+    EXPECT_TRUE(filtered_data->position.isClose(Point(1, 1), 0.01));
+    EXPECT_EQ(2, ball_filter.getNumHypotheses());
+}
+
+TEST_F(BallFilterTest, switches_to_new_ball_when_old_one_disappears)
+{
+    double t = 10.0;
+    for (unsigned int i = 0; i < 30; i++, t += FRAME_PERIOD)
+    {
+        ball_filter.getFilteredData({createDetection(Point(1, 1), t)});
+    }
+
+    // The ball is picked up and placed somewhere else
+    std::optional<FilteredBallData> filtered_data;
+    for (unsigned int i = 0; i < 5; i++, t += FRAME_PERIOD)
+    {
+        filtered_data = ball_filter.getFilteredData({createDetection(Point(-2, 0), t)});
+    }
+
+    ASSERT_TRUE(filtered_data);
+    EXPECT_TRUE(filtered_data->position.isClose(Point(-2, 0), 0.01));
+}
+
+TEST_F(BallFilterTest, follows_kicked_ball)
+{
+    double t = 10.0;
+    for (unsigned int i = 0; i < 30; i++, t += FRAME_PERIOD)
+    {
+        ball_filter.getFilteredData({createDetection(Point(0, 0), t)});
+    }
+
+    // The ball is kicked at 5 m/s, much faster than the filter expects it to change
+    // velocity
+    const Vector kick_velocity(5, 0);
+    std::optional<FilteredBallData> filtered_data;
+    for (unsigned int i = 1; i <= 10; i++, t += FRAME_PERIOD)
+    {
+        filtered_data = ball_filter.getFilteredData(
+            {createDetection(kick_velocity * (i * FRAME_PERIOD), t)});
+    }
+
+    ASSERT_TRUE(filtered_data);
+    EXPECT_TRUE(
+        filtered_data->position.isClose(kick_velocity * (10 * FRAME_PERIOD), 0.02));
+    EXPECT_TRUE(filtered_data->velocity.isClose(kick_velocity, 0.5));
+}
+
+TEST_F(BallFilterTest, predicts_ball_while_it_is_not_detected)
+{
+    const Vector velocity(1, 0);
+    double t = 10.0;
+    for (unsigned int i = 0; i < 30; i++, t += FRAME_PERIOD)
+    {
+        ball_filter.getFilteredData({createDetection(velocity * (t - 10.0), t)});
+    }
+
+    // The ball is hidden from the cameras for a frame
+    std::optional<FilteredBallData> filtered_data = ball_filter.getFilteredData({});
+
+    ASSERT_TRUE(filtered_data);
+    EXPECT_TRUE(filtered_data->velocity.isClose(velocity, 0.05));
+}
+
+TEST_F(BallFilterTest, ball_is_forgotten_after_it_is_not_detected_for_too_long)
+{
+    ball_filter.getFilteredData({createDetection(Point(0, 0), 10.0)});
+    ball_filter.getFilteredData({createDetection(Point(3, 3), 10.2)});
+    EXPECT_EQ(2, ball_filter.getNumHypotheses());
+
+    // The first ball has not been seen for more than half a second
+    ball_filter.getFilteredData({createDetection(Point(3, 3), 10.6)});
+    EXPECT_EQ(1, ball_filter.getNumHypotheses());
+}
+
+TEST_F(BallFilterTest, number_of_hypotheses_is_bounded)
+{
+    std::vector<SSLBallData> detections;
+    for (unsigned int i = 0; i < 2 * BallFilter::MAX_HYPOTHESES; i++)
+    {
+        detections.emplace_back(createDetection(Point(i, 0), 10.0));
+    }
+
+    EXPECT_TRUE(ball_filter.getFilteredData(detections));
+    EXPECT_EQ(BallFilter::MAX_HYPOTHESES, ball_filter.getNumHypotheses());
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
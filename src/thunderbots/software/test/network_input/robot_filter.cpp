@@ -0,0 +1,150 @@
+#include "network_input/filter/robot_filter.h"
+
+#include <gtest/gtest.h>
+
+class RobotFilterTest : public ::testing::Test
+{
+   protected:
+    static SSLRobotData createDetection(unsigned int id, Point position,
+                                        Angle orientation, double timestamp,
+                                        double confidence = 0.9)
+    {
+        SSLRobotData detection;
+        detection.id          = id;
+        detection.position    = position;
+        detection.orientation = orientation;
+        detection.confidence  = confidence;
+        detection.timestamp   = timestamp;
+        return detection;
+    }
+
+    // SSL Vision runs at 60Hz
+    static constexpr double FRAME_PERIOD = 1.0 / 60.0;
+
+    RobotFilter robot_filter = RobotFilter(3);
+};
+
+TEST_F(RobotFilterTest, no_data_before_robot_is_seen)
+{
+    EXPECT_FALSE(robot_filter.getFilteredData(std::vector<SSLRobotData>()));
+}
+
+TEST_F(RobotFilterTest, detections_of_other_robots_are_ignored)
+{
+    EXPECT_FALSE(robot_filter.getFilteredData(
+        {createDetection(4, Point(1, 1), Angle::zero(), 10.0)}));
+}
+
+TEST_F(RobotFilterTest, first_detection_is_returned_with_zero_velocity)
+{
+    std::optional<FilteredRobotData> filtered_data = robot_filter.getFilteredData(
+        {createDetection(3, Point(1, -2), Angle::quarter(), 10.0)});
+
+    ASSERT_TRUE(filtered_data);
+    EXPECT_EQ(3, filtered_data->id);
+    EXPECT_EQ(Point(1, -2), filtered_data->position);
+    EXPECT_EQ(Vector(0, 0), filtered_data->velocity);
+    EXPECT_DOUBLE_EQ(Angle::quarter().toRadians(),
+                     filtered_data->orientation.toRadians());
+    EXPECT_EQ(AngularVelocity::zero(), filtered_data->angular_velocity);
+    EXPECT_EQ(AITimestamp(std::chrono::seconds(10)), filtered_data->timestamp);
+}
+
+TEST_F(RobotFilterTest, most_confident_detection_is_used)
+{
+    std::optional<FilteredRobotData> filtered_data = robot_filter.getFilteredData(
+        {createDetection(3, Point(1, 1), Angle::zero(), 10.0, 0.3),
+         createDetection(3, Point(2, 2), Angle::zero(), 10.0, 0.8)});
+
+    ASSERT_TRUE(filtered_data);
+    EXPECT_EQ(Point(2, 2), filtered_data->position);
+}
+
+TEST_F(RobotFilterTest, estimates_velocity_and_angular_velocity_of_moving_robot)
+{
+    const Vector velocity(1.5, -0.5);
+    const AngularVelocity angular_velocity = AngularVelocity::ofRadians(2);
+    std::optional<FilteredRobotData> filtered_data;
+    for (unsigned int i = 0; i < 60; i++)
+    {
+        double t      = 10.0 + i * FRAME_PERIOD;
+        filtered_data = robot_filter.getFilteredData(
+            createDetection(3, Point(0, 0) + velocity * (i * FRAME_PERIOD),
+                            angular_velocity * (i * FRAME_PERIOD), t));
+    }
+
+    ASSERT_TRUE(filtered_data);
+    EXPECT_TRUE(filtered_data->position.isClose(velocity * (59 * FRAME_PERIOD), 0.01));
+    EXPECT_TRUE(filtered_data->velocity.isClose(velocity, 0.05));
+    EXPECT_NEAR(angular_velocity.toRadians(), filtered_data->angular_velocity.toRadians(),
+                0.05);
+}
+
+TEST_F(RobotFilterTest, orientation_wraps_when_robot_turns_through_pi)
+{
+    // The robot spins at 3 rad/s, so it passes through +/-pi many times
+    const AngularVelocity angular_velocity = AngularVelocity::ofRadians(3);
+    std::optional<FilteredRobotData> filtered_data;
+    Angle orientation;
+    for (unsigned int i = 0; i < 120; i++)
+    {
+        double t    = 10.0 + i * FRAME_PERIOD;
+        orientation = (angular_velocity * (i * FRAME_PERIOD)).angleMod();
+        filtered_data =
+            robot_filter.getFilteredData(createDetection(3, Point(0, 0), orientation, t));
+
+        ASSERT_TRUE(filtered_data);
+        EXPECT_LE(filtered_data->orientation.abs(), Angle::half());
+    }
+
+    EXPECT_LT((filtered_data->orientation - orientation).angleMod().abs(),
+              Angle::ofDegrees(1));
+    EXPECT_NEAR(angular_velocity.toRadians(), filtered_data->angular_velocity.toRadians(),
+                0.05);
+}
+
+TEST_F(RobotFilterTest, output_timestamp_is_the_capture_time)
+{
+    robot_filter.getFilteredData(createDetection(3, Point(0, 0), Angle::zero(), 10.0));
+    std::optional<FilteredRobotData> filtered_data = robot_filter.getFilteredData(
+        createDetection(3, Point(0, 0), Angle::zero(), 10.25));
+
+    ASSERT_TRUE(filtered_data);
+    EXPECT_EQ(AITimestamp(std::chrono::milliseconds(10250)), filtered_data->timestamp);
+}
+
+TEST_F(RobotFilterTest, repeated_detection_does_not_change_estimate)
+{
+    robot_filter.getFilteredData(createDetection(3, Point(0, 0), Angle::zero(), 10.0));
+    std::optional<FilteredRobotData> first_data = robot_filter.getFilteredData(
+        createDetection(3, Point(0.01, 0), Angle::zero(), 10.0 + FRAME_PERIOD));
+    std::optional<FilteredRobotData> repeated_data = robot_filter.getFilteredData(
+        createDetection(3, Point(0.01, 0), Angle::zero(), 10.0 + FRAME_PERIOD));
+
+    ASSERT_TRUE(first_data);
+    ASSERT_TRUE(repeated_data);
+    EXPECT_EQ(first_data->position, repeated_data->position);
+    EXPECT_EQ(first_data->velocity, repeated_data->velocity);
+}
+
+TEST_F(RobotFilterTest, restarts_when_robot_is_not_seen_for_too_long)
+{
+    robot_filter.getFilteredData(createDetection(3, Point(0, 0), Angle::zero(), 10.0));
+    robot_filter.getFilteredData(
+        createDetection(3, Point(0.02, 0), Angle::zero(), 10.0 + FRAME_PERIOD));
+
+    // The robot was picked up and put down somewhere else
+    std::optional<FilteredRobotData> filtered_data = robot_filter.getFilteredData(
+        createDetection(3, Point(-2, 1), Angle::zero(), 12.0));
+
+    ASSERT_TRUE(filtered_data);
+    EXPECT_EQ(Point(-2, 1), filtered_data->position);
+    EXPECT_EQ(Vector(0, 0), filtered_data->velocity);
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,92 @@
+#include "network_input/filter/robot_team_filter.h"
+
+#include <gtest/gtest.h>
+
+class RobotTeamFilterTest : public ::testing::Test
+{
+   protected:
+    static SSLRobotData createDetection(unsigned int id, Point position, double timestamp,
+                                        double confidence = 0.9)
+    {
+        SSLRobotData detection;
+        detection.id          = id;
+        detection.position    = position;
+        detection.orientation = Angle::zero();
+        detection.confidence  = confidence;
+        detection.timestamp   = timestamp;
+        return detection;
+    }
+
+    RobotTeamFilter team_filter;
+};
+
+TEST_F(RobotTeamFilterTest, no_data_when_no_robots_are_detected)
+{
+    EXPECT_TRUE(team_filter.getFilteredData({}).empty());
+}
+
+TEST_F(RobotTeamFilterTest, returns_detected_robots_ordered_by_id)
+{
+    const std::vector<FilteredRobotData> &filtered_data = team_filter.getFilteredData(
+        {createDetection(5, Point(1, 0), 10.0), createDetection(0, Point(2, 0), 10.0),
+         createDetection(2, Point(3, 0), 10.0)});
+
+    ASSERT_EQ(3, filtered_data.size());
+    EXPECT_EQ(0, filtered_data[0].id);
+    EXPECT_EQ(Point(2, 0), filtered_data[0].position);
+    EXPECT_EQ(2, filtered_data[1].id);
+    EXPECT_EQ(Point(3, 0), filtered_data[1].position);
+    EXPECT_EQ(5, filtered_data[2].id);
+    EXPECT_EQ(Point(1, 0), filtered_data[2].position);
+}
+
+TEST_F(RobotTeamFilterTest, only_returns_robots_detected_this_update)
+{
+    team_filter.getFilteredData(
+        {createDetection(1, Point(1, 0), 10.0), createDetection(4, Point(2, 0), 10.0)});
+    const std::vector<FilteredRobotData> &filtered_data =
+        team_filter.getFilteredData({createDetection(4, Point(2, 0), 10.1)});
+
+    ASSERT_EQ(1, filtered_data.size());
+    EXPECT_EQ(4, filtered_data[0].id);
+}
+
+TEST_F(RobotTeamFilterTest, each_robot_is_filtered_separately)
+{
+    team_filter.getFilteredData(
+        {createDetection(1, Point(0, 0), 10.0), createDetection(2, Point(0, 0), 10.0)});
+    const std::vector<FilteredRobotData> &filtered_data =
+        team_filter.getFilteredData({createDetection(1, Point(0.1, 0), 10.1),
+                                     createDetection(2, Point(0, -0.1), 10.1)});
+
+    ASSERT_EQ(2, filtered_data.size());
+    EXPECT_GT(filtered_data[0].velocity.x(), 0);
+    EXPECT_DOUBLE_EQ(0, filtered_data[0].velocity.y());
+    EXPECT_DOUBLE_EQ(0, filtered_data[1].velocity.x());
+    EXPECT_LT(filtered_data[1].velocity.y(), 0);
+}
+
+TEST_F(RobotTeamFilterTest, duplicate_detections_use_most_confident)
+{
+    const std::vector<FilteredRobotData> &filtered_data =
+        team_filter.getFilteredData({createDetection(3, Point(1, 0), 10.0, 0.2),
+                                     createDetection(3, Point(2, 0), 10.0, 0.7)});
+
+    ASSERT_EQ(1, filtered_data.size());
+    EXPECT_EQ(Point(2, 0), filtered_data[0].position);
+}
+
+TEST_F(RobotTeamFilterTest, robots_with_invalid_ids_are_ignored)
+{
+    const std::vector<FilteredRobotData> &filtered_data = team_filter.getFilteredData(
+        {createDetection(RobotTeamFilter::MAX_ROBOT_IDS, Point(1, 0), 10.0)});
+
+    EXPECT_TRUE(filtered_data.empty());
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,184 @@
+#include "network_input/networking/ssl_wire_decoder.h"
+
+#include <gtest/gtest.h>
+
+#include "proto/messages_robocup_ssl_wrapper.pb.h"
+#include "shared/constants.h"
+
+class SSLWireDecoderTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        SSL_DetectionFrame *frame = packet.mutable_detection();
+        frame->set_frame_number(1234);
+        frame->set_t_capture(10.5);
+        frame->set_t_sent(10.52);
+        frame->set_camera_id(3);
+
+        SSL_DetectionBall *ball = frame->add_balls();
+        ball->set_confidence(0.9f);
+        ball->set_area(78);
+        ball->set_x(1000.0f);
+        ball->set_y(-500.0f);
+        ball->set_z(0.0f);
+        ball->set_pixel_x(320.0f);
+        ball->set_pixel_y(240.0f);
+
+        SSL_DetectionRobot *yellow_robot = frame->add_robots_yellow();
+        yellow_robot->set_confidence(0.8f);
+        yellow_robot->set_robot_id(2);
+        yellow_robot->set_x(-1500.0f);
+        yellow_robot->set_y(250.0f);
+        yellow_robot->set_orientation(1.5f);
+        yellow_robot->set_pixel_x(100.0f);
+        yellow_robot->set_pixel_y(200.0f);
+        yellow_robot->set_height(150.0f);
+
+        for (unsigned int id = 0; id < 3; id++)
+        {
+            SSL_DetectionRobot *blue_robot = frame->add_robots_blue();
+            blue_robot->set_confidence(0.7f);
+            blue_robot->set_robot_id(id);
+            blue_robot->set_x(100.0f * id);
+            blue_robot->set_y(-100.0f * id);
+            blue_robot->set_orientation(-0.5f * id);
+            blue_robot->set_pixel_x(10.0f);
+            blue_robot->set_pixel_y(20.0f);
+        }
+    }
+
+    SSL_WrapperPacket packet;
+    SSLWrapperPacketData packet_data;
+};
+
+TEST_F(SSLWireDecoderTest, decode_detection_packet)
+{
+    std::string data = packet.SerializeAsString();
+    ASSERT_TRUE(
+        SSLWireDecoder::decodeWrapperPacket(data.data(), data.size(), packet_data));
+
+    EXPECT_TRUE(packet_data.has_detection);
+    EXPECT_FALSE(packet_data.has_geometry);
+
+    const SSLDetectionFrameData &frame_data = packet_data.detection;
+    EXPECT_EQ(1234, frame_data.frame_number);
+    EXPECT_EQ(3, frame_data.camera_id);
+    EXPECT_DOUBLE_EQ(10.5, frame_data.t_capture);
+    EXPECT_DOUBLE_EQ(10.52, frame_data.t_sent);
+    EXPECT_EQ(0, frame_data.num_dropped_detections);
+
+    ASSERT_EQ(1, frame_data.num_balls);
+    EXPECT_EQ(Point(1.0, -0.5), frame_data.balls[0].position);
+    EXPECT_FLOAT_EQ(0.9f, frame_data.balls[0].confidence);
+    EXPECT_DOUBLE_EQ(10.5, frame_data.balls[0].timestamp);
+
+    ASSERT_EQ(1, frame_data.num_yellow_robots);
+    EXPECT_EQ(2, frame_data.yellow_robots[0].id);
+    EXPECT_EQ(Point(-1.5, 0.25), frame_data.yellow_robots[0].position);
+    EXPECT_FLOAT_EQ(1.5f, frame_data.yellow_robots[0].orientation.toRadians());
+    EXPECT_FLOAT_EQ(0.8f, frame_data.yellow_robots[0].confidence);
+    EXPECT_DOUBLE_EQ(10.5, frame_data.yellow_robots[0].timestamp);
+
+    ASSERT_EQ(3, frame_data.num_blue_robots);
+    for (unsigned int id = 0; id < 3; id++)
+    {
+        EXPECT_EQ(id, frame_data.blue_robots[id].id);
+        EXPECT_EQ(Point(0.1 * id, -0.1 * id), frame_data.blue_robots[id].position);
+        EXPECT_FLOAT_EQ(-0.5f * id, frame_data.blue_robots[id].orientation.toRadians());
+    }
+}
+
+TEST_F(SSLWireDecoderTest, decode_detection_frame_directly)
+{
+    std::string data = packet.detection().SerializeAsString();
+    SSLDetectionFrameData frame_data;
+    ASSERT_TRUE(
+        SSLWireDecoder::decodeDetectionFrame(data.data(), data.size(), frame_data));
+
+    EXPECT_EQ(1234, frame_data.frame_number);
+    EXPECT_EQ(1, frame_data.num_balls);
+    EXPECT_EQ(1, frame_data.num_yellow_robots);
+    EXPECT_EQ(3, frame_data.num_blue_robots);
+}
+
+TEST_F(SSLWireDecoderTest, decode_geometry_packet)
+{
+    SSL_WrapperPacket geometry_packet;
+    SSL_GeometryFieldSize *field = geometry_packet.mutable_geometry()->mutable_field();
+    field->set_field_length(9000);
+    field->set_field_width(6000);
+    field->set_goalwidth(1000);
+    field->set_goal_depth(200);
+    field->set_boundary_width(300);
+
+    std::string data = geometry_packet.SerializeAsString();
+    ASSERT_TRUE(
+        SSLWireDecoder::decodeWrapperPacket(data.data(), data.size(), packet_data));
+
+    EXPECT_FALSE(packet_data.has_detection);
+    EXPECT_TRUE(packet_data.has_geometry);
+}
+
+TEST_F(SSLWireDecoderTest, decoded_data_is_overwritten_when_reused)
+{
+    std::string data = packet.SerializeAsString();
+    ASSERT_TRUE(
+        SSLWireDecoder::decodeWrapperPacket(data.data(), data.size(), packet_data));
+    ASSERT_TRUE(
+        SSLWireDecoder::decodeWrapperPacket(data.data(), data.size(), packet_data));
+
+    // The detections should not be appended to the ones from the first packet
+    EXPECT_EQ(1, packet_data.detection.num_balls);
+    EXPECT_EQ(1, packet_data.detection.num_yellow_robots);
+    EXPECT_EQ(3, packet_data.detection.num_blue_robots);
+}
+
+TEST_F(SSLWireDecoderTest, detections_beyond_capacity_are_dropped)
+{
+    SSL_DetectionFrame *frame = packet.mutable_detection();
+    const std::size_t num_extra_robots =
+        SSLDetectionFrameData::MAX_ROBOT_DETECTIONS_PER_TEAM + 5 -
+        frame->robots_blue_size();
+    for (std::size_t i = 0; i < num_extra_robots; i++)
+    {
+        *frame->add_robots_blue() = frame->robots_blue(0);
+    }
+
+    std::string data = packet.SerializeAsString();
+    ASSERT_TRUE(
+        SSLWireDecoder::decodeWrapperPacket(data.data(), data.size(), packet_data));
+
+    EXPECT_EQ(SSLDetectionFrameData::MAX_ROBOT_DETECTIONS_PER_TEAM,
+              packet_data.detection.num_blue_robots);
+    EXPECT_EQ(5, packet_data.detection.num_dropped_detections);
+}
+
+TEST_F(SSLWireDecoderTest, truncated_data_fails_to_decode)
+{
+    std::string data = packet.SerializeAsString();
+
+    // Every strict prefix of the packet cuts a field short or leaves out required
+    // fields, so none of them should decode
+    for (std::size_t size = 1; size < data.size(); size++)
+    {
+        EXPECT_FALSE(SSLWireDecoder::decodeWrapperPacket(data.data(), size, packet_data))
+            << "Decoded a packet truncated to " << size << " bytes";
+    }
+}
+
+TEST_F(SSLWireDecoderTest, frame_missing_required_fields_fails_to_decode)
+{
+    packet.mutable_detection()->clear_t_capture();
+
+    std::string data = packet.SerializePartialAsString();
+    EXPECT_FALSE(
+        SSLWireDecoder::decodeWrapperPacket(data.data(), data.size(), packet_data));
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
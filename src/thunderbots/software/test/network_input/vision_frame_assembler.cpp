@@ -0,0 +1,195 @@
+#include "network_input/vision_frame_assembler.h"
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono;
+
+class VisionFrameAssemblerTest : public ::testing::Test
+{
+   protected:
+    /**
+     * Creates a frame from the given camera with no detections
+     */
+    static SSLDetectionFrameData createFrame(unsigned int camera_id, double t_capture)
+    {
+        SSLDetectionFrameData frame;
+        frame.frame_number           = 0;
+        frame.camera_id              = camera_id;
+        frame.t_capture              = t_capture;
+        frame.t_sent                 = t_capture + 0.005;
+        frame.num_balls              = 0;
+        frame.num_yellow_robots      = 0;
+        frame.num_blue_robots        = 0;
+        frame.num_dropped_detections = 0;
+        return frame;
+    }
+
+    static void addBall(SSLDetectionFrameData &frame, Point position, double confidence)
+    {
+        SSLBallData &ball = frame.balls[frame.num_balls++];
+        ball.position     = position;
+        ball.confidence   = confidence;
+        ball.timestamp    = frame.t_capture;
+    }
+
+    static void addYellowRobot(SSLDetectionFrameData &frame, unsigned int id,
+                               Point position, double confidence)
+    {
+        SSLRobotData &robot = frame.yellow_robots[frame.num_yellow_robots++];
+        robot.id            = id;
+        robot.position      = position;
+        robot.orientation   = Angle::zero();
+        robot.confidence    = confidence;
+        robot.timestamp     = frame.t_capture;
+    }
+
+    // An arbitrary fixed point in time, so the tests are deterministic
+    const AITimestamp start_time = seconds(10000);
+
+    VisionFrameAssembler assembler =
+        VisionFrameAssembler(4, milliseconds(10), /* merge_distance_meters = */ 0.1);
+};
+
+TEST_F(VisionFrameAssemblerTest, frame_is_emitted_once_every_camera_reports)
+{
+    for (unsigned int camera_id = 0; camera_id < 3; camera_id++)
+    {
+        SSLDetectionFrameData frame = createFrame(camera_id, 1.0);
+        addYellowRobot(frame, camera_id, Point(camera_id, 0), 0.9);
+        EXPECT_FALSE(assembler.addDetectionFrame(frame, start_time));
+    }
+
+    SSLDetectionFrameData frame = createFrame(3, 1.001);
+    addBall(frame, Point(1, 1), 0.9);
+    std::optional<SSLDetectionFrameData> merged_frame =
+        assembler.addDetectionFrame(frame, start_time + milliseconds(1));
+
+    ASSERT_TRUE(merged_frame);
+    EXPECT_EQ(0, merged_frame->frame_number);
+    EXPECT_DOUBLE_EQ(1.001, merged_frame->t_capture);
+    EXPECT_EQ(1, merged_frame->num_balls);
+    EXPECT_EQ(3, merged_frame->num_yellow_robots);
+    EXPECT_EQ(0, merged_frame->num_blue_robots);
+
+    // The next frame should start from scratch
+    EXPECT_FALSE(assembler.addDetectionFrame(createFrame(0, 1.016), start_time));
+}
+
+TEST_F(VisionFrameAssemblerTest, frame_is_emitted_when_a_camera_reports_twice)
+{
+    SSLDetectionFrameData first_frame = createFrame(0, 1.0);
+    addYellowRobot(first_frame, 1, Point(0, 0), 0.9);
+    EXPECT_FALSE(assembler.addDetectionFrame(first_frame, start_time));
+    EXPECT_FALSE(assembler.addDetectionFrame(createFrame(1, 1.0), start_time));
+
+    SSLDetectionFrameData second_frame = createFrame(0, 1.016);
+    addYellowRobot(second_frame, 1, Point(0.01, 0), 0.9);
+    std::optional<SSLDetectionFrameData> merged_frame =
+        assembler.addDetectionFrame(second_frame, start_time + milliseconds(1));
+
+    // Only the data from the first tick should be in the merged frame
+    ASSERT_TRUE(merged_frame);
+    ASSERT_EQ(1, merged_frame->num_yellow_robots);
+    EXPECT_EQ(Point(0, 0), merged_frame->yellow_robots[0].position);
+}
+
+TEST_F(VisionFrameAssemblerTest, frames_captured_far_apart_are_not_merged)
+{
+    EXPECT_FALSE(assembler.addDetectionFrame(createFrame(0, 1.0), start_time));
+
+    std::optional<SSLDetectionFrameData> merged_frame =
+        assembler.addDetectionFrame(createFrame(1, 1.05), start_time);
+
+    ASSERT_TRUE(merged_frame);
+    EXPECT_DOUBLE_EQ(1.0, merged_frame->t_capture);
+}
+
+TEST_F(VisionFrameAssemblerTest, frame_is_emitted_after_timeout)
+{
+    SSLDetectionFrameData frame = createFrame(0, 1.0);
+    addBall(frame, Point(1, 1), 0.9);
+    EXPECT_FALSE(assembler.addDetectionFrame(frame, start_time));
+
+    EXPECT_FALSE(assembler.getTimedOutFrame(start_time + milliseconds(9)));
+
+    std::optional<SSLDetectionFrameData> merged_frame =
+        assembler.getTimedOutFrame(start_time + milliseconds(10));
+    ASSERT_TRUE(merged_frame);
+    EXPECT_EQ(1, merged_frame->num_balls);
+
+    // Nothing is waiting to be assembled any more
+    EXPECT_FALSE(assembler.getTimedOutFrame(start_time + milliseconds(100)));
+}
+
+TEST_F(VisionFrameAssemblerTest, nothing_times_out_when_no_frames_received)
+{
+    EXPECT_FALSE(assembler.getTimedOutFrame(start_time + seconds(10)));
+}
+
+TEST_F(VisionFrameAssemblerTest, duplicate_detections_in_camera_overlap_are_merged)
+{
+    SSLDetectionFrameData first_frame = createFrame(0, 1.0);
+    addBall(first_frame, Point(0, 0), 0.5);
+    addYellowRobot(first_frame, 3, Point(1, 0), 0.9);
+    addYellowRobot(first_frame, 4, Point(2, 0), 0.9);
+
+    SSLDetectionFrameData second_frame = createFrame(1, 1.0);
+    // The same ball, seen with a higher confidence
+    addBall(second_frame, Point(0.02, 0), 0.8);
+    // The same robot, seen with a lower confidence
+    addYellowRobot(second_frame, 3, Point(1.02, 0), 0.6);
+    // A robot with the same id as one from the first camera, but too far away to be
+    // the same robot
+    addYellowRobot(second_frame, 4, Point(-2, 0), 0.5);
+
+    VisionFrameAssembler two_camera_assembler(2, milliseconds(10), 0.1);
+    EXPECT_FALSE(two_camera_assembler.addDetectionFrame(first_frame, start_time));
+    std::optional<SSLDetectionFrameData> merged_frame =
+        two_camera_assembler.addDetectionFrame(second_frame, start_time);
+
+    ASSERT_TRUE(merged_frame);
+    ASSERT_EQ(1, merged_frame->num_balls);
+    EXPECT_EQ(Point(0.02, 0), merged_frame->balls[0].position);
+    EXPECT_DOUBLE_EQ(0.8, merged_frame->balls[0].confidence);
+
+    ASSERT_EQ(3, merged_frame->num_yellow_robots);
+    EXPECT_EQ(3, merged_frame->yellow_robots[0].id);
+    EXPECT_EQ(Point(1, 0), merged_frame->yellow_robots[0].position);
+    EXPECT_EQ(4, merged_frame->yellow_robots[1].id);
+    EXPECT_EQ(Point(2, 0), merged_frame->yellow_robots[1].position);
+    EXPECT_EQ(4, merged_frame->yellow_robots[2].id);
+    EXPECT_EQ(Point(-2, 0), merged_frame->yellow_robots[2].position);
+}
+
+TEST_F(VisionFrameAssemblerTest, detections_from_the_same_camera_are_not_merged)
+{
+    SSLDetectionFrameData frame = createFrame(0, 1.0);
+    addBall(frame, Point(0, 0), 0.5);
+    addBall(frame, Point(0.01, 0), 0.5);
+
+    VisionFrameAssembler one_camera_assembler(1, milliseconds(10), 0.1);
+    std::optional<SSLDetectionFrameData> merged_frame =
+        one_camera_assembler.addDetectionFrame(frame, start_time);
+
+    ASSERT_TRUE(merged_frame);
+    EXPECT_EQ(2, merged_frame->num_balls);
+}
+
+TEST_F(VisionFrameAssemblerTest, merged_frames_are_numbered_consecutively)
+{
+    VisionFrameAssembler one_camera_assembler(1, milliseconds(10), 0.1);
+    for (unsigned int i = 0; i < 5; i++)
+    {
+        std::optional<SSLDetectionFrameData> merged_frame =
+            one_camera_assembler.addDetectionFrame(createFrame(0, i / 60.0), start_time);
+        ASSERT_TRUE(merged_frame);
+        EXPECT_EQ(i, merged_frame->frame_number);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "network_input/networking/vision_packet_recorder.h"
+#include "network_input/networking/vision_packet_replayer.h"
+
+using namespace std::chrono;
+
+class VisionPacketLogTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        file_path = ::testing::TempDir() + "vision_packet_log_test.log";
+    }
+
+    void TearDown() override
+    {
+        std::remove(file_path.c_str());
+    }
+
+    /**
+     * Records a packet for each of the given receive times, with the frame number of
+     * each packet set to its index
+     */
+    void recordPackets(const std::vector<milliseconds> &receive_times)
+    {
+        VisionPacketRecorder recorder(file_path);
+        for (unsigned int i = 0; i < receive_times.size(); i++)
+        {
+            SSL_WrapperPacket packet;
+            SSL_DetectionFrame *frame = packet.mutable_detection();
+            frame->set_frame_number(i);
+            frame->set_t_capture(i / 60.0);
+            frame->set_t_sent(i / 60.0);
+            frame->set_camera_id(i % 4);
+
+            std::string data = packet.SerializeAsString();
+            recorder.recordPacket(data.data(), data.size(), receive_times[i]);
+        }
+    }
+
+    /**
+     * Returns the frame numbers of all the packets the replayer has due by the given
+     * time
+     */
+    static std::vector<unsigned int> getDueFrameNumbers(VisionPacketReplayer &replayer,
+                                                        const AITimestamp &now)
+    {
+        std::vector<SSL_WrapperPacket> packets;
+        replayer.getVisionPacketsDueBy(packets, now);
+        std::vector<unsigned int> frame_numbers;
+        for (const SSL_WrapperPacket &packet : packets)
+        {
+            frame_numbers.emplace_back(packet.detection().frame_number());
+        }
+        return frame_numbers;
+    }
+
+    std::string file_path;
+};
+
+TEST_F(VisionPacketLogTest, replays_recorded_packets_as_fast_as_possible)
+{
+    recordPackets({milliseconds(100), milliseconds(116), milliseconds(133)});
+
+    VisionPacketReplayer replayer(file_path, VisionPacketReplayer::AS_FAST_AS_POSSIBLE);
+
+    EXPECT_EQ(3, replayer.getNumPackets());
+    EXPECT_EQ(std::vector<unsigned int>({0, 1, 2}),
+              getDueFrameNumbers(replayer, seconds(0)));
+    EXPECT_TRUE(replayer.isFinished());
+    EXPECT_TRUE(getDueFrameNumbers(replayer, seconds(0)).empty());
+}
+
+TEST_F(VisionPacketLogTest, replays_packets_with_recorded_timing)
+{
+    recordPackets({milliseconds(100), milliseconds(110), milliseconds(150)});
+
+    VisionPacketReplayer replayer(file_path);
+
+    // Playback starts with the first packet at the time of the first call
+    EXPECT_EQ(std::vector<unsigned int>({0}),
+              getDueFrameNumbers(replayer, seconds(5)));
+    EXPECT_TRUE(getDueFrameNumbers(replayer, seconds(5) + milliseconds(9)).empty());
+    EXPECT_EQ(
+        std::vector<unsigned int>({1}),
+        getDueFrameNumbers(replayer, seconds(5) + milliseconds(10)));
+    EXPECT_EQ(
+        std::vector<unsigned int>({2}),
+        getDueFrameNumbers(replayer, seconds(5) + milliseconds(60)));
+    EXPECT_TRUE(replayer.isFinished());
+}
+
+TEST_F(VisionPacketLogTest, replays_packets_faster_than_recorded)
+{
+    recordPackets({milliseconds(100), milliseconds(120), milliseconds(140)});
+
+    VisionPacketReplayer replayer(file_path, 2.0);
+
+    getDueFrameNumbers(replayer, seconds(5));
+    EXPECT_EQ(
+        std::vector<unsigned int>({1, 2}),
+        getDueFrameNumbers(replayer, seconds(5) + milliseconds(20)));
+}
+
+TEST_F(VisionPacketLogTest, seek_moves_to_first_packet_at_or_after_time)
+{
+    std::vector<milliseconds> receive_times;
+    for (unsigned int i = 0; i < 100; i++)
+    {
+        receive_times.emplace_back(milliseconds(1000 + 10 * i));
+    }
+    recordPackets(receive_times);
+
+    VisionPacketReplayer replayer(file_path, VisionPacketReplayer::AS_FAST_AS_POSSIBLE);
+    EXPECT_EQ(AITimestamp(milliseconds(1000)), replayer.getRecordingStartTime());
+    EXPECT_EQ(AITimestamp(milliseconds(1990)), replayer.getRecordingEndTime());
+
+    replayer.seek(milliseconds(1455));
+    std::vector<unsigned int> frame_numbers =
+        getDueFrameNumbers(replayer, seconds(0));
+    ASSERT_FALSE(frame_numbers.empty());
+    EXPECT_EQ(46, frame_numbers[0]);
+
+    replayer.seek(milliseconds(0));
+    EXPECT_EQ(0, getDueFrameNumbers(replayer, seconds(0))[0]);
+
+    replayer.seek(milliseconds(5000));
+    EXPECT_TRUE(replayer.isFinished());
+}
+
+TEST_F(VisionPacketLogTest, recording_without_index_can_still_be_replayed)
+{
+    recordPackets({milliseconds(100), milliseconds(116), milliseconds(133)});
+
+    // Cut off the index and the end of the last packet, as if the recording was
+    // interrupted while the last packet was being written
+    std::ifstream input(file_path, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(input)),
+                         std::istreambuf_iterator<char>());
+    input.close();
+    std::size_t truncated_size = contents.size() - sizeof(VisionPacketLogFooter) -
+                                 3 * sizeof(VisionPacketLogIndexEntry) - 4;
+    std::ofstream output(file_path, std::ios::binary | std::ios::trunc);
+    output.write(contents.data(), static_cast<std::streamsize>(truncated_size));
+    output.close();
+
+    VisionPacketReplayer replayer(file_path, VisionPacketReplayer::AS_FAST_AS_POSSIBLE);
+
+    EXPECT_EQ(2, replayer.getNumPackets());
+    EXPECT_EQ(std::vector<unsigned int>({0, 1}),
+              getDueFrameNumbers(replayer, seconds(0)));
+}
+
+TEST_F(VisionPacketLogTest, index_with_overflowing_number_of_entries_is_not_used)
+{
+    recordPackets({milliseconds(100), milliseconds(116), milliseconds(133)});
+
+    // Add 2^60 entries to the footer, so the size of the index overflows to the same
+    // size as the real one
+    std::fstream file(file_path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekg(-static_cast<std::streamoff>(sizeof(VisionPacketLogFooter)),
+               std::ios::end);
+    VisionPacketLogFooter footer;
+    file.read(reinterpret_cast<char *>(&footer), sizeof(footer));
+    footer.num_index_entries += uint64_t(1) << 60;
+    file.seekp(-static_cast<std::streamoff>(sizeof(VisionPacketLogFooter)),
+               std::ios::end);
+    file.write(reinterpret_cast<const char *>(&footer), sizeof(footer));
+    file.close();
+
+    VisionPacketReplayer replayer(file_path, VisionPacketReplayer::AS_FAST_AS_POSSIBLE);
+
+    // The index is built by scanning the file instead, which also finds what looks
+    // like a record in the bytes of the unused index, but can't parse a packet from it
+    EXPECT_EQ(4, replayer.getNumPackets());
+    EXPECT_EQ(std::vector<unsigned int>({0, 1, 2}),
+              getDueFrameNumbers(replayer, seconds(0)));
+}
+
+TEST_F(VisionPacketLogTest, invalid_file_throws)
+{
+    std::ofstream output(file_path, std::ios::binary | std::ios::trunc);
+    output << "this is not a vision packet log";
+    output.close();
+
+    EXPECT_THROW(VisionPacketReplayer replayer(file_path), std::runtime_error);
+}
+
+TEST_F(VisionPacketLogTest, missing_file_throws)
+{
+    EXPECT_THROW(VisionPacketReplayer replayer(file_path + ".missing"),
+                 std::runtime_error);
+}
+
+TEST_F(VisionPacketLogTest, negative_speed_throws)
+{
+    recordPackets({milliseconds(100)});
+
+    EXPECT_THROW(VisionPacketReplayer replayer(file_path, -1.0), std::invalid_argument);
+}
+
+TEST_F(VisionPacketLogTest, recording_stops_when_a_write_fails)
+{
+    // Writes to /dev/full always fail once they reach the device. The packet is bigger
+    // than the file's buffer, so it can't be held there
+    VisionPacketRecorder recorder("/dev/full");
+    std::string data(1 << 16, 'x');
+
+    EXPECT_FALSE(recorder.recordPacket(data.data(), data.size(), milliseconds(100)));
+    EXPECT_FALSE(recorder.recordPacket(data.data(), 1, milliseconds(116)));
+    EXPECT_EQ(0, recorder.getNumRecordedPackets());
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,238 @@
+#include "ai/hl/stp/play_selector.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "test/test_util/test_util.h"
+
+/**
+ * A Play whose applicability, score, invariant and failure are set by the test
+ */
+class TestPlay : public Play
+{
+   public:
+    explicit TestPlay(bool applicable, double score)
+        : applicable(applicable),
+          score(score),
+          invariant_holds(true),
+          failed(false),
+          num_applicable_checks(0)
+    {
+    }
+
+    bool isApplicable(const World &world) override
+    {
+        num_applicable_checks++;
+        return applicable;
+    }
+
+    double calculateScore(const World &world) override
+    {
+        return score;
+    }
+
+    bool invariantHolds(const World &world) override
+    {
+        return invariant_holds;
+    }
+
+    bool hasFailed(const World &world) override
+    {
+        return failed;
+    }
+
+    std::vector<std::unique_ptr<Tactic>> getTactics(const World &world) override
+    {
+        return std::vector<std::unique_ptr<Tactic>>();
+    }
+
+    std::string name() override
+    {
+        return "Test Play";
+    }
+
+    bool applicable;
+    double score;
+    bool invariant_holds;
+    bool failed;
+    std::atomic<unsigned int> num_applicable_checks;
+};
+
+/**
+ * A PlayFactory for a Play made by the test
+ */
+class TestPlayFactory : public PlayFactory
+{
+   public:
+    explicit TestPlayFactory(std::shared_ptr<Play> play) : play(play), name(play->name())
+    {
+    }
+
+    std::shared_ptr<Play> getInstance() override
+    {
+        return play;
+    }
+
+    const std::string &getName() const override
+    {
+        return name;
+    }
+
+   private:
+    std::shared_ptr<Play> play;
+    std::string name;
+};
+
+class PlaySelectorTest : public ::testing::Test
+{
+   protected:
+    /**
+     * Adds a TestPlay to the registry and returns it
+     */
+    std::shared_ptr<TestPlay> addPlay(bool applicable, double score)
+    {
+        auto play = std::make_shared<TestPlay>(applicable, score);
+        registry.emplace_back(std::make_shared<TestPlayFactory>(play));
+        return play;
+    }
+
+    World world            = ::Test::TestUtil::createBlankTestingWorld();
+    ThreadPool thread_pool = ThreadPool(4);
+    std::vector<std::shared_ptr<PlayFactory>> registry;
+};
+
+TEST_F(PlaySelectorTest, picks_highest_scoring_applicable_play)
+{
+    addPlay(true, 0.3);
+    auto best_play = addPlay(true, 0.8);
+    addPlay(false, 1.0);
+    addPlay(true, 0.5);
+    PlaySelector selector(registry, thread_pool);
+
+    EXPECT_EQ(best_play, selector.selectPlay(world, nullptr));
+}
+
+TEST_F(PlaySelectorTest, ties_go_to_first_registered_play)
+{
+    addPlay(false, 0.5);
+    auto first_play = addPlay(true, 0.5);
+    addPlay(true, 0.5);
+    PlaySelector selector(registry, thread_pool);
+
+    EXPECT_EQ(first_play, selector.selectPlay(world, nullptr));
+}
+
+TEST_F(PlaySelectorTest, checks_every_play_once_per_selection)
+{
+    std::vector<std::shared_ptr<TestPlay>> plays;
+    for (unsigned int i = 0; i < 10; i++)
+    {
+        plays.emplace_back(addPlay(i % 2 == 0, i / 10.0));
+    }
+    PlaySelector selector(registry, thread_pool);
+
+    selector.selectPlay(world, nullptr);
+    selector.selectPlay(world, plays[0]);
+
+    for (const auto &play : plays)
+    {
+        EXPECT_EQ(2u, play->num_applicable_checks.load());
+    }
+}
+
+TEST_F(PlaySelectorTest, keeps_current_play_unless_another_scores_much_higher)
+{
+    auto current_play = addPlay(true, 0.5);
+    auto other_play   = addPlay(true, 0.55);
+    PlaySelector selector(registry, thread_pool);
+
+    EXPECT_EQ(current_play, selector.selectPlay(world, current_play));
+
+    other_play->score = 0.5 + PlaySelector::PLAY_SWITCH_SCORE_HYSTERESIS + 0.01;
+    EXPECT_EQ(other_play, selector.selectPlay(world, current_play));
+}
+
+TEST_F(PlaySelectorTest, current_play_continues_while_invariant_holds)
+{
+    // The current play only has to be applicable to start
+    auto current_play = addPlay(false, 0.5);
+    addPlay(true, 0.5);
+    PlaySelector selector(registry, thread_pool);
+
+    EXPECT_EQ(current_play, selector.selectPlay(world, current_play));
+}
+
+TEST_F(PlaySelectorTest, replaces_current_play_when_invariant_breaks_or_it_fails)
+{
+    auto current_play = addPlay(true, 0.9);
+    auto other_play   = addPlay(true, 0.2);
+    PlaySelector selector(registry, thread_pool);
+
+    current_play->invariant_holds = false;
+    EXPECT_EQ(other_play, selector.selectPlay(world, current_play));
+
+    current_play->invariant_holds = true;
+    current_play->failed          = true;
+    EXPECT_EQ(other_play, selector.selectPlay(world, current_play));
+}
+
+TEST_F(PlaySelectorTest, keeps_current_play_if_nothing_else_is_applicable)
+{
+    auto current_play             = addPlay(true, 0.5);
+    current_play->invariant_holds = false;
+    addPlay(false, 0.5);
+    PlaySelector selector(registry, thread_pool);
+
+    EXPECT_EQ(current_play, selector.selectPlay(world, current_play));
+}
+
+TEST_F(PlaySelectorTest, falls_back_to_first_play_if_none_are_applicable)
+{
+    auto first_play = addPlay(false, 0.5);
+    addPlay(false, 0.5);
+    PlaySelector selector(registry, thread_pool);
+
+    EXPECT_EQ(first_play, selector.selectPlay(world, nullptr));
+}
+
+TEST_F(PlaySelectorTest, no_plays_selects_nothing)
+{
+    PlaySelector selector(registry, thread_pool);
+
+    EXPECT_EQ(nullptr, selector.selectPlay(world, nullptr));
+}
+
+TEST_F(PlaySelectorTest, records_how_long_selection_took)
+{
+    /**
+     * A Play that takes a while to check
+     */
+    class SlowPlay : public TestPlay
+    {
+       public:
+        SlowPlay() : TestPlay(true, 0.5) {}
+
+        bool isApplicable(const World &world) override
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            return true;
+        }
+    };
+    registry.emplace_back(
+        std::make_shared<TestPlayFactory>(std::make_shared<SlowPlay>()));
+    PlaySelector selector(registry, thread_pool);
+    EXPECT_EQ(AITimestamp(0), selector.getLastSelectionDuration());
+
+    selector.selectPlay(world, nullptr);
+
+    EXPECT_GE(selector.getLastSelectionDuration(), std::chrono::milliseconds(5));
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
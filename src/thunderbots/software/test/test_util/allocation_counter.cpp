@@ -0,0 +1,36 @@
+#include "test/test_util/allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // Every allocation made by the test program is counted
+    std::atomic<unsigned long> num_allocations(0);
+}  // namespace
+
+unsigned long Test::getNumAllocations()
+{
+    return num_allocations.load();
+}
+
+void *operator new(std::size_t size)
+{
+    num_allocations++;
+    if (void *ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
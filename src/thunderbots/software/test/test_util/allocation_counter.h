@@ -0,0 +1,16 @@
+#pragma once
+
+namespace Test
+{
+    /**
+     * Returns the number of allocations made with the global operator new by the test
+     * program so far, so tests can check that an operation doesn't allocate.
+     *
+     * Linking allocation_counter.cpp into a test replaces the global operator new and
+     * operator delete for the whole test program, so it should only be linked into the
+     * tests that use this function.
+     *
+     * @return the number of allocations made by the test program so far
+     */
+    unsigned long getNumAllocations();
+}  // namespace Test
@@ -0,0 +1,137 @@
+#include "util/hungarian_solver.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+
+/**
+ * Finds the lowest total cost of assigning every row to a different column by trying
+ * every assignment
+ */
+double findLowestCostByBruteForce(const std::vector<std::vector<double>> &costs)
+{
+    std::vector<std::size_t> columns(costs[0].size());
+    std::iota(columns.begin(), columns.end(), 0);
+    double lowest_cost = std::numeric_limits<double>::infinity();
+    do
+    {
+        double cost = 0;
+        for (std::size_t row = 0; row < costs.size(); row++)
+        {
+            cost += costs[row][columns[row]];
+        }
+        lowest_cost = std::min(lowest_cost, cost);
+    } while (std::next_permutation(columns.begin(), columns.end()));
+    return lowest_cost;
+}
+
+TEST(HungarianSolverTest, solves_small_square_problem)
+{
+    // The cheapest assignment is row 0 to column 1, row 1 to column 0 and row 2 to
+    // column 2, even though row 1 is cheapest in column 1
+    const double costs[3][3] = {{4, 1, 3}, {2, 0, 5}, {3, 2, 2}};
+    HungarianSolver solver;
+    solver.reset(3, 3);
+    for (std::size_t row = 0; row < 3; row++)
+    {
+        for (std::size_t column = 0; column < 3; column++)
+        {
+            solver.setCost(row, column, costs[row][column]);
+        }
+    }
+    solver.solve();
+
+    EXPECT_EQ(1u, solver.getAssignedColumn(0));
+    EXPECT_EQ(0u, solver.getAssignedColumn(1));
+    EXPECT_EQ(2u, solver.getAssignedColumn(2));
+    EXPECT_DOUBLE_EQ(5, solver.getTotalCost());
+}
+
+TEST(HungarianSolverTest, leaves_expensive_columns_unassigned)
+{
+    HungarianSolver solver;
+    solver.reset(1, 3);
+    solver.setCost(0, 0, 5);
+    solver.setCost(0, 1, 7);
+    solver.setCost(0, 2, 2);
+    solver.solve();
+
+    EXPECT_EQ(2u, solver.getAssignedColumn(0));
+    EXPECT_DOUBLE_EQ(2, solver.getTotalCost());
+}
+
+TEST(HungarianSolverTest, handles_negative_costs)
+{
+    HungarianSolver solver;
+    solver.reset(2, 2);
+    solver.setCost(0, 0, -1);
+    solver.setCost(0, 1, 0.5);
+    solver.setCost(1, 0, 0);
+    solver.setCost(1, 1, 3);
+    solver.solve();
+
+    EXPECT_EQ(1u, solver.getAssignedColumn(0));
+    EXPECT_EQ(0u, solver.getAssignedColumn(1));
+    EXPECT_DOUBLE_EQ(0.5, solver.getTotalCost());
+}
+
+TEST(HungarianSolverTest, empty_problem_has_no_cost)
+{
+    HungarianSolver solver;
+    solver.reset(0, 4);
+    solver.solve();
+
+    EXPECT_EQ(0, solver.getTotalCost());
+}
+
+TEST(HungarianSolverTest, matches_brute_force_for_random_problems)
+{
+    std::mt19937 random_generator(0);
+    std::uniform_real_distribution<double> cost_distribution(0, 10);
+    HungarianSolver solver;
+
+    // The same solver is reused for problems of different sizes, so any state left
+    // over from the last problem would show up here
+    for (unsigned int trial = 0; trial < 300; trial++)
+    {
+        const std::size_t num_columns = 1 + trial % 8;
+        const std::size_t num_rows    = 1 + (trial / 8) % num_columns;
+        std::vector<std::vector<double>> costs(num_rows,
+                                               std::vector<double>(num_columns));
+        solver.reset(num_rows, num_columns);
+        for (std::size_t row = 0; row < num_rows; row++)
+        {
+            for (std::size_t column = 0; column < num_columns; column++)
+            {
+                // Whole numbers make ties, which are the hardest case
+                costs[row][column] = std::floor(cost_distribution(random_generator));
+                solver.setCost(row, column, costs[row][column]);
+            }
+        }
+        solver.solve();
+
+        std::set<std::size_t> assigned_columns;
+        double total_cost = 0;
+        for (std::size_t row = 0; row < num_rows; row++)
+        {
+            const std::size_t column = solver.getAssignedColumn(row);
+            ASSERT_LT(column, num_columns);
+            assigned_columns.insert(column);
+            total_cost += costs[row][column];
+        }
+        EXPECT_EQ(num_rows, assigned_columns.size());
+        EXPECT_DOUBLE_EQ(total_cost, solver.getTotalCost());
+        EXPECT_DOUBLE_EQ(findLowestCostByBruteForce(costs), solver.getTotalCost());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,83 @@
+#include "util/latency_tracer.h"
+
+#include <gtest/gtest.h>
+
+TEST(LatencyTracerTest, latencies_are_recorded_per_stage)
+{
+    LatencyTracer tracer({"first", "second"}, std::chrono::seconds(1));
+
+    tracer.recordLatency(0, std::chrono::milliseconds(1));
+    tracer.recordLatency(1, std::chrono::milliseconds(2));
+    tracer.recordLatency(1, std::chrono::milliseconds(3));
+
+    EXPECT_EQ(1, tracer.getHistogram(0).getCount());
+    EXPECT_EQ(2, tracer.getHistogram(1).getCount());
+    EXPECT_DOUBLE_EQ(3000, tracer.getHistogram(1).getMax());
+}
+
+TEST(LatencyTracerTest, report_contains_every_stage)
+{
+    LatencyTracer tracer({"first", "second"}, std::chrono::seconds(1));
+    tracer.recordLatency(1, std::chrono::microseconds(250));
+
+    std::string report = tracer.createReport();
+
+    EXPECT_NE(std::string::npos, report.find("first [n=0 p50=0 p99=0 max=0]"));
+    EXPECT_NE(std::string::npos, report.find("second [n=1"));
+    EXPECT_NE(std::string::npos, report.find("max=250]"));
+}
+
+TEST(LatencyTracerTest, periodic_report_is_only_returned_once_per_period)
+{
+    LatencyTracer tracer({"stage"}, std::chrono::seconds(1));
+    AITimestamp start = std::chrono::seconds(100);
+
+    // The first call starts the first period
+    EXPECT_FALSE(tracer.getPeriodicReport(start));
+    tracer.recordLatency(0, std::chrono::milliseconds(1));
+    EXPECT_FALSE(tracer.getPeriodicReport(start + std::chrono::milliseconds(999)));
+
+    EXPECT_TRUE(tracer.getPeriodicReport(start + std::chrono::seconds(1)));
+    // Each report only covers the latencies recorded since the last one
+    EXPECT_EQ(0, tracer.getHistogram(0).getCount());
+    EXPECT_FALSE(tracer.getPeriodicReport(start + std::chrono::milliseconds(1500)));
+}
+
+TEST(LatencyTracerTest, percentiles_are_within_one_bucket_of_the_true_value)
+{
+    LatencyTracer tracer({"stage"}, std::chrono::seconds(1));
+
+    // 1ms to 100ms in steps of 1ms
+    for (int i = 1; i <= 100; i++)
+    {
+        tracer.recordLatency(0, std::chrono::milliseconds(i));
+    }
+
+    // Each bucket is at most 2^(1/8) times wider than the one before it
+    const MetricHistogram &histogram = tracer.getHistogram(0);
+    EXPECT_GE(histogram.getPercentile(0.5), 50000);
+    EXPECT_LE(histogram.getPercentile(0.5), 50000 * 1.091);
+    EXPECT_GE(histogram.getPercentile(0.99), 99000);
+    EXPECT_LE(histogram.getPercentile(0.99), 100000);
+}
+
+TEST(LatencyTracerTest, negative_and_huge_latencies_are_counted)
+{
+    LatencyTracer tracer({"stage"}, std::chrono::seconds(1));
+
+    // Clock skew between machines can make latencies negative
+    tracer.recordLatency(0, std::chrono::milliseconds(-5));
+    tracer.recordLatency(0, std::chrono::hours(1));
+
+    const MetricHistogram &histogram = tracer.getHistogram(0);
+    EXPECT_EQ(2, histogram.getCount());
+    EXPECT_DOUBLE_EQ(3.6e9, histogram.getMax());
+    EXPECT_LE(histogram.getPercentile(0.5), 1);
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,136 @@
+#include "util/metrics/metrics.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+TEST(MetricCounterTest, counter_starts_at_zero_and_counts_up)
+{
+    MetricCounter counter;
+    EXPECT_EQ(0, counter.get());
+
+    counter.increment();
+    counter.increment(4);
+
+    EXPECT_EQ(5, counter.get());
+}
+
+TEST(MetricCounterTest, increments_from_several_threads_are_not_lost)
+{
+    MetricCounter counter;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++)
+    {
+        threads.emplace_back([&counter]() {
+            for (int j = 0; j < 10000; j++)
+            {
+                counter.increment();
+            }
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(40000, counter.get());
+}
+
+TEST(MetricGaugeTest, gauge_holds_the_latest_value)
+{
+    MetricGauge gauge;
+    EXPECT_EQ(0.0, gauge.get());
+
+    gauge.set(3.5);
+    gauge.set(-1.0);
+
+    EXPECT_EQ(-1.0, gauge.get());
+}
+
+TEST(MetricHistogramTest, empty_histogram)
+{
+    MetricHistogram histogram({1, 2, 4});
+
+    EXPECT_EQ(0, histogram.getCount());
+    EXPECT_EQ(0.0, histogram.getMean());
+    EXPECT_EQ(0.0, histogram.getMax());
+    EXPECT_EQ(0.0, histogram.getPercentile(0.5));
+}
+
+TEST(MetricHistogramTest, statistics_of_recorded_values)
+{
+    MetricHistogram histogram({1, 2, 4, 8});
+
+    for (double value : {0.5, 1.5, 1.5, 3.0, 7.0})
+    {
+        histogram.record(value);
+    }
+
+    EXPECT_EQ(5, histogram.getCount());
+    EXPECT_DOUBLE_EQ(2.7, histogram.getMean());
+    EXPECT_EQ(7.0, histogram.getMax());
+    // The percentile is the upper bound of the bucket it falls in
+    EXPECT_EQ(2.0, histogram.getPercentile(0.5));
+    // But never more than the largest value
+    EXPECT_EQ(7.0, histogram.getPercentile(1.0));
+}
+
+TEST(MetricHistogramTest, values_past_the_last_bucket_use_the_max)
+{
+    MetricHistogram histogram({1, 2});
+
+    histogram.record(100.0);
+
+    EXPECT_EQ(1, histogram.getCount());
+    EXPECT_EQ(100.0, histogram.getPercentile(0.99));
+}
+
+TEST(MetricHistogramTest, negative_values_are_recorded)
+{
+    MetricHistogram histogram({1, 2});
+
+    histogram.record(-3.0);
+    histogram.record(-5.0);
+
+    EXPECT_EQ(-3.0, histogram.getMax());
+    EXPECT_EQ(-4.0, histogram.getMean());
+}
+
+TEST(MetricHistogramTest, bucket_bounds_must_be_increasing)
+{
+    EXPECT_THROW(MetricHistogram({}), std::invalid_argument);
+    EXPECT_THROW(MetricHistogram({1, 1}), std::invalid_argument);
+    EXPECT_THROW(MetricHistogram({2, 1}), std::invalid_argument);
+}
+
+TEST(MetricHistogramTest, exponential_bucket_bounds)
+{
+    std::vector<double> bounds = MetricHistogram::createExponentialBucketBounds(1, 2, 4);
+
+    EXPECT_EQ(std::vector<double>({1, 2, 4, 8}), bounds);
+}
+
+TEST(MetricHistogramTest, reset_removes_all_values)
+{
+    MetricHistogram histogram({1, 2, 4});
+    histogram.record(3);
+
+    histogram.reset();
+
+    EXPECT_EQ(0, histogram.getCount());
+    EXPECT_DOUBLE_EQ(0, histogram.getMax());
+    EXPECT_DOUBLE_EQ(0, histogram.getPercentile(0.5));
+
+    // Statistics start again from the next value
+    histogram.record(-1);
+    EXPECT_DOUBLE_EQ(-1, histogram.getMax());
+    EXPECT_DOUBLE_EQ(-1, histogram.getMean());
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
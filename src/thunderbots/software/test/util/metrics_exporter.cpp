@@ -0,0 +1,90 @@
+#include "util/metrics/metrics_exporter.h"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+class MetricsExporterTest : public ::testing::Test
+{
+   protected:
+    MetricsRegistry registry;
+    MetricsExporter exporter = MetricsExporter(registry, std::chrono::seconds(1));
+    AITimestamp start        = std::chrono::seconds(100);
+};
+
+TEST_F(MetricsExporterTest, snapshot_is_only_returned_once_per_period)
+{
+    registry.getCounter("counter");
+
+    EXPECT_TRUE(exporter.getPeriodicSnapshot(start));
+    EXPECT_FALSE(exporter.getPeriodicSnapshot(start + std::chrono::milliseconds(999)));
+    EXPECT_TRUE(exporter.getPeriodicSnapshot(start + std::chrono::seconds(1)));
+}
+
+TEST_F(MetricsExporterTest, counter_rates_are_calculated_between_snapshots)
+{
+    MetricCounter &counter = registry.getCounter("counter");
+
+    // There is nothing to calculate a rate from in the first snapshot
+    std::optional<std::vector<MetricSample>> snapshot =
+        exporter.getPeriodicSnapshot(start);
+    ASSERT_TRUE(snapshot);
+    EXPECT_EQ(1, snapshot->size());
+
+    counter.increment(30);
+    snapshot = exporter.getPeriodicSnapshot(start + std::chrono::seconds(2));
+    ASSERT_TRUE(snapshot);
+    ASSERT_EQ(2, snapshot->size());
+    EXPECT_EQ("counter", (*snapshot)[0].name);
+    EXPECT_EQ(30.0, (*snapshot)[0].value);
+    EXPECT_EQ("counter.per_second", (*snapshot)[1].name);
+    EXPECT_DOUBLE_EQ(15.0, (*snapshot)[1].value);
+}
+
+TEST_F(MetricsExporterTest, snapshot_is_written_to_file_as_text)
+{
+    std::vector<MetricSample> snapshot = {{"a", 1.5, false}, {"b", 2, true}};
+    std::string file_path =
+        testing::TempDir() + "metrics_exporter_test_" + std::to_string(getpid());
+
+    ASSERT_TRUE(MetricsExporter::writeSnapshotToFile(file_path, "test_node", snapshot));
+
+    std::ifstream file(file_path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    EXPECT_EQ("# Metrics for test_node\na 1.5\nb 2\n", contents.str());
+    std::remove(file_path.c_str());
+}
+
+TEST_F(MetricsExporterTest, writing_to_a_missing_directory_fails)
+{
+    std::vector<MetricSample> snapshot = {{"a", 1.5, false}};
+
+    EXPECT_FALSE(MetricsExporter::writeSnapshotToFile(
+        "/this/directory/does/not/exist/metrics.txt", "test_node", snapshot));
+}
+
+TEST_F(MetricsExporterTest, metrics_msg_contains_every_sample)
+{
+    std::vector<MetricSample> snapshot = {{"a", 1.5, false}, {"b", 2, true}};
+
+    thunderbots_msgs::Metrics metrics_msg =
+        MetricsExporter::createMetricsMsg("test_node", snapshot);
+
+    EXPECT_EQ("test_node", metrics_msg.node_name);
+    ASSERT_EQ(2, metrics_msg.metrics.size());
+    EXPECT_EQ("a", metrics_msg.metrics[0].name);
+    EXPECT_EQ(1.5, metrics_msg.metrics[0].value);
+    EXPECT_EQ("b", metrics_msg.metrics[1].name);
+    EXPECT_EQ(2.0, metrics_msg.metrics[1].value);
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
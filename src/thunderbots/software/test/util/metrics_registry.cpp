@@ -0,0 +1,59 @@
+#include "util/metrics/metrics_registry.h"
+
+#include <gtest/gtest.h>
+
+TEST(MetricsRegistryTest, same_name_returns_the_same_metric)
+{
+    MetricsRegistry registry;
+
+    MetricCounter &counter = registry.getCounter("counter");
+    counter.increment();
+
+    EXPECT_EQ(&counter, &registry.getCounter("counter"));
+    EXPECT_EQ(1, registry.getCounter("counter").get());
+}
+
+TEST(MetricsRegistryTest, references_stay_valid_as_metrics_are_added)
+{
+    MetricsRegistry registry;
+
+    MetricGauge &gauge = registry.getGauge("gauge");
+    for (int i = 0; i < 100; i++)
+    {
+        registry.getGauge("gauge_" + std::to_string(i));
+    }
+    gauge.set(2.0);
+
+    EXPECT_EQ(2.0, registry.getGauge("gauge").get());
+}
+
+TEST(MetricsRegistryTest, snapshot_contains_every_metric_sorted_by_name)
+{
+    MetricsRegistry registry;
+    registry.getGauge("b_gauge").set(1.5);
+    registry.getCounter("a_counter").increment(3);
+    registry.getHistogram("c_histogram", {1, 2}).record(1.0);
+
+    std::vector<MetricSample> snapshot = registry.getSnapshot();
+
+    ASSERT_EQ(7, snapshot.size());
+    EXPECT_EQ("a_counter", snapshot[0].name);
+    EXPECT_EQ(3.0, snapshot[0].value);
+    EXPECT_TRUE(snapshot[0].is_counter);
+    EXPECT_EQ("b_gauge", snapshot[1].name);
+    EXPECT_EQ(1.5, snapshot[1].value);
+    EXPECT_FALSE(snapshot[1].is_counter);
+    EXPECT_EQ("c_histogram.count", snapshot[2].name);
+    EXPECT_EQ(1.0, snapshot[2].value);
+    EXPECT_EQ("c_histogram.max", snapshot[3].name);
+    EXPECT_EQ("c_histogram.mean", snapshot[4].name);
+    EXPECT_EQ("c_histogram.p50", snapshot[5].name);
+    EXPECT_EQ("c_histogram.p99", snapshot[6].name);
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -27,10 +27,13 @@ TEST_F(ROSMessageUtilTest, create_ball_from_ros_message)
     ball_msg.position.y = -8.07;
     ball_msg.velocity.x = 0;
     ball_msg.velocity.y = 3;
+    ball_msg.timestamp_microseconds =
+        duration_cast<microseconds>(current_time.time_since_epoch()).count();
 
     Ball ball = Util::ROSMessages::createBallFromROSMessage(ball_msg);
 
     EXPECT_EQ(Ball(Point(1.2, -8.07), Vector(0, 3)), ball);
+    EXPECT_EQ(current_time, ball.lastUpdateTimestamp());
 }
 
 TEST_F(ROSMessageUtilTest, create_robot_from_ros_message)
@@ -0,0 +1,135 @@
+#include "util/spsc_ring_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+
+TEST(SPSCRingBufferTest, construction)
+{
+    SPSCRingBuffer<int, 4> buffer;
+
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(0, buffer.size());
+    EXPECT_EQ(4, buffer.capacity());
+}
+
+TEST(SPSCRingBufferTest, pop_from_empty_buffer)
+{
+    SPSCRingBuffer<int, 4> buffer;
+
+    int value = 7;
+    EXPECT_FALSE(buffer.pop(value));
+    // The value should be left unchanged
+    EXPECT_EQ(7, value);
+}
+
+TEST(SPSCRingBufferTest, values_are_popped_in_the_order_they_were_pushed)
+{
+    SPSCRingBuffer<int, 4> buffer;
+
+    EXPECT_TRUE(buffer.push(1));
+    EXPECT_TRUE(buffer.push(2));
+    EXPECT_TRUE(buffer.push(3));
+    EXPECT_EQ(3, buffer.size());
+
+    int value;
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(1, value);
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(2, value);
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(3, value);
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SPSCRingBufferTest, push_to_full_buffer_drops_the_new_value)
+{
+    SPSCRingBuffer<int, 2> buffer;
+
+    EXPECT_TRUE(buffer.push(1));
+    EXPECT_TRUE(buffer.push(2));
+    EXPECT_FALSE(buffer.push(3));
+    EXPECT_EQ(2, buffer.size());
+
+    int value;
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(1, value);
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(2, value);
+    EXPECT_FALSE(buffer.pop(value));
+}
+
+TEST(SPSCRingBufferTest, buffer_wraps_around_the_end_of_its_storage)
+{
+    SPSCRingBuffer<int, 3> buffer;
+
+    int value;
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_TRUE(buffer.push(int(i)));
+        EXPECT_TRUE(buffer.push(int(i + 100)));
+        EXPECT_EQ(2, buffer.size());
+
+        EXPECT_TRUE(buffer.pop(value));
+        EXPECT_EQ(i, value);
+        EXPECT_TRUE(buffer.pop(value));
+        EXPECT_EQ(i + 100, value);
+        EXPECT_TRUE(buffer.empty());
+    }
+}
+
+TEST(SPSCRingBufferTest, values_are_moved_not_copied)
+{
+    // unique_ptr can't be copied, so this only compiles if values are moved
+    SPSCRingBuffer<std::unique_ptr<int>, 2> buffer;
+
+    EXPECT_TRUE(buffer.push(std::make_unique<int>(5)));
+
+    std::unique_ptr<int> value;
+    EXPECT_TRUE(buffer.pop(value));
+    ASSERT_TRUE(value);
+    EXPECT_EQ(5, *value);
+}
+
+TEST(SPSCRingBufferTest, values_pass_between_threads_in_order)
+{
+    static constexpr int num_values = 100000;
+    SPSCRingBuffer<int, 16> buffer;
+
+    std::thread producer([&buffer]() {
+        for (int i = 0; i < num_values; i++)
+        {
+            // Keep trying until there is space in the buffer
+            while (!buffer.push(int(i)))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected_value = 0;
+    int value;
+    while (expected_value < num_values)
+    {
+        if (buffer.pop(value))
+        {
+            ASSERT_EQ(expected_value, value);
+            expected_value++;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    EXPECT_TRUE(buffer.empty());
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,97 @@
+#include "util/thread_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST(ThreadPoolTest, runs_every_task_once)
+{
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> num_runs(1000);
+
+    pool.parallelFor(num_runs.size(), [&](std::size_t i) { num_runs[i]++; });
+
+    for (const std::atomic<int> &runs : num_runs)
+    {
+        EXPECT_EQ(1, runs.load());
+    }
+}
+
+TEST(ThreadPoolTest, runs_many_batches_in_a_row)
+{
+    ThreadPool pool(3);
+    std::atomic<std::size_t> total(0);
+
+    for (std::size_t batch = 0; batch < 500; batch++)
+    {
+        pool.parallelFor(batch % 7, [&](std::size_t i) { total += i + 1; });
+    }
+
+    // Each batch of n tasks adds 1 + 2 + ... + n
+    std::size_t expected_total = 0;
+    for (std::size_t batch = 0; batch < 500; batch++)
+    {
+        std::size_t n = batch % 7;
+        expected_total += n * (n + 1) / 2;
+    }
+    EXPECT_EQ(expected_total, total.load());
+}
+
+TEST(ThreadPoolTest, tasks_are_spread_across_threads)
+{
+    ThreadPool pool(4);
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+
+    // Each task waits until the other threads have joined in, or gives up after a while
+    // so the test can't hang if they don't
+    std::atomic<unsigned int> num_started(0);
+    pool.parallelFor(4, [&](std::size_t i) {
+        num_started++;
+        for (int spins = 0; spins < 100000000 && num_started < 4; spins++)
+        {
+        }
+        std::scoped_lock lock(mutex);
+        thread_ids.insert(std::this_thread::get_id());
+    });
+
+    EXPECT_EQ(4u, thread_ids.size());
+}
+
+TEST(ThreadPoolTest, single_thread_pool_runs_tasks_on_calling_thread)
+{
+    ThreadPool pool(1);
+    EXPECT_EQ(1u, pool.getNumThreads());
+
+    std::vector<std::thread::id> thread_ids;
+    pool.parallelFor(
+        10, [&](std::size_t i) { thread_ids.push_back(std::this_thread::get_id()); });
+
+    ASSERT_EQ(10u, thread_ids.size());
+    for (const std::thread::id &id : thread_ids)
+    {
+        EXPECT_EQ(std::this_thread::get_id(), id);
+    }
+}
+
+TEST(ThreadPoolTest, zero_threads_is_treated_as_one)
+{
+    ThreadPool pool(0);
+    EXPECT_EQ(1u, pool.getNumThreads());
+
+    int num_runs = 0;
+    pool.parallelFor(5, [&](std::size_t i) { num_runs++; });
+    EXPECT_EQ(5, num_runs);
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,136 @@
+#include "util/tick_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace std::chrono;
+
+class TickSchedulerTest : public ::testing::Test
+{
+   protected:
+    /**
+     * Returns the value of the metric with the given name from a snapshot of the
+     * registry
+     */
+    double getMetricValue(const std::string &name)
+    {
+        for (const MetricSample &sample : metrics.getSnapshot())
+        {
+            if (sample.name == name)
+            {
+                return sample.value;
+            }
+        }
+        ADD_FAILURE() << "No metric named " << name;
+        return 0;
+    }
+
+    MetricsRegistry metrics;
+};
+
+TEST_F(TickSchedulerTest, first_tick_starts_straight_away)
+{
+    TickScheduler scheduler(TICK_ON_NEW_DATA, seconds(10), milliseconds(10), metrics,
+                            "test");
+
+    AITimestamp start = Timestamp::getTimestampNow();
+    EXPECT_TRUE(scheduler.waitForNextTick());
+    EXPECT_LT(Timestamp::getTimestampNow() - start, seconds(1));
+}
+
+TEST_F(TickSchedulerTest, new_data_starts_the_next_tick)
+{
+    TickScheduler scheduler(TICK_ON_NEW_DATA, seconds(10), milliseconds(10), metrics,
+                            "test");
+    ASSERT_TRUE(scheduler.waitForNextTick());
+    scheduler.finishTick();
+
+    std::thread notify_thread([&scheduler]() {
+        std::this_thread::sleep_for(milliseconds(20));
+        scheduler.notifyNewData();
+    });
+
+    AITimestamp start = Timestamp::getTimestampNow();
+    EXPECT_TRUE(scheduler.waitForNextTick());
+    // We should have woken up long before the max period
+    EXPECT_LT(Timestamp::getTimestampNow() - start, seconds(5));
+    notify_thread.join();
+}
+
+TEST_F(TickSchedulerTest, tick_starts_after_max_period_without_new_data)
+{
+    TickScheduler scheduler(TICK_ON_NEW_DATA, milliseconds(20), milliseconds(10), metrics,
+                            "test");
+    ASSERT_TRUE(scheduler.waitForNextTick());
+    scheduler.finishTick();
+
+    AITimestamp start = Timestamp::getTimestampNow();
+    EXPECT_TRUE(scheduler.waitForNextTick());
+    EXPECT_GE(Timestamp::getTimestampNow() - start, milliseconds(15));
+    // The first tick and this one both started without new data
+    EXPECT_EQ(2.0, getMetricValue("test.ticks_without_new_data"));
+}
+
+TEST_F(TickSchedulerTest, fixed_rate_ticks_ignore_new_data)
+{
+    TickScheduler scheduler(TICK_AT_FIXED_RATE, milliseconds(30), milliseconds(10),
+                            metrics, "test");
+    ASSERT_TRUE(scheduler.waitForNextTick());
+    scheduler.finishTick();
+
+    scheduler.notifyNewData();
+    AITimestamp start = Timestamp::getTimestampNow();
+    EXPECT_TRUE(scheduler.waitForNextTick());
+    EXPECT_GE(Timestamp::getTimestampNow() - start, milliseconds(20));
+    EXPECT_EQ(1.0, getMetricValue("test.tick_interval_us.count"));
+}
+
+TEST_F(TickSchedulerTest, tick_deadline_is_the_deadline_after_the_tick_started)
+{
+    TickScheduler scheduler(TICK_ON_NEW_DATA, seconds(10), milliseconds(10), metrics,
+                            "test");
+
+    AITimestamp before_tick = Timestamp::getTimestampNow();
+    ASSERT_TRUE(scheduler.waitForNextTick());
+    AITimestamp after_tick = Timestamp::getTimestampNow();
+
+    EXPECT_GE(scheduler.getTickDeadline(), before_tick + milliseconds(10));
+    EXPECT_LE(scheduler.getTickDeadline(), after_tick + milliseconds(10));
+}
+
+TEST_F(TickSchedulerTest, late_ticks_are_counted_as_deadline_misses)
+{
+    TickScheduler scheduler(TICK_ON_NEW_DATA, seconds(10), milliseconds(1), metrics,
+                            "test");
+
+    ASSERT_TRUE(scheduler.waitForNextTick());
+    std::this_thread::sleep_for(milliseconds(5));
+    EXPECT_FALSE(scheduler.finishTick());
+
+    EXPECT_EQ(1.0, getMetricValue("test.deadline_misses"));
+}
+
+TEST_F(TickSchedulerTest, stop_wakes_the_tick_thread)
+{
+    TickScheduler scheduler(TICK_ON_NEW_DATA, seconds(10), milliseconds(10), metrics,
+                            "test");
+    ASSERT_TRUE(scheduler.waitForNextTick());
+    scheduler.finishTick();
+
+    std::thread stop_thread([&scheduler]() {
+        std::this_thread::sleep_for(milliseconds(20));
+        scheduler.stop();
+    });
+
+    EXPECT_FALSE(scheduler.waitForNextTick());
+    EXPECT_FALSE(scheduler.waitForNextTick());
+    stop_thread.join();
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
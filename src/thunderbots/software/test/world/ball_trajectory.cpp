@@ -0,0 +1,207 @@
+#include "ai/world/ball_trajectory.h"
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono;
+
+class BallTrajectoryTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        auto epoch       = time_point<std::chrono::steady_clock>();
+        auto since_epoch = std::chrono::seconds(10000);
+
+        // An arbitrary fixed point in time. 10000 seconds after the epoch.
+        // We use this fixed point in time to make the tests deterministic.
+        current_time = epoch + since_epoch;
+    }
+
+    steady_clock::time_point current_time;
+};
+
+TEST_F(BallTrajectoryTest, stationary_ball_stays_where_it_is)
+{
+    BallTrajectory trajectory(Ball(Point(1, -2), Vector(), current_time));
+
+    EXPECT_EQ(current_time, trajectory.getStartTimestamp());
+    EXPECT_EQ(Point(1, -2), trajectory.estimatePositionAtFutureTime(seconds(3)));
+    EXPECT_EQ(Vector(), trajectory.estimateVelocityAtFutureTime(seconds(3)));
+    EXPECT_EQ(Point(1, -2), trajectory.getRestingPosition());
+    EXPECT_EQ(microseconds(0), trajectory.getTimeUntilStopped());
+    EXPECT_FALSE(trajectory.isSliding());
+    EXPECT_EQ(1, trajectory.getNumSamples());
+}
+
+TEST_F(BallTrajectoryTest, rolling_ball_slows_down_and_stops)
+{
+    // Takes 2 / 0.35 seconds to stop, after rolling 2^2 / (2 * 0.35) metres
+    BallTrajectory trajectory(Ball(Point(0, 0), Vector(0, 2), current_time));
+    const double a = BallTrajectory::ROLLING_DECELERATION_METERS_PER_SECOND_SQUARED;
+
+    EXPECT_FALSE(trajectory.isSliding());
+    EXPECT_TRUE(trajectory.estimatePositionAtFutureTime(seconds(1))
+                    .isClose(Point(0, 2 - a / 2), 1e-9));
+    EXPECT_TRUE(trajectory.estimateVelocityAtFutureTime(seconds(1))
+                    .isClose(Vector(0, 2 - a), 1e-9));
+
+    EXPECT_NEAR(2 / a, duration<double>(trajectory.getTimeUntilStopped()).count(), 1e-6);
+    EXPECT_TRUE(trajectory.getRestingPosition().isClose(Point(0, 2 / a), 1e-9));
+    EXPECT_TRUE(trajectory.estimatePositionAtFutureTime(seconds(100))
+                    .isClose(trajectory.getRestingPosition(), 1e-9));
+    EXPECT_EQ(Vector(), trajectory.estimateVelocityAtFutureTime(seconds(100)));
+}
+
+TEST_F(BallTrajectoryTest, kicked_ball_slides_then_rolls)
+{
+    Ball ball(Point(0, 0), Vector(), current_time);
+    BallTrajectory trajectory(ball);
+
+    // The ball is now much faster than the stationary trajectory predicted
+    ball.updateState(Point(0, 0), Vector(5, 0), current_time + milliseconds(10));
+    trajectory.update(ball);
+
+    const double rolling_speed = 5 * BallTrajectory::ROLLING_SPEED_RATIO;
+    const double sliding_seconds =
+        (5 - rolling_speed) /
+        BallTrajectory::SLIDING_DECELERATION_METERS_PER_SECOND_SQUARED;
+    const double sliding_distance = (5 + rolling_speed) / 2 * sliding_seconds;
+
+    EXPECT_TRUE(trajectory.isSliding());
+    EXPECT_EQ(current_time + milliseconds(10), trajectory.getStartTimestamp());
+
+    // Halfway through sliding, the ball is slowing down quickly
+    auto halfway_sliding =
+        duration_cast<microseconds>(duration<double>(sliding_seconds / 2));
+    EXPECT_NEAR(5 - BallTrajectory::SLIDING_DECELERATION_METERS_PER_SECOND_SQUARED *
+                        duration<double>(halfway_sliding).count(),
+                trajectory.estimateVelocityAtFutureTime(halfway_sliding).len(), 1e-9);
+
+    // Once it's rolling, it slows down slowly
+    auto one_second_rolling =
+        duration_cast<microseconds>(duration<double>(sliding_seconds + 1));
+    EXPECT_NEAR(
+        rolling_speed - BallTrajectory::ROLLING_DECELERATION_METERS_PER_SECOND_SQUARED,
+        trajectory.estimateVelocityAtFutureTime(one_second_rolling).len(), 1e-5);
+    EXPECT_NEAR(sliding_distance + rolling_speed -
+                    BallTrajectory::ROLLING_DECELERATION_METERS_PER_SECOND_SQUARED / 2,
+                trajectory.estimatePositionAtFutureTime(one_second_rolling).x(), 1e-5);
+}
+
+TEST_F(BallTrajectoryTest, ball_keeps_sliding_over_updates_until_it_rolls)
+{
+    Ball ball(Point(0, 0), Vector(), current_time);
+    BallTrajectory trajectory(ball);
+    ball.updateState(Point(0, 0), Vector(5, 0), current_time);
+    trajectory.update(ball);
+
+    // The next update agrees with the predicted trajectory, so the ball is still sliding
+    // towards the same rolling speed
+    auto later = milliseconds(50);
+    ball.updateState(trajectory.estimatePositionAtFutureTime(later),
+                     trajectory.estimateVelocityAtFutureTime(later),
+                     current_time + later);
+    trajectory.update(ball);
+    EXPECT_TRUE(trajectory.isSliding());
+
+    // Much later, the ball has finished sliding
+    auto much_later = seconds(1);
+    ball.updateState(trajectory.estimatePositionAtFutureTime(much_later),
+                     trajectory.estimateVelocityAtFutureTime(much_later),
+                     current_time + later + much_later);
+    trajectory.update(ball);
+    EXPECT_FALSE(trajectory.isSliding());
+}
+
+TEST_F(BallTrajectoryTest, time_to_travel_distance)
+{
+    BallTrajectory trajectory(Ball(Point(0, 0), Vector(1, 1), current_time));
+    const double stop_distance = trajectory.getRestingPosition().len();
+
+    EXPECT_EQ(microseconds(0), trajectory.estimateTimeToTravelDistance(0));
+    EXPECT_EQ(trajectory.getTimeUntilStopped(),
+              trajectory.estimateTimeToTravelDistance(stop_distance));
+    EXPECT_EQ(std::nullopt,
+              trajectory.estimateTimeToTravelDistance(stop_distance + 0.01));
+
+    // Looking up the position at the time it takes to travel a distance should give
+    // back that distance
+    for (double distance = 0.1; distance < stop_distance; distance += 0.1)
+    {
+        std::optional<microseconds> time =
+            trajectory.estimateTimeToTravelDistance(distance);
+        ASSERT_TRUE(time);
+        EXPECT_NEAR(distance, trajectory.estimatePositionAtFutureTime(*time).len(), 1e-5);
+    }
+}
+
+TEST_F(BallTrajectoryTest, time_to_travel_distance_while_sliding)
+{
+    Ball ball(Point(0, 0), Vector(), current_time);
+    BallTrajectory trajectory(ball);
+    ball.updateState(Point(0, 0), Vector(0, -6), current_time);
+    trajectory.update(ball);
+
+    std::optional<microseconds> time = trajectory.estimateTimeToTravelDistance(0.5);
+    ASSERT_TRUE(time);
+    EXPECT_NEAR(0.5, trajectory.estimatePositionAtFutureTime(*time).len(), 1e-5);
+    // The ball is still sliding after half a metre
+    EXPECT_GT(trajectory.estimateVelocityAtFutureTime(*time).len(),
+              6 * BallTrajectory::ROLLING_SPEED_RATIO);
+}
+
+TEST_F(BallTrajectoryTest, samples_match_lookups)
+{
+    BallTrajectory trajectory(Ball(Point(-1, 0.5), Vector(1.5, -0.5), current_time));
+
+    ASSERT_GT(trajectory.getNumSamples(), 1);
+    ASSERT_EQ(trajectory.getNumSamples(), trajectory.getSampleXPositions().size());
+    ASSERT_EQ(trajectory.getNumSamples(), trajectory.getSampleYPositions().size());
+    ASSERT_EQ(trajectory.getNumSamples(), trajectory.getSampleSpeeds().size());
+
+    for (std::size_t i = 0; i < trajectory.getNumSamples(); i++)
+    {
+        auto time      = BallTrajectory::SAMPLE_PERIOD * i;
+        Point position = trajectory.estimatePositionAtFutureTime(time);
+        EXPECT_NEAR(position.x(), trajectory.getSampleXPositions()[i], 1e-9);
+        EXPECT_NEAR(position.y(), trajectory.getSampleYPositions()[i], 1e-9);
+        EXPECT_NEAR(trajectory.estimateVelocityAtFutureTime(time).len(),
+                    trajectory.getSampleSpeeds()[i], 1e-9);
+    }
+
+    // The last sample is at or after the ball stops
+    EXPECT_EQ(0, trajectory.getSampleSpeeds().back());
+}
+
+TEST_F(BallTrajectoryTest, number_of_samples_is_limited)
+{
+    // A fast rolling ball takes far longer than MAX_NUM_SAMPLES samples to stop
+    BallTrajectory trajectory(Ball(Point(0, 0), Vector(6, 0), current_time));
+
+    EXPECT_EQ(BallTrajectory::MAX_NUM_SAMPLES, trajectory.getNumSamples());
+}
+
+TEST_F(BallTrajectoryTest, copy_and_assign)
+{
+    BallTrajectory trajectory(Ball(Point(0, 0), Vector(1, 0), current_time));
+    BallTrajectory copy(trajectory);
+    BallTrajectory assigned(Ball(Point(3, 3), Vector(), current_time));
+    assigned = trajectory;
+
+    for (const BallTrajectory &other : {copy, assigned})
+    {
+        EXPECT_EQ(trajectory.getStartTimestamp(), other.getStartTimestamp());
+        EXPECT_EQ(trajectory.getRestingPosition(), other.getRestingPosition());
+        EXPECT_EQ(trajectory.getTimeUntilStopped(), other.getTimeUntilStopped());
+        EXPECT_EQ(trajectory.getSampleXPositions(), other.getSampleXPositions());
+        EXPECT_EQ(trajectory.getSampleYPositions(), other.getSampleYPositions());
+        EXPECT_EQ(trajectory.getSampleSpeeds(), other.getSampleSpeeds());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
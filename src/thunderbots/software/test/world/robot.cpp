@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include "shared/constants.h"
+
 using namespace std::chrono;
 
 class RobotTest : public ::testing::Test
@@ -86,6 +88,105 @@ TEST_F(RobotTest, update_state_to_predicted_state_with_future_timestamp)
     EXPECT_EQ(one_second_future, robot.lastUpdateTimestamp());
 }
 
+TEST_F(RobotTest, update_state_estimates_acceleration_from_change_in_velocity)
+{
+    Robot robot = Robot(0, Point(), Vector(1, 0), Angle::zero(), AngularVelocity::zero(),
+                        current_time);
+
+    // A change of 0.5 m/s over half a second is an acceleration of 1 m/s^2, of which
+    // the smoothed estimate takes a fraction
+    robot.updateState(Point(0.5, 0), Vector(1.5, 0), Angle::zero(),
+                      AngularVelocity::zero(), half_second_future);
+
+    EXPECT_LT(0, robot.acceleration().x());
+    EXPECT_GE(1, robot.acceleration().x());
+    EXPECT_DOUBLE_EQ(0, robot.acceleration().y());
+}
+
+TEST_F(RobotTest, update_state_acceleration_is_limited_to_max_acceleration)
+{
+    Robot robot =
+        Robot(0, Point(), Vector(), Angle::zero(), AngularVelocity::zero(), current_time);
+
+    // A change in velocity far faster than the robot could accelerate
+    for (int i = 1; i <= 20; i++)
+    {
+        robot.updateState(Point(), Vector(0, 100 * i), Angle::zero(),
+                          AngularVelocity::zero(), current_time + milliseconds(i));
+    }
+
+    EXPECT_NEAR(ROBOT_MAX_ACCELERATION_METERS_PER_SECOND_SQUARED,
+                robot.acceleration().len(), 0.01);
+}
+
+TEST_F(RobotTest, get_position_and_velocity_at_future_time_with_acceleration)
+{
+    Robot robot = Robot(0, Point(1, 1), Vector(0.5, 0), Angle::zero(),
+                        AngularVelocity::zero(), current_time, Vector(1, 0));
+
+    EXPECT_EQ(Point(2, 1), robot.estimatePositionAtFutureTime(milliseconds(1000)));
+    EXPECT_EQ(Vector(1.5, 0), robot.estimateVelocityAtFutureTime(milliseconds(1000)));
+}
+
+TEST_F(RobotTest,
+       get_position_and_velocity_at_future_time_stops_accelerating_at_max_speed)
+{
+    Robot robot = Robot(0, Point(), Vector(1, 0), Angle::zero(), AngularVelocity::zero(),
+                        current_time, Vector(1, 0));
+
+    // The robot reaches its max speed of 2 m/s after 1 second, having moved 1.5 metres,
+    // and then moves at its max speed for another second
+    EXPECT_EQ(Vector(ROBOT_MAX_SPEED_METERS_PER_SECOND, 0),
+              robot.estimateVelocityAtFutureTime(milliseconds(2000)));
+    EXPECT_EQ(Point(1.5 + ROBOT_MAX_SPEED_METERS_PER_SECOND, 0),
+              robot.estimatePositionAtFutureTime(milliseconds(2000)));
+}
+
+TEST_F(RobotTest, get_position_and_velocity_at_future_time_stops_when_braking)
+{
+    Robot robot = Robot(0, Point(), Vector(1, 0), Angle::zero(), AngularVelocity::zero(),
+                        current_time, Vector(-2, 0));
+
+    // The robot stops after half a second, having moved 0.25 metres, and then stays
+    // there rather than speeding up backwards
+    EXPECT_EQ(Vector(0.5, 0), robot.estimateVelocityAtFutureTime(milliseconds(250)));
+    EXPECT_EQ(Vector(), robot.estimateVelocityAtFutureTime(milliseconds(2000)));
+    EXPECT_EQ(Point(0.25, 0), robot.estimatePositionAtFutureTime(milliseconds(2000)));
+}
+
+TEST_F(RobotTest, update_state_to_predicted_state_after_braking_stays_stopped)
+{
+    Robot robot = Robot(0, Point(), Vector(1, 0), Angle::zero(), AngularVelocity::zero(),
+                        current_time, Vector(-2, 0));
+
+    robot.updateStateToPredictedState(one_second_future);
+
+    EXPECT_EQ(Point(0.25, 0), robot.position());
+    EXPECT_EQ(Vector(), robot.velocity());
+    EXPECT_EQ(Vector(), robot.acceleration());
+    EXPECT_EQ(Point(0.25, 0), robot.estimatePositionAtFutureTime(milliseconds(1000)));
+}
+
+TEST_F(RobotTest, get_position_at_future_time_with_microsecond_resolution)
+{
+    Robot robot = Robot(0, Point(), Vector(2, 0), Angle::zero(), AngularVelocity::zero(),
+                        current_time);
+
+    EXPECT_DOUBLE_EQ(0.0015, robot.estimatePositionAtFutureTime(microseconds(750)).x());
+}
+
+TEST_F(RobotTest, update_state_to_predicted_state_with_acceleration)
+{
+    Robot robot = Robot(0, Point(1, 1), Vector(0.5, 0), Angle::zero(),
+                        AngularVelocity::zero(), current_time, Vector(1, 0));
+
+    robot.updateStateToPredictedState(one_second_future);
+
+    EXPECT_EQ(Point(2, 1), robot.position());
+    EXPECT_EQ(Vector(1.5, 0), robot.velocity());
+    EXPECT_EQ(Vector(1, 0), robot.acceleration());
+}
+
 TEST_F(RobotTest, update_state_to_predicted_state_with_past_timestamp)
 {
     // TODO: Add unit tests to check for thrown exceptions when past timestamps are used
@@ -0,0 +1,98 @@
+#include "ai/world/signed_distance_field.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "test/test_util/test_util.h"
+
+class SignedDistanceFieldTest : public ::testing::Test
+{
+   protected:
+    // Division B: the field is 9m by 6m, with a 0.3m boundary, and the defense areas
+    // are 1m long and 2m wide
+    Field field                  = ::Test::TestUtil::createSSLDivBField();
+    SignedDistanceField distance = SignedDistanceField(field);
+};
+
+TEST_F(SignedDistanceFieldTest, clearance_in_open_field)
+{
+    // Closest to the side of the field, 3.3m away
+    EXPECT_NEAR(3.3, distance.getClearance(Point(0, 0)), 1e-9);
+    // Closest to the front of the friendly defense area
+    EXPECT_NEAR(0.5, distance.getClearance(Point(-3, 0)), 1e-9);
+    // Closest to the end of the field
+    EXPECT_NEAR(0.1, distance.getClearance(Point(4.7, 2.5)), 1e-9);
+}
+
+TEST_F(SignedDistanceFieldTest, clearance_inside_defense_areas_is_negative)
+{
+    // 0.25m behind the front of the friendly defense area
+    EXPECT_NEAR(-0.25, distance.getClearance(Point(-3.75, 0)), 1e-9);
+    // 0.2m inside the side of the enemy defense area
+    EXPECT_NEAR(-0.2, distance.getClearance(Point(4, 0.8)), 1e-9);
+}
+
+TEST_F(SignedDistanceFieldTest, clearance_off_the_field_is_negative)
+{
+    EXPECT_NEAR(-0.5, distance.getClearance(Point(0, 3.8)), 1e-9);
+    EXPECT_NEAR(-std::hypot(0.3, 0.4), distance.getClearance(Point(5.1, -3.7)), 1e-9);
+}
+
+TEST_F(SignedDistanceFieldTest, clearance_matches_exact_calculation)
+{
+    std::mt19937 random_generator(0);
+    std::uniform_real_distribution<double> x(-field.totalLength() / 2,
+                                             field.totalLength() / 2);
+    std::uniform_real_distribution<double> y(-field.totalWidth() / 2,
+                                             field.totalWidth() / 2);
+    for (int i = 0; i < 10000; i++)
+    {
+        const Point point(x(random_generator), y(random_generator));
+        EXPECT_NEAR(SignedDistanceField::calculateClearance(field, point),
+                    distance.getClearance(point), SignedDistanceField::RESOLUTION_METERS)
+            << point;
+    }
+}
+
+TEST_F(SignedDistanceFieldTest, gradient_points_away_from_nearest_obstacle)
+{
+    // In front of the friendly defense area, so away from it is along +x
+    Vector gradient = distance.getGradient(Point(-3, 0.1));
+    EXPECT_NEAR(1, gradient.x(), 1e-9);
+    EXPECT_NEAR(0, gradient.y(), 1e-9);
+
+    // Near the top edge of the field
+    gradient = distance.getGradient(Point(1, 3.1));
+    EXPECT_NEAR(0, gradient.x(), 1e-9);
+    EXPECT_NEAR(-1, gradient.y(), 1e-9);
+
+    // Inside the enemy defense area, near its front
+    gradient = distance.getGradient(Point(3.6, 0.1));
+    EXPECT_NEAR(-1, gradient.x(), 1e-9);
+    EXPECT_NEAR(0, gradient.y(), 1e-9);
+}
+
+TEST_F(SignedDistanceFieldTest, gradient_off_the_field_points_back_onto_it)
+{
+    Vector gradient = distance.getGradient(Point(-6, 0));
+    EXPECT_NEAR(1, gradient.x(), 1e-9);
+    EXPECT_NEAR(0, gradient.y(), 1e-9);
+}
+
+TEST_F(SignedDistanceFieldTest, update_field_geometry_resamples_obstacles)
+{
+    Field bigger_field(12, 9, 1.8, 3.6, 1.2, 0.3, 0.5);
+
+    distance.updateFieldGeometry(bigger_field);
+
+    EXPECT_NEAR(0.8, distance.getClearance(Point(0, 4)), 1e-9);
+    EXPECT_NEAR(-0.3, distance.getClearance(Point(-4.5, 0)), 1e-9);
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,270 @@
+#include "ai/world/spatial_index.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+#include "geom/util.h"
+#include "test/test_util/allocation_counter.h"
+
+using namespace std::chrono;
+
+class SpatialIndexTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        auto epoch       = time_point<std::chrono::steady_clock>();
+        auto since_epoch = std::chrono::seconds(10000);
+
+        // An arbitrary fixed point in time. 10000 seconds after the epoch.
+        // We use this fixed point in time to make the tests deterministic.
+        current_time = epoch + since_epoch;
+    }
+
+    /**
+     * Returns a team with robots at the given positions, with ids in order
+     */
+    Team makeTeam(const std::vector<Point> &positions)
+    {
+        std::vector<Robot> robots;
+        for (unsigned int id = 0; id < positions.size(); id++)
+        {
+            robots.emplace_back(Robot(id, positions[id], Vector(), Angle::zero(),
+                                      AngularVelocity::zero(), current_time));
+        }
+        Team team(milliseconds(1000));
+        team.updateRobots(robots);
+        return team;
+    }
+
+    /**
+     * Returns whether the result contains the given object
+     */
+    static bool contains(const SpatialQueryResult &result, SpatialObjectType type,
+                         unsigned int id)
+    {
+        return std::any_of(result.begin(), result.end(), [&](const SpatialObject &o) {
+            return o.type == type && o.id == id;
+        });
+    }
+
+    // A Division B field, 10.4m by 7.4m including the boundary
+    Field field = Field(9, 6, 1, 2, 1, 0.7, 0.5);
+    steady_clock::time_point current_time;
+};
+
+TEST_F(SpatialIndexTest, empty_index_finds_nothing)
+{
+    SpatialIndex index(field);
+
+    EXPECT_TRUE(index.findKNearest(Point(0, 0), 3).empty());
+    EXPECT_TRUE(index.findWithinRadius(Point(0, 0), 10).empty());
+    EXPECT_TRUE(index.findNearSegment(Seg(Point(-5, -3), Point(5, 3)), 1).empty());
+    EXPECT_TRUE(index.isSegmentClear(Seg(Point(-5, -3), Point(5, 3)), 1));
+}
+
+TEST_F(SpatialIndexTest, k_nearest_are_ordered_by_distance)
+{
+    SpatialIndex index(field);
+    index.updateFriendlyTeam(makeTeam({Point(3, 0), Point(-1, 0)}));
+    index.updateEnemyTeam(makeTeam({Point(0, 2), Point(4, 3)}));
+    index.updateBall(Ball(Point(0.5, 0), Vector(), current_time));
+
+    SpatialQueryResult nearest = index.findKNearest(Point(0, 0), 3);
+    ASSERT_EQ(3, nearest.size());
+    EXPECT_EQ(SPATIAL_BALL, nearest[0].type);
+    EXPECT_EQ(SPATIAL_FRIENDLY_ROBOT, nearest[1].type);
+    EXPECT_EQ(1, nearest[1].id);
+    EXPECT_EQ(SPATIAL_ENEMY_ROBOT, nearest[2].type);
+    EXPECT_EQ(0, nearest[2].id);
+
+    // Asking for more objects than there are finds them all
+    EXPECT_EQ(5, index.findKNearest(Point(0, 0), 10).size());
+}
+
+TEST_F(SpatialIndexTest, queries_only_find_objects_matching_the_filter)
+{
+    SpatialIndex index(field);
+    index.updateFriendlyTeam(makeTeam({Point(3, 0), Point(-1, 0)}));
+    index.updateEnemyTeam(makeTeam({Point(0, 2), Point(4, 3)}));
+    index.updateBall(Ball(Point(0.5, 0), Vector(), current_time));
+
+    SpatialQueryResult nearest_enemy =
+        index.findKNearest(Point(3.5, 2.5), 1, SPATIAL_ENEMY_ROBOT);
+    ASSERT_EQ(1, nearest_enemy.size());
+    EXPECT_EQ(SPATIAL_ENEMY_ROBOT, nearest_enemy[0].type);
+    EXPECT_EQ(1, nearest_enemy[0].id);
+
+    SpatialQueryResult robots_near_ball =
+        index.findWithinRadius(Point(0.5, 0), 3, SPATIAL_FRIENDLY_ROBOT);
+    EXPECT_EQ(2, robots_near_ball.size());
+    EXPECT_TRUE(contains(robots_near_ball, SPATIAL_FRIENDLY_ROBOT, 0));
+    EXPECT_TRUE(contains(robots_near_ball, SPATIAL_FRIENDLY_ROBOT, 1));
+}
+
+TEST_F(SpatialIndexTest, find_within_radius)
+{
+    SpatialIndex index(field);
+    index.updateFriendlyTeam(makeTeam({Point(0, 0), Point(1, 0), Point(1.5, 1.5)}));
+
+    SpatialQueryResult result = index.findWithinRadius(Point(0.2, 0), 1);
+    EXPECT_EQ(2, result.size());
+    EXPECT_TRUE(contains(result, SPATIAL_FRIENDLY_ROBOT, 0));
+    EXPECT_TRUE(contains(result, SPATIAL_FRIENDLY_ROBOT, 1));
+}
+
+TEST_F(SpatialIndexTest, segment_queries)
+{
+    SpatialIndex index(field);
+    index.updateFriendlyTeam(makeTeam({Point(0, 0)}));
+    index.updateEnemyTeam(makeTeam({Point(2, 0.6), Point(-2, -2)}));
+
+    // A diagonal segment passing near the enemy robot
+    Seg diagonal(Point(-1, -1), Point(3, 1));
+    SpatialQueryResult near_diagonal = index.findNearSegment(diagonal, 0.2);
+    EXPECT_EQ(1, near_diagonal.size());
+    EXPECT_TRUE(contains(near_diagonal, SPATIAL_ENEMY_ROBOT, 0));
+    EXPECT_FALSE(index.isSegmentClear(diagonal, 0.2));
+    EXPECT_TRUE(index.isSegmentClear(diagonal, 0.2, SPATIAL_FRIENDLY_ROBOT));
+
+    // A vertical segment through the friendly robot
+    Seg vertical(Point(0, -3), Point(0, 3));
+    EXPECT_FALSE(index.isSegmentClear(vertical, 0.1, SPATIAL_FRIENDLY_ROBOT));
+    EXPECT_TRUE(index.isSegmentClear(vertical, 0.1, SPATIAL_ENEMY_ROBOT));
+}
+
+TEST_F(SpatialIndexTest, objects_off_the_field_are_found)
+{
+    SpatialIndex index(field);
+    index.updateFriendlyTeam(makeTeam({Point(8, 0), Point(0, -6)}));
+
+    EXPECT_EQ(1, index.findWithinRadius(Point(7.5, 0), 1).size());
+    EXPECT_FALSE(index.isSegmentClear(Seg(Point(-1, -6), Point(1, -6)), 0.1));
+    SpatialQueryResult nearest = index.findKNearest(Point(4, 0), 1);
+    ASSERT_EQ(1, nearest.size());
+    EXPECT_EQ(0, nearest[0].id);
+}
+
+TEST_F(SpatialIndexTest, objects_far_off_the_field_are_found)
+{
+    SpatialIndex index(field);
+    index.updateFriendlyTeam(makeTeam({Point(1e300, 0), Point(0, -1e300)}));
+
+    SpatialQueryResult nearest = index.findKNearest(Point(1e300, 0), 1);
+    ASSERT_EQ(1, nearest.size());
+    EXPECT_EQ(0, nearest[0].id);
+    EXPECT_EQ(2, index.findKNearest(Point(std::numeric_limits<double>::infinity(),
+                                          std::numeric_limits<double>::quiet_NaN()),
+                                    2)
+                     .size());
+}
+
+TEST_F(SpatialIndexTest, updates_move_and_remove_robots)
+{
+    SpatialIndex index(field);
+    index.updateFriendlyTeam(makeTeam({Point(0, 0), Point(1, 1)}));
+    index.updateFriendlyTeam(makeTeam({Point(-3, -2)}));
+
+    EXPECT_TRUE(index.findWithinRadius(Point(0.5, 0.5), 1.5).empty());
+    SpatialQueryResult result = index.findWithinRadius(Point(-3, -2), 0.1);
+    ASSERT_EQ(1, result.size());
+    EXPECT_EQ(0, result[0].id);
+}
+
+TEST_F(SpatialIndexTest, changing_the_field_keeps_the_objects)
+{
+    SpatialIndex index(field);
+    index.updateFriendlyTeam(makeTeam({Point(0, 0), Point(5, 3.5)}));
+    index.updateBall(Ball(Point(-1, 1), Vector(), current_time));
+
+    index.updateFieldGeometry(Field(12, 9, 1.2, 2.4, 1.2, 0.3, 0.5));
+
+    EXPECT_EQ(3, index.findWithinRadius(Point(0, 0), 10).size());
+    SpatialQueryResult nearest = index.findKNearest(Point(5, 3), 1);
+    ASSERT_EQ(1, nearest.size());
+    EXPECT_EQ(1, nearest[0].id);
+}
+
+TEST_F(SpatialIndexTest, queries_match_checking_every_object)
+{
+    std::mt19937 random_generator(0);
+    std::uniform_real_distribution<double> x(-6, 6);
+    std::uniform_real_distribution<double> y(-4.5, 4.5);
+    std::uniform_real_distribution<double> radius(0, 2);
+
+    SpatialIndex index(field);
+    for (unsigned int scenario = 0; scenario < 100; scenario++)
+    {
+        std::vector<Point> positions;
+        for (unsigned int id = 0; id < Team::MAX_ROBOT_IDS; id++)
+        {
+            positions.emplace_back(Point(x(random_generator), y(random_generator)));
+        }
+        index.updateFriendlyTeam(makeTeam(positions));
+
+        Point point(x(random_generator), y(random_generator));
+        Seg segment(point, Point(x(random_generator), y(random_generator)));
+        double r = radius(random_generator);
+
+        std::vector<double> distances;
+        for (const Point &position : positions)
+        {
+            distances.emplace_back(dist(position, point));
+        }
+        std::vector<double> sorted_distances = distances;
+        std::sort(sorted_distances.begin(), sorted_distances.end());
+
+        SpatialQueryResult nearest = index.findKNearest(point, 5);
+        ASSERT_EQ(5, nearest.size());
+        for (unsigned int i = 0; i < nearest.size(); i++)
+        {
+            EXPECT_DOUBLE_EQ(sorted_distances[i], distances[nearest[i].id]);
+        }
+
+        SpatialQueryResult within_radius = index.findWithinRadius(point, r);
+        SpatialQueryResult near_segment  = index.findNearSegment(segment, r);
+        for (unsigned int id = 0; id < Team::MAX_ROBOT_IDS; id++)
+        {
+            EXPECT_EQ(distances[id] <= r,
+                      contains(within_radius, SPATIAL_FRIENDLY_ROBOT, id));
+            EXPECT_EQ(distsq(positions[id], segment) <= r * r,
+                      contains(near_segment, SPATIAL_FRIENDLY_ROBOT, id));
+        }
+    }
+}
+
+TEST_F(SpatialIndexTest, updates_and_queries_do_not_allocate)
+{
+    SpatialIndex index(field);
+    Team team       = makeTeam({Point(0, 0), Point(1, 1), Point(2, -1)});
+    Team moved_team = makeTeam({Point(3, 0), Point(1, 1.1)});
+    Ball ball(Point(0.5, 0), Vector(), current_time);
+    SpatialIndex index_copy(field);
+
+    unsigned long num_allocations_before = ::Test::getNumAllocations();
+
+    index.updateFriendlyTeam(team);
+    index.updateEnemyTeam(moved_team);
+    index.updateFriendlyTeam(moved_team);
+    index.updateBall(ball);
+    std::size_t num_found =
+        index.findKNearest(Point(0, 0), 4).size() +
+        index.findWithinRadius(Point(0, 0), 2).size() +
+        index.findNearSegment(Seg(Point(-3, 0), Point(3, 0)), 1).size();
+    bool clear = index.isSegmentClear(Seg(Point(-3, 0), Point(3, 0)), 1);
+    index_copy = index;
+
+    EXPECT_EQ(num_allocations_before, ::Test::getNumAllocations());
+    EXPECT_EQ(4 + 3 + 3, num_found);
+    EXPECT_FALSE(clear);
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
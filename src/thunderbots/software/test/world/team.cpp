@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include "test/test_util/allocation_counter.h"
+
 using namespace std::chrono;
 
 class TeamTest : public ::testing::Test
@@ -425,6 +427,119 @@ TEST_F(TeamTest, equality_operator_teams_with_different_goalie)
     EXPECT_NE(team_0, team_1);
 }
 
+TEST_F(TeamTest, robots_view_iterates_in_order_of_id)
+{
+    Team team = Team(milliseconds(1000));
+
+    Robot robot_0 = Robot(0, Point(0, 1), Vector(-1, -2), Angle::half(),
+                          AngularVelocity::threeQuarter(), current_time);
+
+    Robot robot_3 = Robot(3, Point(3, -1), Vector(), Angle::zero(),
+                          AngularVelocity::zero(), current_time);
+
+    Robot robot_7 = Robot(7, Point(), Vector(-0.5, 4), Angle::quarter(),
+                          AngularVelocity::half(), current_time);
+
+    team.updateRobots({robot_7, robot_0, robot_3});
+
+    std::vector<Robot> viewed_robots;
+    for (const Robot &robot : team.robots())
+    {
+        viewed_robots.emplace_back(robot);
+    }
+
+    EXPECT_EQ(std::vector<Robot>({robot_0, robot_3, robot_7}), viewed_robots);
+    EXPECT_EQ(3, team.robots().size());
+    EXPECT_FALSE(team.robots().empty());
+    EXPECT_TRUE(Team(milliseconds(1000)).robots().empty());
+}
+
+TEST_F(TeamTest, robot_columns_are_indexed_by_id)
+{
+    Team team = Team(milliseconds(1000));
+
+    Robot robot_2 = Robot(2, Point(0, 1), Vector(-1, -2), Angle::half(),
+                          AngularVelocity::threeQuarter(), current_time);
+
+    Robot robot_5 = Robot(5, Point(3, -1), Vector(), Angle::zero(),
+                          AngularVelocity::zero(), current_time);
+
+    team.updateRobots({robot_2, robot_5});
+
+    EXPECT_EQ(0b100100, team.getRobotPresenceMask());
+    EXPECT_TRUE(team.hasRobot(2));
+    EXPECT_TRUE(team.hasRobot(5));
+    EXPECT_FALSE(team.hasRobot(0));
+    EXPECT_FALSE(team.hasRobot(Team::MAX_ROBOT_IDS));
+    EXPECT_EQ(Point(0, 1), team.getRobotPositions()[2]);
+    EXPECT_EQ(Point(3, -1), team.getRobotPositions()[5]);
+    EXPECT_EQ(Vector(-1, -2), team.getRobotVelocities()[2]);
+    EXPECT_EQ(Angle::half(), team.getRobotOrientations()[2]);
+    EXPECT_EQ(AngularVelocity::threeQuarter(), team.getRobotAngularVelocities()[2]);
+    EXPECT_EQ(current_time, team.getRobotLastUpdateTimestamps()[5]);
+}
+
+TEST_F(TeamTest, update_ignores_robots_with_ids_that_are_too_large)
+{
+    Team team = Team(milliseconds(1000));
+
+    Robot robot_0 = Robot(0, Point(0, 1), Vector(-1, -2), Angle::half(),
+                          AngularVelocity::threeQuarter(), current_time);
+
+    Robot robot_too_large = Robot(Team::MAX_ROBOT_IDS, Point(3, -1), Vector(),
+                                  Angle::zero(), AngularVelocity::zero(), current_time);
+
+    team.updateRobots({robot_0, robot_too_large});
+
+    EXPECT_EQ(1, team.numRobots());
+    EXPECT_EQ(robot_0, team.getRobotById(0));
+    EXPECT_EQ(std::nullopt, team.getRobotById(Team::MAX_ROBOT_IDS));
+}
+
+TEST_F(TeamTest, per_tick_updates_and_queries_do_not_allocate)
+{
+    std::vector<Robot> robot_list;
+    std::vector<Robot> updated_robot_list;
+    for (unsigned int id = 0; id < Team::MAX_ROBOT_IDS; id++)
+    {
+        robot_list.emplace_back(Robot(id, Point(id, 1), Vector(-1, 0.5), Angle::half(),
+                                      AngularVelocity::quarter(), current_time));
+        updated_robot_list.emplace_back(Robot(id, Point(id, -1), Vector(1, 0.5),
+                                              Angle::zero(), AngularVelocity::zero(),
+                                              one_second_future));
+    }
+
+    Team team        = Team(milliseconds(1000));
+    Team team_update = Team(milliseconds(1000));
+    Team team_copy   = Team(milliseconds(1000));
+    team.updateRobots(robot_list);
+    team_update.updateRobots(updated_robot_list);
+
+    unsigned long num_allocations_before = ::Test::getNumAllocations();
+
+    team.updateRobots(robot_list);
+    team.updateState(team_update);
+    team.assignGoalie(0);
+    team.updateStateToPredictedState(two_seconds_future);
+    team.removeExpiredRobots(two_seconds_future);
+    team_copy = team;
+
+    double total_x = 0;
+    for (const Robot &robot : team.robots())
+    {
+        total_x += robot.position().x();
+    }
+    bool teams_equal = team == team_copy;
+    auto robot       = team.getRobotById(3);
+    auto goalie      = team.goalie();
+
+    EXPECT_EQ(num_allocations_before, ::Test::getNumAllocations());
+    EXPECT_TRUE(teams_equal);
+    EXPECT_TRUE(robot);
+    EXPECT_TRUE(goalie);
+    EXPECT_LT(0, total_x);
+}
+
 int main(int argc, char **argv)
 {
     std::cout << argv[0] << std::endl;
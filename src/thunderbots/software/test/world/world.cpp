@@ -58,6 +58,100 @@ TEST_F(WorldTest, construction_with_parameters)
     EXPECT_EQ(enemy_team, world.enemyTeam());
 }
 
+TEST_F(WorldTest, get_most_recent_timestamp)
+{
+    Ball ball = Ball(Point(1, 2), Vector(-0.3, 0), current_time);
+
+    Team friendly_team = Team(milliseconds(1000));
+    friendly_team.updateRobots(
+        {Robot(0, Point(0, 1), Vector(), Angle::zero(), AngularVelocity::zero(),
+               current_time + milliseconds(20))});
+
+    Team enemy_team = Team(milliseconds(1000));
+
+    World world =
+        World(::Test::TestUtil::createSSLDivBField(), ball, friendly_team, enemy_team);
+
+    EXPECT_EQ(current_time + milliseconds(20), world.getMostRecentTimestamp());
+}
+
+TEST_F(WorldTest, update_state_to_predicted_state)
+{
+    Ball ball = Ball(Point(1, 2), Vector(-0.3, 0), current_time);
+
+    Robot friendly_robot = Robot(0, Point(0, 1), Vector(1, 0), Angle::zero(),
+                                 AngularVelocity::zero(), current_time);
+    Team friendly_team   = Team(milliseconds(1000));
+    friendly_team.updateRobots({friendly_robot});
+
+    Robot enemy_robot = Robot(3, Point(-1, 0), Vector(0, -1), Angle::zero(),
+                              AngularVelocity::zero(), current_time + milliseconds(50));
+    Team enemy_team   = Team(milliseconds(1000));
+    enemy_team.updateRobots({enemy_robot});
+
+    World world =
+        World(::Test::TestUtil::createSSLDivBField(), ball, friendly_team, enemy_team);
+
+    world.updateStateToPredictedState(current_time + milliseconds(100));
+
+    // The ball rolls, slowing down by 0.35 m/s^2
+    EXPECT_TRUE(world.ball().position().isClose(Point(0.97175, 2), 1e-9));
+    EXPECT_TRUE(world.ball().velocity().isClose(Vector(-0.265, 0), 1e-9));
+    EXPECT_EQ(current_time + milliseconds(100), world.ball().lastUpdateTimestamp());
+    EXPECT_EQ(Point(0.1, 1), world.friendlyTeam().getRobotById(0)->position());
+    EXPECT_EQ(Point(-1, -0.05), world.enemyTeam().getRobotById(3)->position());
+    EXPECT_EQ(current_time + milliseconds(100), world.getMostRecentTimestamp());
+}
+
+TEST_F(WorldTest, spatial_index_follows_updates)
+{
+    Ball ball = Ball(Point(1, 2), Vector(), current_time);
+    World world(::Test::TestUtil::createSSLDivBField(), ball, Team(milliseconds(1000)),
+                Team(milliseconds(1000)));
+
+    Team enemy_team = Team(milliseconds(1000));
+    enemy_team.updateRobots({Robot(3, Point(-1, 0), Vector(), Angle::zero(),
+                                   AngularVelocity::zero(), current_time)});
+    world.updateEnemyTeamState(enemy_team);
+    world.updateBallState(Ball(Point(-1.2, 0), Vector(), current_time));
+
+    SpatialQueryResult nearby = world.spatialIndex().findWithinRadius(Point(-1, 0), 0.5);
+    ASSERT_EQ(2, nearby.size());
+    SpatialQueryResult nearest_enemy =
+        world.spatialIndex().findKNearest(Point(0, 0), 1, SPATIAL_ENEMY_ROBOT);
+    ASSERT_EQ(1, nearest_enemy.size());
+    EXPECT_EQ(3, nearest_enemy[0].id);
+}
+
+TEST_F(WorldTest, signed_distance_field_rebuilt_when_field_geometry_changes)
+{
+    Ball ball = Ball(Point(1, 2), Vector(), current_time);
+    World world(::Test::TestUtil::createSSLDivBField(), ball, Team(milliseconds(1000)),
+                Team(milliseconds(1000)));
+    EXPECT_NEAR(0.5, world.signedDistanceField().getClearance(Point(-3, 0)), 1e-9);
+
+    // Make the defense areas half a metre longer
+    world.updateFieldGeometry(Field(9.0, 6.0, 1.5, 2.0, 1.0, 0.3, 0.5));
+
+    EXPECT_NEAR(0, world.signedDistanceField().getClearance(Point(-3, 0)), 1e-9);
+}
+
+TEST_F(WorldTest, copies_share_signed_distance_field_until_field_geometry_changes)
+{
+    Ball ball = Ball(Point(1, 2), Vector(), current_time);
+    World world(::Test::TestUtil::createSSLDivBField(), ball, Team(milliseconds(1000)),
+                Team(milliseconds(1000)));
+
+    World copy = world;
+    EXPECT_EQ(&world.signedDistanceField(), &copy.signedDistanceField());
+
+    world.updateFieldGeometry(Field(9.0, 6.0, 1.5, 2.0, 1.0, 0.3, 0.5));
+
+    // The copy keeps the distances for the field it has
+    EXPECT_NE(&world.signedDistanceField(), &copy.signedDistanceField());
+    EXPECT_NEAR(0.5, copy.signedDistanceField().getClearance(Point(-3, 0)), 1e-9);
+}
+
 int main(int argc, char **argv)
 {
     std::cout << argv[0] << std::endl;
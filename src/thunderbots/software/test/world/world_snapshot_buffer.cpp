@@ -0,0 +1,143 @@
+#include "ai/world/world_snapshot_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "test/test_util/test_util.h"
+
+using namespace std::chrono;
+
+class WorldSnapshotBufferTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        // An arbitrary fixed point in time. 10000 seconds after the epoch.
+        current_time = steady_clock::time_point() + seconds(10000);
+    }
+
+    World createWorld()
+    {
+        return World(::Test::TestUtil::createSSLDivBField(),
+                     Ball(Point(), Vector(), current_time), Team(milliseconds(1000)),
+                     Team(milliseconds(1000)));
+    }
+
+    steady_clock::time_point current_time;
+};
+
+TEST_F(WorldSnapshotBufferTest, initial_world_is_the_first_snapshot)
+{
+    WorldSnapshotBuffer buffer(createWorld());
+
+    EXPECT_FALSE(buffer.hasNewSnapshot());
+    EXPECT_EQ(createWorld().field(), buffer.getLatestSnapshot().field());
+    EXPECT_EQ(0, buffer.getSnapshotVersion());
+}
+
+TEST_F(WorldSnapshotBufferTest, updates_are_not_visible_until_published)
+{
+    WorldSnapshotBuffer buffer(createWorld());
+
+    buffer.updateBallState(Ball(Point(1, 2), Vector(), current_time));
+
+    EXPECT_FALSE(buffer.hasNewSnapshot());
+    EXPECT_EQ(Point(), buffer.getLatestSnapshot().ball().position());
+
+    EXPECT_TRUE(buffer.publish());
+
+    EXPECT_TRUE(buffer.hasNewSnapshot());
+    EXPECT_EQ(Point(1, 2), buffer.getLatestSnapshot().ball().position());
+    EXPECT_EQ(1, buffer.getSnapshotVersion());
+    EXPECT_FALSE(buffer.hasNewSnapshot());
+}
+
+TEST_F(WorldSnapshotBufferTest, nothing_is_published_if_nothing_changed)
+{
+    WorldSnapshotBuffer buffer(createWorld());
+
+    // The same field geometry as the initial world is not a change
+    buffer.updateFieldGeometry(::Test::TestUtil::createSSLDivBField());
+
+    EXPECT_FALSE(buffer.publish());
+    EXPECT_FALSE(buffer.hasNewSnapshot());
+}
+
+TEST_F(WorldSnapshotBufferTest, snapshot_does_not_change_while_it_is_being_used)
+{
+    WorldSnapshotBuffer buffer(createWorld());
+    buffer.updateBallState(Ball(Point(1, 0), Vector(), current_time));
+    buffer.publish();
+
+    const World &snapshot = buffer.getLatestSnapshot();
+
+    // Publish enough snapshots to cycle through every buffer
+    for (int i = 2; i < 10; i++)
+    {
+        buffer.updateBallState(Ball(Point(i, 0), Vector(), current_time));
+        buffer.publish();
+    }
+
+    EXPECT_EQ(Point(1, 0), snapshot.ball().position());
+    EXPECT_EQ(Point(9, 0), buffer.getLatestSnapshot().ball().position());
+}
+
+TEST_F(WorldSnapshotBufferTest, every_change_since_a_buffer_was_last_written_is_copied)
+{
+    WorldSnapshotBuffer buffer(createWorld());
+
+    // Each of these is published into a different buffer, so the buffer the last
+    // snapshot is written into has missed the earlier changes
+    buffer.updateBallState(Ball(Point(1, 0), Vector(), current_time));
+    buffer.publish();
+    Robot robot = Robot(3, Point(-1, 0), Vector(), Angle::zero(), AngularVelocity::zero(),
+                        current_time);
+    Team friendly_team = Team(milliseconds(1000));
+    friendly_team.updateRobots({robot});
+    buffer.updateFriendlyTeamState(friendly_team);
+    buffer.publish();
+    buffer.updateEnemyTeamState(friendly_team);
+    buffer.publish();
+
+    const World &snapshot = buffer.getLatestSnapshot();
+    EXPECT_EQ(Point(1, 0), snapshot.ball().position());
+    EXPECT_EQ(1, snapshot.friendlyTeam().numRobots());
+    EXPECT_EQ(1, snapshot.enemyTeam().numRobots());
+    EXPECT_EQ(3, buffer.getSnapshotVersion());
+}
+
+TEST_F(WorldSnapshotBufferTest, snapshots_are_coherent_across_threads)
+{
+    WorldSnapshotBuffer buffer(createWorld());
+    static constexpr int NUM_SNAPSHOTS = 20000;
+
+    // The ball's position and velocity are always updated together, so a coherent
+    // snapshot always has them equal
+    std::thread ingest_thread([&]() {
+        for (int i = 1; i <= NUM_SNAPSHOTS; i++)
+        {
+            buffer.updateBallState(Ball(Point(i, 0), Vector(i, 0), current_time));
+            buffer.publish();
+        }
+    });
+
+    uint64_t last_version = 0;
+    while (last_version < NUM_SNAPSHOTS)
+    {
+        const World &snapshot = buffer.getLatestSnapshot();
+        ASSERT_EQ(snapshot.ball().position().x(), snapshot.ball().velocity().x());
+        ASSERT_GE(buffer.getSnapshotVersion(), last_version);
+        last_version = buffer.getSnapshotVersion();
+    }
+
+    ingest_thread.join();
+    EXPECT_EQ(Point(NUM_SNAPSHOTS, 0), buffer.getLatestSnapshot().ball().position());
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << argv[0] << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
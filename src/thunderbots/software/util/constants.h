@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <string>
 
 #include "../ai/world/team.h"
@@ -16,6 +17,7 @@ namespace Util
         static const std::string NETWORK_INPUT_ENEMY_TEAM_TOPIC = "backend/enemy_team";
         static const std::string AI_PRIMITIVES_TOPIC            = "backend/primitives";
         static const std::string ROBOT_STATUS_TOPIC             = "log/robot_status";
+        static const std::string DIAGNOSTICS_METRICS_TOPIC      = "diagnostics/metrics";
 
         // TODO: Make this a tuneable parameter
         static const TeamColour FRIENDLY_TEAM_COLOUR = YELLOW;
@@ -26,5 +28,42 @@ namespace Util
 
         // There are 4 cameras for SSL Division B
         static const unsigned int NUMBER_OF_SSL_VISION_CAMERAS = 4;
+        // How long to wait for the rest of the cameras to report after the first camera
+        // of a vision tick reports, before publishing the data we have. SSL Vision runs
+        // at 60Hz, so this is a bit over half a vision tick
+        static const std::chrono::milliseconds SSL_VISION_FRAME_ASSEMBLY_TIMEOUT(10);
+        // The longest network_input waits for an SSL Vision packet before checking for
+        // frames that have timed out. This is well under the frame assembly timeout so
+        // timed out frames aren't held much longer than the timeout
+        static const std::chrono::milliseconds SSL_VISION_PACKET_WAIT_TIMEOUT(2);
+        // Detections from different cameras closer together than this distance are
+        // considered to be the same object
+        static const double SSL_VISION_CAMERA_OVERLAP_MERGE_DISTANCE_METERS = 0.1;
+
+        // AI ticks
+        // When ticking on new data, the default for the longest the AI waits for new data
+        // before ticking anyway, so it keeps acting on its predictions if vision stops
+        static const std::chrono::milliseconds AI_DEFAULT_MAX_TICK_PERIOD(50);
+        // The default rate the AI ticks at when ticking at a fixed rate
+        static const double AI_DEFAULT_FIXED_TICK_RATE_HZ = 60.0;
+        // The default for how long each AI tick may take. SSL Vision runs at 60Hz, so
+        // this leaves some of each vision tick for sending the commands
+        static const std::chrono::milliseconds AI_DEFAULT_TICK_DEADLINE(10);
+        // The default time from the AI publishing primitives to the robots acting on
+        // them, for sending the commands and the robots' own delays
+        static const std::chrono::milliseconds DEFAULT_ROBOT_COMMAND_LATENCY(20);
+        // The furthest ahead of the latest data the AI predicts the world. A larger gap
+        // between the data and when the commands take effect means the vision and AI
+        // clocks are not synchronized, or a recording is being replayed
+        static const std::chrono::milliseconds AI_MAX_PREDICTION_TIME(200);
+
+        // Diagnostics
+        // How often each node logs a report of the latencies it has measured
+        static const std::chrono::seconds LATENCY_REPORT_PERIOD(10);
+        // How often each node exports a snapshot of its metrics
+        static const std::chrono::seconds METRICS_EXPORT_PERIOD(1);
+        // The directory each node writes the latest snapshot of its metrics to, in a
+        // file named <node name>_metrics.txt
+        static const std::string METRICS_FILE_DIRECTORY = "/tmp";
     }  // namespace Constants
 }  // namespace Util
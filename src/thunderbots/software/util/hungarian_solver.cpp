@@ -0,0 +1,116 @@
+#include "util/hungarian_solver.h"
+
+#include <limits>
+
+HungarianSolver::HungarianSolver()
+    : num_rows(0),
+      num_columns(0),
+      costs(),
+      row_potentials(),
+      column_potentials(),
+      column_rows(),
+      previous_columns(),
+      min_slacks(),
+      visited_columns(),
+      row_columns(),
+      total_cost(0)
+{
+}
+
+void HungarianSolver::reset(std::size_t num_rows, std::size_t num_columns)
+{
+    this->num_rows    = num_rows;
+    this->num_columns = num_columns;
+    costs.fill(0);
+}
+
+void HungarianSolver::setCost(std::size_t row, std::size_t column, double cost)
+{
+    costs[(row + 1) * ARRAY_SIZE + column + 1] = cost;
+}
+
+void HungarianSolver::solve()
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+    row_potentials.fill(0);
+    column_potentials.fill(0);
+    column_rows.fill(0);
+    previous_columns.fill(0);
+
+    // Add the rows one at a time, each time finding the shortest path of reduced costs
+    // from the new row to a free column, and flipping the assignments along it
+    for (std::size_t row = 1; row <= num_rows; row++)
+    {
+        column_rows[0]     = row;
+        std::size_t column = 0;
+        min_slacks.fill(infinity);
+        visited_columns.fill(false);
+        do
+        {
+            visited_columns[column]      = true;
+            const std::size_t column_row = column_rows[column];
+            double delta                 = infinity;
+            std::size_t next_column      = 0;
+            for (std::size_t j = 1; j <= num_columns; j++)
+            {
+                if (visited_columns[j])
+                {
+                    continue;
+                }
+                const double slack = costs[column_row * ARRAY_SIZE + j] -
+                                     row_potentials[column_row] - column_potentials[j];
+                if (slack < min_slacks[j])
+                {
+                    min_slacks[j]       = slack;
+                    previous_columns[j] = column;
+                }
+                if (min_slacks[j] < delta)
+                {
+                    delta       = min_slacks[j];
+                    next_column = j;
+                }
+            }
+            for (std::size_t j = 0; j <= num_columns; j++)
+            {
+                if (visited_columns[j])
+                {
+                    row_potentials[column_rows[j]] += delta;
+                    column_potentials[j] -= delta;
+                }
+                else
+                {
+                    min_slacks[j] -= delta;
+                }
+            }
+            column = next_column;
+        } while (column_rows[column] != 0);
+
+        // Flip the assignments along the path back to the new row
+        do
+        {
+            const std::size_t previous_column = previous_columns[column];
+            column_rows[column]               = column_rows[previous_column];
+            column                            = previous_column;
+        } while (column != 0);
+    }
+
+    total_cost = 0;
+    for (std::size_t j = 1; j <= num_columns; j++)
+    {
+        if (column_rows[j] != 0)
+        {
+            row_columns[column_rows[j] - 1] = j - 1;
+            total_cost += costs[column_rows[j] * ARRAY_SIZE + j];
+        }
+    }
+}
+
+std::size_t HungarianSolver::getAssignedColumn(std::size_t row) const
+{
+    return row_columns[row];
+}
+
+double HungarianSolver::getTotalCost() const
+{
+    return total_cost;
+}
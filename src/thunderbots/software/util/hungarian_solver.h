@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/**
+ * Solves the assignment problem: given the cost of assigning each of a set of rows
+ * (such as tactics) to each of a set of columns (such as robots), finds the assignment
+ * of every row to a different column with the lowest total cost.
+ *
+ * This uses the O(n^2 m) Hungarian algorithm for n rows and m columns, keeping a
+ * potential for each row and column so each row is added to the assignment with one
+ * shortest path search. All storage is fixed-size arrays inside the solver, so solving
+ * never allocates, and one solver can be reused for every problem.
+ */
+class HungarianSolver final
+{
+   public:
+    // The largest number of rows or columns a problem can have
+    static constexpr std::size_t MAX_SIZE = 16;
+
+    /**
+     * Creates a new HungarianSolver for a problem with no rows or columns
+     */
+    explicit HungarianSolver();
+
+    /**
+     * Starts a new problem of the given size. Every cost is reset to zero
+     *
+     * @param num_rows The number of rows to assign. Must be no more than num_columns
+     * @param num_columns The number of columns to assign the rows to. Must be no more
+     * than MAX_SIZE
+     */
+    void reset(std::size_t num_rows, std::size_t num_columns);
+
+    /**
+     * Sets the cost of assigning the given row to the given column
+     *
+     * @param row The row. Must be less than the number of rows
+     * @param column The column. Must be less than the number of columns
+     * @param cost The cost of assigning the row to the column
+     */
+    void setCost(std::size_t row, std::size_t column, double cost);
+
+    /**
+     * Finds the assignment of every row to a different column with the lowest total
+     * cost. Ties are broken consistently, so the same costs always give the same
+     * assignment
+     */
+    void solve();
+
+    /**
+     * Returns the column the given row was assigned to by the last call to solve()
+     *
+     * @param row The row. Must be less than the number of rows
+     *
+     * @return the column the row was assigned to
+     */
+    std::size_t getAssignedColumn(std::size_t row) const;
+
+    /**
+     * Returns the total cost of the assignment found by the last call to solve()
+     *
+     * @return the total cost of the assignment
+     */
+    double getTotalCost() const;
+
+   private:
+    // The algorithm numbers rows and columns from 1, so index 0 can stand for the row
+    // being added and the column it starts its search from
+    static constexpr std::size_t ARRAY_SIZE = MAX_SIZE + 1;
+
+    std::size_t num_rows;
+    std::size_t num_columns;
+    // The costs, indexed by (row + 1) * ARRAY_SIZE + column + 1
+    std::array<double, ARRAY_SIZE * ARRAY_SIZE> costs;
+    std::array<double, ARRAY_SIZE> row_potentials;
+    std::array<double, ARRAY_SIZE> column_potentials;
+    // The row assigned to each column, or 0 if it has no row
+    std::array<std::size_t, ARRAY_SIZE> column_rows;
+    // The column before each column on the shortest path found so far
+    std::array<std::size_t, ARRAY_SIZE> previous_columns;
+    std::array<double, ARRAY_SIZE> min_slacks;
+    std::array<bool, ARRAY_SIZE> visited_columns;
+    // The column assigned to each row, found from column_rows after solving
+    std::array<std::size_t, MAX_SIZE> row_columns;
+    double total_cost;
+};
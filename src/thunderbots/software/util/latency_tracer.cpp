@@ -0,0 +1,72 @@
+#include "util/latency_tracer.h"
+
+#include <cmath>
+#include <sstream>
+
+LatencyTracer::LatencyTracer(const std::vector<std::string> &stage_names,
+                             const AITimestamp &report_period)
+    : stage_names(stage_names),
+      stage_histograms(),
+      report_period(report_period),
+      last_report_time(std::nullopt)
+{
+    const std::vector<double> bucket_bounds_us =
+        MetricHistogram::createExponentialBucketBounds(
+            1, std::exp2(1.0 / BUCKETS_PER_DOUBLING),
+            BUCKETS_PER_DOUBLING * NUM_DOUBLINGS + 1);
+    for (std::size_t i = 0; i < stage_names.size(); i++)
+    {
+        stage_histograms.emplace_back(
+            std::make_unique<MetricHistogram>(bucket_bounds_us));
+    }
+}
+
+void LatencyTracer::recordLatency(std::size_t stage, const AITimestamp &latency)
+{
+    stage_histograms.at(stage)->record(
+        std::chrono::duration<double, std::micro>(latency).count());
+}
+
+const MetricHistogram &LatencyTracer::getHistogram(std::size_t stage) const
+{
+    return *stage_histograms.at(stage);
+}
+
+std::string LatencyTracer::createReport() const
+{
+    std::ostringstream report;
+    report << "Latencies (us):";
+    for (std::size_t i = 0; i < stage_names.size(); i++)
+    {
+        const MetricHistogram &histogram = *stage_histograms[i];
+        report << " " << stage_names[i] << " [n=" << histogram.getCount()
+               << " p50=" << std::llround(histogram.getPercentile(0.5))
+               << " p99=" << std::llround(histogram.getPercentile(0.99))
+               << " max=" << std::llround(histogram.getMax()) << "]";
+    }
+
+    return report.str();
+}
+
+std::optional<std::string> LatencyTracer::getPeriodicReport(const AITimestamp &now)
+{
+    if (!last_report_time)
+    {
+        last_report_time = now;
+        return std::nullopt;
+    }
+
+    if (now - *last_report_time < report_period)
+    {
+        return std::nullopt;
+    }
+
+    std::string report = createReport();
+    for (const std::unique_ptr<MetricHistogram> &histogram : stage_histograms)
+    {
+        histogram->reset();
+    }
+    last_report_time = now;
+
+    return report;
+}
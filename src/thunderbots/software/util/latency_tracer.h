@@ -0,0 +1,82 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "util/metrics/metrics.h"
+#include "util/timestamp.h"
+
+/**
+ * Keeps a histogram of latencies in microseconds for each stage of a node's part of the
+ * pipeline from SSL Vision capturing a frame to a command being sent to the robots, and
+ * periodically produces a report of the p50, p99 and max latency of each stage.
+ *
+ * Stages are identified by their index in the list of names the tracer was created
+ * with, so nodes usually keep an enum of their stages in the same order.
+ */
+class LatencyTracer
+{
+   public:
+    // The histogram buckets grow by 2^(1/BUCKETS_PER_DOUBLING) each, from 1us up to
+    // 2^NUM_DOUBLINGS us (about 16 seconds), so percentiles are accurate to within 9%.
+    // Anything under 1us, including negative latencies caused by the clocks of
+    // different machines being out of sync, is counted in the first bucket
+    static constexpr std::size_t BUCKETS_PER_DOUBLING = 8;
+    static constexpr std::size_t NUM_DOUBLINGS        = 24;
+
+    /**
+     * Creates a new LatencyTracer
+     *
+     * @param stage_names The name of each stage, in the order of their indices
+     * @param report_period How often getPeriodicReport() returns a report
+     */
+    explicit LatencyTracer(const std::vector<std::string> &stage_names,
+                           const AITimestamp &report_period);
+
+    /**
+     * Records a latency measured for the given stage
+     *
+     * @param stage The index of the stage
+     * @param latency The latency measured
+     */
+    void recordLatency(std::size_t stage, const AITimestamp &latency);
+
+    /**
+     * Returns the histogram of the latencies recorded for the given stage since the
+     * last report
+     *
+     * @param stage The index of the stage
+     *
+     * @return the histogram of the latencies recorded for the given stage, in
+     * microseconds
+     */
+    const MetricHistogram &getHistogram(std::size_t stage) const;
+
+    /**
+     * Returns a one line report of the p50, p99 and max latency of every stage
+     *
+     * @return a report of the latencies recorded for every stage since the last
+     * periodic report
+     */
+    std::string createReport() const;
+
+    /**
+     * If a report period has passed since the last periodic report, creates a report
+     * and resets the histograms so the next report only covers the next period. The
+     * first period starts the first time this is called
+     *
+     * @param now The current time
+     *
+     * @return a report if one is due, and std::nullopt otherwise
+     */
+    std::optional<std::string> getPeriodicReport(const AITimestamp &now);
+
+   private:
+    std::vector<std::string> stage_names;
+    // Histograms can't be moved, so they are kept by pointer
+    std::vector<std::unique_ptr<MetricHistogram>> stage_histograms;
+    AITimestamp report_period;
+    std::optional<AITimestamp> last_report_time;
+};
@@ -0,0 +1,128 @@
+#include "util/metrics/metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+MetricHistogram::MetricHistogram(const std::vector<double>& bucket_upper_bounds)
+    : bucket_upper_bounds(bucket_upper_bounds),
+      bucket_counts(new std::atomic<uint64_t>[bucket_upper_bounds.size() + 1]),
+      count(0),
+      sum(0),
+      max(std::numeric_limits<double>::lowest())
+{
+    if (bucket_upper_bounds.empty() ||
+        std::adjacent_find(bucket_upper_bounds.begin(), bucket_upper_bounds.end(),
+                           std::greater_equal<double>()) != bucket_upper_bounds.end())
+    {
+        throw std::invalid_argument(
+            "MetricHistogram bucket bounds must be non-empty and increasing");
+    }
+
+    for (std::size_t i = 0; i <= bucket_upper_bounds.size(); i++)
+    {
+        bucket_counts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+std::vector<double> MetricHistogram::createExponentialBucketBounds(
+    double first_bound, double factor, std::size_t num_buckets)
+{
+    std::vector<double> bounds;
+    bounds.reserve(num_buckets);
+    double bound = first_bound;
+    for (std::size_t i = 0; i < num_buckets; i++)
+    {
+        bounds.emplace_back(bound);
+        bound *= factor;
+    }
+
+    return bounds;
+}
+
+void MetricHistogram::record(double value)
+{
+    std::size_t bucket_index = static_cast<std::size_t>(
+        std::lower_bound(bucket_upper_bounds.begin(), bucket_upper_bounds.end(), value) -
+        bucket_upper_bounds.begin());
+    bucket_counts[bucket_index].fetch_add(1, std::memory_order_relaxed);
+
+    // There is no atomic add or max for doubles, so we retry until no other thread
+    // has changed the value between us reading and writing it
+    double old_sum = sum.load(std::memory_order_relaxed);
+    while (
+        !sum.compare_exchange_weak(old_sum, old_sum + value, std::memory_order_relaxed))
+    {
+    }
+
+    double old_max = max.load(std::memory_order_relaxed);
+    while (value > old_max &&
+           !max.compare_exchange_weak(old_max, value, std::memory_order_relaxed))
+    {
+    }
+
+    count.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t MetricHistogram::getCount() const
+{
+    return count.load(std::memory_order_relaxed);
+}
+
+double MetricHistogram::getMean() const
+{
+    uint64_t num_values = getCount();
+    return num_values == 0
+               ? 0.0
+               : sum.load(std::memory_order_relaxed) / static_cast<double>(num_values);
+}
+
+double MetricHistogram::getMax() const
+{
+    return getCount() == 0 ? 0.0 : max.load(std::memory_order_relaxed);
+}
+
+double MetricHistogram::getPercentile(double percentile) const
+{
+    // The buckets may be updated while we read them, so we work from their total
+    // rather than the count
+    uint64_t total = 0;
+    for (std::size_t i = 0; i <= bucket_upper_bounds.size(); i++)
+    {
+        total += bucket_counts[i].load(std::memory_order_relaxed);
+    }
+    if (total == 0)
+    {
+        return 0.0;
+    }
+
+    // The number of the value we want, if they were sorted from smallest to largest,
+    // counting from 1
+    auto rank = static_cast<uint64_t>(
+        std::ceil(std::clamp(percentile, 0.0, 1.0) * static_cast<double>(total)));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t num_seen = 0;
+    for (std::size_t i = 0; i < bucket_upper_bounds.size(); i++)
+    {
+        num_seen += bucket_counts[i].load(std::memory_order_relaxed);
+        if (num_seen >= rank)
+        {
+            return std::min(bucket_upper_bounds[i], getMax());
+        }
+    }
+
+    return getMax();
+}
+
+void MetricHistogram::reset()
+{
+    for (std::size_t i = 0; i <= bucket_upper_bounds.size(); i++)
+    {
+        bucket_counts[i].store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    max.store(std::numeric_limits<double>::lowest(), std::memory_order_relaxed);
+}
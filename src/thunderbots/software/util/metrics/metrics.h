@@ -0,0 +1,181 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * The metrics in this file are meant to be updated from the hot paths of a node, such
+ * as the code handling every packet or every AI tick. Updating them never locks or
+ * allocates, and they can safely be updated from any thread while a snapshot of them
+ * is being taken from another.
+ *
+ * Updates use relaxed atomic operations, so a snapshot taken while a metric is being
+ * updated may see some updates but not others. This is fine for monitoring, which
+ * only cares about the overall trend.
+ */
+
+/**
+ * A count of how many times something has happened, such as packets received.
+ * Counters only go up.
+ */
+class MetricCounter
+{
+   public:
+    /**
+     * Creates a new MetricCounter starting at 0
+     */
+    explicit MetricCounter() : value(0) {}
+
+    /**
+     * Adds the given amount to the counter
+     *
+     * @param amount The amount to add
+     */
+    void increment(uint64_t amount = 1)
+    {
+        value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * Returns the current value of the counter
+     *
+     * @return the current value of the counter
+     */
+    uint64_t get() const
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+
+   private:
+    std::atomic<uint64_t> value;
+};
+
+/**
+ * The latest value of something that can go up or down, such as the number of robots
+ * on a team
+ */
+class MetricGauge
+{
+   public:
+    /**
+     * Creates a new MetricGauge starting at 0
+     */
+    explicit MetricGauge() : value(0) {}
+
+    /**
+     * Sets the value of the gauge
+     *
+     * @param new_value The new value of the gauge
+     */
+    void set(double new_value)
+    {
+        value.store(new_value, std::memory_order_relaxed);
+    }
+
+    /**
+     * Returns the current value of the gauge
+     *
+     * @return the current value of the gauge
+     */
+    double get() const
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+
+   private:
+    std::atomic<double> value;
+};
+
+/**
+ * The distribution of a measured value, such as how long it takes to process a packet.
+ *
+ * Values are counted in buckets with fixed upper bounds that are chosen when the
+ * histogram is created, so percentiles are only as accurate as the buckets are
+ * narrow. Values larger than the largest bound are counted in an extra overflow
+ * bucket.
+ */
+class MetricHistogram
+{
+   public:
+    /**
+     * Creates a new, empty MetricHistogram
+     *
+     * @param bucket_upper_bounds The inclusive upper bound of each bucket, in
+     * increasing order
+     *
+     * @throws std::invalid_argument if the bounds are empty or not increasing
+     */
+    explicit MetricHistogram(const std::vector<double>& bucket_upper_bounds);
+
+    /**
+     * Returns bucket upper bounds that grow exponentially, which give percentiles
+     * with the same relative accuracy over a wide range of values
+     *
+     * @param first_bound The upper bound of the first bucket. Must be > 0
+     * @param factor How much larger each bound is than the one before it. Must be > 1
+     * @param num_buckets The number of buckets
+     *
+     * @return the upper bounds of the buckets
+     */
+    static std::vector<double> createExponentialBucketBounds(double first_bound,
+                                                             double factor,
+                                                             std::size_t num_buckets);
+
+    /**
+     * Adds a value to the histogram
+     *
+     * @param value The value to add
+     */
+    void record(double value);
+
+    /**
+     * Returns the number of values recorded
+     *
+     * @return the number of values recorded
+     */
+    uint64_t getCount() const;
+
+    /**
+     * Returns the mean of the values recorded
+     *
+     * @return the mean of the values recorded, or 0 if nothing has been recorded
+     */
+    double getMean() const;
+
+    /**
+     * Returns the largest value recorded
+     *
+     * @return the largest value recorded, or 0 if nothing has been recorded
+     */
+    double getMax() const;
+
+    /**
+     * Returns the given percentile of the values recorded. This is the upper bound of
+     * the bucket the percentile falls in, or the largest value recorded if that is
+     * smaller or the percentile falls in the overflow bucket
+     *
+     * @param percentile The percentile to find, in the range [0, 1]
+     *
+     * @return the given percentile of the values recorded, or 0 if nothing has been
+     * recorded
+     */
+    double getPercentile(double percentile) const;
+
+    /**
+     * Removes all recorded values from the histogram. Values recorded by other threads
+     * while this runs may be partly kept, so this should only be used by histograms
+     * that are recorded and reset from the same thread
+     */
+    void reset();
+
+   private:
+    std::vector<double> bucket_upper_bounds;
+    // One count for each bucket, plus the overflow bucket. Atomics can't be stored in
+    // a vector since they can't be moved, so these are allocated once up front
+    std::unique_ptr<std::atomic<uint64_t>[]> bucket_counts;
+    std::atomic<uint64_t> count;
+    std::atomic<double> sum;
+    std::atomic<double> max;
+};
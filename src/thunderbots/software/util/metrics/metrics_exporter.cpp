@@ -0,0 +1,103 @@
+#include "util/metrics/metrics_exporter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+MetricsExporter::MetricsExporter(const MetricsRegistry &registry,
+                                 const AITimestamp &export_period)
+    : registry(registry),
+      export_period(export_period),
+      last_export_time(std::nullopt),
+      last_counter_values()
+{
+}
+
+std::optional<std::vector<MetricSample>> MetricsExporter::getPeriodicSnapshot(
+    const AITimestamp &now)
+{
+    if (last_export_time && now - *last_export_time < export_period)
+    {
+        return std::nullopt;
+    }
+
+    std::vector<MetricSample> snapshot = registry.getSnapshot();
+
+    std::vector<MetricSample> counter_rates;
+    for (const MetricSample &sample : snapshot)
+    {
+        if (!sample.is_counter)
+        {
+            continue;
+        }
+
+        auto last_value = last_counter_values.find(sample.name);
+        if (last_export_time && last_value != last_counter_values.end())
+        {
+            double seconds_elapsed =
+                std::chrono::duration<double>(now - *last_export_time).count();
+            counter_rates.emplace_back(MetricSample{
+                sample.name + ".per_second",
+                (sample.value - last_value->second) / seconds_elapsed, false});
+        }
+        last_counter_values[sample.name] = sample.value;
+    }
+
+    snapshot.insert(snapshot.end(), counter_rates.begin(), counter_rates.end());
+    std::sort(
+        snapshot.begin(), snapshot.end(),
+        [](const MetricSample &a, const MetricSample &b) { return a.name < b.name; });
+    last_export_time = now;
+
+    return snapshot;
+}
+
+std::string MetricsExporter::createTextSnapshot(const std::string &node_name,
+                                                const std::vector<MetricSample> &snapshot)
+{
+    std::ostringstream text;
+    text << "# Metrics for " << node_name << std::endl;
+    for (const MetricSample &sample : snapshot)
+    {
+        text << sample.name << " " << sample.value << std::endl;
+    }
+
+    return text.str();
+}
+
+bool MetricsExporter::writeSnapshotToFile(const std::string &file_path,
+                                          const std::string &node_name,
+                                          const std::vector<MetricSample> &snapshot)
+{
+    // We write to a temporary file and rename it over the real one, since renaming is
+    // atomic
+    std::string temporary_file_path = file_path + ".tmp";
+    {
+        std::ofstream file(temporary_file_path, std::ios::trunc);
+        file << createTextSnapshot(node_name, snapshot);
+        if (!file)
+        {
+            return false;
+        }
+    }
+
+    return std::rename(temporary_file_path.c_str(), file_path.c_str()) == 0;
+}
+
+thunderbots_msgs::Metrics MetricsExporter::createMetricsMsg(
+    const std::string &node_name, const std::vector<MetricSample> &snapshot)
+{
+    thunderbots_msgs::Metrics metrics_msg;
+    metrics_msg.node_name = node_name;
+    metrics_msg.metrics.reserve(snapshot.size());
+    for (const MetricSample &sample : snapshot)
+    {
+        thunderbots_msgs::Metric metric_msg;
+        metric_msg.name  = sample.name;
+        metric_msg.value = sample.value;
+        metrics_msg.metrics.emplace_back(metric_msg);
+    }
+
+    return metrics_msg;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "thunderbots_msgs/Metrics.h"
+#include "util/metrics/metrics_registry.h"
+#include "util/timestamp.h"
+
+/**
+ * Periodically takes snapshots of a MetricsRegistry so they can be exported, and
+ * writes them to text files.
+ *
+ * Each snapshot also includes how fast each counter went up since the previous
+ * snapshot, as a sample named <counter>.per_second, so rates such as packets per
+ * second don't have to be calculated by whatever reads the snapshot.
+ */
+class MetricsExporter
+{
+   public:
+    /**
+     * Creates a new MetricsExporter
+     *
+     * @param registry The registry to take snapshots of. Must outlive the exporter
+     * @param export_period How often getPeriodicSnapshot() returns a snapshot
+     */
+    explicit MetricsExporter(const MetricsRegistry &registry,
+                             const AITimestamp &export_period);
+
+    /**
+     * If an export period has passed since the last snapshot, takes a new snapshot of
+     * the registry. The first snapshot is taken the first time this is called, and
+     * has no counter rates since there is nothing to compare it to
+     *
+     * @param now The current time
+     *
+     * @return a snapshot of every metric sorted by name, if one is due, and std::nullopt
+     * otherwise
+     */
+    std::optional<std::vector<MetricSample>> getPeriodicSnapshot(const AITimestamp &now);
+
+    /**
+     * Returns the given snapshot as text, with a header line naming the node followed
+     * by one "<name> <value>" line per sample
+     *
+     * @param node_name The name of the node the snapshot was taken in
+     * @param snapshot The snapshot
+     *
+     * @return the given snapshot as text
+     */
+    static std::string createTextSnapshot(const std::string &node_name,
+                                          const std::vector<MetricSample> &snapshot);
+
+    /**
+     * Writes the given snapshot to a text file, replacing its contents. The file is
+     * replaced in a single step, so anything reading it never sees a partial snapshot
+     *
+     * @param file_path The path of the file to write
+     * @param node_name The name of the node the snapshot was taken in
+     * @param snapshot The snapshot
+     *
+     * @return true if the file was written, and false otherwise
+     */
+    static bool writeSnapshotToFile(const std::string &file_path,
+                                    const std::string &node_name,
+                                    const std::vector<MetricSample> &snapshot);
+
+    /**
+     * Creates a Metrics message from the given snapshot
+     *
+     * @param node_name The name of the node the snapshot was taken in
+     * @param snapshot The snapshot
+     *
+     * @return a Metrics message containing the given snapshot
+     */
+    static thunderbots_msgs::Metrics createMetricsMsg(
+        const std::string &node_name, const std::vector<MetricSample> &snapshot);
+
+   private:
+    const MetricsRegistry &registry;
+    AITimestamp export_period;
+    std::optional<AITimestamp> last_export_time;
+    // The value of each counter in the last snapshot
+    std::map<std::string, double> last_counter_values;
+};
@@ -0,0 +1,75 @@
+#include "util/metrics/metrics_registry.h"
+
+#include <algorithm>
+
+MetricsRegistry::MetricsRegistry() : mutex(), counters(), gauges(), histograms() {}
+
+MetricCounter &MetricsRegistry::getCounter(const std::string &name)
+{
+    std::scoped_lock lock(mutex);
+    std::unique_ptr<MetricCounter> &counter = counters[name];
+    if (!counter)
+    {
+        counter = std::make_unique<MetricCounter>();
+    }
+
+    return *counter;
+}
+
+MetricGauge &MetricsRegistry::getGauge(const std::string &name)
+{
+    std::scoped_lock lock(mutex);
+    std::unique_ptr<MetricGauge> &gauge = gauges[name];
+    if (!gauge)
+    {
+        gauge = std::make_unique<MetricGauge>();
+    }
+
+    return *gauge;
+}
+
+MetricHistogram &MetricsRegistry::getHistogram(
+    const std::string &name, const std::vector<double> &bucket_upper_bounds)
+{
+    std::scoped_lock lock(mutex);
+    std::unique_ptr<MetricHistogram> &histogram = histograms[name];
+    if (!histogram)
+    {
+        histogram = std::make_unique<MetricHistogram>(bucket_upper_bounds);
+    }
+
+    return *histogram;
+}
+
+std::vector<MetricSample> MetricsRegistry::getSnapshot() const
+{
+    std::scoped_lock lock(mutex);
+
+    std::vector<MetricSample> snapshot;
+    snapshot.reserve(counters.size() + gauges.size() + 5 * histograms.size());
+    for (const auto &[name, counter] : counters)
+    {
+        snapshot.emplace_back(
+            MetricSample{name, static_cast<double>(counter->get()), true});
+    }
+    for (const auto &[name, gauge] : gauges)
+    {
+        snapshot.emplace_back(MetricSample{name, gauge->get(), false});
+    }
+    for (const auto &[name, histogram] : histograms)
+    {
+        snapshot.emplace_back(MetricSample{
+            name + ".count", static_cast<double>(histogram->getCount()), false});
+        snapshot.emplace_back(MetricSample{name + ".mean", histogram->getMean(), false});
+        snapshot.emplace_back(
+            MetricSample{name + ".p50", histogram->getPercentile(0.5), false});
+        snapshot.emplace_back(
+            MetricSample{name + ".p99", histogram->getPercentile(0.99), false});
+        snapshot.emplace_back(MetricSample{name + ".max", histogram->getMax(), false});
+    }
+
+    std::sort(
+        snapshot.begin(), snapshot.end(),
+        [](const MetricSample &a, const MetricSample &b) { return a.name < b.name; });
+    return snapshot;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "util/metrics/metrics.h"
+
+/**
+ * A single value taken from a metric when a snapshot of the registry is created.
+ * Histograms produce several samples, one for each statistic
+ */
+typedef struct
+{
+    std::string name;
+    double value;
+    // Whether this sample is the value of a counter, which can be used to calculate
+    // how fast the counter is going up
+    bool is_counter;
+} MetricSample;
+
+/**
+ * Owns the metrics for a node and creates snapshots of all of them at once.
+ *
+ * Metrics are created the first time they are asked for, and asking for the same name
+ * again returns the same metric. Creating a metric and taking a snapshot lock the
+ * registry, so the code on hot paths should ask for its metrics once up front and keep
+ * the references it gets back, which stay valid for the life of the registry.
+ * Updating those metrics never locks.
+ */
+class MetricsRegistry
+{
+   public:
+    /**
+     * Creates a new, empty MetricsRegistry
+     */
+    explicit MetricsRegistry();
+
+    // The registry hands out references to the metrics it owns, so it can't be copied
+    MetricsRegistry(const MetricsRegistry &) = delete;
+    MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+
+    /**
+     * Returns the counter with the given name, creating it if it doesn't exist
+     *
+     * @param name The name of the counter
+     *
+     * @return the counter with the given name
+     */
+    MetricCounter &getCounter(const std::string &name);
+
+    /**
+     * Returns the gauge with the given name, creating it if it doesn't exist
+     *
+     * @param name The name of the gauge
+     *
+     * @return the gauge with the given name
+     */
+    MetricGauge &getGauge(const std::string &name);
+
+    /**
+     * Returns the histogram with the given name, creating it with the given bucket
+     * bounds if it doesn't exist. If it already exists, the bounds are ignored
+     *
+     * @param name The name of the histogram
+     * @param bucket_upper_bounds The upper bound of each bucket, in increasing order
+     *
+     * @return the histogram with the given name
+     */
+    MetricHistogram &getHistogram(const std::string &name,
+                                  const std::vector<double> &bucket_upper_bounds);
+
+    /**
+     * Returns the current value of every metric, sorted by name. Counters and gauges
+     * produce a single sample with their name. Histograms produce samples named
+     * <name>.count, <name>.mean, <name>.p50, <name>.p99 and <name>.max
+     *
+     * @return the current value of every metric
+     */
+    std::vector<MetricSample> getSnapshot() const;
+
+   private:
+    // Protects the maps, but not the metrics themselves
+    mutable std::mutex mutex;
+    // The metrics are stored behind pointers so references to them stay valid as more
+    // are added
+    std::map<std::string, std::unique_ptr<MetricCounter>> counters;
+    std::map<std::string, std::unique_ptr<MetricGauge>> gauges;
+    std::map<std::string, std::unique_ptr<MetricHistogram>> histograms;
+};
@@ -2,6 +2,7 @@
 
 #include <ros/ros.h>
 
+#include <map>
 #include <memory>
 #include <string>
 
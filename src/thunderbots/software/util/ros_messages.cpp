@@ -9,7 +9,13 @@ namespace Util
             Point ball_position  = Point(ball_msg.position.x, ball_msg.position.y);
             Vector ball_velocity = Vector(ball_msg.velocity.x, ball_msg.velocity.y);
 
-            Ball ball = Ball(ball_position, ball_velocity);
+            // The timestamp is the capture time of the frame the ball was filtered
+            // from, on the same clock as the robots' timestamps
+            auto epoch       = std::chrono::steady_clock::time_point();
+            auto since_epoch = std::chrono::microseconds(ball_msg.timestamp_microseconds);
+            auto timestamp   = epoch + since_epoch;
+
+            Ball ball = Ball(ball_position, ball_velocity, timestamp);
 
             return ball;
         }
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * A fixed-capacity, lock-free ring buffer for passing data from exactly one producer
+ * thread to exactly one consumer thread (Single Producer Single Consumer).
+ *
+ * All storage is allocated up front when the buffer is created, so pushing and popping
+ * never allocate. Values are moved in and out of the buffer rather than copied.
+ *
+ * Only a single thread may call push(), and only a single (possibly different) thread
+ * may call pop(). The size queries may be called from any thread, but their results
+ * are only a snapshot and may be out of date as soon as they are returned.
+ *
+ * @tparam T The type of the values stored in the buffer. Must be default-constructible
+ * and move-assignable
+ * @tparam Capacity The maximum number of values the buffer can hold at once
+ */
+template <typename T, std::size_t Capacity>
+class SPSCRingBuffer
+{
+    static_assert(Capacity > 0, "The capacity of the SPSCRingBuffer must be > 0");
+
+   public:
+    /**
+     * Creates a new, empty SPSCRingBuffer
+     */
+    explicit SPSCRingBuffer() : head(0), tail(0), buffer() {}
+
+    /**
+     * Moves the given value into the buffer. If the buffer is full, the value is not
+     * added and the buffer is left unchanged. Must only be called by the producer thread.
+     *
+     * @param value The value to add to the buffer
+     *
+     * @return true if the value was added to the buffer, and false if the buffer was
+     * full and the value was dropped
+     */
+    bool push(T&& value)
+    {
+        const std::size_t current_tail = tail.load(std::memory_order_relaxed);
+        const std::size_t next_tail    = increment(current_tail);
+
+        // The buffer is full if advancing the tail would make it run into the head
+        if (next_tail == head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        buffer[current_tail] = std::move(value);
+        tail.store(next_tail, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Moves the oldest value in the buffer into the given value, and removes it from the
+     * buffer. If the buffer is empty, the given value is left unchanged. Must only be
+     * called by the consumer thread.
+     *
+     * @param value The value to move the oldest value in the buffer into
+     *
+     * @return true if a value was removed from the buffer, and false if the buffer was
+     * empty
+     */
+    bool pop(T& value)
+    {
+        const std::size_t current_head = head.load(std::memory_order_relaxed);
+
+        if (current_head == tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        value = std::move(buffer[current_head]);
+        head.store(increment(current_head), std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Returns the number of values currently in the buffer
+     *
+     * @return the number of values currently in the buffer
+     */
+    std::size_t size() const
+    {
+        const std::size_t current_head = head.load(std::memory_order_acquire);
+        const std::size_t current_tail = tail.load(std::memory_order_acquire);
+
+        return current_tail >= current_head ? current_tail - current_head
+                                            : current_tail + buffer.size() - current_head;
+    }
+
+    /**
+     * Returns true if the buffer contains no values, and false otherwise
+     *
+     * @return true if the buffer contains no values, and false otherwise
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * Returns the maximum number of values the buffer can hold at once
+     *
+     * @return the maximum number of values the buffer can hold at once
+     */
+    static constexpr std::size_t capacity()
+    {
+        return Capacity;
+    }
+
+   private:
+    /**
+     * Returns the index that comes after the given index, wrapping around the end of
+     * the underlying storage
+     *
+     * @param index The index to increment
+     *
+     * @return the index that comes after the given index
+     */
+    static constexpr std::size_t increment(std::size_t index)
+    {
+        return index + 1 == Capacity + 1 ? 0 : index + 1;
+    }
+
+    // The head and tail are kept on separate cache lines so that the producer and
+    // consumer threads don't invalidate each other's cache every time they update
+    // their own index (false sharing)
+    //
+    // The index of the oldest value in the buffer. Only written by the consumer
+    alignas(64) std::atomic<std::size_t> head;
+    // The index one past the newest value in the buffer. Only written by the producer
+    alignas(64) std::atomic<std::size_t> tail;
+    // We allocate one more slot than the capacity so that we can distinguish a full
+    // buffer from an empty one without any additional shared state
+    alignas(64) std::array<T, Capacity + 1> buffer;
+};
@@ -0,0 +1,112 @@
+#include "util/thread_pool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned int num_threads)
+    : workers(),
+      mutex(),
+      batch_started_condition(),
+      batch_finished_condition(),
+      current_task(nullptr),
+      num_tasks(0),
+      batch_number(0),
+      num_busy_workers(0),
+      stopped(false),
+      next_task(0)
+{
+    // The thread that runs a batch is one of the threads working on it
+    for (unsigned int i = 1; i < std::max(num_threads, 1u); i++)
+    {
+        workers.emplace_back([this]() { runWorker(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::scoped_lock lock(mutex);
+        stopped = true;
+    }
+    batch_started_condition.notify_all();
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+unsigned int ThreadPool::getNumThreads() const
+{
+    return static_cast<unsigned int>(workers.size()) + 1;
+}
+
+void ThreadPool::parallelFor(std::size_t num_tasks,
+                             const std::function<void(std::size_t)>& task)
+{
+    // Waking the workers isn't worth it if there is nothing for them to do
+    if (workers.empty() || num_tasks <= 1)
+    {
+        for (std::size_t i = 0; i < num_tasks; i++)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::scoped_lock lock(mutex);
+        current_task     = &task;
+        this->num_tasks  = num_tasks;
+        num_busy_workers = static_cast<unsigned int>(workers.size());
+        next_task.store(0);
+        batch_number++;
+    }
+    batch_started_condition.notify_all();
+
+    runTasks();
+
+    // Every worker has to finish before the task goes out of scope, even if there
+    // were no tasks left for it by the time it woke up
+    std::unique_lock lock(mutex);
+    batch_finished_condition.wait(lock, [this]() { return num_busy_workers == 0; });
+    current_task = nullptr;
+}
+
+void ThreadPool::runWorker()
+{
+    uint64_t last_batch_number = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock(mutex);
+            batch_started_condition.wait(lock, [this, last_batch_number]() {
+                return stopped || batch_number != last_batch_number;
+            });
+            if (stopped)
+            {
+                return;
+            }
+            last_batch_number = batch_number;
+        }
+
+        runTasks();
+
+        bool batch_finished;
+        {
+            std::scoped_lock lock(mutex);
+            batch_finished = --num_busy_workers == 0;
+        }
+        if (batch_finished)
+        {
+            batch_finished_condition.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runTasks()
+{
+    for (std::size_t i = next_task.fetch_add(1); i < num_tasks;
+         i             = next_task.fetch_add(1))
+    {
+        (*current_task)(i);
+    }
+}
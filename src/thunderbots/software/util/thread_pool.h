@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed set of worker threads that split up batches of independent tasks, such as
+ * the rows of a grid, so the batch finishes sooner than it would on one thread.
+ *
+ * The threads are started when the pool is created and wait for work until it is
+ * destroyed, so running a batch doesn't create any threads. The thread that runs a
+ * batch works on it too, and tasks are handed out one at a time to whichever thread
+ * is free, so uneven tasks still balance out.
+ *
+ * Only one thread may run batches on a pool, and tasks must not throw exceptions.
+ */
+class ThreadPool final
+{
+   public:
+    /**
+     * Creates a new ThreadPool and starts its worker threads
+     *
+     * @param num_threads The number of threads that work on each batch, including the
+     * thread that runs the batch. A pool with one thread runs every task on the thread
+     * that runs the batch
+     */
+    explicit ThreadPool(unsigned int num_threads);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Stops the worker threads and waits for them to finish
+     */
+    ~ThreadPool();
+
+    /**
+     * Returns the number of threads that work on each batch, including the thread that
+     * runs the batch
+     *
+     * @return the number of threads that work on each batch
+     */
+    unsigned int getNumThreads() const;
+
+    /**
+     * Runs the given task once for every index from 0 to num_tasks - 1, spread across
+     * the threads of the pool, and waits for all of them to finish. The tasks may run
+     * in any order
+     *
+     * @param num_tasks The number of times to run the task
+     * @param task The task to run, which is given the index of each run
+     */
+    void parallelFor(std::size_t num_tasks, const std::function<void(std::size_t)>& task);
+
+   private:
+    /**
+     * Waits for batches and works on them until the pool is destroyed. Run by each
+     * worker thread
+     */
+    void runWorker();
+
+    /**
+     * Runs tasks from the current batch until there are none left
+     */
+    void runTasks();
+
+    std::vector<std::thread> workers;
+
+    // Protects everything below. The current task and number of tasks are only changed
+    // while no worker is working on a batch
+    std::mutex mutex;
+    std::condition_variable batch_started_condition;
+    std::condition_variable batch_finished_condition;
+    const std::function<void(std::size_t)>* current_task;
+    std::size_t num_tasks;
+    // Counts the batches run so far, so a worker can tell a new batch from the last one
+    uint64_t batch_number;
+    unsigned int num_busy_workers;
+    bool stopped;
+
+    // The index of the next task to be handed out in the current batch
+    std::atomic<std::size_t> next_task;
+};
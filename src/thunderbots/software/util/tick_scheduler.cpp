@@ -0,0 +1,142 @@
+#include "util/tick_scheduler.h"
+
+#include <cassert>
+#include <cmath>
+
+TickScheduler::TickScheduler(TickMode mode, const AITimestamp &period,
+                             const AITimestamp &deadline, MetricsRegistry &metrics,
+                             const std::string &metrics_prefix)
+    : mode(mode),
+      period(period),
+      deadline(deadline),
+      mutex(),
+      wake_condition(),
+      has_new_data(false),
+      stopped(false),
+      last_tick_start_time(std::nullopt),
+      last_tick_interval(std::nullopt),
+      next_fixed_rate_tick_time(std::nullopt),
+      average_jitter_us(0),
+      deadline_misses_metric(metrics.getCounter(metrics_prefix + ".deadline_misses")),
+      ticks_without_new_data_metric(
+          metrics.getCounter(metrics_prefix + ".ticks_without_new_data")),
+      tick_interval_metric(metrics.getHistogram(
+          metrics_prefix + ".tick_interval_us",
+          MetricHistogram::createExponentialBucketBounds(100, 1.1, 64))),
+      tick_jitter_metric(metrics.getGauge(metrics_prefix + ".tick_jitter_us"))
+{
+    // Fixed rate ticks would never catch up to the current time otherwise
+    assert(period > AITimestamp::zero());
+}
+
+void TickScheduler::notifyNewData()
+{
+    {
+        std::scoped_lock lock(mutex);
+        has_new_data = true;
+    }
+    wake_condition.notify_one();
+}
+
+void TickScheduler::stop()
+{
+    {
+        std::scoped_lock lock(mutex);
+        stopped = true;
+    }
+    wake_condition.notify_one();
+}
+
+bool TickScheduler::waitForNextTick()
+{
+    std::unique_lock lock(mutex);
+
+    if (mode == TICK_ON_NEW_DATA)
+    {
+        // The first tick starts straight away, so there is always something to act on
+        AITimestamp wake_time = last_tick_start_time ? *last_tick_start_time + period
+                                                     : Timestamp::getTimestampNow();
+        wake_condition.wait_until(lock, std::chrono::steady_clock::time_point(wake_time),
+                                  [this]() { return has_new_data || stopped; });
+    }
+    else
+    {
+        if (!next_fixed_rate_tick_time)
+        {
+            next_fixed_rate_tick_time = Timestamp::getTimestampNow();
+        }
+        wake_condition.wait_until(
+            lock, std::chrono::steady_clock::time_point(*next_fixed_rate_tick_time),
+            [this]() { return stopped; });
+
+        // Ticks are scheduled from when they should have started rather than when they
+        // did, so the rate doesn't drift. If a tick overran, we skip the ticks it
+        // overran into rather than running them back to back to catch up
+        AITimestamp now = Timestamp::getTimestampNow();
+        while (*next_fixed_rate_tick_time <= now)
+        {
+            *next_fixed_rate_tick_time += period;
+        }
+    }
+
+    if (stopped)
+    {
+        return false;
+    }
+
+    bool tick_has_new_data = has_new_data;
+    has_new_data           = false;
+    lock.unlock();
+
+    recordTickStart(Timestamp::getTimestampNow(), tick_has_new_data);
+    return true;
+}
+
+AITimestamp TickScheduler::getTickDeadline() const
+{
+    return last_tick_start_time.value_or(Timestamp::getTimestampNow()) + deadline;
+}
+
+bool TickScheduler::finishTick()
+{
+    if (!last_tick_start_time)
+    {
+        return true;
+    }
+
+    if (Timestamp::getTimestampNow() - *last_tick_start_time > deadline)
+    {
+        deadline_misses_metric.increment();
+        return false;
+    }
+
+    return true;
+}
+
+void TickScheduler::recordTickStart(const AITimestamp &tick_start_time,
+                                    bool tick_has_new_data)
+{
+    if (!tick_has_new_data)
+    {
+        ticks_without_new_data_metric.increment();
+    }
+
+    if (last_tick_start_time)
+    {
+        AITimestamp interval = tick_start_time - *last_tick_start_time;
+        tick_interval_metric.record(
+            static_cast<double>(Timestamp::getMicroseconds(interval)));
+
+        if (last_tick_interval)
+        {
+            double interval_change_us = static_cast<double>(
+                std::abs(Timestamp::getMicroseconds(interval - *last_tick_interval)));
+            average_jitter_us +=
+                (interval_change_us - average_jitter_us) * JITTER_SMOOTHING_FACTOR;
+            tick_jitter_metric.set(average_jitter_us);
+        }
+        last_tick_interval = interval;
+    }
+
+    last_tick_start_time = tick_start_time;
+}
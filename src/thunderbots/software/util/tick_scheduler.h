@@ -0,0 +1,127 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "util/metrics/metrics_registry.h"
+#include "util/timestamp.h"
+
+/**
+ * Defines when a TickScheduler starts ticks
+ */
+typedef enum
+{
+    // Tick as soon as new data arrives, or once the maximum period has passed since the
+    // last tick if no new data arrives
+    TICK_ON_NEW_DATA = 0,
+    // Tick at a fixed rate, whether or not new data has arrived
+    TICK_AT_FIXED_RATE = 1
+} TickMode;
+
+/**
+ * Decides when a loop that acts on new data, such as the AI's planning loop, should
+ * run its next tick, so the loop sleeps rather than spinning when there is nothing to
+ * do. Each tick has a deadline it should finish by. The scheduler can't stop a tick
+ * that runs late, so the tick's work enforces the deadline itself by fitting into the
+ * time left before getTickDeadline(), and finishTick() records the ticks that didn't.
+ *
+ * The scheduler reports how well ticks are keeping up through a MetricsRegistry:
+ * - <prefix>.deadline_misses: A counter of the ticks that finished after their deadline
+ * - <prefix>.ticks_without_new_data: A counter of the ticks started without new data
+ * - <prefix>.tick_interval_us: A histogram of the time between the starts of ticks
+ * - <prefix>.tick_jitter_us: A gauge of the average change in the time between ticks
+ *
+ * One thread (the tick thread) waits for and runs the ticks, while any thread may
+ * notify the scheduler of new data or stop it.
+ */
+class TickScheduler
+{
+   public:
+    /**
+     * Creates a new TickScheduler
+     *
+     * @param mode When to start ticks
+     * @param period The time between ticks when ticking at a fixed rate, or the longest
+     * time to wait for new data before ticking anyway when ticking on new data. Must be
+     * greater than 0
+     * @param deadline How long each tick may take
+     * @param metrics The registry to report the scheduler's statistics to
+     * @param metrics_prefix The prefix of the names of the scheduler's metrics
+     */
+    explicit TickScheduler(TickMode mode, const AITimestamp &period,
+                           const AITimestamp &deadline, MetricsRegistry &metrics,
+                           const std::string &metrics_prefix);
+
+    /**
+     * Tells the scheduler that new data has arrived, which starts the next tick if
+     * ticking on new data. May be called from any thread
+     */
+    void notifyNewData();
+
+    /**
+     * Wakes the tick thread and makes every call to waitForNextTick() return false from
+     * now on. May be called from any thread
+     */
+    void stop();
+
+    /**
+     * Blocks until the next tick should start. Must only be called by the tick thread
+     *
+     * @return true if the next tick should be run, and false if the scheduler was
+     * stopped
+     */
+    bool waitForNextTick();
+
+    /**
+     * Returns when the tick started by the last call to waitForNextTick() must finish
+     * by. Must only be called by the tick thread
+     *
+     * @return when the current tick must finish by, on the same clock as
+     * Timestamp::getTimestampNow()
+     */
+    AITimestamp getTickDeadline() const;
+
+    /**
+     * Marks the end of the tick started by the last call to waitForNextTick(), and
+     * records if it missed its deadline. Must only be called by the tick thread
+     *
+     * @return true if the tick finished by its deadline, and false otherwise
+     */
+    bool finishTick();
+
+   private:
+    /**
+     * Records the statistics for a tick that started at the given time
+     *
+     * @param tick_start_time The time the tick started
+     * @param tick_has_new_data Whether new data arrived since the last tick
+     */
+    void recordTickStart(const AITimestamp &tick_start_time, bool tick_has_new_data);
+
+    // How much of each new change in the interval between ticks is added to the
+    // average jitter. This is the same smoothing RTP uses for packet jitter
+    static constexpr double JITTER_SMOOTHING_FACTOR = 1.0 / 16.0;
+
+    TickMode mode;
+    AITimestamp period;
+    AITimestamp deadline;
+
+    // Protects has_new_data and stopped, which are shared with the other threads
+    std::mutex mutex;
+    std::condition_variable wake_condition;
+    bool has_new_data;
+    bool stopped;
+
+    // These are only used by the tick thread
+    std::optional<AITimestamp> last_tick_start_time;
+    std::optional<AITimestamp> last_tick_interval;
+    std::optional<AITimestamp> next_fixed_rate_tick_time;
+    double average_jitter_us;
+
+    MetricCounter &deadline_misses_metric;
+    MetricCounter &ticks_without_new_data_metric;
+    MetricHistogram &tick_interval_metric;
+    MetricGauge &tick_jitter_metric;
+};
@@ -16,6 +16,19 @@ namespace Timestamp
         return std::chrono::steady_clock::now().time_since_epoch();
     }
 
+    /**
+     * Returns an AITimestamp of the current time on the system (wall) clock, measured
+     * from the unix epoch. Unlike getTimestampNow(), this is on the same clock as the
+     * capture times SSL Vision reports, provided both machines' clocks are synchronized
+     *
+     * @return an AITimestamp of the current time on the system clock
+     */
+    static inline AITimestamp getSystemTimestampNow()
+    {
+        return std::chrono::duration_cast<AITimestamp>(
+            std::chrono::system_clock::now().time_since_epoch());
+    }
+
     /**
      * Returns the given timestamp in microseconds
      *
@@ -27,4 +40,17 @@ namespace Timestamp
     {
         return std::chrono::duration_cast<std::chrono::microseconds>(timestamp).count();
     }
+
+    /**
+     * Returns an AITimestamp of the given number of microseconds
+     *
+     * @param microseconds the number of microseconds
+     *
+     * @return an AITimestamp of the given number of microseconds
+     */
+    static inline AITimestamp fromMicroseconds(int64_t microseconds)
+    {
+        return std::chrono::duration_cast<AITimestamp>(
+            std::chrono::microseconds(microseconds));
+    }
 }  // namespace Timestamp